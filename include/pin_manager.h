@@ -12,17 +12,19 @@ extern "C" {
  * Pin Manager - Manages all pin states and I/O operations
  */
 
+/**
+ * Shared metadata of a pin type (static, never freed)
+ * @param type Pin type
+ * @return NULL for an invalid pin type
+ */
+const PinInfo* pin_manager_get_info(PinType type);
+
 /**
  * Initialize a pin with its properties
  * @param pin Pointer to pin structure
- * @param type Pin type
- * @param is_input Whether pin is an input
- * @param is_output Whether pin is an output
- * @param min_voltage Minimum valid voltage
- * @param max_voltage Maximum valid voltage
+ * @param info Pin metadata (borrowed, must outlive the pin)
  */
-void pin_init(Pin* pin, PinType type, bool is_input, bool is_output,
-              double min_voltage, double max_voltage);
+void pin_init(Pin* pin, const PinInfo* info);
 
 /**
  * Set pin value (for input pins)
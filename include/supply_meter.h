@@ -0,0 +1,58 @@
+#ifndef SUPPLY_METER_H
+#define SUPPLY_METER_H
+
+#include "tcan1463q1_types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Supply Meter - Integrates ISUP/ICC/IIO over mode residency intervals
+ */
+
+/**
+ * Initialize supply meter structure
+ * @param meter Pointer to supply meter structure
+ */
+void supply_meter_init(SupplyMeter* meter);
+
+/**
+ * Update the load point; closes the open interval only if it changed
+ * @param meter Pointer to supply meter structure
+ * @param mode Current operating mode
+ * @param driver_dominant true if the CAN driver is driving dominant
+ * @param bias Current bus bias state
+ * @param vsup VSUP voltage
+ * @param vcc VCC voltage
+ * @param vio VIO voltage
+ * @param rl_resistance Bus load resistance (Ω)
+ * @param current_time Current simulation time in nanoseconds
+ */
+void supply_meter_update(SupplyMeter* meter, OperatingMode mode, bool driver_dominant,
+                         BusBiasState bias, double vsup, double vcc, double vio,
+                         double rl_resistance, uint64_t current_time);
+
+/**
+ * Close the open interval at a given time and start a new one
+ * @param meter Pointer to supply meter structure
+ * @param current_time Current simulation time in nanoseconds
+ */
+void supply_meter_close_interval(SupplyMeter* meter, uint64_t current_time);
+
+/**
+ * Get accumulated charge and energy, including the open interval
+ * @param meter Pointer to supply meter structure
+ * @param current_time Current simulation time in nanoseconds
+ * @param energy Output totals
+ */
+void supply_meter_get_energy(const SupplyMeter* meter, uint64_t current_time,
+                             SupplyEnergy* energy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SUPPLY_METER_H
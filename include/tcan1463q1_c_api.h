@@ -146,6 +146,19 @@ TCAN_ErrorCode tcan_simulator_create(TCAN1463Q1SimHandle* handle);
  */
 TCAN_ErrorCode tcan_simulator_destroy(TCAN1463Q1SimHandle handle);
 
+/**
+ * @brief Clone a simulator
+ * 
+ * The clone gets a copy of the state and shares the device profile and
+ * callback registrations with the original (callbacks are copied on the
+ * first change). Destroy it with tcan_simulator_destroy().
+ * 
+ * @param[in] handle Simulator to clone
+ * @param[out] clone Pointer to receive the clone's handle
+ * @return TCAN_SUCCESS on success, error code otherwise
+ */
+TCAN_ErrorCode tcan_simulator_clone(TCAN1463Q1SimHandle handle, TCAN1463Q1SimHandle* clone);
+
 /**
  * @brief Reset simulator to initial state
  * 
@@ -507,6 +520,112 @@ TCAN_ErrorCode tcan_simulator_restore(
  */
 TCAN_ErrorCode tcan_simulator_snapshot_free(TCAN1463Q1SnapHandle snapshot);
 
+/* ========================================================================
+ * Batch Functions
+ *
+ * Operate on an array of handles in one call, for hosts stepping large
+ * populations of simulators. Arguments are validated once per call and
+ * every handle is checked before any simulator is touched, so a bad
+ * handle leaves the whole population unchanged.
+ * ======================================================================== */
+
+/**
+ * @brief Flag word bits (see tcan_simulator_batch_get_flag_words)
+ */
+typedef enum {
+    TCAN_FLAG_PWRON = 1u << 0,
+    TCAN_FLAG_WAKERQ = 1u << 1,
+    TCAN_FLAG_WAKESR = 1u << 2,
+    TCAN_FLAG_UVSUP = 1u << 3,
+    TCAN_FLAG_UVCC = 1u << 4,
+    TCAN_FLAG_UVIO = 1u << 5,
+    TCAN_FLAG_CBF = 1u << 6,
+    TCAN_FLAG_TXDCLP = 1u << 7,
+    TCAN_FLAG_TXDDTO = 1u << 8,
+    TCAN_FLAG_TXDRXD = 1u << 9,
+    TCAN_FLAG_CANDOM = 1u << 10,
+    TCAN_FLAG_TSD = 1u << 11
+} TCAN_FlagBit;
+
+/**
+ * @brief Set the same pin on many simulators
+ * 
+ * @param[in] handles Simulator handles
+ * @param[in] count Number of handles
+ * @param[in] pin Pin to set
+ * @param[in] states Pin state per simulator
+ * @param[in] voltages Pin voltage per simulator
+ * @return TCAN_SUCCESS on success, error code otherwise
+ * 
+ * @note Every voltage is checked first: if one is rejected (or the pin is
+ *       missing on that simulator's variant) no simulator is changed and
+ *       TCAN_ERROR_INVALID_VOLTAGE is returned
+ */
+TCAN_ErrorCode tcan_simulator_batch_set_pin(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    TCAN_PinType pin,
+    const TCAN_PinState* states,
+    const double* voltages
+);
+
+/**
+ * @brief Advance every simulator to the same simulation time
+ * 
+ * @param[in] handles Simulator handles
+ * @param[in] count Number of handles
+ * @param[in] target_ns Target time in nanoseconds; simulators already at
+ *            or past it are left alone
+ * @return TCAN_SUCCESS on success, error code otherwise
+ */
+TCAN_ErrorCode tcan_simulator_batch_step_to(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    uint64_t target_ns
+);
+
+/**
+ * @brief Read the operating mode of every simulator
+ * 
+ * @param[in] handles Simulator handles
+ * @param[in] count Number of handles
+ * @param[out] modes Array of count modes
+ * @return TCAN_SUCCESS on success, error code otherwise
+ */
+TCAN_ErrorCode tcan_simulator_batch_get_modes(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    TCAN_OperatingMode* modes
+);
+
+/**
+ * @brief Read the status flags of every simulator as TCAN_FlagBit words
+ * 
+ * @param[in] handles Simulator handles
+ * @param[in] count Number of handles
+ * @param[out] flags Array of count flag words
+ * @return TCAN_SUCCESS on success, error code otherwise
+ */
+TCAN_ErrorCode tcan_simulator_batch_get_flag_words(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    uint32_t* flags
+);
+
+/**
+ * @brief Read the simulation time of every simulator
+ * 
+ * @param[in] handles Simulator handles
+ * @param[in] count Number of handles
+ * @param[out] times_ns Array of count times in nanoseconds
+ * @return TCAN_SUCCESS on success, error code otherwise
+ */
+TCAN_ErrorCode tcan_simulator_batch_get_times(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    uint64_t* times_ns
+);
+
 /* ========================================================================
  * Event Callback Functions
  * ======================================================================== */
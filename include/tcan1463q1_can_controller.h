@@ -0,0 +1,134 @@
+#ifndef TCAN1463Q1_CAN_CONTROLLER_H
+#define TCAN1463Q1_CAN_CONTROLLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * CAN protocol controller
+ *
+ * Bit-level model of a classical CAN (ISO 11898-1) controller as found in
+ * the MCU next to the transceiver: arbitration, bit stuffing, CRC, ACK,
+ * bit monitoring, error flags, TEC/REC, error-passive and bus-off with
+ * recovery. The controller is driven one bit at a time: tx_bit() gives
+ * the level to put on TXD, rx_bit() takes the level sampled from RXD at
+ * the sample point. See tcan1463q1_can_network.h for wiring controllers
+ * to simulators.
+ *
+ * Levels are true for recessive (TXD/RXD high) and false for dominant.
+ */
+
+#define CAN_CONTROLLER_TX_QUEUE 16
+#define CAN_CONTROLLER_RX_QUEUE 32
+
+/**
+ * Bit timing
+ */
+typedef struct {
+    uint32_t bitrate;       // Bits per second
+    double sample_point;    // Sample point as a fraction of the bit time (0-1)
+} CANBitTiming;
+
+/**
+ * Classical CAN frame
+ */
+typedef struct {
+    uint32_t id;            // 11-bit or 29-bit identifier
+    bool extended;          // 29-bit identifier
+    bool rtr;               // Remote frame
+    uint8_t dlc;            // Data length code (0-15, at most 8 data bytes)
+    uint8_t data[8];
+} CANFrame;
+
+/**
+ * Fault confinement state
+ */
+typedef enum {
+    CAN_ERROR_ACTIVE,
+    CAN_ERROR_PASSIVE,
+    CAN_BUS_OFF
+} CANErrorState;
+
+/**
+ * Detected error types
+ */
+typedef enum {
+    CAN_ERROR_BIT,
+    CAN_ERROR_STUFF,
+    CAN_ERROR_CRC,
+    CAN_ERROR_FORM,
+    CAN_ERROR_ACK,
+    CAN_ERROR_TYPE_COUNT
+} CANErrorType;
+
+/**
+ * Controller statistics
+ */
+typedef struct {
+    uint64_t tx_frames;
+    uint64_t rx_frames;
+    uint64_t arbitration_lost;
+    uint64_t errors[CAN_ERROR_TYPE_COUNT];
+    uint64_t bus_off_count;
+    uint64_t rx_overruns;
+} CANControllerStats;
+
+typedef struct CANController CANController;
+
+// Controller management
+CANController* tcan1463q1_can_controller_create(const CANBitTiming* timing);
+void tcan1463q1_can_controller_destroy(CANController* controller);
+// Clear queues, counters and statistics; the controller re-integrates
+// (waits for 11 recessive bits) before joining bus traffic
+void tcan1463q1_can_controller_reset(CANController* controller);
+
+/**
+ * Validate bit timing
+ * @param timing Bit timing
+ * @return true if the bitrate is 10 kbit/s to 1 Mbit/s and the sample
+ *         point lies between 0.5 and 0.95
+ */
+bool tcan1463q1_can_controller_validate_timing(const CANBitTiming* timing);
+
+// Bit time and sample point offset in nanoseconds
+uint64_t tcan1463q1_can_controller_get_bit_time_ns(const CANController* controller);
+uint64_t tcan1463q1_can_controller_get_sample_offset_ns(const CANController* controller);
+
+// Frame queues
+// send returns false if the frame is invalid or the TX queue is full;
+// receive returns false if no frame is pending
+bool tcan1463q1_can_controller_send(CANController* controller, const CANFrame* frame);
+bool tcan1463q1_can_controller_receive(CANController* controller, CANFrame* frame);
+size_t tcan1463q1_can_controller_tx_pending(const CANController* controller);
+
+// Bit interface
+bool tcan1463q1_can_controller_tx_bit(CANController* controller);
+void tcan1463q1_can_controller_rx_bit(CANController* controller, bool level);
+
+// Fault confinement
+CANErrorState tcan1463q1_can_controller_get_error_state(const CANController* controller);
+uint16_t tcan1463q1_can_controller_get_tec(const CANController* controller);
+uint16_t tcan1463q1_can_controller_get_rec(const CANController* controller);
+// Automatic recovery starts the 128 x 11 recessive bit sequence as soon as
+// the controller enters bus-off; otherwise it waits for request_recovery
+void tcan1463q1_can_controller_set_auto_recovery(CANController* controller, bool enable);
+bool tcan1463q1_can_controller_request_recovery(CANController* controller);
+
+// Statistics
+void tcan1463q1_can_controller_get_stats(const CANController* controller,
+                                         CANControllerStats* stats);
+
+// Name lookups
+const char* tcan1463q1_can_error_state_name(CANErrorState state);
+const char* tcan1463q1_can_error_type_name(CANErrorType type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_CAN_CONTROLLER_H
@@ -0,0 +1,140 @@
+#ifndef TCAN1463Q1_CAN_NETWORK_H
+#define TCAN1463Q1_CAN_NETWORK_H
+
+#include "tcan1463q1_simulator.h"
+#include "tcan1463q1_can_controller.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * CAN network
+ *
+ * Nodes made of a transceiver simulator and a protocol controller on one
+ * bus. All nodes share the bit grid (no oscillator tolerance, so no
+ * resynchronization). Each bit, every controller drives its TXD pin, the
+ * bus resolves as wired-AND of the drivers able to drive, every simulator
+ * is stepped to the sample point where the controller samples RXD, then to
+ * the end of the bit. A node whose transceiver delays RXD past the sample
+ * point therefore sees bit errors, as would a real controller.
+ *
+ * Simulators are borrowed (configured and destroyed by the caller);
+ * controllers are owned by the network.
+ *
+ * Ground shift: each node may sit at its own ground offset, and a common-
+ * mode disturbance may be put on both bus lines. Each bit the bus common
+ * mode follows the nodes setting the level (the dominant drivers, else all
+ * nodes) plus the disturbance; every node sees it against its own ground
+ * (the network keeps the offsets in a per-node array that each node's
+ * simulator reads, overriding tcan1463q1_simulator_set_bus_offset) and its
+ * receiver classifies the locally referenced bus, so a node outside the
+ * receiver common-mode range (VCM_RANGE_MIN..VCM_RANGE_MAX) reads an
+ * indeterminate bus.
+ *
+ * Equivalence classes (off by default): nodes whose simulator and
+ * controller states, TXD and ground offset are equal get equal inputs
+ * every bit, so the network can simulate one of them and copy its state
+ * to the others. Classes are formed at the first bit of each run call and
+ * the followers brought up to date when it returns, or earlier by
+ * tcan1463q1_can_network_sync and the node getters; a node changed from
+ * outside in between (its own TXD, WAKE, a queued frame) simply ends up
+ * in a class of its own at the next grouping. Simulators with callbacks,
+ * stimulus, noise, run control or probes attached are never collapsed,
+ * nor are pinned nodes (driven mid-run, e.g. from the bit callback).
+ * Many identical listeners then cost about as much as one.
+ *
+ * Lazy sleep (off by default): a node in Sleep or Standby with TXD and RXD
+ * high and an idle controller only reacts to bus edges and its own timers,
+ * so after a recessive bit it is parked and no longer stepped. The next
+ * dominant bit wakes every parked node, and a node also wakes at the bit
+ * holding its next timer deadline (tSILENCE, WUP, UV filters): it is
+ * stepped over the time it slept in one step, its controller counts the
+ * recessive bits, and it takes part in the bit, so transitions and supply
+ * energy match the full simulation. Syncing (see above) wakes them too.
+ * Not used with ground shift.
+ * Sleep studies then cost in proportion to the awake nodes.
+ */
+typedef struct CANNetwork CANNetwork;
+
+/**
+ * Called after every simulated bit with the network time at its end
+ */
+typedef void (*CANNetworkBitCallback)(CANNetwork* network, uint64_t time_ns, void* user_data);
+
+/**
+ * Network statistics
+ */
+typedef struct {
+    uint64_t bits;              // Bit times simulated
+    uint64_t dominant_bits;     // Bit times with a dominant bus
+    uint64_t node_bits;         // Node bit times stepped (one per class when collapsed, none while parked)
+} CANNetworkStats;
+
+CANNetwork* tcan1463q1_can_network_create(const CANBitTiming* timing);
+void tcan1463q1_can_network_destroy(CANNetwork* network);
+
+/**
+ * Add a node
+ * @param network Network
+ * @param sim Transceiver simulator (not owned)
+ * @return Node index, or -1 on error
+ */
+int tcan1463q1_can_network_add_node(CANNetwork* network, TCAN1463Q1Simulator* sim);
+size_t tcan1463q1_can_network_node_count(const CANNetwork* network);
+CANController* tcan1463q1_can_network_get_controller(CANNetwork* network, size_t node);
+TCAN1463Q1Simulator* tcan1463q1_can_network_get_simulator(CANNetwork* network, size_t node);
+
+// Simulate a number of bit times, or whole bit times covering a duration
+void tcan1463q1_can_network_run_bits(CANNetwork* network, uint64_t bits);
+void tcan1463q1_can_network_run_for(CANNetwork* network, uint64_t duration_ns);
+
+// Network time (bits simulated x bit time) and bit time
+uint64_t tcan1463q1_can_network_get_time_ns(const CANNetwork* network);
+uint64_t tcan1463q1_can_network_get_bit_time_ns(const CANNetwork* network);
+
+// Install (or clear with NULL) the per-bit callback
+void tcan1463q1_can_network_set_bit_callback(CANNetwork* network,
+                                             CANNetworkBitCallback callback,
+                                             void* user_data);
+
+// Ground offset of one node or of all nodes (count must equal the node count)
+bool tcan1463q1_can_network_set_ground_offset(CANNetwork* network, size_t node, double volts);
+bool tcan1463q1_can_network_set_ground_offsets(CANNetwork* network, const double* volts,
+                                               size_t count);
+// Common-mode disturbance on both bus lines, e.g. set from the bit callback
+void tcan1463q1_can_network_set_common_mode(CANNetwork* network, double volts);
+// Bus common-mode offset a node saw in the last bit
+double tcan1463q1_can_network_get_bus_offset(const CANNetwork* network, size_t node);
+
+/**
+ * Collapse equal nodes into equivalence classes while running. Between
+ * bits (the bit callback) followers lag their leaders: call
+ * tcan1463q1_can_network_sync before reading or changing their simulators
+ * through pointers held outside the network.
+ */
+void tcan1463q1_can_network_set_collapse(CANNetwork* network, bool enable);
+/**
+ * Park sleeping nodes until the next bus edge; parked nodes lag like
+ * followers do (call tcan1463q1_can_network_sync from the bit callback)
+ */
+void tcan1463q1_can_network_set_lazy_sleep(CANNetwork* network, bool enable);
+/**
+ * Keep a node out of equivalence classes and lazy sleep, so that it is
+ * simulated every bit: for nodes whose controller is driven from outside
+ * the run loop, e.g. from the bit callback (a gateway pins its own nodes)
+ */
+bool tcan1463q1_can_network_set_node_pinned(CANNetwork* network, size_t node, bool pinned);
+// Bring every node up to date; classes are formed again at the next bit
+void tcan1463q1_can_network_sync(CANNetwork* network);
+
+// true once every controller has an empty TX queue
+bool tcan1463q1_can_network_tx_idle(const CANNetwork* network);
+
+void tcan1463q1_can_network_get_stats(const CANNetwork* network, CANNetworkStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_CAN_NETWORK_H
@@ -0,0 +1,117 @@
+#ifndef TCAN1463Q1_DEVICE_H
+#define TCAN1463Q1_DEVICE_H
+
+#include "tcan1463q1_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Device variants
+ *
+ * Each variant is described by a compile-time profile (see
+ * src/device_profiles.h) and gets its own specialized step kernel, so
+ * simulators of different variants can share one network.
+ */
+typedef enum {
+    DEVICE_VARIANT_TCAN1463Q1,   // Full pin set: INH, INH_MASK and WAKE
+    DEVICE_VARIANT_TCAN1462Q1,   // Reduced pin set: no INH, INH_MASK or WAKE
+    DEVICE_VARIANT_COUNT
+} DeviceVariant;
+
+/**
+ * Datasheet timing range (in nanoseconds)
+ */
+typedef struct {
+    uint64_t min_ns;
+    uint64_t max_ns;
+} TimingRangeNs;
+
+/**
+ * Device characteristics
+ *
+ * Voltage thresholds are the switching points used by the model, timings
+ * are datasheet ranges. Components pick their operating point from the
+ * range the same way for every variant (e.g. tUV uses the minimum).
+ */
+typedef struct {
+    // Undervoltage thresholds (V)
+    double uvsup_falling;
+    double uvsup_rising;
+    double uvcc_falling;
+    double uvcc_rising;
+    double uvio_falling;
+    double uvio_rising;
+
+    // Receiver thresholds (differential voltage, V)
+    double vdiff_dominant;
+    double vdiff_recessive;
+
+    // Driver and bias levels (V)
+    double canh_dominant;
+    double canl_dominant;
+    double canh_recessive;
+    double canl_recessive;
+    double bias_autonomous;
+    double inh_voltage_drop;
+
+    // Thermal shutdown threshold (°C)
+    double tsd_celsius;
+
+    // Timing ranges
+    TimingRangeNs tuv;
+    TimingRangeNs ttxddto;
+    TimingRangeNs tbusdom;
+    TimingRangeNs twk_filter;
+    TimingRangeNs twk_timeout;
+    TimingRangeNs tsilence;
+    TimingRangeNs tprop_loop1;
+    TimingRangeNs tprop_loop2;
+    uint64_t tinh_slp_stb_ns;
+
+    // Supply currents (A); dominant ICC adds the bus load current VOD/RL
+    double isup_normal;
+    double isup_standby;
+    double isup_sleep;
+    double isup_bias;          // Additional ISUP while autonomous bias is active
+    double icc_recessive;
+    double icc_dominant;
+    double icc_silent;
+    double icc_low_power;      // Standby, go-to-sleep and sleep
+    double iio_normal;
+    double iio_low_power;
+
+    // Feature presence
+    bool has_inh;
+    bool has_inh_mask;
+    bool has_wake;
+} DeviceParams;
+
+/**
+ * Get the characteristics of a device variant
+ * @param variant Device variant
+ * @return Pointer to static device parameters, or NULL for an invalid variant
+ */
+const DeviceParams* tcan1463q1_device_get_params(DeviceVariant variant);
+
+/**
+ * Get the display name of a device variant
+ * @param variant Device variant
+ * @return Variant name (e.g. "TCAN1463-Q1"), or NULL for an invalid variant
+ */
+const char* tcan1463q1_device_variant_name(DeviceVariant variant);
+
+/**
+ * Check whether a device has a given pin
+ * @param params Device parameters
+ * @param pin Pin to check
+ * @return true if the pin exists on the device
+ */
+bool tcan1463q1_device_has_pin(const DeviceParams* params, PinType pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_DEVICE_H
@@ -0,0 +1,140 @@
+#ifndef TCAN1463Q1_GATEWAY_H
+#define TCAN1463Q1_GATEWAY_H
+
+#include "tcan1463q1_can_network.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Store-and-forward CAN gateway
+ *
+ * Joins two CAN networks (bus segments A and B) with one node on each:
+ * frames received by the gateway's controller on one segment are looked
+ * up in a routing table, optionally given a new identifier, held for the
+ * direction's processing latency in a bounded queue and then handed to
+ * the gateway's controller on the other segment.
+ *
+ * Standard identifiers are routed through a flat 2048-entry table per
+ * segment, extended identifiers through an open-addressing hash table;
+ * both are O(1) per received frame.
+ *
+ * The segments advance together with tcan1463q1_gateway_run_for in
+ * windows no longer than the smallest latency (minus one bit time), so
+ * nothing received in a window can be due on the other segment before the
+ * window ends: the two segments can be simulated on separate threads.
+ * Frames received during a window enter the forwarding queue at the end
+ * of the window, where the queue depth is enforced. With a latency below
+ * two bit times windows are one bit long and the effective latency is
+ * rounded up to the window.
+ *
+ * Wake forwarding: a wake-up request (WAKERQ) on a gateway transceiver in
+ * a low-power mode switches both gateway transceivers to Normal (as far as
+ * the mode transitions allow: Sleep only leaves through a wake-up) and, if
+ * enabled, queues the wake frame on the other segment, whose bit pattern
+ * wakes the transceivers there.
+ */
+
+typedef enum {
+    GATEWAY_SEGMENT_A,
+    GATEWAY_SEGMENT_B,
+    GATEWAY_SEGMENT_COUNT
+} GatewaySegment;
+
+/**
+ * Routing entry: a frame received on source with (id, extended) is
+ * forwarded to the other segment as (target_id, target_extended)
+ */
+typedef struct {
+    GatewaySegment source;
+    uint32_t id;
+    bool extended;
+    uint32_t target_id;
+    bool target_extended;
+} GatewayRoute;
+
+/**
+ * Gateway configuration; per-direction arrays are indexed by the source segment
+ */
+typedef struct {
+    uint64_t latency_ns[GATEWAY_SEGMENT_COUNT];     // Processing latency
+    size_t queue_depth[GATEWAY_SEGMENT_COUNT];      // Frames held per direction
+    bool wake_forwarding;
+    CANFrame wake_frame;                            // Sent on the woken segment
+} GatewayConfig;
+
+/**
+ * Per-direction statistics (indexed by the source segment)
+ */
+typedef struct {
+    uint64_t received[GATEWAY_SEGMENT_COUNT];       // Frames seen by the gateway
+    uint64_t unrouted[GATEWAY_SEGMENT_COUNT];       // No routing entry
+    uint64_t dropped[GATEWAY_SEGMENT_COUNT];        // Queue full
+    uint64_t forwarded[GATEWAY_SEGMENT_COUNT];      // Handed to the other controller
+    uint64_t max_delay_ns[GATEWAY_SEGMENT_COUNT];   // Reception to hand-over
+    uint64_t wakeups_forwarded;
+} GatewayStats;
+
+typedef struct Gateway Gateway;
+
+/**
+ * Initialize a configuration: 100 us latency, 32 frames per direction,
+ * no wake forwarding, wake frame ID 0x000 with no data
+ */
+void tcan1463q1_gateway_config_init(GatewayConfig* config);
+
+/**
+ * Create a gateway
+ * @param a Network of segment A
+ * @param b Network of segment B
+ * @param sim_a Gateway transceiver on A (borrowed, added as a node of a)
+ * @param sim_b Gateway transceiver on B (borrowed, added as a node of b)
+ * @param config Configuration (NULL for defaults)
+ * @return Gateway, or NULL on invalid arguments (zero queue depth) or
+ *         allocation failure. The gateway installs the per-bit callback of
+ *         both networks.
+ */
+Gateway* tcan1463q1_gateway_create(CANNetwork* a, CANNetwork* b,
+                                   TCAN1463Q1Simulator* sim_a, TCAN1463Q1Simulator* sim_b,
+                                   const GatewayConfig* config);
+// Removes the per-bit callbacks; the gateway nodes stay on the networks
+void tcan1463q1_gateway_destroy(Gateway* gateway);
+
+/**
+ * Add a routing entry
+ * @return false if the identifier is invalid or already routed from that segment
+ */
+bool tcan1463q1_gateway_add_route(Gateway* gateway, const GatewayRoute* route);
+
+/**
+ * Look up a route
+ * @return Routing entry, or NULL if frames with this identifier are not forwarded
+ */
+const GatewayRoute* tcan1463q1_gateway_find_route(const Gateway* gateway, GatewaySegment source,
+                                                  uint32_t id, bool extended);
+
+// Gateway controllers (e.g. to send or receive frames of the gateway itself)
+CANController* tcan1463q1_gateway_get_controller(Gateway* gateway, GatewaySegment segment);
+
+/**
+ * Lookahead: how far one segment may run ahead of the other
+ * @return Window length used by run_for, in nanoseconds
+ */
+uint64_t tcan1463q1_gateway_get_lookahead_ns(const Gateway* gateway);
+
+/**
+ * Advance both segments
+ * @param gateway Gateway
+ * @param duration_ns Time to simulate
+ * @param threads 2 to run the segments of each window in parallel, else sequentially
+ */
+void tcan1463q1_gateway_run_for(Gateway* gateway, uint64_t duration_ns, unsigned threads);
+
+void tcan1463q1_gateway_get_stats(const Gateway* gateway, GatewayStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_GATEWAY_H
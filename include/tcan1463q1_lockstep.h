@@ -0,0 +1,154 @@
+#ifndef TCAN1463Q1_LOCKSTEP_H
+#define TCAN1463Q1_LOCKSTEP_H
+
+#include "tcan1463q1_scenario.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Lockstep differential validation
+ *
+ * Drives two simulators with the same stimulus: the "fast" one advances
+ * with the configuration under test (whole WAITs or fast_step_ns chunks),
+ * the reference one with reference_step_ns steps (1 ns by default). After
+ * every fast step and every stimulus action the observable state of both
+ * is compared, and the first divergence is reported with both states.
+ *
+ * Reference cost is proportional to simulated time / reference_step_ns
+ * while something is changing. With skip_quiescent, once a reference step
+ * changes nothing but the time, the steps up to the next timer, RXD or
+ * stimulus deadline are taken as one step; the result is the same as
+ * taking them one by one. Noise or probes on the reference disable it.
+ */
+
+/**
+ * Lockstep configuration
+ */
+typedef struct {
+    uint64_t fast_step_ns;       // Fast step size, 0 = each WAIT as one step
+    uint64_t reference_step_ns;  // Reference step size (default 1 ns)
+    double voltage_tolerance;    // Allowed pin voltage difference (V)
+    bool skip_quiescent;         // Cross quiescent intervals in one step (default true)
+} LockstepConfig;
+
+/**
+ * Differences found at a divergence (bit masks)
+ */
+typedef struct {
+    bool mode;              // Operating modes differ
+    uint32_t flags;         // XOR of the flag words
+    uint32_t pin_states;    // Bit n set if pin n state differs
+    uint32_t pin_voltages;  // Bit n set if pin n voltage differs beyond tolerance
+} LockstepDifference;
+
+/**
+ * Lockstep result
+ */
+typedef struct {
+    bool diverged;
+    bool cancelled;               // Stopped by the fast simulator's run control
+    size_t action_index;          // Scenario action where divergence was found
+    uint64_t checkpoints;         // Number of state comparisons made
+    uint64_t reference_steps;     // Number of reference steps covered
+    uint64_t reference_skipped;   // Of those, steps crossed in quiescent jumps
+    LockstepDifference difference;
+    SimulatorObservableState fast;
+    SimulatorObservableState reference;
+} LockstepResult;
+
+/**
+ * Initialize a lockstep configuration with defaults
+ * @param config Configuration to initialize
+ */
+void tcan1463q1_lockstep_config_init(LockstepConfig* config);
+
+/**
+ * Compare two observable states
+ * @param a First state
+ * @param b Second state
+ * @param voltage_tolerance Allowed voltage difference (V)
+ * @param difference Optional output describing what differs
+ * @return true if the states match
+ */
+bool tcan1463q1_lockstep_compare(const SimulatorObservableState* a,
+                                  const SimulatorObservableState* b,
+                                  double voltage_tolerance,
+                                  LockstepDifference* difference);
+
+/**
+ * Advance both simulators by a duration and compare at every fast step
+ * @param fast Simulator under test
+ * @param reference Reference simulator (same state as fast on entry)
+ * @param duration_ns Time to advance
+ * @param config Lockstep configuration (NULL for defaults)
+ * @param result Result, updated with counters and the divergence if any
+ * @return false if the simulators diverged or the run was cancelled
+ */
+bool tcan1463q1_lockstep_advance(TCAN1463Q1Simulator* fast,
+                                  TCAN1463Q1Simulator* reference,
+                                  uint64_t duration_ns,
+                                  const LockstepConfig* config,
+                                  LockstepResult* result);
+
+/**
+ * Run a scenario's stimulus on both simulators in lockstep
+ *
+ * Check actions are not evaluated; the reference run is the oracle.
+ * WAIT_UNTIL runs the fast simulator with run_until and advances the
+ * reference by the same amount of time.
+ *
+ * @param scenario Scenario providing the stimulus
+ * @param fast Simulator under test (reset by the caller)
+ * @param reference Reference simulator (reset by the caller)
+ * @param config Lockstep configuration (NULL for defaults)
+ * @param result Result
+ * @return true if no divergence was found
+ */
+bool tcan1463q1_lockstep_run_scenario(Scenario* scenario,
+                                       TCAN1463Q1Simulator* fast,
+                                       TCAN1463Q1Simulator* reference,
+                                       const LockstepConfig* config,
+                                       LockstepResult* result);
+
+/**
+ * Execute a scenario on the fast simulator with the reference in lockstep
+ *
+ * As tcan1463q1_lockstep_run_scenario, but check actions are evaluated on
+ * the fast simulator and tallied as tcan1463q1_scenario_execute does, so
+ * one pass gives both the scenario result and the lockstep verdict. A
+ * divergence fails the scenario at the diverging action; a failed check
+ * with stop_on_error ends the run without a divergence.
+ *
+ * @param scenario_result Scenario result of the fast simulator
+ * @return true if no divergence was found
+ */
+bool tcan1463q1_lockstep_execute_scenario(Scenario* scenario,
+                                           TCAN1463Q1Simulator* fast,
+                                           TCAN1463Q1Simulator* reference,
+                                           const LockstepConfig* config,
+                                           ScenarioResult* scenario_result,
+                                           LockstepResult* result);
+
+/**
+ * Format a divergence report (both states, differing fields marked)
+ * @param result Lockstep result
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of characters that would have been written
+ */
+int tcan1463q1_lockstep_format(const LockstepResult* result, char* buffer, size_t size);
+
+/**
+ * Print a lockstep result to stdout
+ * @param result Lockstep result
+ */
+void tcan1463q1_lockstep_result_print(const LockstepResult* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_LOCKSTEP_H
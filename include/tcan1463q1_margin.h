@@ -0,0 +1,93 @@
+#ifndef TCAN1463Q1_MARGIN_H
+#define TCAN1463Q1_MARGIN_H
+
+#include "tcan1463q1_scenario.h"
+#include "tcan1463q1_run_control.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Timing-margin finder
+ *
+ * Finds where a scenario flips between pass and fail as one device
+ * parameter (a profile key, see tcan1463q1_profile.h) moves across a
+ * bracket, e.g. the shortest tTXDDTO at which a slow frame still passes.
+ * Each parameter is searched on its own, the others keep their base
+ * values. A scenario passes when none of its actions fails.
+ *
+ * Both ends of the bracket are run first; if they agree there is no
+ * boundary to find. Otherwise every round evaluates up to jobs points
+ * evenly spread inside the bracket in parallel (parameters still being
+ * searched share the workers) and keeps the sub-interval around the first
+ * change of outcome, until the bracket is no wider than the tolerance.
+ * Rounds needed grow with log(width / tolerance) / log(points + 1).
+ *
+ * Actions before the parameter first matters are run only once: the two
+ * bracket runs are compared action by action, and every later evaluation
+ * starts from a snapshot taken before the first action after which their
+ * states differ (internal filters and timers included, not only pins and
+ * flags). This assumes the parameter acts like a
+ * threshold or timeout, so that no value inside the bracket changes the
+ * run earlier than both ends do; set prefix_actions to override.
+ *
+ * Parameter values the profile validation rejects count as failing.
+ */
+
+typedef struct {
+    const char* key;            // Profile key, e.g. "ttxddto"
+    double low;                 // Bracket (times in ns, voltages in V)
+    double high;
+    double tolerance;           // Final bracket width
+} MarginParam;
+
+typedef struct {
+    DeviceProfile* base;        // Base parameters (borrowed), NULL for variant defaults
+    DeviceVariant variant;      // Used without a base profile
+    unsigned jobs;              // Worker threads, 0 = number of CPUs
+    int prefix_actions;         // Shared leading actions, -1 = detect
+    RunControl* run_control;    // Optional cancellation and progress (borrowed)
+} MarginConfig;
+
+typedef struct {
+    bool found;                 // Outcomes differ at the bracket ends
+    bool cancelled;
+    bool pass_at_low;           // Outcome at the low end (high is the opposite when found)
+    double pass_value;          // Passing value closest to the boundary
+    double fail_value;          // Failing value closest to the boundary
+    double base_value;          // Parameter value in the base profile
+    double margin;              // Boundary (pass_value) - base_value
+    size_t prefix_actions;      // Actions shared by all evaluations
+    unsigned evaluations;       // Scenario runs, bracket ends included
+} MarginResult;
+
+/**
+ * Initialize a configuration: TCAN1463-Q1 defaults, all CPUs, detected prefix
+ */
+void tcan1463q1_margin_config_init(MarginConfig* config);
+
+/**
+ * Search the pass/fail boundary of each parameter
+ * @param scenario Scenario (only read; may be shared by the workers)
+ * @param config Configuration (NULL for defaults)
+ * @param params Parameters to search
+ * @param count Number of parameters
+ * @param results Output, one per parameter
+ * @return false on invalid arguments (unknown key, empty bracket, tolerance
+ *         not positive) or when cancelled
+ */
+bool tcan1463q1_margin_find(const Scenario* scenario, const MarginConfig* config,
+                            const MarginParam* params, size_t count, MarginResult* results);
+
+/**
+ * Print a result line: parameter, passing and failing values, margin
+ */
+void tcan1463q1_margin_print(const MarginParam* param, const MarginResult* result, FILE* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_MARGIN_H
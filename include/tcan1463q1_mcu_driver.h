@@ -0,0 +1,99 @@
+#ifndef TCAN1463Q1_MCU_DRIVER_H
+#define TCAN1463Q1_MCU_DRIVER_H
+
+#include "tcan1463q1_simulator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Reactive MCU driver model
+ *
+ * The transceiver driver of a typical ECU as a state machine attached to
+ * a simulator: after a startup delay it sets EN and nSTB high, services
+ * nFAULT by reading the flags, requests Sleep (EN and nSTB low) after the
+ * bus has been idle for a while, and wakes the transceiver again on a
+ * wake-up interrupt (nFAULT low with WAKERQ set) or RXD activity.
+ *
+ * Pin edges reach the driver through the simulator's event callbacks, so
+ * the driver does no work on steps where nothing changes. An edge arms an
+ * interrupt that is handled after the configured ISR latency; the
+ * handler, the startup delay and the idle timeout are deadlines at which
+ * tcan1463q1_mcu_driver_advance splits its steps, so actions happen at
+ * exact simulation times. Fleets are advanced with
+ * tcan1463q1_mcu_driver_advance_all on the caller's thread.
+ *
+ * A simulator stepped elsewhere (e.g. by a CAN network) can host a driver
+ * too: call tcan1463q1_mcu_driver_service once the simulator time has
+ * passed tcan1463q1_mcu_driver_next_deadline_ns.
+ *
+ * One driver per simulator; the simulator is borrowed.
+ */
+
+typedef enum {
+    MCU_DRIVER_STARTUP,         // Waiting for the startup delay
+    MCU_DRIVER_ACTIVE,          // EN and nSTB high
+    MCU_DRIVER_SLEEP            // EN and nSTB low, waiting for a wake-up
+} McuDriverState;
+
+typedef struct {
+    uint64_t isr_latency_ns;    // Pin edge to interrupt handler
+    uint64_t startup_delay_ns;  // Attach to first EN/nSTB configuration
+    uint64_t idle_timeout_ns;   // RXD recessive time before Sleep (0: never)
+    bool wake_on_rxd;           // RXD falling edge in Sleep wakes the driver
+    bool silent_on_fault;       // EN low (Silent) while a bus fault flag is set
+} McuDriverConfig;
+
+typedef struct {
+    uint64_t interrupts;        // Handlers run
+    uint64_t flag_reads;        // nFAULT handlers (flag register reads)
+    uint64_t faults;            // Flag reads that found a fault flag
+    uint64_t sleeps;            // Sleep requests
+    uint64_t wakeups;           // Returns to active
+    uint32_t last_flags;        // Flag word of the last read
+    uint64_t worst_latency_ns;  // Longest edge-to-handler time
+} McuDriverStats;
+
+typedef struct McuDriver McuDriver;
+
+/**
+ * Initialize a configuration: 5 us ISR latency, 100 us startup delay,
+ * 50 ms idle timeout, wake on RXD, no silent-on-fault
+ */
+void tcan1463q1_mcu_driver_config_init(McuDriverConfig* config);
+
+/**
+ * Attach a driver to a simulator
+ * @param sim Simulator (borrowed; must outlive the driver)
+ * @param config Configuration (NULL for defaults)
+ * @return Driver, or NULL on allocation or callback registration failure
+ */
+McuDriver* tcan1463q1_mcu_driver_create(TCAN1463Q1Simulator* sim, const McuDriverConfig* config);
+// Detaches from the simulator; its pins are left as they are
+void tcan1463q1_mcu_driver_destroy(McuDriver* driver);
+
+/**
+ * Advance the simulator, splitting steps at driver deadlines
+ * @param driver Driver
+ * @param duration_ns Time to simulate
+ * @param step_ns Simulator step size
+ */
+void tcan1463q1_mcu_driver_advance(McuDriver* driver, uint64_t duration_ns, uint64_t step_ns);
+// Advance several drivers (each on its own simulator) by the same time
+void tcan1463q1_mcu_driver_advance_all(McuDriver** drivers, size_t count,
+                                       uint64_t duration_ns, uint64_t step_ns);
+
+// Earliest pending action (UINT64_MAX if none)
+uint64_t tcan1463q1_mcu_driver_next_deadline_ns(const McuDriver* driver);
+// Run the actions due at the simulator's current time
+void tcan1463q1_mcu_driver_service(McuDriver* driver);
+
+McuDriverState tcan1463q1_mcu_driver_get_state(const McuDriver* driver);
+void tcan1463q1_mcu_driver_get_stats(const McuDriver* driver, McuDriverStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_MCU_DRIVER_H
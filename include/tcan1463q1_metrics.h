@@ -0,0 +1,106 @@
+#ifndef TCAN1463Q1_METRICS_H
+#define TCAN1463Q1_METRICS_H
+
+#include "tcan1463q1_can_network.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Metrics exporter for long-running simulations
+ *
+ * Simulation threads register a source each and publish its counters
+ * with tcan1463q1_metrics_publish: a wait-free seqlock write of a few
+ * words, cheap enough to call every bit or every frame. A background
+ * thread reads consistent copies every interval_ms and writes them in the
+ * Prometheus text exposition format:
+ *
+ * - to file_path, atomically (written to "<file_path>.tmp", then renamed),
+ *   for a textfile collector
+ * - to every client connecting to the UNIX socket socket_path, which gets
+ *   the latest text and is disconnected
+ *
+ * Besides the published totals, each source exports its steps per second
+ * and simulated-to-wall time ratio over the last export interval, and the
+ * exporter adds the process resident memory.
+ */
+
+/**
+ * Counters of one source (totals are cumulative, gauges current)
+ */
+typedef struct {
+    uint64_t sim_time_ns;       // Simulated time
+    uint64_t steps;             // Work done: simulator steps, bits, ...
+    uint64_t events;            // Events handled: frames, callbacks, ...
+    uint64_t faults;            // Faults and errors seen
+    uint64_t queue_depth;       // Gauge: work waiting
+    uint64_t memory_bytes;      // Gauge: memory held by the source
+} MetricsCounters;
+
+typedef struct {
+    const char* file_path;      // Textfile output, NULL: none
+    const char* socket_path;    // UNIX socket, NULL: none
+    uint32_t interval_ms;       // Export period
+    size_t max_sources;
+} MetricsConfig;
+
+typedef struct MetricsExporter MetricsExporter;
+
+/**
+ * Initialize a configuration: no outputs, 10 s interval, 64 sources
+ */
+void tcan1463q1_metrics_config_init(MetricsConfig* config);
+
+/**
+ * Create an exporter (paths are copied)
+ * @return NULL on a zero interval or source count, or allocation failure
+ */
+MetricsExporter* tcan1463q1_metrics_create(const MetricsConfig* config);
+// Stops the background thread, removes the socket file
+void tcan1463q1_metrics_destroy(MetricsExporter* exporter);
+
+/**
+ * Register a source; name is exported as its "source" label ([A-Za-z0-9_-.],
+ * other characters become '_')
+ * @return Source ID, or -1 when max_sources are registered
+ */
+int tcan1463q1_metrics_add_source(MetricsExporter* exporter, const char* name);
+
+/**
+ * Publish a source's counters (one writer per source, any thread)
+ */
+void tcan1463q1_metrics_publish(MetricsExporter* exporter, int source,
+                                const MetricsCounters* counters);
+
+/**
+ * Publish a network's counters: network time, bits, frames sent and
+ * received, protocol errors and frames waiting to be sent over all nodes
+ */
+void tcan1463q1_metrics_publish_network(MetricsExporter* exporter, int source,
+                                        CANNetwork* network);
+
+/**
+ * Start / stop the background thread
+ * @return false if already running, or the socket cannot be bound
+ */
+bool tcan1463q1_metrics_start(MetricsExporter* exporter);
+void tcan1463q1_metrics_stop(MetricsExporter* exporter);
+
+/**
+ * Render the current metrics (also advances the rate interval)
+ * @return Length of the full text; it is truncated to size - 1 characters
+ */
+size_t tcan1463q1_metrics_format(MetricsExporter* exporter, char* buffer, size_t size);
+
+/**
+ * Export once to file_path now
+ * @return false without file_path or on I/O error
+ */
+bool tcan1463q1_metrics_write_file(MetricsExporter* exporter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_METRICS_H
@@ -0,0 +1,73 @@
+#ifndef TCAN1463Q1_NOISE_H
+#define TCAN1463Q1_NOISE_H
+
+#include "tcan1463q1_simulator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * EMC noise injection on CANH/CANL
+ *
+ * Noise is a sequence of samples, one per sample_period_ns, held between
+ * samples. Sample n is a pure function of (seed, n): every random number
+ * comes from a counter-based generator (a 64-bit hash of seed and sample
+ * index), so any stretch of the sequence can be produced independently,
+ * results do not depend on step sizes, and a seed reproduces the run
+ * exactly (also across snapshot/restore).
+ *
+ * Components:
+ * - Gaussian differential and common-mode noise (sum of four uniforms:
+ *   tails are cut at 3.46 sigma), optionally band-limited by a moving
+ *   average over bandwidth_taps samples (RMS is preserved)
+ * - Impulses at impulse_rate_hz on average, impulse_width_ns long, of
+ *   +-impulse_amplitude_v differential
+ *
+ * Samples are produced in blocks by branch-free loops over flat arrays;
+ * an attached simulator adds them to CANH/CANL before its receiver
+ * classifies the bus.
+ */
+
+typedef struct {
+    uint64_t seed;
+    uint64_t sample_period_ns;
+    double differential_rms_v;
+    double common_mode_rms_v;
+    unsigned bandwidth_taps;        // Moving-average length (1: white)
+    double impulse_rate_hz;
+    double impulse_amplitude_v;
+    uint64_t impulse_width_ns;
+} NoiseConfig;
+
+/**
+ * Initialize a configuration: seed 1, 50 ns samples, no noise
+ * (all amplitudes and rates zero), white
+ */
+void tcan1463q1_noise_config_init(NoiseConfig* config);
+
+/**
+ * Generate a stretch of the noise sequence
+ * @param config Configuration
+ * @param first Index of the first sample
+ * @param count Number of samples
+ * @param differential Output, count values (V), may be NULL
+ * @param common_mode Output, count values (V), may be NULL
+ * @return false on an invalid configuration or allocation failure
+ */
+bool tcan1463q1_noise_generate(const NoiseConfig* config, uint64_t first, size_t count,
+                               double* differential, double* common_mode);
+
+/**
+ * Attach noise to a simulator's bus lines (replaces any attached noise)
+ * @return false on an invalid configuration (zero sample period) or
+ *         allocation failure
+ */
+bool tcan1463q1_noise_attach(TCAN1463Q1Simulator* sim, const NoiseConfig* config);
+void tcan1463q1_noise_detach(TCAN1463Q1Simulator* sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_NOISE_H
@@ -0,0 +1,88 @@
+#ifndef TCAN1463Q1_PROBE_H
+#define TCAN1463Q1_PROBE_H
+
+#include "tcan1463q1_simulator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Internal signal probes
+ *
+ * A probe set samples internal signals after every stride-th simulator
+ * step into ring buffers supplied by the caller, one buffer per probed
+ * signal, all with the set's capacity. Sample n goes to slot
+ * n % capacity; once more than capacity samples were taken, the oldest
+ * one is at slot samples % capacity. 1-bit signals are packed, bit
+ * (slot % 64) of word slot / 64.
+ *
+ * Sampling is a store per probed signal; nothing is allocated, formatted
+ * or dispatched, so probes can stay attached to long dense runs.
+ */
+
+typedef enum {
+    PROBE_TIME,                 // u64: simulation time (ns)
+    PROBE_VDIFF,                // f64: CANH - CANL (V)
+    PROBE_BUS_STATE,            // u8: BusState
+    PROBE_RXD,                  // bit: RXD high
+    PROBE_DRIVER_ENABLED,       // bit: driver may put dominant bits on the bus
+    PROBE_MODE,                 // u8: OperatingMode
+    PROBE_WUP_STATE,            // u8: WUPState
+    PROBE_TXD_DOMINANT_NS,      // u64: TXD dominant timer elapsed (0 = not running)
+    PROBE_BUS_DOMINANT_NS,      // u64: bus dominant timer elapsed (0 = not running)
+    PROBE_SIGNAL_COUNT
+} ProbeSignal;
+
+typedef enum {
+    PROBE_FORMAT_BIT,           // uint64_t[capacity / 64]
+    PROBE_FORMAT_U8,            // uint8_t[capacity]
+    PROBE_FORMAT_U64,           // uint64_t[capacity]
+    PROBE_FORMAT_F64            // double[capacity]
+} ProbeFormat;
+
+typedef struct ProbeSet ProbeSet;
+
+/**
+ * Create a probe set
+ * @param stride Sample after every stride-th step (1 = every step)
+ * @param capacity Ring buffer length in samples, a multiple of 64
+ * @return NULL on invalid arguments or allocation failure
+ */
+ProbeSet* tcan1463q1_probe_set_create(uint32_t stride, size_t capacity);
+void tcan1463q1_probe_set_destroy(ProbeSet* set);
+
+/**
+ * Probe a signal into a caller buffer (borrowed, layout per
+ * tcan1463q1_probe_signal_format); probing a signal again replaces
+ * its buffer, NULL stops probing it
+ */
+bool tcan1463q1_probe_set_add(ProbeSet* set, ProbeSignal signal, void* buffer);
+
+// Samples taken since creation or the last reset
+uint64_t tcan1463q1_probe_set_samples(const ProbeSet* set);
+// Restart at slot 0 with the stride count
+void tcan1463q1_probe_set_reset(ProbeSet* set);
+
+/**
+ * Take a sample now, regardless of the stride
+ */
+void tcan1463q1_probe_set_sample(ProbeSet* set, TCAN1463Q1Simulator* sim);
+
+ProbeFormat tcan1463q1_probe_signal_format(ProbeSignal signal);
+const char* tcan1463q1_probe_signal_name(ProbeSignal signal);
+
+// Read slot index of a packed bit buffer
+bool tcan1463q1_probe_get_bit(const uint64_t* words, size_t index);
+
+/**
+ * Attach a probe set to a simulator (borrowed; NULL detaches). It is
+ * kept across simulator reset and restore. One set per simulator.
+ */
+void tcan1463q1_simulator_set_probes(TCAN1463Q1Simulator* sim, ProbeSet* set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_PROBE_H
@@ -0,0 +1,134 @@
+#ifndef TCAN1463Q1_PROFILE_H
+#define TCAN1463Q1_PROFILE_H
+
+#include "tcan1463q1_device.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Runtime device profiles
+ *
+ * A profile is a DeviceParams table loaded from a text file, validated
+ * once and shared read-only (reference counted) by every simulator that
+ * uses it. Profiles loaded by path are cached, so loading the same corner
+ * twice returns the same table.
+ *
+ * File format, one directive per line ('#' starts a comment):
+ *
+ *   name slow_corner          Profile name (defaults to the file name)
+ *   base TCAN1462-Q1          Start from a built-in variant (default TCAN1463-Q1)
+ *   uvcc_falling 3.8          Voltage or temperature value
+ *   tuv 120ms 340ms           Timing range (min max); one value sets both
+ *   tinh_slp_stb 80us         Single timing value
+ *   has_wake no               Feature presence (yes/no)
+ *
+ * Keys are the DeviceParams field names. Times accept ns/us/ms/s suffixes
+ * and are stored as integer nanoseconds.
+ */
+typedef struct DeviceProfile DeviceProfile;
+
+/**
+ * Parse and validate a profile from text (not cached)
+ * @param text Profile text
+ * @param error Optional buffer receiving "line: message" on failure
+ * @param error_size Size of the error buffer
+ * @return New profile with one reference, or NULL on error
+ */
+DeviceProfile* tcan1463q1_profile_parse(const char* text, char* error, size_t error_size);
+
+/**
+ * Load a profile file through the profile cache
+ * @param path Profile file path
+ * @param error Optional buffer receiving the error message on failure
+ * @param error_size Size of the error buffer
+ * @return Profile with one additional reference, or NULL on error
+ */
+DeviceProfile* tcan1463q1_profile_load(const char* path, char* error, size_t error_size);
+
+/**
+ * Take an additional reference to a profile
+ * @param profile Profile
+ * @return The same profile
+ */
+DeviceProfile* tcan1463q1_profile_acquire(DeviceProfile* profile);
+
+/**
+ * Drop a reference; the profile is freed (and evicted from the cache)
+ * when the last reference is released
+ * @param profile Profile (NULL is ignored)
+ */
+void tcan1463q1_profile_release(DeviceProfile* profile);
+
+/**
+ * Get the parameter table of a profile
+ * @param profile Profile
+ * @return Pointer to the shared, read-only parameters
+ */
+const DeviceParams* tcan1463q1_profile_get_params(const DeviceProfile* profile);
+
+/**
+ * Get the profile name
+ * @param profile Profile
+ * @return Profile name
+ */
+const char* tcan1463q1_profile_get_name(const DeviceProfile* profile);
+
+/**
+ * Get the built-in variant the profile is based on
+ * @param profile Profile
+ * @return Base device variant
+ */
+DeviceVariant tcan1463q1_profile_get_variant(const DeviceProfile* profile);
+
+/**
+ * Check parameters for consistency (threshold ordering, timing ranges)
+ * @param params Parameters to check
+ * @param error Optional buffer receiving the first problem found
+ * @param error_size Size of the error buffer
+ * @return true if the parameters are usable
+ */
+bool tcan1463q1_profile_validate_params(const DeviceParams* params,
+                                         char* error, size_t error_size);
+
+/**
+ * Create a profile from a parameter table (validated, not cached)
+ * @param name Profile name (NULL for "custom")
+ * @param variant Built-in variant the parameters are based on
+ * @param params Parameters, copied
+ * @param error Optional buffer receiving the first problem found
+ * @param error_size Size of the error buffer
+ * @return New profile with one reference, or NULL on error
+ */
+DeviceProfile* tcan1463q1_profile_create(const char* name, DeviceVariant variant,
+                                          const DeviceParams* params,
+                                          char* error, size_t error_size);
+
+/**
+ * Set one parameter by its profile key (e.g. "ttxddto", "vdiff_dominant")
+ *
+ * Times are nanoseconds, rounded to whole ns; a timing range is set to
+ * the single value at both ends. Features cannot be set this way.
+ * @return false for an unknown key, a feature or a negative time
+ */
+bool tcan1463q1_profile_set_param(DeviceParams* params, const char* key, double value);
+
+/**
+ * Get one parameter by its profile key (timing ranges report their minimum)
+ * @return false for an unknown key or a feature
+ */
+bool tcan1463q1_profile_get_param(const DeviceParams* params, const char* key, double* value);
+
+/**
+ * Get the number of profiles currently held by the cache
+ * @return Number of cached profiles
+ */
+size_t tcan1463q1_profile_cache_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_PROFILE_H
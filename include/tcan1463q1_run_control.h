@@ -0,0 +1,61 @@
+#ifndef TCAN1463Q1_RUN_CONTROL_H
+#define TCAN1463Q1_RUN_CONTROL_H
+
+#include "tcan1463q1_simulator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Cooperative cancellation and progress reporting
+ *
+ * A run control is shared by the simulators of a job (or of a whole pool
+ * of workers) and observed from any other thread. Simulators it is
+ * attached to check the cancellation flag at cheap points - between
+ * stimulus sub-steps, between run_until steps, before each scenario
+ * action, between lockstep steps - and stop there once it is set:
+ *
+ * - tcan1463q1_simulator_step returns before reaching its end time
+ *   (a step is only split when stimulus generators are attached)
+ * - tcan1463q1_simulator_run_until returns false
+ * - scenario execution stops with the result's cancelled flag set
+ * - lockstep runs return false with the result's cancelled flag set
+ *
+ * Progress counters add up over every simulator sharing the control:
+ * simulated time stepped, scenario actions completed and scenario runs
+ * finished. All operations are lock-free; cancel may be called from a
+ * signal handler.
+ */
+typedef struct RunControl RunControl;
+
+typedef struct {
+    uint64_t sim_time_ns;       // Simulated time stepped
+    uint64_t actions_completed; // Scenario actions executed
+    uint64_t runs_finished;     // Scenario runs completed (not cancelled)
+} RunProgress;
+
+RunControl* tcan1463q1_run_control_create(void);
+void tcan1463q1_run_control_destroy(RunControl* control);
+
+// Request cancellation (any thread, async-signal-safe)
+void tcan1463q1_run_control_cancel(RunControl* control);
+bool tcan1463q1_run_control_is_cancelled(const RunControl* control);
+// Clear the cancellation flag and the counters
+void tcan1463q1_run_control_reset(RunControl* control);
+
+void tcan1463q1_run_control_get_progress(const RunControl* control, RunProgress* progress);
+// Count a finished run of work not driven by a scenario (e.g. a sweep point)
+void tcan1463q1_run_control_add_run(RunControl* control);
+
+/**
+ * Attach a run control to a simulator (borrowed; NULL detaches). It is
+ * kept across simulator reset and restore.
+ */
+void tcan1463q1_simulator_set_run_control(TCAN1463Q1Simulator* sim, RunControl* control);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_RUN_CONTROL_H
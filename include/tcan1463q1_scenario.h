@@ -120,6 +120,7 @@ typedef struct {
     size_t actions_failed;
     const char* error_message;
     size_t failed_action_index;
+    bool cancelled;           // Stopped by the simulator's run control
 } ScenarioResult;
 
 // Scenario creation and management
@@ -156,6 +157,46 @@ ScenarioResult tcan1463q1_scenario_execute_step(Scenario* scenario, TCAN1463Q1Si
 void tcan1463q1_scenario_print(const Scenario* scenario);
 void tcan1463q1_scenario_result_print(const ScenarioResult* result);
 
+/**
+ * Scenario files
+ *
+ * Scenarios can be written as plain text, one action per line. Blank lines
+ * and lines starting with '#' are ignored. Anything after " -- " on an
+ * action line becomes the action description.
+ *
+ *   scenario <name>
+ *   description <text>
+ *   stop_on_error yes|no
+ *   configure <vsup> <vcc> <vio> <tj> <rl> <cl>
+ *   set_pin <PIN> <STATE> [voltage]
+ *   wait <duration>                  (suffix ns, us, ms or s; default ns)
+ *   check_pin <PIN> <STATE> [voltage [tolerance]]
+ *   check_mode <MODE>
+ *   check_flag <FLAG> 0|1
+ *   comment <text>
+ *
+ * PIN, STATE, MODE and FLAG use the enum names without prefix
+ * (e.g. TXD, HIGH_IMPEDANCE, GO_TO_SLEEP, WAKERQ), case-insensitive.
+ * Templates (tcan1463q1_template.h) may write $name in place of a state,
+ * voltage, tolerance, duration, mode, flag value or configure value.
+ *
+ * On failure NULL is returned and, if error is non-NULL, a message of the
+ * form "<line>: <reason>" is written to it.
+ */
+Scenario* tcan1463q1_scenario_parse(const char* text, char* error, size_t error_size);
+Scenario* tcan1463q1_scenario_load_file(const char* path, char* error, size_t error_size);
+
+// Name lookups shared by scenario files and tools (NULL/false if unknown)
+const char* tcan1463q1_scenario_pin_name(PinType pin);
+const char* tcan1463q1_scenario_pin_state_name(PinState state);
+const char* tcan1463q1_scenario_mode_name(OperatingMode mode);
+const char* tcan1463q1_scenario_flag_name(FlagType flag);
+bool tcan1463q1_scenario_pin_from_name(const char* name, PinType* pin);
+bool tcan1463q1_scenario_pin_state_from_name(const char* name, PinState* state);
+bool tcan1463q1_scenario_mode_from_name(const char* name, OperatingMode* mode);
+bool tcan1463q1_scenario_flag_from_name(const char* name, FlagType* flag);
+bool tcan1463q1_scenario_parse_duration(const char* text, uint64_t* duration_ns);
+
 // Pre-defined scenario builders
 Scenario* tcan1463q1_scenario_power_up_sequence(void);
 Scenario* tcan1463q1_scenario_normal_to_sleep(void);
@@ -2,6 +2,8 @@
 #define TCAN1463Q1_SIMULATOR_H
 
 #include "tcan1463q1_types.h"
+#include "tcan1463q1_device.h"
+#include "tcan1463q1_profile.h"
 #include "inh_controller.h"
 #include <stddef.h>
 
@@ -21,6 +23,18 @@ typedef struct {
     double tsilence_s;       // Silence timeout (0.6-1.2s)
 } TimingParameters;
 
+/**
+ * Operating conditions and timing parameters. Blocks are immutable and
+ * shared: simulators with equal settings point to the same block, and
+ * the setters switch a simulator to another block instead of writing.
+ */
+typedef struct {
+    double tj_temperature;
+    double rl_resistance;
+    double cl_capacitance;
+    TimingParameters timing_params;
+} SimulatorConfig;
+
 /**
  * Simulator event types
  */
@@ -32,12 +46,16 @@ typedef enum {
     EVENT_FLAG_CHANGE
 } SimulatorEventType;
 
+// Main simulator structure (defined below)
+typedef struct TCAN1463Q1Simulator TCAN1463Q1Simulator;
+
 /**
  * Simulator event structure
  */
 typedef struct {
     SimulatorEventType type;
     uint64_t timestamp;
+    TCAN1463Q1Simulator* sim;     // Simulator that raised the event
     union {
         struct {
             OperatingMode old_mode;
@@ -68,13 +86,28 @@ typedef void (*EventCallback)(const SimulatorEvent* event, void* user_data);
 typedef struct EventCallbackEntry {
     EventCallback callback;
     void* user_data;
+    bool bound;                   // Tied to one simulator, not shared with clones
     struct EventCallbackEntry* next;
 } EventCallbackEntry;
 
+// Event callback lists, shared by clones until one of them changes them
+typedef struct EventCallbackTable EventCallbackTable;
+
+// Stimulus generators attached to a simulator (tcan1463q1_stimulus.h)
+typedef struct StimulusSet StimulusSet;
+// Bus noise attached to a simulator (tcan1463q1_noise.h)
+typedef struct NoiseSource NoiseSource;
+// Cancellation and progress shared with other threads (tcan1463q1_run_control.h)
+typedef struct RunControl RunControl;
+// Internal signal probes (tcan1463q1_probe.h)
+typedef struct ProbeSet ProbeSet;
+
 /**
  * Main simulator structure
  */
-typedef struct {
+struct TCAN1463Q1Simulator {
+    DeviceVariant variant;
+    DeviceProfile* profile;       // Shared runtime profile, NULL for built-in variants
     Pin pins[14];
     ModeState mode_state;
     CANTransceiver can_transceiver;
@@ -82,18 +115,33 @@ typedef struct {
     FaultState fault_state;
     WakeState wake_state;
     BusBiasController bus_bias;
+    SupplyMeter supply_meter;
     INHController* inh_controller;
     TimingEngine timing;
     
-    // Configuration
-    double tj_temperature;
-    double rl_resistance;
-    double cl_capacitance;
-    TimingParameters timing_params;
+    // Configuration (shared, read-only; see SimulatorConfig)
+    const SimulatorConfig* config;
     
-    // Event callbacks (linked lists for each event type)
-    EventCallbackEntry* callbacks[5];  // One for each SimulatorEventType
-} TCAN1463Q1Simulator;
+    // Network coupling: another node on the bus drives dominant
+    bool remote_dominant;
+    // Bus common-mode offset against this node's GND (V)
+    double bus_offset;
+    // Offset kept by a CAN network in its per-node array, read instead of
+    // bus_offset, borrowed, NULL unless the network applies ground shift
+    const double* bus_offset_source;
+    
+    // Event callbacks (linked list per SimulatorEventType), NULL until one is registered
+    EventCallbackTable* callbacks;
+    
+    // Stimulus generators, NULL until one is attached
+    StimulusSet* stimulus;
+    // EMC noise on CANH/CANL, NULL unless attached
+    NoiseSource* noise;
+    // Cancellation and progress, borrowed, NULL unless attached
+    RunControl* run_control;
+    // Signal probes, borrowed, NULL unless attached
+    ProbeSet* probes;
+};
 
 /**
  * Pin value structure for batch operations
@@ -104,6 +152,17 @@ typedef struct {
     double voltage;
 } PinValue;
 
+/**
+ * Externally observable simulator state (pins, mode and flags)
+ */
+typedef struct {
+    uint64_t time_ns;
+    OperatingMode mode;
+    uint32_t flags;             // Flag word, see tcan1463q1_simulator_get_flag_word
+    PinState pin_states[14];
+    double pin_voltages[14];
+} SimulatorObservableState;
+
 /**
  * Simulation condition function type
  */
@@ -119,6 +178,8 @@ typedef struct {
 
 // Core simulator functions
 TCAN1463Q1Simulator* tcan1463q1_simulator_create(void);
+TCAN1463Q1Simulator* tcan1463q1_simulator_create_variant(DeviceVariant variant);
+TCAN1463Q1Simulator* tcan1463q1_simulator_create_with_profile(DeviceProfile* profile);
 void tcan1463q1_simulator_destroy(TCAN1463Q1Simulator* sim);
 void tcan1463q1_simulator_reset(TCAN1463Q1Simulator* sim);
 
@@ -142,12 +203,43 @@ bool tcan1463q1_simulator_run_until(TCAN1463Q1Simulator* sim,
                                      void* user_data, uint64_t timeout_ns);
 
 // State query functions
+DeviceVariant tcan1463q1_simulator_get_variant(TCAN1463Q1Simulator* sim);
+const DeviceParams* tcan1463q1_simulator_get_device_params(TCAN1463Q1Simulator* sim);
 OperatingMode tcan1463q1_simulator_get_mode(TCAN1463Q1Simulator* sim);
 void tcan1463q1_simulator_get_flags(TCAN1463Q1Simulator* sim,
                                      bool* pwron, bool* wakerq, bool* wakesr,
                                      bool* uvsup, bool* uvcc, bool* uvio,
                                      bool* cbf, bool* txdclp, bool* txddto,
                                      bool* txdrxd, bool* candom, bool* tsd);
+// Flags packed into one word: bit n is the n-th flag in get_flags order
+// (PWRON, WAKERQ, WAKESR, UVSUP, UVCC, UVIO, CBF, TXDCLP, TXDDTO, TXDRXD, CANDOM, TSD)
+uint32_t tcan1463q1_simulator_get_flag_word(TCAN1463Q1Simulator* sim);
+uint64_t tcan1463q1_simulator_get_time_ns(TCAN1463Q1Simulator* sim);
+void tcan1463q1_simulator_get_observable_state(TCAN1463Q1Simulator* sim,
+                                                SimulatorObservableState* state);
+
+// Network coupling
+// A dominant bit driven by another node overrides the local driver/bias
+// output on CANH/CANL (wired-AND bus), see tcan1463q1_can_network.h
+void tcan1463q1_simulator_set_remote_dominant(TCAN1463Q1Simulator* sim, bool dominant);
+// true if the local driver would put a dominant bit on the bus for TXD low
+bool tcan1463q1_simulator_can_drive_bus(TCAN1463Q1Simulator* sim);
+// Common-mode offset added to CANH/CANL as seen by this node (ground shift);
+// a CAN network with ground shift sets it for its nodes
+void tcan1463q1_simulator_set_bus_offset(TCAN1463Q1Simulator* sim, double volts);
+
+// Supply current and energy accounting
+// Currents are integrated per load-point interval (mode, driver, bias,
+// supply voltages), so long runs in one mode cost nothing per step.
+void tcan1463q1_simulator_get_supply_currents(TCAN1463Q1Simulator* sim,
+                                               double currents[SUPPLY_COUNT]);
+bool tcan1463q1_simulator_get_supply_energy(TCAN1463Q1Simulator* sim, SupplyEnergy* energy);
+// Add one simulator's totals to a fleet total
+void tcan1463q1_supply_energy_merge(SupplyEnergy* total, const SupplyEnergy* energy);
+// Energy (J) drawn from a rail across all modes
+double tcan1463q1_supply_energy_total(const SupplyEnergy* energy, SupplyRail rail);
+// Average current (A) on a rail over the accounted time
+double tcan1463q1_supply_energy_average_current(const SupplyEnergy* energy, SupplyRail rail);
 
 // Configuration functions
 void tcan1463q1_simulator_configure(TCAN1463Q1Simulator* sim,
@@ -173,17 +265,43 @@ bool tcan1463q1_simulator_validate_vio(double vio);
 bool tcan1463q1_simulator_validate_temperature(double tj_temperature);
 bool tcan1463q1_simulator_validate_timing_parameters(const TimingParameters* params);
 
+/**
+ * Clone a simulator for branching runs or populations forked from one
+ * template. The state is copied; the profile and the callback
+ * registrations are shared with the original, and callbacks are copied
+ * on the first registration change by either side. Bound callbacks and
+ * attachments (stimulus, noise, run control, probes) are not carried over.
+ * @return NULL on allocation failure
+ */
+TCAN1463Q1Simulator* tcan1463q1_simulator_clone(const TCAN1463Q1Simulator* sim);
+
 // Snapshot functions
 SimulatorSnapshot* tcan1463q1_simulator_snapshot(TCAN1463Q1Simulator* sim);
 bool tcan1463q1_simulator_restore(TCAN1463Q1Simulator* sim,
                                    const SimulatorSnapshot* snapshot);
 void tcan1463q1_simulator_snapshot_free(SimulatorSnapshot* snapshot);
 
-// Event callback functions
+/**
+ * Event callbacks
+ *
+ * tcan1463q1_simulator_step raises events for changes it produced: mode
+ * changes, fault flags set or cleared (fault_name is the flag name),
+ * WAKERQ set, any flag change, and pin state changes. Pins written by the
+ * caller do not raise events. With no callback registered, steps do no
+ * extra work.
+ */
 bool tcan1463q1_simulator_register_callback(TCAN1463Q1Simulator* sim,
                                              SimulatorEventType event_type,
                                              EventCallback callback,
                                              void* user_data);
+/**
+ * Register a callback that belongs to this simulator only, e.g. one whose
+ * user_data drives the simulator; clones do not inherit it
+ */
+bool tcan1463q1_simulator_register_bound_callback(TCAN1463Q1Simulator* sim,
+                                                   SimulatorEventType event_type,
+                                                   EventCallback callback,
+                                                   void* user_data);
 bool tcan1463q1_simulator_unregister_callback(TCAN1463Q1Simulator* sim,
                                                SimulatorEventType event_type,
                                                EventCallback callback);
@@ -0,0 +1,92 @@
+#ifndef TCAN1463Q1_STIMULUS_H
+#define TCAN1463Q1_STIMULUS_H
+
+#include "tcan1463q1_simulator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * In-engine stimulus generators
+ *
+ * Declarative waveforms attached to a simulator's input pins or to its bus
+ * input (the remote dominant state). Each generator is a function of the
+ * simulator time and reports when its next edge is due, so
+ * tcan1463q1_simulator_step splits a step at the edges of all attached
+ * generators and applies them itself: one call advances across any number
+ * of edges with no host code in between. Without generators the step is
+ * unchanged.
+ *
+ * Timers that sample inputs on the step grid (the wake-up filter) need
+ * steps shorter than the phases they measure: resolution_ns bounds the
+ * steps while a generator is active.
+ *
+ * Times are absolute simulator times. A generator outside [start_ns,
+ * stop_ns) holds its idle level; a non-repeating pattern returns to it
+ * after the last bit. Generators survive simulator reset and restore and
+ * follow the time back when it moves backwards.
+ */
+
+typedef enum {
+    STIMULUS_SQUARE,            // high_ns high, then low for the rest of period_ns
+    STIMULUS_PATTERN,           // Bit pattern, one bit per period_ns
+    STIMULUS_PRBS,              // Pseudo-random bits (PRBS-7/15/31), one per period_ns
+    STIMULUS_RIPPLE             // Analog sine ripple, updated every period_ns
+} StimulusType;
+
+typedef struct {
+    StimulusType type;
+    PinType pin;                // Driven input pin (unless bus is set)
+    bool bus;                   // Drive the bus instead: low level = remote dominant
+    uint64_t start_ns;
+    uint64_t stop_ns;           // 0: never stops
+    uint64_t period_ns;         // Square period, bit time or ripple update interval
+    uint64_t high_ns;           // Square: high time per period
+    const uint8_t* pattern;     // Pattern: bits, MSB first (copied when attached)
+    size_t pattern_bits;
+    bool repeat;                // Pattern: restart after the last bit
+    unsigned prbs_order;        // PRBS: 7, 15 or 31
+    bool idle_high;             // Digital level outside the active interval
+    double low_v;               // Digital low / high voltages
+    double high_v;
+    double offset_v;            // Ripple: offset + amplitude * sin(2 pi t / ripple_period)
+    double amplitude_v;         // (offset is also the idle voltage)
+    uint64_t ripple_period_ns;
+    uint64_t resolution_ns;     // Longest step while active (0: edges only)
+} StimulusConfig;
+
+/**
+ * Initialize a configuration for a generator on a pin
+ *
+ * Square and pattern/PRBS bit times default to 2 us (500 kbit/s) with a
+ * 50% duty cycle, idle high at 0/3.3 V, PRBS-7; ripple defaults to
+ * 12 V +- 0.5 V at 10 kHz updated every 1 us.
+ */
+void tcan1463q1_stimulus_config_init(StimulusConfig* config, StimulusType type, PinType pin);
+
+/**
+ * Initialize a bus wake-up pattern: dominant, recessive, dominant phases
+ * of phase_ns each, starting at start_ns, at 1 us resolution
+ */
+void tcan1463q1_stimulus_config_wup(StimulusConfig* config, uint64_t phase_ns, uint64_t start_ns);
+
+/**
+ * Attach a generator
+ * @return Generator ID (>= 0), or -1 if the configuration is invalid
+ *         (output pin, zero period, empty pattern, unknown PRBS order) or
+ *         allocation fails
+ */
+int tcan1463q1_stimulus_attach(TCAN1463Q1Simulator* sim, const StimulusConfig* config);
+// Detach one generator (the pin keeps its last level) or all of them
+bool tcan1463q1_stimulus_detach(TCAN1463Q1Simulator* sim, int id);
+void tcan1463q1_stimulus_detach_all(TCAN1463Q1Simulator* sim);
+
+// Time of the next edge of any attached generator (UINT64_MAX if none)
+uint64_t tcan1463q1_stimulus_next_edge_ns(TCAN1463Q1Simulator* sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_STIMULUS_H
@@ -0,0 +1,124 @@
+#ifndef TCAN1463Q1_TEMPLATE_H
+#define TCAN1463Q1_TEMPLATE_H
+
+#include "tcan1463q1_scenario.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Parametrized scenario templates
+ *
+ * A template is a scenario some of whose action fields (voltages, pin
+ * states, waits, expected values) are named parameters. Instances are
+ * the rows of a parameter table: row r holds one value per parameter, in
+ * parameter index order, so a table of R rows is R * param_count doubles.
+ * Enum fields take the enum value (PIN_STATE_HIGH = 1.0), waits take ns.
+ *
+ * Instances are never materialized: each action is expanded into a stack
+ * copy of the template action just before it runs, descriptions are
+ * shared with the template. Running any number of rows needs the
+ * template, the lanes' simulators and the caller's table, nothing per row.
+ *
+ * Scenario files become templates by writing $name in place of an
+ * argument (see tcan1463q1_scenario_parse):
+ *
+ *   set_pin VSUP ANALOG $vsup
+ *   wait $settle
+ *   set_pin TXD $txd
+ *   check_mode $mode
+ */
+
+typedef enum {
+    TEMPLATE_FIELD_VOLTAGE,     // set_pin voltage, check_pin expected voltage (V)
+    TEMPLATE_FIELD_STATE,       // set_pin state, check_pin expected state (PinState)
+    TEMPLATE_FIELD_TOLERANCE,   // check_pin voltage tolerance (V)
+    TEMPLATE_FIELD_DURATION,    // wait duration (ns)
+    TEMPLATE_FIELD_MODE,        // check_mode expected mode (OperatingMode)
+    TEMPLATE_FIELD_FLAG_VALUE,  // check_flag expected value (0 or 1)
+    TEMPLATE_FIELD_VSUP,        // configure values
+    TEMPLATE_FIELD_VCC,
+    TEMPLATE_FIELD_VIO,
+    TEMPLATE_FIELD_TJ,
+    TEMPLATE_FIELD_RL,
+    TEMPLATE_FIELD_CL
+} TemplateField;
+
+typedef struct ScenarioTemplate ScenarioTemplate;
+
+/**
+ * Called with each finished row; return false to stop the run
+ * @param sim The lane's simulator, in the state the row left it
+ */
+typedef bool (*TemplateRowCallback)(size_t row, const ScenarioResult* result,
+                                    const TCAN1463Q1Simulator* sim, void* user_data);
+
+/**
+ * Create a template over a scenario (borrowed, must outlive the template);
+ * parameters are added with tcan1463q1_template_bind
+ */
+ScenarioTemplate* tcan1463q1_template_create(const Scenario* scenario);
+
+/**
+ * Parse a scenario file with $name arguments; the template owns the scenario.
+ * Errors as for tcan1463q1_scenario_parse.
+ */
+ScenarioTemplate* tcan1463q1_template_parse(const char* text, char* error, size_t error_size);
+
+void tcan1463q1_template_destroy(ScenarioTemplate* tmpl);
+
+/**
+ * Make a field of an action a parameter; binding a name again adds
+ * another field driven by the same parameter
+ * @return false if the field does not belong to the action's type
+ */
+bool tcan1463q1_template_bind(ScenarioTemplate* tmpl, size_t action_index,
+                              TemplateField field, const char* name);
+
+// Template scenario (parameter fields hold neutral values)
+const Scenario* tcan1463q1_template_get_scenario(const ScenarioTemplate* tmpl);
+size_t tcan1463q1_template_param_count(const ScenarioTemplate* tmpl);
+const char* tcan1463q1_template_param_name(const ScenarioTemplate* tmpl, size_t index);
+// Index of a parameter, -1 if unknown
+int tcan1463q1_template_param_index(const ScenarioTemplate* tmpl, const char* name);
+
+/**
+ * Expand one action of an instance
+ * @param row Parameter values of the instance
+ * @return false for an invalid index or a value out of its field's range
+ */
+bool tcan1463q1_template_expand_action(const ScenarioTemplate* tmpl, const double* row,
+                                       size_t action_index, ScenarioAction* action);
+
+/**
+ * Run one instance on a simulator, as tcan1463q1_scenario_execute
+ */
+ScenarioResult tcan1463q1_template_execute(const ScenarioTemplate* tmpl, const double* row,
+                                           TCAN1463Q1Simulator* sim);
+
+/**
+ * Run instances side by side, action by action: lane i runs row i of
+ * rows on sims[i]. Each action is looked up once for all lanes.
+ * @return false on invalid arguments
+ */
+bool tcan1463q1_template_execute_lanes(const ScenarioTemplate* tmpl, const double* rows,
+                                       TCAN1463Q1Simulator* const* sims, size_t lanes,
+                                       ScenarioResult* results);
+
+/**
+ * Run every row of a table in batches of lanes. Each row starts from the
+ * state of initial (NULL for a new TCAN1463-Q1 simulator); the lanes are
+ * clones of it, restored before every batch, and use its run control.
+ * @return false on invalid arguments, allocation failure, cancellation or
+ *         when the callback stopped the run
+ */
+bool tcan1463q1_template_run_table(const ScenarioTemplate* tmpl, const double* table,
+                                   size_t row_count, const TCAN1463Q1Simulator* initial,
+                                   size_t lanes, TemplateRowCallback callback, void* user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_TEMPLATE_H
@@ -0,0 +1,159 @@
+#ifndef TCAN1463Q1_TIMING_ANALYZER_H
+#define TCAN1463Q1_TIMING_ANALYZER_H
+
+#include "tcan1463q1_simulator.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Streaming bit-timing analyzer
+ *
+ * Consumes time-ordered TXD/RXD/bus edges in one pass with constant
+ * memory and accumulates histograms and worst cases of:
+ *
+ *   - loop delay TXD -> RXD and TXD -> bus, per edge direction
+ *   - bit-width asymmetry: RXD (or bus) pulse width minus the TXD pulse
+ *     width that caused it, per pulse polarity
+ *   - receiver timing symmetry: RXD pulse width minus the nearest
+ *     multiple of the configured bit time (pulses of up to 10 bits)
+ *
+ * Edges come live from a simulator (see tcan1463q1_edge_probe_sample) or
+ * from recorded edge trace files: a flat array of EdgeRecord in host
+ * byte order, read in large blocks so analysis stays I/O-bound.
+ *
+ * An RXD/bus edge is matched to the last unmatched TXD edge of the same
+ * direction; edges caused by other nodes are not matched and only feed
+ * the receiver symmetry metric.
+ */
+
+/**
+ * Traced signals
+ */
+typedef enum {
+    EDGE_SIGNAL_TXD,
+    EDGE_SIGNAL_RXD,
+    EDGE_SIGNAL_BUS,        // Bus level: high = recessive
+    EDGE_SIGNAL_COUNT
+} EdgeSignal;
+
+/**
+ * Edge trace record (16 bytes)
+ */
+typedef struct {
+    uint64_t time_ns;
+    uint8_t signal;         // EdgeSignal
+    uint8_t level;          // New level: 1 = high/recessive, 0 = low/dominant
+    uint8_t reserved[6];
+} EdgeRecord;
+
+/**
+ * Analyzed metrics
+ */
+typedef enum {
+    TIMING_LOOP_DELAY_DOMINANT,         // TXD falling -> RXD falling
+    TIMING_LOOP_DELAY_RECESSIVE,        // TXD rising -> RXD rising
+    TIMING_BUS_DELAY_DOMINANT,          // TXD falling -> bus dominant
+    TIMING_BUS_DELAY_RECESSIVE,         // TXD rising -> bus recessive
+    TIMING_RXD_ASYMMETRY_DOMINANT,      // RXD width - TXD width
+    TIMING_RXD_ASYMMETRY_RECESSIVE,
+    TIMING_BUS_ASYMMETRY_DOMINANT,      // Bus width - TXD width
+    TIMING_BUS_ASYMMETRY_RECESSIVE,
+    TIMING_RXD_SYMMETRY_DOMINANT,       // RXD width - n x bit time
+    TIMING_RXD_SYMMETRY_RECESSIVE,
+    TIMING_METRIC_COUNT
+} TimingMetric;
+
+#define TIMING_HISTOGRAM_BINS 64
+
+/**
+ * Histogram of one metric (ns); bins are centered on zero:
+ * bin i covers [(i - BINS/2) * bin_width, (i - BINS/2 + 1) * bin_width)
+ */
+typedef struct {
+    uint64_t count;
+    int64_t min_ns;
+    int64_t max_ns;
+    double sum_ns;
+    uint64_t worst_time_ns;     // Time of the value with the largest magnitude
+    int64_t worst_ns;
+    uint64_t underflow;
+    uint64_t overflow;
+    uint64_t bins[TIMING_HISTOGRAM_BINS];
+} TimingHistogram;
+
+/**
+ * Analyzer configuration
+ */
+typedef struct {
+    uint32_t bitrate;           // Nominal bitrate for symmetry (0 = disabled)
+    int64_t bin_width_ns;       // Histogram bin width
+} TimingAnalyzerConfig;
+
+typedef struct TimingAnalyzer TimingAnalyzer;
+
+/**
+ * Sampler turning simulator pin levels into edges
+ */
+typedef struct {
+    bool valid;
+    bool levels[EDGE_SIGNAL_COUNT];
+} EdgeProbe;
+
+// Analyzer management
+void tcan1463q1_timing_analyzer_config_init(TimingAnalyzerConfig* config);
+TimingAnalyzer* tcan1463q1_timing_analyzer_create(const TimingAnalyzerConfig* config);
+void tcan1463q1_timing_analyzer_destroy(TimingAnalyzer* analyzer);
+void tcan1463q1_timing_analyzer_reset(TimingAnalyzer* analyzer);
+
+// Feed edges (time-ordered); edges that do not change the level are ignored
+void tcan1463q1_timing_analyzer_feed(TimingAnalyzer* analyzer, const EdgeRecord* edges,
+                                     size_t count);
+void tcan1463q1_timing_analyzer_feed_edge(TimingAnalyzer* analyzer, EdgeSignal signal,
+                                          bool level, uint64_t time_ns);
+
+/**
+ * Analyze a recorded edge trace
+ * @param analyzer Analyzer
+ * @param file Open edge trace (binary EdgeRecord array)
+ * @return Number of records processed, or -1 on a read error or a
+ *         truncated record
+ */
+int64_t tcan1463q1_timing_analyzer_process_file(TimingAnalyzer* analyzer, FILE* file);
+
+/**
+ * Sample the simulator after a step and feed the resulting edges
+ * @param analyzer Analyzer
+ * @param probe Probe state (zero-initialized before the first call)
+ * @param sim Simulator
+ */
+void tcan1463q1_timing_analyzer_observe(TimingAnalyzer* analyzer, EdgeProbe* probe,
+                                        TCAN1463Q1Simulator* sim);
+
+// Results
+const TimingHistogram* tcan1463q1_timing_analyzer_get_histogram(const TimingAnalyzer* analyzer,
+                                                                 TimingMetric metric);
+uint64_t tcan1463q1_timing_analyzer_edge_count(const TimingAnalyzer* analyzer);
+// TXD edges that were not followed by an RXD (or bus) edge of the same direction
+uint64_t tcan1463q1_timing_analyzer_unmatched(const TimingAnalyzer* analyzer, EdgeSignal signal);
+void tcan1463q1_timing_analyzer_print(const TimingAnalyzer* analyzer, FILE* out);
+const char* tcan1463q1_timing_metric_name(TimingMetric metric);
+
+/**
+ * Sample TXD, RXD and the bus level of a simulator and report changes
+ * @param probe Probe state (zero-initialized before the first call; the
+ *        first sample establishes levels and reports no edges)
+ * @param sim Simulator
+ * @param edges Output edges, stamped with the current simulation time
+ * @return Number of edges written (0 to EDGE_SIGNAL_COUNT)
+ */
+size_t tcan1463q1_edge_probe_sample(EdgeProbe* probe, TCAN1463Q1Simulator* sim,
+                                    EdgeRecord edges[EDGE_SIGNAL_COUNT]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_TIMING_ANALYZER_H
@@ -0,0 +1,105 @@
+#ifndef TCAN1463Q1_TRACE_STREAM_H
+#define TCAN1463Q1_TRACE_STREAM_H
+
+#include "tcan1463q1_timing_analyzer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Live trace streaming to pipes and sockets
+ *
+ * Records are EdgeRecord (tcan1463q1_timing_analyzer.h), so a stream can
+ * be piped straight into the timing analyzer or the WUP scanner. Besides
+ * the TXD/RXD/bus edges, pin, flag and mode changes use signal codes from
+ * TRACE_SIGNAL_PIN_BASE up, which those consumers skip.
+ *
+ * Records are collected in chunks and written one chunk per system call.
+ * On Linux pipes, full chunks are handed over with vmsplice: the pipe
+ * references the chunk pages instead of copying them. The pipe is sized
+ * to one chunk and two chunks are used in turn, so a chunk is refilled
+ * only after a full chunk behind it has entered the pipe, which means its
+ * pages have been read. Consumers must read() the pipe, not splice it
+ * onwards. Sockets, files and other systems get plain large writes.
+ *
+ * Writes block while the consumer is behind (back-pressure on the
+ * simulation). Partial chunks are written by flush and close. A closed
+ * socket fails the stream; a closed pipe raises SIGPIPE unless ignored.
+ */
+
+// Signal codes beyond EdgeSignal
+#define TRACE_SIGNAL_PIN_BASE  16   // + PinType, level = PinState (digital pins)
+#define TRACE_SIGNAL_FLAG_BASE 32   // + flag bit (get_flag_word order), level = 0/1
+#define TRACE_SIGNAL_MODE      48   // level = OperatingMode
+
+// Record classes written by tcan1463q1_trace_stream_observe
+#define TRACE_EDGES 0x1             // TXD, RXD and bus edges (EdgeSignal)
+#define TRACE_PINS  0x2             // Digital pin states (TXD..INH_MASK)
+#define TRACE_FLAGS 0x4
+#define TRACE_MODE  0x8
+#define TRACE_ALL   0xf
+
+typedef struct {
+    size_t chunk_bytes;         // Records per system call (rounded to whole pages)
+    uint32_t classes;           // TRACE_* mask for observe
+} TraceStreamConfig;
+
+typedef struct {
+    uint64_t records;
+    uint64_t bytes;             // Bytes handed to the kernel
+    uint64_t spliced_bytes;     // Of which by vmsplice
+    uint64_t writes;            // System calls
+} TraceStreamStats;
+
+typedef struct TraceStream TraceStream;
+
+/**
+ * Initialize a configuration: 1 MiB chunks, all record classes
+ */
+void tcan1463q1_trace_stream_config_init(TraceStreamConfig* config);
+
+/**
+ * Stream to an open descriptor (pipe, socket or file; borrowed)
+ * @return NULL on allocation failure
+ */
+TraceStream* tcan1463q1_trace_stream_open_fd(int fd, const TraceStreamConfig* config);
+
+/**
+ * Connect to a listening UNIX stream socket (the stream owns the socket)
+ * @return NULL if the connection fails
+ */
+TraceStream* tcan1463q1_trace_stream_connect(const char* socket_path,
+                                             const TraceStreamConfig* config);
+
+/**
+ * Flush and release the stream
+ * @return false if a write failed at any point
+ */
+bool tcan1463q1_trace_stream_close(TraceStream* stream);
+
+/**
+ * Append records
+ * @return false once a write has failed (consumer gone)
+ */
+bool tcan1463q1_trace_stream_write(TraceStream* stream, const EdgeRecord* records,
+                                   size_t count);
+
+/**
+ * Sample a simulator after a step and append a record per change of the
+ * configured classes; the first call records every traced signal
+ * @param probe Probe state (zero-initialized before the first call)
+ */
+bool tcan1463q1_trace_stream_observe(TraceStream* stream, EdgeProbe* probe,
+                                     TCAN1463Q1Simulator* sim);
+
+// Hand buffered records to the kernel now
+bool tcan1463q1_trace_stream_flush(TraceStream* stream);
+
+void tcan1463q1_trace_stream_get_stats(const TraceStream* stream, TraceStreamStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_TRACE_STREAM_H
@@ -50,6 +50,8 @@ typedef enum {
     MODE_OFF          // VSUP < UVSUP - Power off state
 } OperatingMode;
 
+#define OPERATING_MODE_COUNT (MODE_OFF + 1)
+
 /**
  * CAN bus state
  */
@@ -91,15 +93,22 @@ typedef enum {
 } WUPState;
 
 /**
- * Pin structure
+ * Pin metadata: one immutable entry per pin type, shared by every simulator
  */
 typedef struct {
-    PinState state;
-    double voltage;
     bool is_input;
     bool is_output;
     double min_voltage;
     double max_voltage;
+} PinInfo;
+
+/**
+ * Pin structure
+ */
+typedef struct {
+    PinState state;
+    double voltage;
+    const PinInfo* info;        // Shared metadata (pin_manager_get_info)
 } Pin;
 
 /**
@@ -125,6 +134,7 @@ typedef struct {
     bool rxd_pending;           // True if RXD update is pending
     bool rxd_pending_value;     // Pending RXD value
     uint64_t rxd_update_time;   // Time when RXD should be updated
+    uint64_t last_bus_activity_time; // Last dominant bus activity (silence timeout)
 } CANTransceiver;
 
 /**
@@ -155,6 +165,7 @@ typedef struct {
     uint64_t txd_dominant_start;
     uint64_t bus_dominant_start;
     int cbf_transition_count;
+    BusState cbf_prev_bus_state;  // Bus state seen by the previous CBF check
 } FaultState;
 
 /**
@@ -186,6 +197,48 @@ typedef struct {
     uint64_t last_update_ns;
 } TimingEngine;
 
+/**
+ * Supply rails
+ */
+typedef enum {
+    SUPPLY_VSUP,
+    SUPPLY_VCC,
+    SUPPLY_VIO,
+    SUPPLY_COUNT
+} SupplyRail;
+
+/**
+ * Supply charge and energy, accumulated per operating mode
+ */
+typedef struct {
+    uint64_t residency_ns[OPERATING_MODE_COUNT];
+    double charge[OPERATING_MODE_COUNT][SUPPLY_COUNT];  // C
+    double energy[OPERATING_MODE_COUNT][SUPPLY_COUNT];  // J
+    uint64_t transitions;                               // Load point changes
+} SupplyEnergy;
+
+/**
+ * Supply meter structure
+ *
+ * Supply currents only change when the load point (mode, driver state,
+ * bias state, supply voltages, bus load while dominant) changes, so
+ * charge and energy are integrated per residency interval rather than per
+ * step.
+ */
+typedef struct {
+    // Open interval: load point and when it was entered
+    OperatingMode mode;
+    bool driver_dominant;
+    BusBiasState bias;
+    double voltages[SUPPLY_COUNT];
+    double rl_resistance;           // Bus load (Ω), part of the load point while dominant
+    double currents[SUPPLY_COUNT];  // A
+    uint64_t interval_start;
+
+    // Closed intervals
+    SupplyEnergy closed;
+} SupplyMeter;
+
 // Voltage thresholds
 #define UVSUP_FALLING_MIN 3.5
 #define UVSUP_FALLING_MAX 4.25
@@ -202,6 +255,10 @@ typedef struct {
 #define UVIO_RISING_MIN 1.4
 #define UVIO_RISING_MAX 1.65
 
+// Receiver common-mode range, relative to the node's own GND
+#define VCM_RANGE_MIN -12.0
+#define VCM_RANGE_MAX 12.0
+
 // Timing parameters (in appropriate units)
 #define TUV_MIN_MS 100
 #define TUV_MAX_MS 350
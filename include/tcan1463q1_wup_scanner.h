@@ -0,0 +1,115 @@
+#ifndef TCAN1463Q1_WUP_SCANNER_H
+#define TCAN1463Q1_WUP_SCANNER_H
+
+#include "tcan1463q1_device.h"
+#include "tcan1463q1_timing_analyzer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Offline WUP pattern scanner
+ *
+ * Runs the remote wake-up detection of the wake handler
+ * (wake_handler_process_wup) over bus recordings and reports every
+ * pattern it would accept. Like the simulator, the state machine is
+ * evaluated on a time grid: multiples of step_ns for edge lists (a
+ * simulator stepping from t=0), every sample for sample arrays. Its phase
+ * timers make detection depend on that step exactly as in the simulator;
+ * only grid points where the state can change are visited, so long idle
+ * or busy stretches cost one evaluation per edge. After a detection the
+ * scanner re-arms once the bus is sampled recessive again.
+ *
+ * Several tWK_FILTER/tWK_TIMEOUT corners are scanned in a single pass.
+ * Recordings are split into chunks scanned on worker threads; chunks are
+ * aligned to dominant edges preceded by a recessive run longer than the
+ * largest filter time plus two steps, where every detector is provably
+ * idle, so results are identical to a sequential scan.
+ */
+
+/**
+ * Detector corner
+ */
+typedef struct {
+    uint64_t filter_ns;     // tWK_FILTER: minimum duration of each phase
+    uint64_t timeout_ns;    // tWK_TIMEOUT: whole pattern limit
+} WUPScanConfig;
+
+/**
+ * Detected pattern
+ */
+typedef struct {
+    uint64_t start_ns;      // First dominant edge
+    uint64_t complete_ns;   // Second dominant phase met the filter time
+} WUPMatch;
+
+/**
+ * Matches of one corner, in time order
+ */
+typedef struct {
+    WUPMatch* matches;
+    size_t count;
+} WUPScanResult;
+
+/**
+ * Initialize a corner with the operating point used by the wake handler
+ * (minimum tWK_FILTER, maximum tWK_TIMEOUT)
+ * @param config Corner to initialize
+ * @param params Device parameters (NULL for the TCAN1463-Q1 defaults)
+ */
+void tcan1463q1_wup_scan_config_init(WUPScanConfig* config, const DeviceParams* params);
+
+/**
+ * Scan bus edges
+ * @param edges Time-ordered edge records; only EDGE_SIGNAL_BUS records are used
+ * @param count Number of records
+ * @param end_ns End of the recording (grid points before it are evaluated)
+ * @param step_ns Evaluation step
+ * @param configs Corners to scan
+ * @param config_count Number of corners
+ * @param threads Worker threads (0 = number of CPUs)
+ * @param results Output, one per corner; free with tcan1463q1_wup_scan_result_free
+ * @return false on invalid arguments (zero step, filter or timeout) or
+ *         allocation failure
+ */
+bool tcan1463q1_wup_scan_edges(const EdgeRecord* edges, size_t count,
+                               uint64_t end_ns, uint64_t step_ns,
+                               const WUPScanConfig* configs, size_t config_count,
+                               unsigned threads, WUPScanResult* results);
+
+/**
+ * Scan a uniformly sampled bus level, evaluating at every sample
+ * @param samples Bus levels, nonzero = recessive
+ * @param count Number of samples
+ * @param start_ns Time of the first sample
+ * @param period_ns Sample period
+ * @param configs Corners to scan
+ * @param config_count Number of corners
+ * @param threads Worker threads (0 = number of CPUs)
+ * @param results Output, one per corner
+ * @return false on invalid arguments or allocation failure
+ */
+bool tcan1463q1_wup_scan_samples(const uint8_t* samples, size_t count,
+                                 uint64_t start_ns, uint64_t period_ns,
+                                 const WUPScanConfig* configs, size_t config_count,
+                                 unsigned threads, WUPScanResult* results);
+
+/**
+ * Scan a recorded edge trace file (see tcan1463q1_timing_analyzer.h)
+ * The file is memory-mapped and scanned in parallel chunks; the recording
+ * ends at the last record.
+ * @return false if the file cannot be mapped, has a truncated record, or
+ *         the arguments are invalid
+ */
+bool tcan1463q1_wup_scan_file(const char* path, uint64_t step_ns,
+                              const WUPScanConfig* configs, size_t config_count,
+                              unsigned threads, WUPScanResult* results);
+
+void tcan1463q1_wup_scan_result_free(WUPScanResult* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TCAN1463Q1_WUP_SCANNER_H
@@ -1,14 +1,7 @@
 #include "bus_bias_controller.h"
+#include "bus_bias_controller_impl.h"
 #include <string.h>
 
-// Silence timeout for autonomous state transition (in nanoseconds)
-// Using middle of range: 0.6-1.2s -> 0.9s
-#define TSILENCE_NS (900000000ULL)
-
-// Bias voltage levels
-#define BIAS_VOLTAGE_2_5V 2.5
-#define BIAS_VOLTAGE_GND 0.0
-
 void bus_bias_controller_init(BusBiasController* controller) {
     if (!controller) return;
     
@@ -61,42 +54,12 @@ void bus_bias_controller_get_bias(
     double* canh,
     double* canl
 ) {
-    if (!controller || !canh || !canl) return;
-    
-    // Set bias voltages based on state
-    switch (controller->state) {
-        case BIAS_STATE_OFF:
-            // High impedance - no bias voltage (represented as 0)
-            *canh = 0.0;
-            *canl = 0.0;
-            break;
-            
-        case BIAS_STATE_AUTONOMOUS_INACTIVE:
-            // Bias to GND
-            *canh = BIAS_VOLTAGE_GND;
-            *canl = BIAS_VOLTAGE_GND;
-            break;
-            
-        case BIAS_STATE_AUTONOMOUS_ACTIVE:
-            // Bias to 2.5V
-            *canh = BIAS_VOLTAGE_2_5V;
-            *canl = BIAS_VOLTAGE_2_5V;
-            break;
-            
-        case BIAS_STATE_ACTIVE:
-            // Bias to VCC/2
-            *canh = vcc / 2.0;
-            *canl = vcc / 2.0;
-            break;
-    }
+    bus_bias_controller_get_bias_impl(DefaultProfile(), controller, vcc, canh, canl);
 }
 
 bool bus_bias_controller_is_silence_timeout(
     const BusBiasController* controller,
     uint64_t current_time
 ) {
-    if (!controller) return false;
-    
-    uint64_t silence_duration = current_time - controller->last_bus_activity;
-    return silence_duration > TSILENCE_NS;
+    return bus_bias_controller_is_silence_timeout_impl(DefaultProfile(), controller, current_time);
 }
@@ -0,0 +1,62 @@
+#ifndef BUS_BIAS_CONTROLLER_IMPL_H
+#define BUS_BIAS_CONTROLLER_IMPL_H
+
+#include "bus_bias_controller.h"
+#include "device_profiles.h"
+
+/**
+ * Profile-specialized bus bias controller logic
+ */
+
+template <typename Profile>
+inline void bus_bias_controller_get_bias_impl(
+    const Profile& profile,
+    const BusBiasController* controller,
+    double vcc,
+    double* canh,
+    double* canl
+) {
+    if (!controller || !canh || !canl) return;
+    
+    // Set bias voltages based on state
+    switch (controller->state) {
+        case BIAS_STATE_OFF:
+            // High impedance - no bias voltage (represented as 0)
+            *canh = 0.0;
+            *canl = 0.0;
+            break;
+            
+        case BIAS_STATE_AUTONOMOUS_INACTIVE:
+            // Bias to GND
+            *canh = 0.0;
+            *canl = 0.0;
+            break;
+            
+        case BIAS_STATE_AUTONOMOUS_ACTIVE:
+            // Bias to 2.5V
+            *canh = profile.params.bias_autonomous;
+            *canl = profile.params.bias_autonomous;
+            break;
+            
+        case BIAS_STATE_ACTIVE:
+            // Bias to VCC/2
+            *canh = vcc / 2.0;
+            *canl = vcc / 2.0;
+            break;
+    }
+}
+
+template <typename Profile>
+inline bool bus_bias_controller_is_silence_timeout_impl(
+    const Profile& profile,
+    const BusBiasController* controller,
+    uint64_t current_time
+) {
+    if (!controller) return false;
+    
+    uint64_t silence_duration = current_time - controller->last_bus_activity;
+    // tSILENCE uses the middle of the range (0.6-1.2s -> 0.9s)
+    return silence_duration > timing_range_mid_ns(profile.params.tsilence);
+}
+
+#endif // BUS_BIAS_CONTROLLER_IMPL_H
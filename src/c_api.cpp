@@ -1,5 +1,7 @@
 #include "tcan1463q1_c_api.h"
 #include "tcan1463q1_simulator.h"
+#include "tcan1463q1_device.h"
+#include "pin_manager.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -64,6 +66,24 @@ TCAN_ErrorCode tcan_simulator_destroy(TCAN1463Q1SimHandle handle) {
     return TCAN_SUCCESS;
 }
 
+TCAN_ErrorCode tcan_simulator_clone(TCAN1463Q1SimHandle handle, TCAN1463Q1SimHandle* clone) {
+    if (!handle) {
+        return TCAN_ERROR_INVALID_HANDLE;
+    }
+    
+    if (!clone) {
+        return TCAN_ERROR_NULL_POINTER;
+    }
+    
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_clone((TCAN1463Q1Simulator*)handle);
+    if (!sim) {
+        return TCAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    *clone = (TCAN1463Q1SimHandle)sim;
+    return TCAN_SUCCESS;
+}
+
 TCAN_ErrorCode tcan_simulator_reset(TCAN1463Q1SimHandle handle) {
     if (!handle) {
         return TCAN_ERROR_INVALID_HANDLE;
@@ -644,6 +664,151 @@ TCAN_ErrorCode tcan_simulator_snapshot_free(TCAN1463Q1SnapHandle snapshot) {
     return TCAN_SUCCESS;
 }
 
+// ========================================================================
+// Batch Functions
+// ========================================================================
+
+// Check the array and every handle once, before any simulator is touched
+static TCAN_ErrorCode check_batch(const TCAN1463Q1SimHandle* handles, size_t count) {
+    if (!handles && count) {
+        return TCAN_ERROR_NULL_POINTER;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        if (!handles[i]) {
+            return TCAN_ERROR_INVALID_HANDLE;
+        }
+    }
+    
+    return TCAN_SUCCESS;
+}
+
+// Checks of tcan1463q1_simulator_set_pin, without setting anything
+static bool pin_accepts(TCAN1463Q1Simulator* sim, PinType pin, double voltage) {
+    return tcan1463q1_device_has_pin(tcan1463q1_simulator_get_device_params(sim), pin) &&
+           pin_validate_voltage(&sim->pins[pin], voltage);
+}
+
+TCAN_ErrorCode tcan_simulator_batch_set_pin(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    TCAN_PinType pin,
+    const TCAN_PinState* states,
+    const double* voltages
+) {
+    TCAN_ErrorCode error = check_batch(handles, count);
+    if (error != TCAN_SUCCESS) {
+        return error;
+    }
+    
+    if (count && (!states || !voltages)) {
+        return TCAN_ERROR_NULL_POINTER;
+    }
+    
+    if (pin < TCAN_PIN_TXD || pin > TCAN_PIN_GND) {
+        return TCAN_ERROR_INVALID_PIN;
+    }
+    
+    // Every value is checked before the first one is applied
+    PinType cpp_pin = c_to_cpp_pin_type(pin);
+    for (size_t i = 0; i < count; i++) {
+        if (!pin_accepts((TCAN1463Q1Simulator*)handles[i], cpp_pin, voltages[i])) {
+            return TCAN_ERROR_INVALID_VOLTAGE;
+        }
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        tcan1463q1_simulator_set_pin((TCAN1463Q1Simulator*)handles[i], cpp_pin,
+                                     c_to_cpp_pin_state(states[i]), voltages[i]);
+    }
+    
+    return TCAN_SUCCESS;
+}
+
+TCAN_ErrorCode tcan_simulator_batch_step_to(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    uint64_t target_ns
+) {
+    TCAN_ErrorCode error = check_batch(handles, count);
+    if (error != TCAN_SUCCESS) {
+        return error;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        TCAN1463Q1Simulator* sim = (TCAN1463Q1Simulator*)handles[i];
+        uint64_t now = tcan1463q1_simulator_get_time_ns(sim);
+        if (now < target_ns) {
+            tcan1463q1_simulator_step(sim, target_ns - now);
+        }
+    }
+    
+    return TCAN_SUCCESS;
+}
+
+TCAN_ErrorCode tcan_simulator_batch_get_modes(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    TCAN_OperatingMode* modes
+) {
+    TCAN_ErrorCode error = check_batch(handles, count);
+    if (error != TCAN_SUCCESS) {
+        return error;
+    }
+    
+    if (count && !modes) {
+        return TCAN_ERROR_NULL_POINTER;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        modes[i] = cpp_to_c_mode(tcan1463q1_simulator_get_mode((TCAN1463Q1Simulator*)handles[i]));
+    }
+    
+    return TCAN_SUCCESS;
+}
+
+TCAN_ErrorCode tcan_simulator_batch_get_flag_words(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    uint32_t* flags
+) {
+    TCAN_ErrorCode error = check_batch(handles, count);
+    if (error != TCAN_SUCCESS) {
+        return error;
+    }
+    
+    if (count && !flags) {
+        return TCAN_ERROR_NULL_POINTER;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        flags[i] = tcan1463q1_simulator_get_flag_word((TCAN1463Q1Simulator*)handles[i]);
+    }
+    
+    return TCAN_SUCCESS;
+}
+
+TCAN_ErrorCode tcan_simulator_batch_get_times(
+    const TCAN1463Q1SimHandle* handles,
+    size_t count,
+    uint64_t* times_ns
+) {
+    TCAN_ErrorCode error = check_batch(handles, count);
+    if (error != TCAN_SUCCESS) {
+        return error;
+    }
+    
+    if (count && !times_ns) {
+        return TCAN_ERROR_NULL_POINTER;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        times_ns[i] = tcan1463q1_simulator_get_time_ns((TCAN1463Q1Simulator*)handles[i]);
+    }
+    
+    return TCAN_SUCCESS;
+}
+
 // ========================================================================
 // Event Callback Functions
 // ========================================================================
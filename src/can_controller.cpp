@@ -0,0 +1,673 @@
+#include "tcan1463q1_can_controller.h"
+#include "can_controller_impl.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RECESSIVE true
+#define DOMINANT false
+
+// Longest frame: extended, 8 data bytes, worst-case stuffing, plus tail
+#define MAX_FRAME_BITS 160
+// Destuffed bits from SOF to the end of the CRC sequence
+#define MAX_HEADER_BITS 128
+
+// Tail positions after the CRC sequence
+#define TAIL_CRC_DELIMITER 0
+#define TAIL_ACK_SLOT 1
+#define TAIL_ACK_DELIMITER 2
+#define TAIL_EOF_FIRST 3
+#define TAIL_EOF_LAST 9
+
+#define CRC15_POLYNOMIAL 0x4599
+
+/**
+ * Protocol states
+ */
+typedef enum {
+    PROTOCOL_INTEGRATING,     // Waiting for 11 recessive bits
+    PROTOCOL_IDLE,
+    PROTOCOL_FRAME,           // Transmitting or receiving a frame
+    PROTOCOL_ERROR_FLAG,
+    PROTOCOL_ERROR_DELIMITER,
+    PROTOCOL_INTERMISSION,
+    PROTOCOL_SUSPEND,         // Error-passive transmitter suspend
+    PROTOCOL_BUS_OFF
+} ProtocolState;
+
+struct CANController {
+    CANBitTiming timing;
+    uint64_t bit_time_ns;
+    uint64_t sample_offset_ns;
+
+    // Frame queues (ring buffers)
+    CANFrame tx_queue[CAN_CONTROLLER_TX_QUEUE];
+    size_t tx_head;
+    size_t tx_count;
+    CANFrame rx_queue[CAN_CONTROLLER_RX_QUEUE];
+    size_t rx_head;
+    size_t rx_count;
+
+    // Fault confinement
+    CANErrorState error_state;
+    uint16_t tec;
+    uint16_t rec;
+    bool auto_recovery;
+    bool recovery_requested;
+
+    ProtocolState state;
+    uint32_t state_bits;          // Bits spent in the current state
+    uint32_t recessive_run;       // Consecutive recessive bits
+    uint32_t recovery_sequences;  // Bus-off recovery: completed 11-bit sequences
+
+    // Transmitter
+    bool transmitting;
+    bool last_was_transmitter;
+    bool tx_bits[MAX_FRAME_BITS];
+    size_t tx_len;
+    size_t tx_pos;
+
+    // Decoder (shared by transmitter and receivers)
+    bool rx_bits[MAX_HEADER_BITS];
+    size_t rx_len;
+    size_t rx_expected_len;
+    size_t crc_start;
+    bool in_stuffed;
+    uint32_t same_count;
+    bool last_level;
+    uint16_t crc;
+    bool crc_ok;
+    uint32_t tail_pos;
+
+    // Error signalling
+    bool error_passive_flag;
+    bool error_was_transmitter;
+    bool delimiter_recessive_seen;
+    uint32_t dominant_after_flag;
+
+    CANControllerStats stats;
+};
+
+static uint16_t crc15_update(uint16_t crc, bool bit) {
+    bool next = bit ^ ((crc >> 14) & 1);
+    crc = (crc << 1) & 0x7FFF;
+    if (next) crc ^= CRC15_POLYNOMIAL;
+    return crc;
+}
+
+static size_t frame_data_bits(const bool* bits, size_t dlc_start, bool rtr) {
+    uint8_t dlc = 0;
+    for (size_t i = 0; i < 4; i++) {
+        dlc = (uint8_t)((dlc << 1) | (bits[dlc_start + i] ? 1 : 0));
+    }
+    if (rtr) return 0;
+    return (dlc > 8 ? 8 : dlc) * 8;
+}
+
+bool tcan1463q1_can_controller_validate_timing(const CANBitTiming* timing) {
+    if (!timing) return false;
+    return timing->bitrate >= 10000 && timing->bitrate <= 1000000 &&
+           timing->sample_point >= 0.5 && timing->sample_point <= 0.95;
+}
+
+CANController* tcan1463q1_can_controller_create(const CANBitTiming* timing) {
+    if (!tcan1463q1_can_controller_validate_timing(timing)) return NULL;
+
+    CANController* controller = (CANController*)malloc(sizeof(CANController));
+    if (controller) {
+        memset(controller, 0, sizeof(CANController));
+        controller->timing = *timing;
+        controller->bit_time_ns = (1000000000ULL + timing->bitrate / 2) / timing->bitrate;
+        controller->sample_offset_ns =
+            (uint64_t)(controller->bit_time_ns * timing->sample_point + 0.5);
+        controller->auto_recovery = true;
+        tcan1463q1_can_controller_reset(controller);
+    }
+    return controller;
+}
+
+void tcan1463q1_can_controller_destroy(CANController* controller) {
+    free(controller);
+}
+
+void tcan1463q1_can_controller_reset(CANController* controller) {
+    if (!controller) return;
+
+    // Keep configuration
+    CANBitTiming timing = controller->timing;
+    uint64_t bit_time_ns = controller->bit_time_ns;
+    uint64_t sample_offset_ns = controller->sample_offset_ns;
+    bool auto_recovery = controller->auto_recovery;
+
+    memset(controller, 0, sizeof(CANController));
+    controller->timing = timing;
+    controller->bit_time_ns = bit_time_ns;
+    controller->sample_offset_ns = sample_offset_ns;
+    controller->auto_recovery = auto_recovery;
+    controller->error_state = CAN_ERROR_ACTIVE;
+    controller->state = PROTOCOL_INTEGRATING;
+}
+
+uint64_t tcan1463q1_can_controller_get_bit_time_ns(const CANController* controller) {
+    return controller ? controller->bit_time_ns : 0;
+}
+
+uint64_t tcan1463q1_can_controller_get_sample_offset_ns(const CANController* controller) {
+    return controller ? controller->sample_offset_ns : 0;
+}
+
+bool tcan1463q1_can_controller_send(CANController* controller, const CANFrame* frame) {
+    if (!controller || !frame) return false;
+    if (frame->dlc > 15) return false;
+    if (frame->id > (frame->extended ? 0x1FFFFFFFu : 0x7FFu)) return false;
+    if (controller->tx_count >= CAN_CONTROLLER_TX_QUEUE) return false;
+
+    size_t slot = (controller->tx_head + controller->tx_count) % CAN_CONTROLLER_TX_QUEUE;
+    controller->tx_queue[slot] = *frame;
+    controller->tx_count++;
+    return true;
+}
+
+bool tcan1463q1_can_controller_receive(CANController* controller, CANFrame* frame) {
+    if (!controller || !frame || controller->rx_count == 0) return false;
+
+    *frame = controller->rx_queue[controller->rx_head];
+    controller->rx_head = (controller->rx_head + 1) % CAN_CONTROLLER_RX_QUEUE;
+    controller->rx_count--;
+    return true;
+}
+
+size_t tcan1463q1_can_controller_tx_pending(const CANController* controller) {
+    return controller ? controller->tx_count : 0;
+}
+
+/**
+ * Encode the frame at the head of the TX queue into a stuffed bit stream
+ */
+static void build_tx_stream(CANController* controller) {
+    const CANFrame* frame = &controller->tx_queue[controller->tx_head];
+    bool bits[MAX_HEADER_BITS];
+    size_t n = 0;
+
+    bits[n++] = DOMINANT;  // SOF
+    if (frame->extended) {
+        uint32_t base = frame->id >> 18;
+        for (int i = 10; i >= 0; i--) bits[n++] = (base >> i) & 1;
+        bits[n++] = RECESSIVE;  // SRR
+        bits[n++] = RECESSIVE;  // IDE
+        for (int i = 17; i >= 0; i--) bits[n++] = (frame->id >> i) & 1;
+        bits[n++] = frame->rtr;  // RTR
+        bits[n++] = DOMINANT;    // r1
+        bits[n++] = DOMINANT;    // r0
+    } else {
+        for (int i = 10; i >= 0; i--) bits[n++] = (frame->id >> i) & 1;
+        bits[n++] = frame->rtr;  // RTR
+        bits[n++] = DOMINANT;    // IDE
+        bits[n++] = DOMINANT;    // r0
+    }
+    for (int i = 3; i >= 0; i--) bits[n++] = (frame->dlc >> i) & 1;
+    size_t data_bytes = frame->rtr ? 0 : (frame->dlc > 8 ? 8 : frame->dlc);
+    for (size_t byte = 0; byte < data_bytes; byte++) {
+        for (int i = 7; i >= 0; i--) bits[n++] = (frame->data[byte] >> i) & 1;
+    }
+
+    uint16_t crc = 0;
+    for (size_t i = 0; i < n; i++) crc = crc15_update(crc, bits[i]);
+    for (int i = 14; i >= 0; i--) bits[n++] = (crc >> i) & 1;
+
+    // Bit stuffing from SOF to the end of the CRC sequence
+    size_t len = 0;
+    uint32_t run = 0;
+    bool last = RECESSIVE;
+    for (size_t i = 0; i < n; i++) {
+        run = (i > 0 && bits[i] == last) ? run + 1 : 1;
+        last = bits[i];
+        controller->tx_bits[len++] = bits[i];
+        if (run == 5) {
+            last = !last;
+            controller->tx_bits[len++] = last;
+            run = 1;
+        }
+    }
+
+    // CRC delimiter, ACK slot (sent recessive), ACK delimiter, EOF
+    for (int i = TAIL_CRC_DELIMITER; i <= TAIL_EOF_LAST; i++) {
+        controller->tx_bits[len++] = RECESSIVE;
+    }
+    controller->tx_len = len;
+    controller->tx_pos = 0;
+}
+
+static void start_frame(CANController* controller) {
+    controller->state = PROTOCOL_FRAME;
+    controller->state_bits = 0;
+    controller->rx_len = 0;
+    controller->rx_expected_len = MAX_HEADER_BITS;
+    controller->crc_start = MAX_HEADER_BITS;
+    controller->in_stuffed = true;
+    controller->same_count = 0;
+    controller->crc = 0;
+    controller->crc_ok = false;
+    controller->tail_pos = 0;
+}
+
+static void update_error_state(CANController* controller) {
+    if (controller->tec > 255) {
+        controller->error_state = CAN_BUS_OFF;
+    } else if (controller->tec > 127 || controller->rec > 127) {
+        controller->error_state = CAN_ERROR_PASSIVE;
+    } else {
+        controller->error_state = CAN_ERROR_ACTIVE;
+    }
+}
+
+static void enter_bus_off(CANController* controller) {
+    controller->state = PROTOCOL_BUS_OFF;
+    controller->transmitting = false;
+    controller->recessive_run = 0;
+    controller->recovery_sequences = 0;
+    controller->recovery_requested = false;
+    controller->stats.bus_off_count++;
+}
+
+static void add_error_count(CANController* controller, bool transmitter, uint16_t amount) {
+    if (transmitter) {
+        controller->tec += amount;
+    } else if (controller->rec < 255) {
+        controller->rec += amount;
+        if (controller->rec > 255) controller->rec = 255;
+    }
+    update_error_state(controller);
+}
+
+static void signal_error(CANController* controller, CANErrorType type) {
+    controller->stats.errors[type]++;
+
+    bool transmitter = controller->transmitting;
+    // An error-passive transmitter does not count an ACK error
+    if (!(transmitter && type == CAN_ERROR_ACK &&
+          controller->error_state == CAN_ERROR_PASSIVE)) {
+        add_error_count(controller, transmitter, transmitter ? 8 : 1);
+    }
+    controller->transmitting = false;
+    controller->last_was_transmitter = transmitter;
+
+    if (controller->error_state == CAN_BUS_OFF) {
+        enter_bus_off(controller);
+        return;
+    }
+
+    // The frame stays queued and is retransmitted
+    controller->state = PROTOCOL_ERROR_FLAG;
+    controller->state_bits = 0;
+    controller->error_passive_flag = (controller->error_state == CAN_ERROR_PASSIVE);
+    controller->error_was_transmitter = transmitter;
+}
+
+static void deliver_frame(CANController* controller) {
+    const bool* bits = controller->rx_bits;
+    CANFrame frame;
+    memset(&frame, 0, sizeof(frame));
+
+    size_t dlc_start;
+    frame.extended = bits[13];
+    if (frame.extended) {
+        for (size_t i = 1; i <= 11; i++) frame.id = (frame.id << 1) | bits[i];
+        for (size_t i = 14; i <= 31; i++) frame.id = (frame.id << 1) | bits[i];
+        frame.rtr = bits[32];
+        dlc_start = 35;
+    } else {
+        for (size_t i = 1; i <= 11; i++) frame.id = (frame.id << 1) | bits[i];
+        frame.rtr = bits[12];
+        dlc_start = 15;
+    }
+    for (size_t i = 0; i < 4; i++) frame.dlc = (uint8_t)((frame.dlc << 1) | bits[dlc_start + i]);
+    size_t data_start = dlc_start + 4;
+    size_t data_bytes = (controller->crc_start - data_start) / 8;
+    for (size_t byte = 0; byte < data_bytes; byte++) {
+        for (size_t i = 0; i < 8; i++) {
+            frame.data[byte] = (uint8_t)((frame.data[byte] << 1) | bits[data_start + byte * 8 + i]);
+        }
+    }
+
+    controller->stats.rx_frames++;
+    if (controller->rx_count >= CAN_CONTROLLER_RX_QUEUE) {
+        controller->stats.rx_overruns++;
+        return;
+    }
+    size_t slot = (controller->rx_head + controller->rx_count) % CAN_CONTROLLER_RX_QUEUE;
+    controller->rx_queue[slot] = frame;
+    controller->rx_count++;
+}
+
+static void frame_complete(CANController* controller) {
+    controller->state = PROTOCOL_INTERMISSION;
+    controller->state_bits = 0;
+}
+
+static bool in_arbitration(const CANController* controller) {
+    size_t pos = controller->rx_len;
+    if (pos >= 1 && pos <= 13) return true;
+    // Extended identifier and RTR
+    return pos >= 14 && pos <= 32 && controller->rx_bits[13];
+}
+
+/**
+ * Decode one bit of the frame: destuffing, field parsing, CRC and the
+ * fixed-form tail
+ */
+static void decode_bit(CANController* controller, bool level) {
+    if (controller->in_stuffed) {
+        if (controller->same_count == 5) {
+            // Stuff bit: must be the complement of the previous five
+            if (level == controller->last_level) {
+                signal_error(controller, CAN_ERROR_STUFF);
+                return;
+            }
+            controller->last_level = level;
+            controller->same_count = 1;
+            if (controller->rx_len == controller->rx_expected_len) {
+                controller->in_stuffed = false;
+            }
+            return;
+        }
+
+        controller->same_count = (controller->rx_len > 0 && level == controller->last_level)
+            ? controller->same_count + 1 : 1;
+        controller->last_level = level;
+
+        size_t pos = controller->rx_len;
+        if (pos == 0 && level != DOMINANT) {
+            signal_error(controller, CAN_ERROR_FORM);
+            return;
+        }
+        controller->rx_bits[controller->rx_len++] = level;
+        if (pos < controller->crc_start) {
+            controller->crc = crc15_update(controller->crc, level);
+        }
+
+        // Frame length is known once the DLC has been received
+        const bool* bits = controller->rx_bits;
+        if (controller->rx_len == 19 && !bits[13]) {
+            controller->crc_start = 19 + frame_data_bits(bits, 15, bits[12]);
+            controller->rx_expected_len = controller->crc_start + 15;
+        } else if (controller->rx_len == 39 && bits[13]) {
+            controller->crc_start = 39 + frame_data_bits(bits, 35, bits[32]);
+            controller->rx_expected_len = controller->crc_start + 15;
+        }
+
+        if (controller->rx_len == controller->rx_expected_len && controller->same_count != 5) {
+            controller->in_stuffed = false;
+        }
+        return;
+    }
+
+    uint32_t tail = controller->tail_pos++;
+    switch (tail) {
+        case TAIL_CRC_DELIMITER: {
+            uint16_t received = 0;
+            for (size_t i = 0; i < 15; i++) {
+                received = (uint16_t)((received << 1) | controller->rx_bits[controller->crc_start + i]);
+            }
+            controller->crc_ok = (received == controller->crc);
+            if (level != RECESSIVE) signal_error(controller, CAN_ERROR_FORM);
+            break;
+        }
+
+        case TAIL_ACK_SLOT:
+            if (controller->transmitting && level != DOMINANT) {
+                signal_error(controller, CAN_ERROR_ACK);
+            }
+            break;
+
+        case TAIL_ACK_DELIMITER:
+            if (level != RECESSIVE) {
+                signal_error(controller, CAN_ERROR_FORM);
+            } else if (!controller->transmitting && !controller->crc_ok) {
+                // CRC error flag starts after the ACK delimiter
+                signal_error(controller, CAN_ERROR_CRC);
+            }
+            break;
+
+        default:
+            if (level != RECESSIVE) {
+                // A dominant last EOF bit is not an error for receivers
+                if (tail == TAIL_EOF_LAST && !controller->transmitting) {
+                    frame_complete(controller);
+                } else {
+                    signal_error(controller, CAN_ERROR_FORM);
+                }
+                break;
+            }
+            if (tail == TAIL_EOF_LAST - 1 && !controller->transmitting) {
+                // Receivers accept the frame at the last but one EOF bit
+                if (controller->rec > 127) {
+                    controller->rec = 120;
+                } else if (controller->rec > 0) {
+                    controller->rec--;
+                }
+                update_error_state(controller);
+                deliver_frame(controller);
+            } else if (tail == TAIL_EOF_LAST) {
+                if (controller->transmitting) {
+                    if (controller->tec > 0) controller->tec--;
+                    update_error_state(controller);
+                    controller->stats.tx_frames++;
+                    controller->tx_head = (controller->tx_head + 1) % CAN_CONTROLLER_TX_QUEUE;
+                    controller->tx_count--;
+                    controller->transmitting = false;
+                    controller->last_was_transmitter = true;
+                } else {
+                    controller->last_was_transmitter = false;
+                }
+                frame_complete(controller);
+            }
+            break;
+    }
+}
+
+bool tcan1463q1_can_controller_tx_bit(CANController* controller) {
+    if (!controller) return RECESSIVE;
+
+    switch (controller->state) {
+        case PROTOCOL_IDLE:
+            if (controller->tx_count > 0) {
+                build_tx_stream(controller);
+                start_frame(controller);
+                controller->transmitting = true;
+                return controller->tx_bits[0];
+            }
+            return RECESSIVE;
+
+        case PROTOCOL_FRAME:
+            if (controller->transmitting) {
+                return controller->tx_bits[controller->tx_pos];
+            }
+            // Receivers acknowledge a frame with a correct CRC
+            if (!controller->in_stuffed && controller->tail_pos == TAIL_ACK_SLOT &&
+                controller->crc_ok) {
+                return DOMINANT;
+            }
+            return RECESSIVE;
+
+        case PROTOCOL_ERROR_FLAG:
+            return controller->error_passive_flag ? RECESSIVE : DOMINANT;
+
+        default:
+            return RECESSIVE;
+    }
+}
+
+void tcan1463q1_can_controller_rx_bit(CANController* controller, bool level) {
+    if (!controller) return;
+
+    controller->recessive_run = (level == RECESSIVE) ? controller->recessive_run + 1 : 0;
+    controller->state_bits++;
+
+    switch (controller->state) {
+        case PROTOCOL_INTEGRATING:
+            if (controller->recessive_run >= 11) {
+                controller->state = PROTOCOL_IDLE;
+            }
+            break;
+
+        case PROTOCOL_INTERMISSION:
+        case PROTOCOL_SUSPEND:
+        case PROTOCOL_IDLE:
+            if (level == DOMINANT) {
+                // Start of frame from another node
+                start_frame(controller);
+                decode_bit(controller, level);
+            } else if (controller->state == PROTOCOL_INTERMISSION && controller->state_bits >= 3) {
+                bool suspend = controller->last_was_transmitter &&
+                               controller->error_state == CAN_ERROR_PASSIVE;
+                controller->state = suspend ? PROTOCOL_SUSPEND : PROTOCOL_IDLE;
+                controller->state_bits = 0;
+            } else if (controller->state == PROTOCOL_SUSPEND && controller->state_bits >= 8) {
+                controller->state = PROTOCOL_IDLE;
+            }
+            break;
+
+        case PROTOCOL_FRAME: {
+            bool stuff_bit = controller->in_stuffed && controller->same_count == 5;
+            if (controller->transmitting) {
+                bool sent = controller->tx_bits[controller->tx_pos];
+                if (sent != level) {
+                    bool ack_slot = !controller->in_stuffed &&
+                                    controller->tail_pos == TAIL_ACK_SLOT;
+                    if (!stuff_bit && sent == RECESSIVE && in_arbitration(controller)) {
+                        // Lost arbitration: continue as a receiver
+                        controller->transmitting = false;
+                        controller->stats.arbitration_lost++;
+                    } else if (!ack_slot) {
+                        signal_error(controller, CAN_ERROR_BIT);
+                        break;
+                    }
+                }
+                controller->tx_pos++;
+            }
+            decode_bit(controller, level);
+            break;
+        }
+
+        case PROTOCOL_ERROR_FLAG:
+            if (controller->state_bits >= 6) {
+                controller->state = PROTOCOL_ERROR_DELIMITER;
+                controller->state_bits = 0;
+                controller->delimiter_recessive_seen = false;
+                controller->dominant_after_flag = 0;
+            }
+            break;
+
+        case PROTOCOL_ERROR_DELIMITER:
+            if (level == RECESSIVE) {
+                // Eight recessive bits in a row complete the delimiter
+                controller->delimiter_recessive_seen = true;
+                if (controller->state_bits >= 8) {
+                    controller->state = PROTOCOL_INTERMISSION;
+                    controller->state_bits = 0;
+                }
+                break;
+            }
+            controller->state_bits = 0;
+            if (!controller->delimiter_recessive_seen) {
+                // Each further 8 dominant bits after the flag count as errors
+                controller->dominant_after_flag++;
+                if (controller->dominant_after_flag % 8 == 0) {
+                    add_error_count(controller, controller->error_was_transmitter, 8);
+                    if (controller->error_state == CAN_BUS_OFF) {
+                        enter_bus_off(controller);
+                    }
+                }
+            }
+            break;
+
+        case PROTOCOL_BUS_OFF:
+            if (!controller->auto_recovery && !controller->recovery_requested) {
+                // Recovery sequences are only counted once recovery is allowed
+                controller->recessive_run = 0;
+                break;
+            }
+            if (controller->recessive_run == 11) {
+                controller->recessive_run = 0;
+                if (++controller->recovery_sequences >= 128) {
+                    controller->tec = 0;
+                    controller->rec = 0;
+                    controller->error_state = CAN_ERROR_ACTIVE;
+                    controller->state = PROTOCOL_IDLE;
+                    controller->last_was_transmitter = false;
+                }
+            }
+            break;
+    }
+}
+
+CANErrorState tcan1463q1_can_controller_get_error_state(const CANController* controller) {
+    return controller ? controller->error_state : CAN_BUS_OFF;
+}
+
+uint16_t tcan1463q1_can_controller_get_tec(const CANController* controller) {
+    return controller ? controller->tec : 0;
+}
+
+uint16_t tcan1463q1_can_controller_get_rec(const CANController* controller) {
+    return controller ? controller->rec : 0;
+}
+
+void tcan1463q1_can_controller_set_auto_recovery(CANController* controller, bool enable) {
+    if (controller) controller->auto_recovery = enable;
+}
+
+bool tcan1463q1_can_controller_request_recovery(CANController* controller) {
+    if (!controller || controller->state != PROTOCOL_BUS_OFF) return false;
+    controller->recovery_requested = true;
+    return true;
+}
+
+void tcan1463q1_can_controller_get_stats(const CANController* controller,
+                                         CANControllerStats* stats) {
+    if (!controller || !stats) return;
+    *stats = controller->stats;
+}
+
+const char* tcan1463q1_can_error_state_name(CANErrorState state) {
+    switch (state) {
+        case CAN_ERROR_ACTIVE: return "ERROR_ACTIVE";
+        case CAN_ERROR_PASSIVE: return "ERROR_PASSIVE";
+        case CAN_BUS_OFF: return "BUS_OFF";
+        default: return NULL;
+    }
+}
+
+const char* tcan1463q1_can_error_type_name(CANErrorType type) {
+    switch (type) {
+        case CAN_ERROR_BIT: return "BIT";
+        case CAN_ERROR_STUFF: return "STUFF";
+        case CAN_ERROR_CRC: return "CRC";
+        case CAN_ERROR_FORM: return "FORM";
+        case CAN_ERROR_ACK: return "ACK";
+        default: return NULL;
+    }
+}
+
+bool can_controller_same_state(const CANController* a, const CANController* b) {
+    return memcmp(a, b, sizeof(CANController)) == 0;
+}
+
+void can_controller_copy_state(CANController* dst, const CANController* src) {
+    if (dst != src) memcpy(dst, src, sizeof(CANController));
+}
+
+bool can_controller_is_quiet(const CANController* controller) {
+    return controller->tx_count == 0 && (controller->state == PROTOCOL_IDLE ||
+                                         controller->state == PROTOCOL_INTEGRATING);
+}
+
+void can_controller_skip_recessive(CANController* controller, uint64_t bits) {
+    // Counters wrap as they would bit by bit
+    controller->recessive_run += (uint32_t)bits;
+    controller->state_bits += (uint32_t)bits;
+    if (controller->state == PROTOCOL_INTEGRATING && bits > 0 &&
+        (bits >= 11 || controller->recessive_run >= 11)) {
+        controller->state = PROTOCOL_IDLE;
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef CAN_CONTROLLER_IMPL_H
+#define CAN_CONTROLLER_IMPL_H
+
+#include "tcan1463q1_can_controller.h"
+
+/**
+ * Controller state comparison and copying (CAN network equivalence
+ * classes); controllers with the same state fed the same bits stay the same
+ */
+bool can_controller_same_state(const CANController* a, const CANController* b);
+void can_controller_copy_state(CANController* dst, const CANController* src);
+
+// Idle (or integrating) with nothing to send: recessive bits only count
+bool can_controller_is_quiet(const CANController* controller);
+// Same as bits x (tx_bit, rx_bit(recessive)) on a quiet controller
+void can_controller_skip_recessive(CANController* controller, uint64_t bits);
+
+#endif // CAN_CONTROLLER_IMPL_H
@@ -0,0 +1,539 @@
+#include "tcan1463q1_can_network.h"
+#include "simulator_impl.h"
+#include "can_controller_impl.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * One node: transceiver simulator plus protocol controller
+ */
+typedef struct {
+    TCAN1463Q1Simulator* sim;
+    CANController* controller;
+    bool txd_high;
+    bool drives_dominant;
+    size_t leader;              // Node simulated on this one's behalf (itself if simulated)
+    size_t weight;              // Nodes this one simulates, 0 for followers
+    bool parked;                // Asleep on a recessive bus, not stepped
+    bool pinned;                // Driven from outside the run loop: never collapsed or parked
+    uint64_t parked_at_ns;      // Network time the node was last stepped to
+    uint64_t wake_at_ns;        // Network time of its next timer, UINT64_MAX if none
+} CANNode;
+
+struct CANNetwork {
+    CANBitTiming timing;
+    uint64_t bit_time_ns;
+    uint64_t sample_offset_ns;
+    CANNode* nodes;
+    size_t node_count;
+    size_t node_capacity;
+    CANNetworkStats stats;
+    CANNetworkBitCallback bit_callback;
+    void* bit_callback_data;
+
+    // Ground shift: per-node arrays, parallel to nodes; each node's
+    // simulator reads its entry of bus_offsets
+    bool offsets_enabled;
+    bool offsets_valid;         // bus_offsets hold bus_level against the current grounds
+    double common_mode;         // Disturbance on both bus lines (V)
+    double ground_sum;          // Sum of ground_offsets (recessive bus level)
+    double bus_level;           // Bus common mode against the reference ground (V)
+    double* ground_offsets;     // Node GND against the reference ground (V)
+    double* bus_offsets;        // Bus common mode seen by each node (V)
+
+    // Equivalence classes: only leaders are simulated, listed in active
+    bool collapse;
+    bool grouped;               // Followers lag their leaders until the next sync
+    size_t* active;
+    size_t active_count;
+
+    // Lazy sleep: parked nodes wait for the next bus edge or their next
+    // timer, off the active list
+    bool lazy_sleep;
+    size_t* parked;
+    size_t parked_count;
+    uint64_t next_wake_ns;      // Earliest wake_at_ns of the parked nodes
+};
+
+static void sync_nodes(CANNetwork* network);
+
+CANNetwork* tcan1463q1_can_network_create(const CANBitTiming* timing) {
+    if (!tcan1463q1_can_controller_validate_timing(timing)) return NULL;
+
+    CANNetwork* network = (CANNetwork*)malloc(sizeof(CANNetwork));
+    if (network) {
+        memset(network, 0, sizeof(CANNetwork));
+        network->timing = *timing;
+
+        // Take the bit grid from a controller so both agree on rounding
+        CANController* probe = tcan1463q1_can_controller_create(timing);
+        if (!probe) {
+            free(network);
+            return NULL;
+        }
+        network->bit_time_ns = tcan1463q1_can_controller_get_bit_time_ns(probe);
+        network->sample_offset_ns = tcan1463q1_can_controller_get_sample_offset_ns(probe);
+        tcan1463q1_can_controller_destroy(probe);
+    }
+    return network;
+}
+
+void tcan1463q1_can_network_destroy(CANNetwork* network) {
+    if (!network) return;
+
+    for (size_t i = 0; i < network->node_count; i++) {
+        if (network->offsets_enabled) simulator_set_bus_offset_source(network->nodes[i].sim, NULL);
+        tcan1463q1_can_controller_destroy(network->nodes[i].controller);
+    }
+    free(network->nodes);
+    free(network->ground_offsets);
+    free(network->bus_offsets);
+    free(network->active);
+    free(network->parked);
+    free(network);
+}
+
+/**
+ * Point every node's simulator at its entry of bus_offsets (again after the
+ * array moved)
+ */
+static void attach_bus_offsets(CANNetwork* network) {
+    for (size_t i = 0; i < network->node_count; i++) {
+        simulator_set_bus_offset_source(network->nodes[i].sim, &network->bus_offsets[i]);
+    }
+}
+
+/**
+ * Offsets changed: recompute at the next bit, and start applying ground
+ * shift at the first offset set
+ */
+static void enable_offsets(CANNetwork* network) {
+    network->ground_sum = 0.0;
+    for (size_t i = 0; i < network->node_count; i++) {
+        network->ground_sum += network->ground_offsets[i];
+    }
+    network->offsets_valid = false;
+    if (network->offsets_enabled) return;
+    network->offsets_enabled = true;
+    attach_bus_offsets(network);
+}
+
+int tcan1463q1_can_network_add_node(CANNetwork* network, TCAN1463Q1Simulator* sim) {
+    if (!network || !sim) return -1;
+
+    if (network->node_count == network->node_capacity) {
+        size_t capacity = network->node_capacity ? network->node_capacity * 2 : 8;
+        CANNode* nodes = (CANNode*)realloc(network->nodes, capacity * sizeof(CANNode));
+        if (!nodes) return -1;
+        network->nodes = nodes;
+        double* ground = (double*)realloc(network->ground_offsets, capacity * sizeof(double));
+        if (!ground) return -1;
+        network->ground_offsets = ground;
+        double* bus = (double*)realloc(network->bus_offsets, capacity * sizeof(double));
+        if (!bus) return -1;
+        network->bus_offsets = bus;
+        size_t* active = (size_t*)realloc(network->active, capacity * sizeof(size_t));
+        if (!active) return -1;
+        network->active = active;
+        size_t* parked = (size_t*)realloc(network->parked, capacity * sizeof(size_t));
+        if (!parked) return -1;
+        network->parked = parked;
+        network->node_capacity = capacity;
+    }
+
+    CANNode* node = &network->nodes[network->node_count];
+    node->controller = tcan1463q1_can_controller_create(&network->timing);
+    if (!node->controller) return -1;
+    node->sim = sim;
+    node->txd_high = true;
+    node->drives_dominant = false;
+    node->leader = network->node_count;
+    node->weight = 1;
+    node->parked = false;
+    node->pinned = false;
+    network->active[network->active_count++] = network->node_count;
+    network->ground_offsets[network->node_count] = 0.0;
+    network->bus_offsets[network->node_count] = 0.0;
+    network->offsets_valid = false;
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+
+    network->node_count++;
+    if (network->offsets_enabled) attach_bus_offsets(network);
+    return (int)network->node_count - 1;
+}
+
+size_t tcan1463q1_can_network_node_count(const CANNetwork* network) {
+    return network ? network->node_count : 0;
+}
+
+CANController* tcan1463q1_can_network_get_controller(CANNetwork* network, size_t node) {
+    if (!network || node >= network->node_count) return NULL;
+    sync_nodes(network);
+    return network->nodes[node].controller;
+}
+
+TCAN1463Q1Simulator* tcan1463q1_can_network_get_simulator(CANNetwork* network, size_t node) {
+    if (!network || node >= network->node_count) return NULL;
+    sync_nodes(network);
+    return network->nodes[node].sim;
+}
+
+/**
+ * Step the parked nodes due by until (all for UINT64_MAX) over the time
+ * they slept and put them back on the active list. The bus stayed
+ * recessive and no timer expired meanwhile, so one step covers it and
+ * their controllers only count recessive bits.
+ */
+static void unpark_nodes(CANNetwork* network, uint64_t until) {
+    const uint64_t now = network->stats.bits * network->bit_time_ns;
+    size_t kept = 0;
+
+    network->next_wake_ns = UINT64_MAX;
+    for (size_t k = 0; k < network->parked_count; k++) {
+        size_t i = network->parked[k];
+        CANNode* node = &network->nodes[i];
+        if (node->wake_at_ns > until) {
+            if (node->wake_at_ns < network->next_wake_ns) network->next_wake_ns = node->wake_at_ns;
+            network->parked[kept++] = i;
+            continue;
+        }
+        uint64_t slept = now - node->parked_at_ns;
+        if (slept > 0) {
+            tcan1463q1_simulator_step(node->sim, slept);
+            can_controller_skip_recessive(node->controller, slept / network->bit_time_ns);
+        }
+        node->parked = false;
+        network->active[network->active_count++] = i;
+    }
+    network->parked_count = kept;
+}
+
+/**
+ * Park the active nodes that only a bus edge or one of their timers can
+ * change: asleep or in standby, TXD and RXD high, controller quiet,
+ * nothing attached. A node is due again at the bit holding its next
+ * timer deadline (tSILENCE, WUP, UV filters), so its supply intervals
+ * and transitions fall where the full simulation puts them.
+ */
+static void park_nodes(CANNetwork* network) {
+    const uint64_t now = network->stats.bits * network->bit_time_ns;
+    size_t kept = 0;
+
+    if (network->parked_count == 0) network->next_wake_ns = UINT64_MAX;
+    for (size_t k = 0; k < network->active_count; k++) {
+        size_t i = network->active[k];
+        CANNode* node = &network->nodes[i];
+        OperatingMode mode = tcan1463q1_simulator_get_mode(node->sim);
+        PinState rxd;
+        double voltage;
+        tcan1463q1_simulator_get_pin(node->sim, PIN_RXD, &rxd, &voltage);
+        if ((mode == MODE_SLEEP || mode == MODE_STANDBY) && node->txd_high &&
+            rxd == PIN_STATE_HIGH && can_controller_is_quiet(node->controller) &&
+            !node->pinned && simulator_is_detached(node->sim)) {
+            uint64_t deadline = simulator_next_deadline_ns(node->sim);
+            uint64_t sim_now = tcan1463q1_simulator_get_time_ns(node->sim);
+            node->wake_at_ns = deadline == UINT64_MAX ? UINT64_MAX : now + (deadline - sim_now);
+            if (node->wake_at_ns <= now + network->bit_time_ns) {
+                network->active[kept++] = i;
+                continue;
+            }
+            node->parked = true;
+            node->parked_at_ns = now;
+            if (node->wake_at_ns < network->next_wake_ns) network->next_wake_ns = node->wake_at_ns;
+            network->parked[network->parked_count++] = i;
+        } else {
+            network->active[kept++] = i;
+        }
+    }
+    network->active_count = kept;
+}
+
+/**
+ * Bring every node up to date: wake the parked ones, then bring every
+ * follower up to its leader and simulate each node on its own
+ */
+static void sync_nodes(CANNetwork* network) {
+    if (network->parked_count > 0) unpark_nodes(network, UINT64_MAX);
+    if (!network->grouped) return;
+
+    for (size_t i = 0; i < network->node_count; i++) {
+        CANNode* node = &network->nodes[i];
+        if (node->leader != i) {
+            const CANNode* leader = &network->nodes[node->leader];
+            simulator_copy_state(node->sim, leader->sim);
+            can_controller_copy_state(node->controller, leader->controller);
+            node->txd_high = leader->txd_high;
+            node->drives_dominant = leader->drives_dominant;
+        }
+        node->leader = i;
+        node->weight = 1;
+        network->active[i] = i;
+    }
+    network->active_count = network->node_count;
+    network->grouped = false;
+}
+
+// Nothing outside the run loop drives the node
+static bool node_is_collapsible(const CANNode* node) {
+    return !node->pinned && simulator_is_detached(node->sim);
+}
+
+/**
+ * Collapse nodes with equal simulator and controller state, TXD and ground
+ * offset into one class simulated by its first node. Within the network
+ * such nodes get equal inputs every bit, so they stay equal until someone
+ * outside changes one of them.
+ */
+static void group_nodes(CANNetwork* network) {
+    const size_t count = network->node_count;
+    uint64_t* hashes = (uint64_t*)malloc(count * sizeof(uint64_t));
+    if (!hashes) return;
+
+    network->active_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        CANNode* node = &network->nodes[i];
+        bool collapsible = node_is_collapsible(node);
+        hashes[i] = collapsible ? simulator_state_hash(node->sim) : 0;
+
+        for (size_t k = 0; collapsible && k < network->active_count; k++) {
+            size_t j = network->active[k];
+            CANNode* leader = &network->nodes[j];
+            if (hashes[j] == hashes[i] && leader->txd_high == node->txd_high &&
+                network->ground_offsets[j] == network->ground_offsets[i] &&
+                node_is_collapsible(leader) &&
+                simulator_same_state(leader->sim, node->sim) &&
+                can_controller_same_state(leader->controller, node->controller)) {
+                node->leader = j;
+                node->weight = 0;
+                leader->weight++;
+                break;
+            }
+        }
+        if (node->leader == i) network->active[network->active_count++] = i;
+    }
+    free(hashes);
+    network->grouped = true;
+}
+
+/**
+ * Bus common mode as seen by each node: the bus level is set by the
+ * dominant drivers, or by the bias of every node while recessive, and each
+ * node measures it against its own ground. The per-node offsets are only
+ * rewritten when the level changes, in one pass over the arrays.
+ */
+static void update_bus_offsets(CANNetwork* network, size_t dominant_drivers) {
+    const double* ground = network->ground_offsets;
+
+    double sum = network->ground_sum;
+    size_t setters = network->node_count;
+    if (dominant_drivers > 0) {
+        sum = 0.0;
+        setters = dominant_drivers;
+        for (size_t k = 0; k < network->active_count; k++) {
+            const CANNode* node = &network->nodes[network->active[k]];
+            if (node->drives_dominant) sum += (double)node->weight * ground[network->active[k]];
+        }
+    }
+    const double level = sum / (double)setters + network->common_mode;
+    if (network->offsets_valid && level == network->bus_level) return;
+
+    // Followers included: theirs equal their leader's (same ground)
+    double* bus = network->bus_offsets;
+    const size_t count = network->node_count;
+    for (size_t i = 0; i < count; i++) {
+        bus[i] = level - ground[i];
+    }
+    network->bus_level = level;
+    network->offsets_valid = true;
+}
+
+/**
+ * Controllers of active[first..] drive TXD; returns the dominant drivers
+ */
+static size_t drive_txd(CANNetwork* network, size_t first) {
+    size_t dominant_drivers = 0;
+
+    for (size_t k = first; k < network->active_count; k++) {
+        CANNode* node = &network->nodes[network->active[k]];
+        bool txd_high = tcan1463q1_can_controller_tx_bit(node->controller);
+        if (txd_high != node->txd_high) {
+            tcan1463q1_simulator_set_pin(node->sim, PIN_TXD,
+                                         txd_high ? PIN_STATE_HIGH : PIN_STATE_LOW,
+                                         txd_high ? 3.3 : 0.0);
+            node->txd_high = txd_high;
+        }
+        node->drives_dominant = !txd_high && tcan1463q1_simulator_can_drive_bus(node->sim);
+        if (node->drives_dominant) dominant_drivers += node->weight;
+    }
+    return dominant_drivers;
+}
+
+/**
+ * Simulate one bit time on every active node (every class leader when
+ * collapsed; a leader counts as weight drivers on the bus)
+ */
+static void run_bit(CANNetwork* network) {
+    if (network->collapse && !network->grouped) group_nodes(network);
+
+    // Parked nodes whose next timer expires within this bit rejoin first
+    const uint64_t now = network->stats.bits * network->bit_time_ns;
+    if (network->parked_count > 0 && network->next_wake_ns <= now + network->bit_time_ns) {
+        unpark_nodes(network, now + network->bit_time_ns);
+    }
+
+    // Resolve the wired-AND bus; a dominant bus is an edge the parked nodes wait for
+    size_t dominant_drivers = drive_txd(network, 0);
+    if (dominant_drivers > 0 && network->parked_count > 0) {
+        size_t first = network->active_count;
+        unpark_nodes(network, UINT64_MAX);
+        dominant_drivers += drive_txd(network, first);
+    }
+
+    const size_t* active = network->active;
+    const size_t count = network->active_count;
+    network->stats.bits++;
+    network->stats.node_bits += count;
+    if (dominant_drivers > 0) network->stats.dominant_bits++;
+    if (network->offsets_enabled && network->node_count > 0) {
+        update_bus_offsets(network, dominant_drivers);
+    }
+
+    // Step to the sample point and sample RXD
+    for (size_t k = 0; k < count; k++) {
+        CANNode* node = &network->nodes[active[k]];
+        size_t others = dominant_drivers - (node->drives_dominant ? 1 : 0);
+        tcan1463q1_simulator_set_remote_dominant(node->sim, others > 0);
+        tcan1463q1_simulator_step(node->sim, network->sample_offset_ns);
+
+        PinState rxd;
+        double voltage;
+        tcan1463q1_simulator_get_pin(node->sim, PIN_RXD, &rxd, &voltage);
+        tcan1463q1_can_controller_rx_bit(node->controller, rxd == PIN_STATE_HIGH);
+    }
+
+    // Rest of the bit
+    uint64_t remainder = network->bit_time_ns - network->sample_offset_ns;
+    if (remainder > 0) {
+        for (size_t k = 0; k < count; k++) {
+            tcan1463q1_simulator_step(network->nodes[active[k]].sim, remainder);
+        }
+    }
+
+    // Ground shift moves the bus level seen by every node, so nobody sleeps through it
+    if (network->lazy_sleep && dominant_drivers == 0 && !network->offsets_enabled) {
+        park_nodes(network);
+    }
+
+    if (network->bit_callback) {
+        network->bit_callback(network, network->stats.bits * network->bit_time_ns,
+                              network->bit_callback_data);
+    }
+}
+
+void tcan1463q1_can_network_run_bits(CANNetwork* network, uint64_t bits) {
+    if (!network) return;
+
+    for (uint64_t bit = 0; bit < bits; bit++) {
+        run_bit(network);
+    }
+    sync_nodes(network);
+}
+
+void tcan1463q1_can_network_run_for(CANNetwork* network, uint64_t duration_ns) {
+    if (!network) return;
+
+    tcan1463q1_can_network_run_bits(
+        network, (duration_ns + network->bit_time_ns - 1) / network->bit_time_ns);
+}
+
+uint64_t tcan1463q1_can_network_get_time_ns(const CANNetwork* network) {
+    return network ? network->stats.bits * network->bit_time_ns : 0;
+}
+
+uint64_t tcan1463q1_can_network_get_bit_time_ns(const CANNetwork* network) {
+    return network ? network->bit_time_ns : 0;
+}
+
+void tcan1463q1_can_network_set_bit_callback(CANNetwork* network,
+                                             CANNetworkBitCallback callback,
+                                             void* user_data) {
+    if (!network) return;
+
+    network->bit_callback = callback;
+    network->bit_callback_data = user_data;
+}
+
+bool tcan1463q1_can_network_set_ground_offset(CANNetwork* network, size_t node, double volts) {
+    if (!network || node >= network->node_count) return false;
+
+    sync_nodes(network);
+    network->ground_offsets[node] = volts;
+    enable_offsets(network);
+    return true;
+}
+
+bool tcan1463q1_can_network_set_ground_offsets(CANNetwork* network, const double* volts,
+                                               size_t count) {
+    if (!network || !volts || count != network->node_count) return false;
+
+    sync_nodes(network);
+    memcpy(network->ground_offsets, volts, count * sizeof(double));
+    enable_offsets(network);
+    return true;
+}
+
+void tcan1463q1_can_network_set_common_mode(CANNetwork* network, double volts) {
+    if (!network) return;
+
+    if (network->parked_count > 0) unpark_nodes(network, UINT64_MAX);
+    network->common_mode = volts;
+    enable_offsets(network);
+}
+
+double tcan1463q1_can_network_get_bus_offset(const CANNetwork* network, size_t node) {
+    if (!network || node >= network->node_count) return 0.0;
+    return network->bus_offsets[node];
+}
+
+bool tcan1463q1_can_network_tx_idle(const CANNetwork* network) {
+    if (!network) return true;
+
+    for (size_t i = 0; i < network->node_count; i++) {
+        const CANNode* node = &network->nodes[network->nodes[i].leader];
+        if (tcan1463q1_can_controller_tx_pending(node->controller) > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void tcan1463q1_can_network_set_collapse(CANNetwork* network, bool enable) {
+    if (!network) return;
+
+    sync_nodes(network);
+    network->collapse = enable;
+}
+
+bool tcan1463q1_can_network_set_node_pinned(CANNetwork* network, size_t node, bool pinned) {
+    if (!network || node >= network->node_count) return false;
+
+    sync_nodes(network);
+    network->nodes[node].pinned = pinned;
+    return true;
+}
+
+void tcan1463q1_can_network_set_lazy_sleep(CANNetwork* network, bool enable) {
+    if (!network) return;
+
+    sync_nodes(network);
+    network->lazy_sleep = enable;
+}
+
+void tcan1463q1_can_network_sync(CANNetwork* network) {
+    if (network) sync_nodes(network);
+}
+
+void tcan1463q1_can_network_get_stats(const CANNetwork* network, CANNetworkStats* stats) {
+    if (!network || !stats) return;
+    *stats = network->stats;
+}
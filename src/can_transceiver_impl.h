@@ -0,0 +1,271 @@
+#ifndef CAN_TRANSCEIVER_IMPL_H
+#define CAN_TRANSCEIVER_IMPL_H
+
+#include "can_transceiver.h"
+#include "device_profiles.h"
+#include "voltage_impl.h"
+
+/**
+ * Profile-specialized CAN transceiver logic
+ */
+
+template <typename Profile>
+inline BusState can_transceiver_get_bus_state_impl(const Profile& profile, double vdiff) {
+    VoltageKey key = voltage_key(vdiff);
+    if (key >= voltage_key(profile.params.vdiff_dominant)) {
+        return BUS_STATE_DOMINANT;
+    } else if (key <= voltage_key(profile.params.vdiff_recessive)) {
+        return BUS_STATE_RECESSIVE;
+    } else {
+        return BUS_STATE_INDETERMINATE;
+    }
+}
+
+/**
+ * Bus state from locally referenced CANH/CANL: indeterminate outside the
+ * receiver common-mode range, else classified on the differential voltage
+ */
+template <typename Profile>
+inline BusState can_transceiver_classify_bus_impl(const Profile& profile, double canh,
+                                                  double canl) {
+    VoltageKey common_mode = voltage_key(0.5 * (canh + canl));
+    if (common_mode < voltage_key(VCM_RANGE_MIN) || common_mode > voltage_key(VCM_RANGE_MAX)) {
+        return BUS_STATE_INDETERMINATE;
+    }
+    return can_transceiver_get_bus_state_impl(profile, canh - canl);
+}
+
+template <typename Profile>
+inline void can_transceiver_drive_bus_impl(
+    const Profile& profile,
+    CANTransceiver* transceiver,
+    bool dominant,
+    double* canh,
+    double* canl
+) {
+    if (!transceiver || !canh || !canl) return;
+    
+    // Only drive if driver is enabled
+    if (dominant && transceiver->driver_enabled) {
+        // Drive dominant: CANH high, CANL low
+        *canh = profile.params.canh_dominant;
+        *canl = profile.params.canl_dominant;
+        transceiver->canh_voltage = *canh;
+        transceiver->canl_voltage = *canl;
+    } else {
+        // Recessive or driver disabled: high impedance (bus bias takes over)
+        // Set to recessive bias voltage
+        *canh = profile.params.canh_recessive;
+        *canl = profile.params.canl_recessive;
+        transceiver->canh_voltage = *canh;
+        transceiver->canl_voltage = *canl;
+    }
+}
+
+template <typename Profile>
+inline void can_transceiver_update_rxd_impl(
+    const Profile& profile,
+    CANTransceiver* transceiver,
+    BusState bus_state,
+    uint64_t current_time,
+    uint64_t schedule_time
+) {
+    if (!transceiver) return;
+    
+    if (!transceiver->receiver_enabled) {
+        transceiver->rxd_output = true;  // High when receiver disabled
+        transceiver->rxd_pending = false;
+        return;
+    }
+    
+    // First, check if pending RXD update should be applied (using current_time)
+    if (transceiver->rxd_pending && current_time >= transceiver->rxd_update_time) {
+        transceiver->rxd_output = transceiver->rxd_pending_value;
+        transceiver->rxd_pending = false;
+    }
+    
+    // Determine target RXD value based on bus state
+    bool target_rxd;
+    switch (bus_state) {
+        case BUS_STATE_DOMINANT:
+            target_rxd = false;  // RXD low for dominant
+            break;
+        case BUS_STATE_RECESSIVE:
+            target_rxd = true;   // RXD high for recessive
+            break;
+        case BUS_STATE_INDETERMINATE:
+            // Keep previous state for indeterminate
+            return;
+    }
+    
+    // Check if RXD needs to change
+    // Only schedule a new update if:
+    // 1. Target is different from current output
+    // 2. No pending update is already scheduled OR the pending update is for a different value
+    bool needs_update = (target_rxd != transceiver->rxd_output);
+    bool pending_is_stale = transceiver->rxd_pending && (transceiver->rxd_pending_value != target_rxd);
+    
+    if (needs_update && (!transceiver->rxd_pending || pending_is_stale)) {
+        // Determine propagation delay based on transition type
+        uint64_t prop_delay;
+        if (!target_rxd) {
+            // Recessive-to-dominant transition (RXD going low)
+            // Use middle of TPROP_LOOP1 range (100-190ns)
+            prop_delay = timing_range_mid_ns(profile.params.tprop_loop1);
+        } else {
+            // Dominant-to-recessive transition (RXD going high)
+            // Use middle of TPROP_LOOP2 range (110-190ns)
+            prop_delay = timing_range_mid_ns(profile.params.tprop_loop2);
+        }
+        
+        // Calculate when the update should occur
+        uint64_t update_time = schedule_time + prop_delay;
+        
+        // If the update time is in the past or now, apply it immediately
+        if (update_time <= current_time) {
+            transceiver->rxd_output = target_rxd;
+            transceiver->rxd_pending = false;
+        } else {
+            // Schedule RXD update for the future
+            transceiver->rxd_pending = true;
+            transceiver->rxd_pending_value = target_rxd;
+            transceiver->rxd_update_time = update_time;
+        }
+    }
+}
+
+template <typename Profile>
+inline void can_transceiver_update_state_machine_impl(
+    const Profile& profile,
+    CANTransceiver* transceiver,
+    OperatingMode mode,
+    BusState bus_state,
+    bool vsup_valid,
+    uint64_t current_time
+) {
+    if (!transceiver) return;
+    
+    // Silence timeout for autonomous state transition (middle of range)
+    const uint64_t tsilence_ns = timing_range_mid_ns(profile.params.tsilence);
+    
+    // Track bus activity for silence timeout
+    if (bus_state == BUS_STATE_DOMINANT) {
+        transceiver->last_bus_activity_time = current_time;
+    }
+    
+    // Initialize last_bus_activity_time if it's zero
+    if (transceiver->last_bus_activity_time == 0) {
+        transceiver->last_bus_activity_time = current_time;
+    }
+    
+    // State machine transitions
+    switch (transceiver->state) {
+        case CAN_STATE_OFF:
+            if (vsup_valid) {
+                transceiver->state = CAN_STATE_AUTONOMOUS_INACTIVE;
+            }
+            break;
+            
+        case CAN_STATE_AUTONOMOUS_INACTIVE:
+            if (!vsup_valid) {
+                transceiver->state = CAN_STATE_OFF;
+            } else if (mode == MODE_NORMAL || mode == MODE_SILENT) {
+                transceiver->state = CAN_STATE_ACTIVE;
+            } else if (bus_state == BUS_STATE_DOMINANT) {
+                // Remote wake-up detected
+                transceiver->state = CAN_STATE_AUTONOMOUS_ACTIVE;
+                transceiver->last_bus_activity_time = current_time;
+            }
+            break;
+            
+        case CAN_STATE_AUTONOMOUS_ACTIVE:
+            if (!vsup_valid) {
+                transceiver->state = CAN_STATE_OFF;
+            } else if (mode == MODE_NORMAL || mode == MODE_SILENT) {
+                transceiver->state = CAN_STATE_ACTIVE;
+            } else {
+                // Check for silence timeout
+                uint64_t silence_duration = current_time - transceiver->last_bus_activity_time;
+                if (silence_duration > tsilence_ns) {
+                    transceiver->state = CAN_STATE_AUTONOMOUS_INACTIVE;
+                }
+            }
+            break;
+            
+        case CAN_STATE_ACTIVE:
+            if (!vsup_valid) {
+                transceiver->state = CAN_STATE_OFF;
+            } else if (mode != MODE_NORMAL && mode != MODE_SILENT) {
+                // Exiting active mode
+                if (bus_state == BUS_STATE_DOMINANT || 
+                    (current_time - transceiver->last_bus_activity_time) <= tsilence_ns) {
+                    transceiver->state = CAN_STATE_AUTONOMOUS_ACTIVE;
+                } else {
+                    transceiver->state = CAN_STATE_AUTONOMOUS_INACTIVE;
+                }
+            }
+            break;
+    }
+    
+    // Update driver and receiver enable based on state and mode
+    switch (transceiver->state) {
+        case CAN_STATE_OFF:
+            transceiver->driver_enabled = false;
+            transceiver->receiver_enabled = false;
+            break;
+            
+        case CAN_STATE_AUTONOMOUS_INACTIVE:
+        case CAN_STATE_AUTONOMOUS_ACTIVE:
+            transceiver->driver_enabled = false;
+            transceiver->receiver_enabled = true;
+            break;
+            
+        case CAN_STATE_ACTIVE:
+            if (mode == MODE_NORMAL) {
+                transceiver->driver_enabled = true;
+                transceiver->receiver_enabled = true;
+            } else if (mode == MODE_SILENT) {
+                transceiver->driver_enabled = false;
+                transceiver->receiver_enabled = true;
+            } else {
+                transceiver->driver_enabled = false;
+                transceiver->receiver_enabled = false;
+            }
+            break;
+    }
+}
+
+template <typename Profile>
+inline void can_transceiver_update_impl(
+    const Profile& profile,
+    CANTransceiver* transceiver,
+    OperatingMode mode,
+    bool txd_low,
+    double canh_voltage,
+    double canl_voltage,
+    uint64_t current_time
+) {
+    if (!transceiver) return;
+    
+    // Get bus state from the input bus
+    BusState bus_state = can_transceiver_classify_bus_impl(profile, canh_voltage, canl_voltage);
+    
+    // Update state machine (determines driver/receiver enable)
+    bool vsup_valid = (mode != MODE_OFF);
+    can_transceiver_update_state_machine_impl(
+        profile,
+        transceiver,
+        mode,
+        bus_state,
+        vsup_valid,
+        current_time
+    );
+    
+    // Drive bus based on TXD input and driver enable
+    double canh_out, canl_out;
+    can_transceiver_drive_bus_impl(profile, transceiver, txd_low, &canh_out, &canl_out);
+    
+    // Note: RXD update is handled separately in simulator_step after bus is driven
+}
+
+#endif // CAN_TRANSCEIVER_IMPL_H
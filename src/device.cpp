@@ -0,0 +1,37 @@
+#include "tcan1463q1_device.h"
+#include "device_profiles.h"
+#include <stddef.h>
+
+// Variant table, indexed by DeviceVariant
+static const struct {
+    const char* name;
+    const DeviceParams* params;
+} variants[DEVICE_VARIANT_COUNT] = {
+    {"TCAN1463-Q1", &TCAN1463Q1Profile::params},
+    {"TCAN1462-Q1", &TCAN1462Q1Profile::params},
+};
+
+const DeviceParams* tcan1463q1_device_get_params(DeviceVariant variant) {
+    if (variant < 0 || variant >= DEVICE_VARIANT_COUNT) return NULL;
+    return variants[variant].params;
+}
+
+const char* tcan1463q1_device_variant_name(DeviceVariant variant) {
+    if (variant < 0 || variant >= DEVICE_VARIANT_COUNT) return NULL;
+    return variants[variant].name;
+}
+
+bool tcan1463q1_device_has_pin(const DeviceParams* params, PinType pin) {
+    if (!params) return false;
+    
+    switch (pin) {
+        case PIN_INH:
+            return params->has_inh;
+        case PIN_INH_MASK:
+            return params->has_inh_mask;
+        case PIN_WAKE:
+            return params->has_wake;
+        default:
+            return pin >= 0 && pin < 14;
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef DEVICE_PROFILES_H
+#define DEVICE_PROFILES_H
+
+#include "tcan1463q1_device.h"
+
+/**
+ * Device profiles
+ *
+ * A profile is a type with a DeviceParams member named params. Component
+ * logic and the step kernel are templated on the profile. For built-in
+ * variants params is a static constexpr member, so each variant compiles
+ * to its own kernel with thresholds and timings folded in and absent
+ * features removed; RuntimeProfile reads a table loaded at run time.
+ */
+
+constexpr TimingRangeNs timing_range_ns(uint64_t min_ns, uint64_t max_ns) {
+    TimingRangeNs range{};
+    range.min_ns = min_ns;
+    range.max_ns = max_ns;
+    return range;
+}
+
+constexpr uint64_t timing_range_mid_ns(TimingRangeNs range) {
+    return (range.min_ns + range.max_ns) / 2;
+}
+
+// TCAN1463-Q1 datasheet characteristics
+constexpr DeviceParams make_tcan1463q1_params() {
+    DeviceParams p{};
+
+    p.uvsup_falling = UVSUP_FALLING_MIN;
+    p.uvsup_rising = UVSUP_RISING_MIN;
+    p.uvcc_falling = UVCC_FALLING_MAX;
+    p.uvcc_rising = UVCC_RISING_MIN;
+    p.uvio_falling = UVIO_FALLING_MAX;
+    p.uvio_rising = UVIO_RISING_MIN;
+
+    p.vdiff_dominant = 0.9;
+    p.vdiff_recessive = 0.5;
+
+    p.canh_dominant = 3.5;
+    p.canl_dominant = 1.5;
+    p.canh_recessive = 2.5;
+    p.canl_recessive = 2.5;
+    p.bias_autonomous = 2.5;
+    p.inh_voltage_drop = 0.75;
+
+    p.tsd_celsius = TSDR_CELSIUS;
+
+    p.tuv = timing_range_ns(100000000ULL, 350000000ULL);
+    p.ttxddto = timing_range_ns(1200000ULL, 3800000ULL);
+    p.tbusdom = timing_range_ns(1400000ULL, 3800000ULL);
+    p.twk_filter = timing_range_ns(500ULL, 1800ULL);
+    p.twk_timeout = timing_range_ns(800000ULL, 2000000ULL);
+    p.tsilence = timing_range_ns(600000000ULL, 1200000000ULL);
+    p.tprop_loop1 = timing_range_ns(TPROP_LOOP1_MIN_NS, TPROP_LOOP1_MAX_NS);
+    p.tprop_loop2 = timing_range_ns(TPROP_LOOP2_MIN_NS, TPROP_LOOP2_MAX_NS);
+    p.tinh_slp_stb_ns = TINH_SLP_STB_US * 1000ULL;
+
+    // Typical supply currents
+    p.isup_normal = 80e-6;
+    p.isup_standby = 15e-6;
+    p.isup_sleep = 7e-6;
+    p.isup_bias = 30e-6;
+    p.icc_recessive = 5e-3;
+    p.icc_dominant = 10e-3;
+    p.icc_silent = 2e-3;
+    p.icc_low_power = 1e-6;
+    p.iio_normal = 20e-6;
+    p.iio_low_power = 1e-6;
+
+    p.has_inh = true;
+    p.has_inh_mask = true;
+    p.has_wake = true;
+    return p;
+}
+
+// Reduced pin-count variant: same analog front end, no INH/INH_MASK/WAKE
+constexpr DeviceParams make_tcan1462q1_params() {
+    DeviceParams p = make_tcan1463q1_params();
+    p.has_inh = false;
+    p.has_inh_mask = false;
+    p.has_wake = false;
+    return p;
+}
+
+struct TCAN1463Q1Profile {
+    static constexpr DeviceVariant variant = DEVICE_VARIANT_TCAN1463Q1;
+    static constexpr DeviceParams params = make_tcan1463q1_params();
+};
+
+struct TCAN1462Q1Profile {
+    static constexpr DeviceVariant variant = DEVICE_VARIANT_TCAN1462Q1;
+    static constexpr DeviceParams params = make_tcan1462q1_params();
+};
+
+// Profile backed by a runtime parameter table (see tcan1463q1_profile.h)
+struct RuntimeProfile {
+    const DeviceParams& params;
+};
+
+// Profile used by the standalone component functions
+typedef TCAN1463Q1Profile DefaultProfile;
+
+#endif // DEVICE_PROFILES_H
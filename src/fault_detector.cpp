@@ -1,18 +1,14 @@
 #include "fault_detector.h"
+#include "fault_detector_impl.h"
 #include <string.h>
 
-// Convert milliseconds to nanoseconds
-#define MS_TO_NS(ms) ((uint64_t)(ms * 1000000.0))
-
-// Convert microseconds to nanoseconds
-#define US_TO_NS(us) ((uint64_t)(us * 1000.0))
-
 void fault_detector_init(FaultState* state) {
     if (!state) return;
     
     memset(state, 0, sizeof(FaultState));
     state->txd_dominant_start = UINT64_MAX;
     state->bus_dominant_start = UINT64_MAX;
+    state->cbf_prev_bus_state = BUS_STATE_RECESSIVE;
 }
 
 void fault_detector_check_txdclp(
@@ -34,27 +30,7 @@ void fault_detector_check_txddto(
     bool txd_low,
     uint64_t current_time
 ) {
-    if (!state) return;
-    
-    // Requirement 5.2: WHEN TXD is dominant for t >= tTXDDTO (1.2-3.8ms),
-    // THE Fault_Detector SHALL set TXDDTO flag and disable CAN driver
-    
-    if (txd_low) {
-        // TXD is dominant
-        if (state->txd_dominant_start == UINT64_MAX) {
-            // Start tracking dominant time
-            state->txd_dominant_start = current_time;
-        } else {
-            // Check if timeout exceeded
-            uint64_t dominant_duration = current_time - state->txd_dominant_start;
-            if (dominant_duration >= MS_TO_NS(TTXDDTO_MIN_MS)) {
-                state->txddto_flag = true;
-            }
-        }
-    } else {
-        // TXD is recessive, reset tracking
-        state->txd_dominant_start = UINT64_MAX;
-    }
+    fault_detector_check_txddto_impl(DefaultProfile(), state, txd_low, current_time);
 }
 
 void fault_detector_check_txdrxd(
@@ -63,27 +39,7 @@ void fault_detector_check_txdrxd(
     bool rxd_low,
     uint64_t current_time
 ) {
-    if (!state) return;
-    
-    // Requirement 5.3: WHEN TXD and RXD are shorted for t >= tTXDDTO,
-    // THE Fault_Detector SHALL set TXDRXD flag and disable CAN driver
-    
-    // TXD and RXD are shorted if they have the same value
-    bool shorted = (txd_low == rxd_low);
-    
-    if (shorted) {
-        if (state->txd_dominant_start == UINT64_MAX) {
-            state->txd_dominant_start = current_time;
-        } else {
-            uint64_t short_duration = current_time - state->txd_dominant_start;
-            if (short_duration >= MS_TO_NS(TTXDDTO_MIN_MS)) {
-                state->txdrxd_flag = true;
-            }
-        }
-    } else {
-        // Not shorted, reset tracking
-        state->txd_dominant_start = UINT64_MAX;
-    }
+    fault_detector_check_txdrxd_impl(DefaultProfile(), state, txd_low, rxd_low, current_time);
 }
 
 void fault_detector_check_candom(
@@ -91,41 +47,14 @@ void fault_detector_check_candom(
     BusState bus_state,
     uint64_t current_time
 ) {
-    if (!state) return;
-    
-    // Requirement 5.4: WHEN CAN bus is dominant for t >= tBUSDOM (1.4-3.8ms),
-    // THE Fault_Detector SHALL set CANDOM flag
-    
-    if (bus_state == BUS_STATE_DOMINANT) {
-        if (state->bus_dominant_start == UINT64_MAX) {
-            state->bus_dominant_start = current_time;
-        } else {
-            uint64_t dominant_duration = current_time - state->bus_dominant_start;
-            if (dominant_duration >= MS_TO_NS(TBUSDOM_MIN_MS)) {
-                state->candom_flag = true;
-            }
-        }
-    } else {
-        // Bus is recessive, reset tracking
-        state->bus_dominant_start = UINT64_MAX;
-    }
+    fault_detector_check_candom_impl(DefaultProfile(), state, bus_state, current_time);
 }
 
 void fault_detector_check_tsd(
     FaultState* state,
     double tj_temperature
 ) {
-    if (!state) return;
-    
-    // Requirement 5.5: WHEN junction temperature TJ >= TSDR (165°C),
-    // THE Fault_Detector SHALL set TSD flag and disable CAN driver
-    
-    if (tj_temperature >= TSDR_CELSIUS) {
-        state->tsd_flag = true;
-    } else {
-        // Clear TSD flag when temperature drops below threshold
-        state->tsd_flag = false;
-    }
+    fault_detector_check_tsd_impl(DefaultProfile(), state, tj_temperature);
 }
 
 void fault_detector_check_cbf(
@@ -145,9 +74,7 @@ void fault_detector_check_cbf(
     }
     
     // Track dominant-to-recessive transitions
-    static BusState prev_bus_state = BUS_STATE_RECESSIVE;
-    
-    if (prev_bus_state == BUS_STATE_DOMINANT && bus_state == BUS_STATE_RECESSIVE) {
+    if (state->cbf_prev_bus_state == BUS_STATE_DOMINANT && bus_state == BUS_STATE_RECESSIVE) {
         state->cbf_transition_count++;
         
         if (state->cbf_transition_count >= 4) {
@@ -155,7 +82,7 @@ void fault_detector_check_cbf(
         }
     }
     
-    prev_bus_state = bus_state;
+    state->cbf_prev_bus_state = bus_state;
 }
 
 void fault_detector_update(
@@ -167,14 +94,8 @@ void fault_detector_update(
     uint64_t current_time,
     OperatingMode mode
 ) {
-    if (!state) return;
-    
-    // Check all fault conditions
-    fault_detector_check_txddto(state, txd_low, current_time);
-    fault_detector_check_txdrxd(state, txd_low, rxd_low, current_time);
-    fault_detector_check_candom(state, bus_state, current_time);
-    fault_detector_check_tsd(state, tj_temperature);
-    fault_detector_check_cbf(state, bus_state, mode);
+    fault_detector_update_impl(DefaultProfile(), state, txd_low, rxd_low, bus_state,
+                               tj_temperature, current_time, mode);
 }
 
 bool fault_detector_has_any_fault(const FaultState* state) {
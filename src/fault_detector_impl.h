@@ -0,0 +1,139 @@
+#ifndef FAULT_DETECTOR_IMPL_H
+#define FAULT_DETECTOR_IMPL_H
+
+#include "fault_detector.h"
+#include "device_profiles.h"
+
+/**
+ * Profile-specialized fault detector logic
+ */
+
+template <typename Profile>
+inline void fault_detector_check_txddto_impl(
+    const Profile& profile,
+    FaultState* state,
+    bool txd_low,
+    uint64_t current_time
+) {
+    if (!state) return;
+    
+    // Requirement 5.2: WHEN TXD is dominant for t >= tTXDDTO (1.2-3.8ms),
+    // THE Fault_Detector SHALL set TXDDTO flag and disable CAN driver
+    
+    if (txd_low) {
+        // TXD is dominant
+        if (state->txd_dominant_start == UINT64_MAX) {
+            // Start tracking dominant time
+            state->txd_dominant_start = current_time;
+        } else {
+            // Check if timeout exceeded
+            uint64_t dominant_duration = current_time - state->txd_dominant_start;
+            if (dominant_duration >= profile.params.ttxddto.min_ns) {
+                state->txddto_flag = true;
+            }
+        }
+    } else {
+        // TXD is recessive, reset tracking
+        state->txd_dominant_start = UINT64_MAX;
+    }
+}
+
+template <typename Profile>
+inline void fault_detector_check_txdrxd_impl(
+    const Profile& profile,
+    FaultState* state,
+    bool txd_low,
+    bool rxd_low,
+    uint64_t current_time
+) {
+    if (!state) return;
+    
+    // Requirement 5.3: WHEN TXD and RXD are shorted for t >= tTXDDTO,
+    // THE Fault_Detector SHALL set TXDRXD flag and disable CAN driver
+    
+    // TXD and RXD are shorted if they have the same value
+    bool shorted = (txd_low == rxd_low);
+    
+    if (shorted) {
+        if (state->txd_dominant_start == UINT64_MAX) {
+            state->txd_dominant_start = current_time;
+        } else {
+            uint64_t short_duration = current_time - state->txd_dominant_start;
+            if (short_duration >= profile.params.ttxddto.min_ns) {
+                state->txdrxd_flag = true;
+            }
+        }
+    } else {
+        // Not shorted, reset tracking
+        state->txd_dominant_start = UINT64_MAX;
+    }
+}
+
+template <typename Profile>
+inline void fault_detector_check_candom_impl(
+    const Profile& profile,
+    FaultState* state,
+    BusState bus_state,
+    uint64_t current_time
+) {
+    if (!state) return;
+    
+    // Requirement 5.4: WHEN CAN bus is dominant for t >= tBUSDOM (1.4-3.8ms),
+    // THE Fault_Detector SHALL set CANDOM flag
+    
+    if (bus_state == BUS_STATE_DOMINANT) {
+        if (state->bus_dominant_start == UINT64_MAX) {
+            state->bus_dominant_start = current_time;
+        } else {
+            uint64_t dominant_duration = current_time - state->bus_dominant_start;
+            if (dominant_duration >= profile.params.tbusdom.min_ns) {
+                state->candom_flag = true;
+            }
+        }
+    } else {
+        // Bus is recessive, reset tracking
+        state->bus_dominant_start = UINT64_MAX;
+    }
+}
+
+template <typename Profile>
+inline void fault_detector_check_tsd_impl(
+    const Profile& profile,
+    FaultState* state,
+    double tj_temperature
+) {
+    if (!state) return;
+    
+    // Requirement 5.5: WHEN junction temperature TJ >= TSDR (165°C),
+    // THE Fault_Detector SHALL set TSD flag and disable CAN driver
+    
+    if (tj_temperature >= profile.params.tsd_celsius) {
+        state->tsd_flag = true;
+    } else {
+        // Clear TSD flag when temperature drops below threshold
+        state->tsd_flag = false;
+    }
+}
+
+template <typename Profile>
+inline void fault_detector_update_impl(
+    const Profile& profile,
+    FaultState* state,
+    bool txd_low,
+    bool rxd_low,
+    BusState bus_state,
+    double tj_temperature,
+    uint64_t current_time,
+    OperatingMode mode
+) {
+    if (!state) return;
+    
+    // Check all fault conditions
+    fault_detector_check_txddto_impl(profile, state, txd_low, current_time);
+    fault_detector_check_txdrxd_impl(profile, state, txd_low, rxd_low, current_time);
+    fault_detector_check_candom_impl(profile, state, bus_state, current_time);
+    fault_detector_check_tsd_impl(profile, state, tj_temperature);
+    fault_detector_check_cbf(state, bus_state, mode);
+}
+
+#endif // FAULT_DETECTOR_IMPL_H
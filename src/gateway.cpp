@@ -0,0 +1,376 @@
+#include "tcan1463q1_gateway.h"
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#define STANDARD_ID_COUNT 2048
+
+/**
+ * Frame held by the gateway
+ */
+typedef struct {
+    CANFrame frame;
+    uint64_t received_ns;
+    uint64_t ready_ns;
+} PendingFrame;
+
+/**
+ * One forwarding direction (indexed by the source segment). The source
+ * segment appends to staged during a window; the destination segment
+ * pops from queue. Staged frames move to the queue between windows.
+ */
+typedef struct {
+    PendingFrame* queue;
+    size_t head;
+    size_t count;
+    PendingFrame* staged;
+    size_t staged_count;
+    size_t staged_capacity;
+} Direction;
+
+struct Gateway {
+    CANNetwork* networks[GATEWAY_SEGMENT_COUNT];
+    TCAN1463Q1Simulator* sims[GATEWAY_SEGMENT_COUNT];
+    CANController* controllers[GATEWAY_SEGMENT_COUNT];
+    GatewayConfig config;
+
+    // Routing: route indices (or -1) by standard ID, hash slots for extended
+    GatewayRoute* routes;
+    size_t route_count;
+    size_t route_capacity;
+    int32_t standard[GATEWAY_SEGMENT_COUNT][STANDARD_ID_COUNT];
+    int32_t* extended_slots;
+    size_t extended_capacity;       // Power of two, at most half full
+    size_t extended_count;
+
+    Direction directions[GATEWAY_SEGMENT_COUNT];
+    uint64_t time_ns;               // End of the last window
+    uint64_t window_ns;
+    GatewayStats stats;
+};
+
+static uint64_t extended_key(GatewaySegment source, uint32_t id) {
+    return ((uint64_t)source << 32) | id;
+}
+
+static size_t extended_slot(uint64_t key, size_t capacity) {
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 17) & (capacity - 1);
+}
+
+static const GatewayRoute* lookup(const Gateway* gateway, GatewaySegment source,
+                                  uint32_t id, bool extended) {
+    if (!extended) {
+        if (id >= STANDARD_ID_COUNT) return NULL;
+        int32_t index = gateway->standard[source][id];
+        return index >= 0 ? &gateway->routes[index] : NULL;
+    }
+
+    if (gateway->extended_count == 0) return NULL;
+    uint64_t key = extended_key(source, id);
+    size_t mask = gateway->extended_capacity - 1;
+    for (size_t slot = extended_slot(key, gateway->extended_capacity);;
+         slot = (slot + 1) & mask) {
+        int32_t index = gateway->extended_slots[slot];
+        if (index < 0) return NULL;
+        const GatewayRoute* route = &gateway->routes[index];
+        if (route->source == source && route->id == id) return route;
+    }
+}
+
+static bool rebuild_extended(Gateway* gateway, size_t capacity) {
+    int32_t* slots = (int32_t*)malloc(capacity * sizeof(int32_t));
+    if (!slots) return false;
+    for (size_t i = 0; i < capacity; i++) slots[i] = -1;
+
+    for (size_t r = 0; r < gateway->route_count; r++) {
+        const GatewayRoute* route = &gateway->routes[r];
+        if (!route->extended) continue;
+        size_t slot = extended_slot(extended_key(route->source, route->id), capacity);
+        while (slots[slot] >= 0) slot = (slot + 1) & (capacity - 1);
+        slots[slot] = (int32_t)r;
+    }
+
+    free(gateway->extended_slots);
+    gateway->extended_slots = slots;
+    gateway->extended_capacity = capacity;
+    return true;
+}
+
+static bool stage_frame(Direction* direction, const CANFrame* frame,
+                        uint64_t received, uint64_t ready) {
+    if (direction->staged_count == direction->staged_capacity) {
+        size_t capacity = direction->staged_capacity ? direction->staged_capacity * 2 : 16;
+        PendingFrame* staged = (PendingFrame*)realloc(direction->staged,
+                                                      capacity * sizeof(PendingFrame));
+        if (!staged) return false;
+        direction->staged = staged;
+        direction->staged_capacity = capacity;
+    }
+
+    PendingFrame* pending = &direction->staged[direction->staged_count++];
+    pending->frame = *frame;
+    pending->received_ns = received;
+    pending->ready_ns = ready;
+    return true;
+}
+
+/**
+ * Per-bit work on one segment: route what the gateway received there and
+ * hand over frames from the other segment that are due
+ */
+static void on_bit(CANNetwork* network, uint64_t now, void* user_data) {
+    Gateway* gateway = (Gateway*)user_data;
+    GatewaySegment segment = (network == gateway->networks[GATEWAY_SEGMENT_A])
+                                 ? GATEWAY_SEGMENT_A : GATEWAY_SEGMENT_B;
+    GatewaySegment other = (GatewaySegment)(1 - segment);
+
+    CANFrame frame;
+    while (tcan1463q1_can_controller_receive(gateway->controllers[segment], &frame)) {
+        gateway->stats.received[segment]++;
+        const GatewayRoute* route = lookup(gateway, segment, frame.id, frame.extended);
+        if (!route) {
+            gateway->stats.unrouted[segment]++;
+            continue;
+        }
+        frame.id = route->target_id;
+        frame.extended = route->target_extended;
+        if (!stage_frame(&gateway->directions[segment], &frame, now,
+                         now + gateway->config.latency_ns[segment])) {
+            gateway->stats.dropped[segment]++;
+        }
+    }
+
+    Direction* incoming = &gateway->directions[other];
+    size_t depth = gateway->config.queue_depth[other];
+    while (incoming->count > 0) {
+        PendingFrame* pending = &incoming->queue[incoming->head];
+        if (pending->ready_ns > now) break;
+        if (!tcan1463q1_can_controller_send(gateway->controllers[segment], &pending->frame)) {
+            break;  // Controller TX queue full: retry next bit
+        }
+        uint64_t delay = now - pending->received_ns;
+        if (delay > gateway->stats.max_delay_ns[other]) gateway->stats.max_delay_ns[other] = delay;
+        gateway->stats.forwarded[other]++;
+        incoming->head = (incoming->head + 1) % depth;
+        incoming->count--;
+    }
+}
+
+void tcan1463q1_gateway_config_init(GatewayConfig* config) {
+    if (!config) return;
+
+    memset(config, 0, sizeof(GatewayConfig));
+    for (int s = 0; s < GATEWAY_SEGMENT_COUNT; s++) {
+        config->latency_ns[s] = 100000;
+        config->queue_depth[s] = 32;
+    }
+    config->wake_forwarding = false;
+}
+
+Gateway* tcan1463q1_gateway_create(CANNetwork* a, CANNetwork* b,
+                                   TCAN1463Q1Simulator* sim_a, TCAN1463Q1Simulator* sim_b,
+                                   const GatewayConfig* config) {
+    if (!a || !b || a == b || !sim_a || !sim_b) return NULL;
+
+    GatewayConfig defaults;
+    if (!config) {
+        tcan1463q1_gateway_config_init(&defaults);
+        config = &defaults;
+    }
+    if (config->queue_depth[GATEWAY_SEGMENT_A] == 0 || config->queue_depth[GATEWAY_SEGMENT_B] == 0) {
+        return NULL;
+    }
+
+    Gateway* gateway = (Gateway*)calloc(1, sizeof(Gateway));
+    if (!gateway) return NULL;
+    gateway->config = *config;
+    gateway->networks[GATEWAY_SEGMENT_A] = a;
+    gateway->networks[GATEWAY_SEGMENT_B] = b;
+    gateway->sims[GATEWAY_SEGMENT_A] = sim_a;
+    gateway->sims[GATEWAY_SEGMENT_B] = sim_b;
+    memset(gateway->standard, 0xff, sizeof(gateway->standard));
+
+    for (int s = 0; s < GATEWAY_SEGMENT_COUNT; s++) {
+        gateway->directions[s].queue =
+            (PendingFrame*)malloc(config->queue_depth[s] * sizeof(PendingFrame));
+        int node = tcan1463q1_can_network_add_node(gateway->networks[s], gateway->sims[s]);
+        if (!gateway->directions[s].queue || node < 0) {
+            tcan1463q1_gateway_destroy(gateway);
+            return NULL;
+        }
+        // on_bit drives the controller mid-run: keep it out of classes and lazy sleep
+        tcan1463q1_can_network_set_node_pinned(gateway->networks[s], (size_t)node, true);
+        gateway->controllers[s] = tcan1463q1_can_network_get_controller(gateway->networks[s],
+                                                                        (size_t)node);
+    }
+
+    // Segments may not run further apart than the shortest latency allows
+    uint64_t latency = config->latency_ns[GATEWAY_SEGMENT_A] < config->latency_ns[GATEWAY_SEGMENT_B]
+                           ? config->latency_ns[GATEWAY_SEGMENT_A]
+                           : config->latency_ns[GATEWAY_SEGMENT_B];
+    uint64_t bit_a = tcan1463q1_can_network_get_bit_time_ns(a);
+    uint64_t bit_b = tcan1463q1_can_network_get_bit_time_ns(b);
+    uint64_t max_bit = bit_a > bit_b ? bit_a : bit_b;
+    gateway->window_ns = latency >= 2 * max_bit ? latency - max_bit : max_bit;
+
+    uint64_t time_a = tcan1463q1_can_network_get_time_ns(a);
+    uint64_t time_b = tcan1463q1_can_network_get_time_ns(b);
+    gateway->time_ns = time_a < time_b ? time_a : time_b;
+
+    tcan1463q1_can_network_set_bit_callback(a, on_bit, gateway);
+    tcan1463q1_can_network_set_bit_callback(b, on_bit, gateway);
+    return gateway;
+}
+
+void tcan1463q1_gateway_destroy(Gateway* gateway) {
+    if (!gateway) return;
+
+    for (int s = 0; s < GATEWAY_SEGMENT_COUNT; s++) {
+        tcan1463q1_can_network_set_bit_callback(gateway->networks[s], NULL, NULL);
+        free(gateway->directions[s].queue);
+        free(gateway->directions[s].staged);
+    }
+    free(gateway->routes);
+    free(gateway->extended_slots);
+    free(gateway);
+}
+
+bool tcan1463q1_gateway_add_route(Gateway* gateway, const GatewayRoute* route) {
+    if (!gateway || !route || route->source >= GATEWAY_SEGMENT_COUNT) return false;
+
+    uint32_t limit = route->extended ? 0x20000000u : STANDARD_ID_COUNT;
+    uint32_t target_limit = route->target_extended ? 0x20000000u : STANDARD_ID_COUNT;
+    if (route->id >= limit || route->target_id >= target_limit) return false;
+    if (lookup(gateway, route->source, route->id, route->extended)) return false;
+
+    if (gateway->route_count == gateway->route_capacity) {
+        size_t capacity = gateway->route_capacity ? gateway->route_capacity * 2 : 16;
+        GatewayRoute* routes = (GatewayRoute*)realloc(gateway->routes,
+                                                      capacity * sizeof(GatewayRoute));
+        if (!routes) return false;
+        gateway->routes = routes;
+        gateway->route_capacity = capacity;
+    }
+
+    size_t index = gateway->route_count++;
+    gateway->routes[index] = *route;
+
+    if (!route->extended) {
+        gateway->standard[route->source][route->id] = (int32_t)index;
+        return true;
+    }
+
+    // Keep the hash table at most half full
+    gateway->extended_count++;
+    if (gateway->extended_count * 2 > gateway->extended_capacity) {
+        size_t capacity = gateway->extended_capacity ? gateway->extended_capacity * 2 : 64;
+        if (!rebuild_extended(gateway, capacity)) {
+            gateway->extended_count--;
+            gateway->route_count--;
+            return false;
+        }
+    } else {
+        size_t mask = gateway->extended_capacity - 1;
+        size_t slot = extended_slot(extended_key(route->source, route->id),
+                                    gateway->extended_capacity);
+        while (gateway->extended_slots[slot] >= 0) slot = (slot + 1) & mask;
+        gateway->extended_slots[slot] = (int32_t)index;
+    }
+    return true;
+}
+
+const GatewayRoute* tcan1463q1_gateway_find_route(const Gateway* gateway, GatewaySegment source,
+                                                  uint32_t id, bool extended) {
+    if (!gateway || source >= GATEWAY_SEGMENT_COUNT) return NULL;
+    return lookup(gateway, source, id, extended);
+}
+
+CANController* tcan1463q1_gateway_get_controller(Gateway* gateway, GatewaySegment segment) {
+    if (!gateway || segment >= GATEWAY_SEGMENT_COUNT) return NULL;
+    return gateway->controllers[segment];
+}
+
+uint64_t tcan1463q1_gateway_get_lookahead_ns(const Gateway* gateway) {
+    return gateway ? gateway->window_ns : 0;
+}
+
+static bool low_power(TCAN1463Q1Simulator* sim) {
+    OperatingMode mode = tcan1463q1_simulator_get_mode(sim);
+    return mode == MODE_STANDBY || mode == MODE_GO_TO_SLEEP || mode == MODE_SLEEP;
+}
+
+/**
+ * Between windows: queue staged frames and react to wake-up requests
+ */
+static void end_window(Gateway* gateway) {
+    for (int s = 0; s < GATEWAY_SEGMENT_COUNT; s++) {
+        Direction* direction = &gateway->directions[s];
+        size_t depth = gateway->config.queue_depth[s];
+        for (size_t i = 0; i < direction->staged_count; i++) {
+            if (direction->count >= depth) {
+                gateway->stats.dropped[s]++;
+                continue;
+            }
+            direction->queue[(direction->head + direction->count) % depth] = direction->staged[i];
+            direction->count++;
+        }
+        direction->staged_count = 0;
+    }
+
+    for (int s = 0; s < GATEWAY_SEGMENT_COUNT; s++) {
+        bool wake_request = false;
+        tcan1463q1_simulator_get_flags(gateway->sims[s], NULL, &wake_request, NULL, NULL,
+                                       NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+        if (!wake_request || !low_power(gateway->sims[s])) continue;
+
+        // Woken on this segment: bring both transceivers to Normal
+        for (int t = 0; t < GATEWAY_SEGMENT_COUNT; t++) {
+            tcan1463q1_simulator_set_pin(gateway->sims[t], PIN_EN, PIN_STATE_HIGH, 3.3);
+            tcan1463q1_simulator_set_pin(gateway->sims[t], PIN_NSTB, PIN_STATE_HIGH, 3.3);
+        }
+
+        int other = 1 - s;
+        if (gateway->config.wake_forwarding &&
+            tcan1463q1_can_controller_send(gateway->controllers[other],
+                                           &gateway->config.wake_frame)) {
+            gateway->stats.wakeups_forwarded++;
+        }
+        break;
+    }
+}
+
+static void run_segment(Gateway* gateway, int segment, uint64_t until) {
+    CANNetwork* network = gateway->networks[segment];
+    uint64_t now = tcan1463q1_can_network_get_time_ns(network);
+    if (now >= until) return;
+
+    uint64_t bit = tcan1463q1_can_network_get_bit_time_ns(network);
+    tcan1463q1_can_network_run_bits(network, (until - now + bit - 1) / bit);
+}
+
+void tcan1463q1_gateway_run_for(Gateway* gateway, uint64_t duration_ns, unsigned threads) {
+    if (!gateway) return;
+
+    uint64_t end = gateway->time_ns + duration_ns;
+    while (gateway->time_ns < end) {
+        uint64_t until = gateway->time_ns + gateway->window_ns;
+        if (until > end) until = end;
+
+        if (threads >= 2) {
+            std::thread worker(run_segment, gateway, (int)GATEWAY_SEGMENT_B, until);
+            run_segment(gateway, GATEWAY_SEGMENT_A, until);
+            worker.join();
+        } else {
+            run_segment(gateway, GATEWAY_SEGMENT_A, until);
+            run_segment(gateway, GATEWAY_SEGMENT_B, until);
+        }
+
+        end_window(gateway);
+        gateway->time_ns = until;
+    }
+}
+
+void tcan1463q1_gateway_get_stats(const Gateway* gateway, GatewayStats* stats) {
+    if (!gateway || !stats) return;
+    *stats = gateway->stats;
+}
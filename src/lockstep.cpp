@@ -0,0 +1,357 @@
+#include "tcan1463q1_lockstep.h"
+#include "run_control_impl.h"
+#include "simulator_impl.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <stdarg.h>
+
+void tcan1463q1_lockstep_config_init(LockstepConfig* config) {
+    if (!config) return;
+
+    config->fast_step_ns = 0;
+    config->reference_step_ns = 1;
+    config->voltage_tolerance = 1e-9;
+    config->skip_quiescent = true;
+}
+
+bool tcan1463q1_lockstep_compare(const SimulatorObservableState* a,
+                                  const SimulatorObservableState* b,
+                                  double voltage_tolerance,
+                                  LockstepDifference* difference) {
+    if (!a || !b) return false;
+
+    LockstepDifference diff;
+    memset(&diff, 0, sizeof(diff));
+
+    diff.mode = (a->mode != b->mode);
+    diff.flags = a->flags ^ b->flags;
+    for (int i = 0; i < 14; i++) {
+        if (a->pin_states[i] != b->pin_states[i]) {
+            diff.pin_states |= 1u << i;
+        }
+        if (fabs(a->pin_voltages[i] - b->pin_voltages[i]) > voltage_tolerance) {
+            diff.pin_voltages |= 1u << i;
+        }
+    }
+
+    if (difference) *difference = diff;
+    return !diff.mode && diff.flags == 0 && diff.pin_states == 0 && diff.pin_voltages == 0;
+}
+
+/**
+ * Compare both simulators and record the first divergence
+ */
+static bool checkpoint(TCAN1463Q1Simulator* fast, TCAN1463Q1Simulator* reference,
+                       const LockstepConfig* config, LockstepResult* result) {
+    SimulatorObservableState fast_state, reference_state;
+    tcan1463q1_simulator_get_observable_state(fast, &fast_state);
+    tcan1463q1_simulator_get_observable_state(reference, &reference_state);
+    result->checkpoints++;
+
+    LockstepDifference difference;
+    if (tcan1463q1_lockstep_compare(&fast_state, &reference_state,
+                                    config->voltage_tolerance, &difference)) {
+        return true;
+    }
+
+    result->diverged = true;
+    result->difference = difference;
+    result->fast = fast_state;
+    result->reference = reference_state;
+    return false;
+}
+
+/**
+ * Advance the reference by duration_ns in reference steps (the last one
+ * may be shorter). Once a step leaves it settled, the steps up to the one
+ * reaching its next deadline are taken as a single step.
+ */
+static bool reference_catch_up(TCAN1463Q1Simulator* fast, TCAN1463Q1Simulator* reference,
+                               uint64_t duration_ns, const LockstepConfig* config,
+                               LockstepResult* result) {
+    uint64_t reference_step = config->reference_step_ns ? config->reference_step_ns : 1;
+    bool settled = false;
+
+    uint64_t remaining = duration_ns;
+    while (remaining > 0) {
+        if (run_control_cancelled(fast->run_control)) {
+            result->cancelled = true;
+            return false;
+        }
+
+        if (settled) {
+            // Whole steps that end before the deadline
+            uint64_t now = tcan1463q1_simulator_get_time_ns(reference);
+            uint64_t deadline = simulator_next_deadline_ns(reference);
+            uint64_t steps = 0;
+            if (deadline > now) {
+                steps = remaining / reference_step;
+                if ((deadline - now - 1) / reference_step < steps) {
+                    steps = (deadline - now - 1) / reference_step;
+                }
+            }
+            if (steps > 1) {
+                tcan1463q1_simulator_step(reference, steps * reference_step);
+                remaining -= steps * reference_step;
+                result->reference_steps += steps;
+                result->reference_skipped += steps - 1;
+                continue;
+            }
+        }
+
+        uint64_t step = remaining < reference_step ? remaining : reference_step;
+        if (config->skip_quiescent) {
+            settled = simulator_step_settled(reference, step);
+        } else {
+            tcan1463q1_simulator_step(reference, step);
+        }
+        remaining -= step;
+        result->reference_steps++;
+    }
+
+    return true;
+}
+
+bool tcan1463q1_lockstep_advance(TCAN1463Q1Simulator* fast,
+                                  TCAN1463Q1Simulator* reference,
+                                  uint64_t duration_ns,
+                                  const LockstepConfig* config,
+                                  LockstepResult* result) {
+    if (!fast || !reference || !result) return false;
+
+    LockstepConfig defaults;
+    if (!config) {
+        tcan1463q1_lockstep_config_init(&defaults);
+        config = &defaults;
+    }
+
+    uint64_t remaining = duration_ns;
+    while (remaining > 0) {
+        uint64_t chunk = remaining;
+        if (config->fast_step_ns && config->fast_step_ns < chunk) {
+            chunk = config->fast_step_ns;
+        }
+        remaining -= chunk;
+
+        tcan1463q1_simulator_step(fast, chunk);
+
+        // Reference catches up in fine steps
+        if (!reference_catch_up(fast, reference, chunk, config, result)) {
+            return false;
+        }
+
+        if (!checkpoint(fast, reference, config, result)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Elapsed time of a simulator, used to mirror WAIT_UNTIL on the reference
+ */
+static uint64_t sim_time(TCAN1463Q1Simulator* sim) {
+    SimulatorObservableState state;
+    tcan1463q1_simulator_get_observable_state(sim, &state);
+    return state.time_ns;
+}
+
+/**
+ * Run the stimulus of a scenario on both simulators; with checks, also
+ * evaluate check actions on the fast simulator and tally them as
+ * tcan1463q1_scenario_execute does
+ */
+static bool run_lockstep(Scenario* scenario, TCAN1463Q1Simulator* fast,
+                         TCAN1463Q1Simulator* reference, const LockstepConfig* config,
+                         ScenarioResult* checks, LockstepResult* result) {
+    LockstepConfig defaults;
+    if (!config) {
+        tcan1463q1_lockstep_config_init(&defaults);
+        config = &defaults;
+    }
+
+    bool ok = checkpoint(fast, reference, config, result);
+
+    for (size_t i = 0; ok && i < scenario->action_count; i++) {
+        const ScenarioAction* action = &scenario->actions[i];
+        result->action_index = i;
+        if (run_control_cancelled(fast->run_control)) {
+            result->cancelled = true;
+            ok = false;
+            break;
+        }
+
+        ScenarioResult step = {};
+        step.success = true;
+        switch (action->type) {
+            case ACTION_WAIT:
+                ok = tcan1463q1_lockstep_advance(fast, reference, action->data.wait.duration_ns,
+                                                 config, result);
+                break;
+
+            case ACTION_WAIT_UNTIL: {
+                uint64_t start = sim_time(fast);
+                if (!tcan1463q1_simulator_run_until(fast, action->data.wait_until.condition,
+                                                    action->data.wait_until.user_data,
+                                                    action->data.wait_until.timeout_ns)) {
+                    step.success = false;
+                    step.error_message = "Wait until condition timeout";
+                }
+                uint64_t elapsed = sim_time(fast) - start;
+
+                // Mirror the elapsed time on the reference, then compare
+                ok = reference_catch_up(fast, reference, elapsed, config, result) &&
+                     checkpoint(fast, reference, config, result);
+                break;
+            }
+
+            case ACTION_SET_PIN:
+            case ACTION_CONFIGURE:
+                // Apply the same stimulus to both simulators
+                scenario->current_action = i;
+                step = tcan1463q1_scenario_execute_step(scenario, fast);
+                scenario->current_action = i;
+                tcan1463q1_scenario_execute_step(scenario, reference);
+                ok = checkpoint(fast, reference, config, result);
+                break;
+
+            case ACTION_CHECK_PIN:
+            case ACTION_CHECK_MODE:
+            case ACTION_CHECK_FLAG:
+            case ACTION_COMMENT:
+                if (checks) {
+                    scenario->current_action = i;
+                    step = tcan1463q1_scenario_execute_step(scenario, fast);
+                }
+                break;
+        }
+
+        if (!checks || !ok) continue;
+        checks->actions_executed++;
+        if (step.success) {
+            checks->actions_passed++;
+            continue;
+        }
+        checks->actions_failed++;
+        checks->error_message = step.error_message;
+        checks->failed_action_index = i;
+        if (scenario->stop_on_error) break;
+    }
+
+    scenario->current_action = 0;
+    if (checks) {
+        if (result->cancelled) {
+            checks->success = false;
+            checks->cancelled = true;
+            checks->error_message = "Cancelled";
+            checks->failed_action_index = result->action_index;
+        } else if (result->diverged) {
+            checks->success = false;
+            checks->error_message = "Lockstep divergence";
+            checks->failed_action_index = result->action_index;
+        } else {
+            checks->success = (checks->actions_failed == 0);
+            tcan1463q1_run_control_add_run(fast->run_control);
+        }
+    }
+    return ok;
+}
+
+bool tcan1463q1_lockstep_run_scenario(Scenario* scenario,
+                                       TCAN1463Q1Simulator* fast,
+                                       TCAN1463Q1Simulator* reference,
+                                       const LockstepConfig* config,
+                                       LockstepResult* result) {
+    if (!result) return false;
+    memset(result, 0, sizeof(LockstepResult));
+    if (!scenario || !fast || !reference) return false;
+
+    return run_lockstep(scenario, fast, reference, config, NULL, result);
+}
+
+bool tcan1463q1_lockstep_execute_scenario(Scenario* scenario,
+                                           TCAN1463Q1Simulator* fast,
+                                           TCAN1463Q1Simulator* reference,
+                                           const LockstepConfig* config,
+                                           ScenarioResult* scenario_result,
+                                           LockstepResult* result) {
+    if (!result || !scenario_result) return false;
+    memset(result, 0, sizeof(LockstepResult));
+    memset(scenario_result, 0, sizeof(ScenarioResult));
+    if (!scenario || !fast || !reference) {
+        scenario_result->error_message = "Invalid scenario or simulator";
+        return false;
+    }
+
+    return run_lockstep(scenario, fast, reference, config, scenario_result, result);
+}
+
+static int append(char* buffer, size_t size, int length, const char* fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static int append(char* buffer, size_t size, int length, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    size_t offset = (size_t)length < size ? (size_t)length : size;
+    int n = vsnprintf(buffer ? buffer + offset : NULL, buffer ? size - offset : 0, fmt, args);
+    va_end(args);
+    return n < 0 ? length : length + n;
+}
+
+static int format_state(char* buffer, size_t size, int length, const char* label,
+                        const SimulatorObservableState* state,
+                        const LockstepDifference* difference) {
+    length = append(buffer, size, length, "  %-9s mode=%s%s flags=0x%03x%s\n", label,
+                    tcan1463q1_scenario_mode_name(state->mode), difference->mode ? "*" : "",
+                    state->flags, difference->flags ? "*" : "");
+    length = append(buffer, size, length, "           ");
+    for (int i = 0; i < 14; i++) {
+        bool differs = (difference->pin_states | difference->pin_voltages) & (1u << i);
+        length = append(buffer, size, length, " %s=%s/%.3fV%s",
+                        tcan1463q1_scenario_pin_name((PinType)i),
+                        tcan1463q1_scenario_pin_state_name(state->pin_states[i]),
+                        state->pin_voltages[i], differs ? "*" : "");
+        if (i == 6) {
+            length = append(buffer, size, length, "\n           ");
+        }
+    }
+    return append(buffer, size, length, "\n");
+}
+
+int tcan1463q1_lockstep_format(const LockstepResult* result, char* buffer, size_t size) {
+    if (!result) return 0;
+    if (buffer && size > 0) buffer[0] = '\0';
+
+    int length = 0;
+    if (result->cancelled && !result->diverged) {
+        return append(buffer, size, length,
+                      "Cancelled at action %zu (%llu checkpoints, %llu reference steps)\n",
+                      result->action_index + 1, (unsigned long long)result->checkpoints,
+                      (unsigned long long)result->reference_steps);
+    }
+    if (!result->diverged) {
+        return append(buffer, size, length,
+                      "No divergence (%llu checkpoints, %llu reference steps, %llu skipped)\n",
+                      (unsigned long long)result->checkpoints,
+                      (unsigned long long)result->reference_steps,
+                      (unsigned long long)result->reference_skipped);
+    }
+
+    length = append(buffer, size, length,
+                    "Divergence at t=%llu ns (action %zu, checkpoint %llu); * marks differences\n",
+                    (unsigned long long)result->fast.time_ns, result->action_index + 1,
+                    (unsigned long long)result->checkpoints);
+    length = format_state(buffer, size, length, "fast:", &result->fast, &result->difference);
+    return format_state(buffer, size, length, "reference:", &result->reference,
+                        &result->difference);
+}
+
+void tcan1463q1_lockstep_result_print(const LockstepResult* result) {
+    if (!result) return;
+
+    char buffer[2048];
+    tcan1463q1_lockstep_format(result, buffer, sizeof(buffer));
+    fputs(buffer, stdout);
+}
@@ -0,0 +1,285 @@
+#include "tcan1463q1_margin.h"
+#include "run_control_impl.h"
+#include "simulator_impl.h"
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+struct MarginContext {
+    const Scenario* scenario;
+    DeviceParams base;
+    DeviceVariant variant;
+    RunControl* run_control;
+};
+
+// One parameter being searched
+struct MarginSearch {
+    const MarginParam* param;
+    MarginResult* result;
+    double low_side;            // Closest value with the low end's outcome
+    double high_side;           // Closest value with the other outcome
+    bool done;
+    bool flipped;               // Outcome changed in the current round
+    SimulatorSnapshot* prefix;  // State before the first parameter-sensitive action
+};
+
+struct MarginPoint {
+    MarginSearch* search;
+    double value;
+    bool pass;
+};
+
+// Run fn(0..count-1) on up to jobs threads, the caller included
+template <typename Fn>
+static void for_each_parallel(size_t count, unsigned jobs, Fn fn) {
+    std::atomic<size_t> next(0);
+    auto run = [&]() {
+        for (size_t i = next++; i < count; i = next++) fn(i);
+    };
+
+    unsigned threads = jobs < count ? jobs : (unsigned)count;
+    std::vector<std::thread> pool;
+    for (unsigned k = 1; k < threads; k++) pool.emplace_back(run);
+    run();
+    for (std::thread& t : pool) t.join();
+}
+
+// Value the device model sees for a requested one (times round to ns)
+static bool effective_value(const MarginContext* ctx, const char* key, double value,
+                            double* effective) {
+    DeviceParams params = ctx->base;
+    return tcan1463q1_profile_set_param(&params, key, value) &&
+           tcan1463q1_profile_get_param(&params, key, effective);
+}
+
+// Simulator for one parameter value, NULL if the value is rejected
+static TCAN1463Q1Simulator* create_sim(const MarginContext* ctx, const char* key, double value) {
+    DeviceParams params = ctx->base;
+    if (!tcan1463q1_profile_set_param(&params, key, value)) return NULL;
+
+    DeviceProfile* profile = tcan1463q1_profile_create(key, ctx->variant, &params, NULL, 0);
+    if (!profile) return NULL;
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create_with_profile(profile);
+    tcan1463q1_profile_release(profile);
+    if (sim) tcan1463q1_simulator_set_run_control(sim, ctx->run_control);
+    return sim;
+}
+
+// Restore a prefix snapshot taken with another value of the parameter
+static void restore_prefix(TCAN1463Q1Simulator* sim, const SimulatorSnapshot* snapshot) {
+    // Restore refuses snapshots of other profiles; the prefix state does
+    // not depend on the parameter, so borrow the snapshot's profile
+    DeviceProfile* profile = sim->profile;
+    sim->profile = ((const TCAN1463Q1Simulator*)snapshot->data)->profile;
+    tcan1463q1_simulator_restore(sim, snapshot);
+    sim->profile = profile;
+}
+
+// Execute one action on a private cursor (scenarios are shared read-only)
+static bool run_action(const Scenario* scenario, size_t index, TCAN1463Q1Simulator* sim) {
+    Scenario cursor = *scenario;
+    cursor.current_action = index;
+    return tcan1463q1_scenario_execute_step(&cursor, sim).success;
+}
+
+static bool evaluate(const MarginContext* ctx, const MarginSearch* search, double value) {
+    TCAN1463Q1Simulator* sim = create_sim(ctx, search->param->key, value);
+    if (!sim) return false;
+
+    size_t first = 0;
+    if (search->prefix) {
+        restore_prefix(sim, search->prefix);
+        first = search->result->prefix_actions;
+    }
+
+    bool pass = true;
+    for (size_t i = first; i < ctx->scenario->action_count && pass; i++) {
+        if (run_control_cancelled(ctx->run_control)) break;
+        pass = run_action(ctx->scenario, i, sim);
+    }
+    tcan1463q1_run_control_add_run(ctx->run_control);
+    tcan1463q1_simulator_destroy(sim);
+    return pass;
+}
+
+/**
+ * Run both bracket ends side by side, noting their outcomes and keeping a
+ * snapshot from before the first action where they part. The whole state
+ * is compared, not only the observable one: a filter or timer the
+ * parameter drives (a WUP phase, UV filter progress) can differ while the
+ * pins and flags still agree.
+ */
+static void run_bracket(const MarginContext* ctx, MarginSearch* search, int prefix_actions) {
+    const Scenario* scenario = ctx->scenario;
+    MarginResult* result = search->result;
+    TCAN1463Q1Simulator* low = create_sim(ctx, search->param->key, search->low_side);
+    TCAN1463Q1Simulator* high = create_sim(ctx, search->param->key, search->high_side);
+    bool low_pass = low != NULL;
+    bool high_pass = high != NULL;
+    bool agree = low && high;
+
+    for (size_t i = 0; i < scenario->action_count && (low_pass || high_pass); i++) {
+        if (run_control_cancelled(ctx->run_control)) break;
+
+        bool take = prefix_actions < 0 ? agree : (agree && (size_t)prefix_actions == i);
+        if (take) {
+            tcan1463q1_simulator_snapshot_free(search->prefix);
+            search->prefix = tcan1463q1_simulator_snapshot(low);
+            result->prefix_actions = search->prefix ? i : 0;
+        }
+
+        if (low_pass) low_pass = run_action(scenario, i, low);
+        if (high_pass) high_pass = run_action(scenario, i, high);
+        if (agree && (low_pass != high_pass || !simulator_same_run_state(low, high))) agree = false;
+    }
+
+    tcan1463q1_run_control_add_run(ctx->run_control);
+    tcan1463q1_run_control_add_run(ctx->run_control);
+    tcan1463q1_simulator_destroy(low);
+    tcan1463q1_simulator_destroy(high);
+
+    result->evaluations = 2;
+    result->pass_at_low = low_pass;
+    result->found = low_pass != high_pass;
+    search->done = !result->found;
+}
+
+void tcan1463q1_margin_config_init(MarginConfig* config) {
+    if (!config) return;
+    config->base = NULL;
+    config->variant = DEVICE_VARIANT_TCAN1463Q1;
+    config->jobs = 0;
+    config->prefix_actions = -1;
+    config->run_control = NULL;
+}
+
+bool tcan1463q1_margin_find(const Scenario* scenario, const MarginConfig* config,
+                            const MarginParam* params, size_t count, MarginResult* results) {
+    if (!scenario || !params || !results) return false;
+
+    MarginConfig defaults;
+    if (!config) {
+        tcan1463q1_margin_config_init(&defaults);
+        config = &defaults;
+    }
+
+    MarginContext ctx;
+    ctx.scenario = scenario;
+    ctx.run_control = config->run_control;
+    if (config->base) {
+        ctx.base = *tcan1463q1_profile_get_params(config->base);
+        ctx.variant = tcan1463q1_profile_get_variant(config->base);
+    } else {
+        const DeviceParams* defaults_params = tcan1463q1_device_get_params(config->variant);
+        if (!defaults_params) return false;
+        ctx.base = *defaults_params;
+        ctx.variant = config->variant;
+    }
+    unsigned jobs = config->jobs ? config->jobs : std::thread::hardware_concurrency();
+    if (jobs == 0) jobs = 1;
+
+    std::vector<MarginSearch> searches(count);
+    for (size_t i = 0; i < count; i++) {
+        const MarginParam* param = &params[i];
+        MarginResult* result = &results[i];
+        memset(result, 0, sizeof(MarginResult));
+
+        MarginSearch* search = &searches[i];
+        search->param = param;
+        search->result = result;
+        search->done = false;
+        search->flipped = false;
+        search->prefix = NULL;
+        if (!(param->tolerance > 0.0) || !(param->low < param->high) ||
+            !tcan1463q1_profile_get_param(&ctx.base, param->key, &result->base_value) ||
+            !effective_value(&ctx, param->key, param->low, &search->low_side) ||
+            !effective_value(&ctx, param->key, param->high, &search->high_side)) {
+            return false;
+        }
+    }
+
+    for_each_parallel(count, jobs, [&](size_t i) {
+        run_bracket(&ctx, &searches[i], config->prefix_actions);
+    });
+
+    // Rounds of evenly spread points, the workers shared by the open searches
+    std::vector<MarginPoint> points;
+    while (!run_control_cancelled(ctx.run_control)) {
+        size_t open = 0;
+        for (MarginSearch& search : searches) {
+            if (fabs(search.high_side - search.low_side) <= search.param->tolerance) {
+                search.done = true;
+            }
+            if (!search.done) open++;
+        }
+        if (open == 0) break;
+
+        points.clear();
+        size_t per_search = jobs / open ? jobs / open : 1;
+        for (MarginSearch& search : searches) {
+            if (search.done) continue;
+            double width = search.high_side - search.low_side;
+            double previous = search.low_side;
+            for (size_t k = 1; k <= per_search; k++) {
+                double value;
+                effective_value(&ctx, search.param->key,
+                                search.low_side + width * (double)k / (double)(per_search + 1),
+                                &value);
+                // Rounded times can repeat or hit the ends
+                if (value == previous || value == search.high_side) continue;
+                points.push_back({&search, value, false});
+                previous = value;
+            }
+            // Nothing left between the ends
+            if (points.empty() || points.back().search != &search) search.done = true;
+            search.flipped = false;
+        }
+
+        for_each_parallel(points.size(), jobs, [&](size_t i) {
+            points[i].pass = evaluate(&ctx, points[i].search, points[i].value);
+        });
+
+        // Keep the interval around the first change of outcome
+        for (size_t i = 0; i < points.size(); i++) {
+            MarginSearch* search = points[i].search;
+            search->result->evaluations++;
+            if (search->flipped) continue;
+            if (points[i].pass == search->result->pass_at_low) {
+                search->low_side = points[i].value;
+            } else {
+                search->high_side = points[i].value;
+                search->flipped = true;
+            }
+        }
+    }
+
+    bool cancelled = run_control_cancelled(ctx.run_control);
+    for (MarginSearch& search : searches) {
+        MarginResult* result = search.result;
+        tcan1463q1_simulator_snapshot_free(search.prefix);
+        result->cancelled = cancelled;
+        if (!result->found) continue;
+        result->pass_value = result->pass_at_low ? search.low_side : search.high_side;
+        result->fail_value = result->pass_at_low ? search.high_side : search.low_side;
+        result->margin = result->pass_value - result->base_value;
+    }
+    return !cancelled;
+}
+
+void tcan1463q1_margin_print(const MarginParam* param, const MarginResult* result, FILE* out) {
+    if (!param || !result || !out) return;
+
+    fprintf(out, "%s: ", param->key);
+    if (result->cancelled) {
+        fprintf(out, "cancelled\n");
+    } else if (!result->found) {
+        fprintf(out, "no boundary in [%g, %g] (%s at both ends)\n", param->low, param->high,
+                result->pass_at_low ? "passes" : "fails");
+    } else {
+        fprintf(out, "passes at %g, fails at %g (base %g, margin %+g), %u runs, %zu shared actions\n",
+                result->pass_value, result->fail_value, result->base_value, result->margin,
+                result->evaluations, result->prefix_actions);
+    }
+}
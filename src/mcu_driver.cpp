@@ -0,0 +1,231 @@
+#include "tcan1463q1_mcu_driver.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_DEADLINE UINT64_MAX
+
+// Flag word bits (see tcan1463q1_simulator_get_flag_word)
+#define FLAG_WAKERQ     (1u << 1)
+#define FLAG_FAULTS     0xFF8u      // UVSUP..TSD
+#define FLAG_BUS_FAULTS 0x7C0u      // CBF, TXDCLP, TXDDTO, TXDRXD, CANDOM
+
+typedef enum {
+    IRQ_NFAULT,
+    IRQ_RXD,
+    IRQ_COUNT
+} DriverIrq;
+
+struct McuDriver {
+    TCAN1463Q1Simulator* sim;
+    McuDriverConfig config;
+    McuDriverState state;
+    uint64_t startup_at;
+    uint64_t idle_since;            // Last RXD edge
+    uint64_t irq_raised[IRQ_COUNT];
+    uint64_t irq_due[IRQ_COUNT];    // NO_DEADLINE when not pending
+    McuDriverStats stats;
+};
+
+void tcan1463q1_mcu_driver_config_init(McuDriverConfig* config) {
+    if (!config) return;
+
+    config->isr_latency_ns = 5000;
+    config->startup_delay_ns = 100000;
+    config->idle_timeout_ns = 50000000;
+    config->wake_on_rxd = true;
+    config->silent_on_fault = false;
+}
+
+static void raise_irq(McuDriver* driver, DriverIrq irq, uint64_t time_ns) {
+    if (driver->irq_due[irq] != NO_DEADLINE) return;   // Already pending
+    driver->irq_raised[irq] = time_ns;
+    driver->irq_due[irq] = time_ns + driver->config.isr_latency_ns;
+}
+
+/**
+ * Pin edges: the only way the driver learns about the transceiver
+ */
+static void on_pin_change(const SimulatorEvent* event, void* user_data) {
+    McuDriver* driver = (McuDriver*)user_data;
+    PinType pin = event->data.pin_change.pin;
+
+    if (pin == PIN_RXD) {
+        driver->idle_since = event->timestamp;
+        if (driver->state == MCU_DRIVER_SLEEP && driver->config.wake_on_rxd &&
+            event->data.pin_change.new_state == PIN_STATE_LOW) {
+            raise_irq(driver, IRQ_RXD, event->timestamp);
+        }
+    } else if (pin == PIN_NFAULT) {
+        raise_irq(driver, IRQ_NFAULT, event->timestamp);
+    }
+}
+
+McuDriver* tcan1463q1_mcu_driver_create(TCAN1463Q1Simulator* sim, const McuDriverConfig* config) {
+    if (!sim) return NULL;
+
+    McuDriver* driver = (McuDriver*)malloc(sizeof(McuDriver));
+    if (!driver) return NULL;
+
+    memset(driver, 0, sizeof(McuDriver));
+    driver->sim = sim;
+    if (config) {
+        driver->config = *config;
+    } else {
+        tcan1463q1_mcu_driver_config_init(&driver->config);
+    }
+    driver->state = MCU_DRIVER_STARTUP;
+    uint64_t now = tcan1463q1_simulator_get_time_ns(sim);
+    driver->startup_at = now + driver->config.startup_delay_ns;
+    driver->idle_since = now;
+    for (int i = 0; i < IRQ_COUNT; i++) driver->irq_due[i] = NO_DEADLINE;
+
+    // Bound: a clone of the simulator must not drive (or outlive) this driver
+    if (!tcan1463q1_simulator_register_bound_callback(sim, EVENT_PIN_CHANGE, on_pin_change,
+                                                      driver)) {
+        free(driver);
+        return NULL;
+    }
+    return driver;
+}
+
+void tcan1463q1_mcu_driver_destroy(McuDriver* driver) {
+    if (!driver) return;
+
+    tcan1463q1_simulator_unregister_callback(driver->sim, EVENT_PIN_CHANGE, on_pin_change);
+    free(driver);
+}
+
+static void set_control_pins(McuDriver* driver, bool en_high, bool nstb_high) {
+    tcan1463q1_simulator_set_pin(driver->sim, PIN_EN, en_high ? PIN_STATE_HIGH : PIN_STATE_LOW,
+                                 en_high ? 3.3 : 0.0);
+    tcan1463q1_simulator_set_pin(driver->sim, PIN_NSTB,
+                                 nstb_high ? PIN_STATE_HIGH : PIN_STATE_LOW,
+                                 nstb_high ? 3.3 : 0.0);
+}
+
+static void go_active(McuDriver* driver, uint64_t now) {
+    set_control_pins(driver, true, true);
+    driver->state = MCU_DRIVER_ACTIVE;
+    driver->idle_since = now;
+}
+
+/**
+ * Wake-up handling: only once the transceiver has accepted the wake-up
+ * (Standby); Sleep and Go-to-sleep cannot be left through the pins
+ */
+static void try_wake(McuDriver* driver, uint64_t now) {
+    if (tcan1463q1_simulator_get_mode(driver->sim) != MODE_STANDBY) return;
+
+    go_active(driver, now);
+    driver->stats.wakeups++;
+}
+
+static void handle_irq(McuDriver* driver, DriverIrq irq, uint64_t now) {
+    uint64_t latency = now - driver->irq_raised[irq];
+    driver->irq_due[irq] = NO_DEADLINE;
+    driver->stats.interrupts++;
+    if (latency > driver->stats.worst_latency_ns) driver->stats.worst_latency_ns = latency;
+
+    if (irq == IRQ_RXD) {
+        try_wake(driver, now);
+        return;
+    }
+
+    // nFAULT: read the flag register
+    uint32_t flags = tcan1463q1_simulator_get_flag_word(driver->sim);
+    driver->stats.flag_reads++;
+    driver->stats.last_flags = flags;
+    if (flags & FLAG_FAULTS) driver->stats.faults++;
+
+    if (driver->state == MCU_DRIVER_SLEEP) {
+        if (flags & FLAG_WAKERQ) try_wake(driver, now);
+    } else if (driver->state == MCU_DRIVER_ACTIVE && driver->config.silent_on_fault) {
+        set_control_pins(driver, (flags & FLAG_BUS_FAULTS) == 0, true);
+    }
+}
+
+uint64_t tcan1463q1_mcu_driver_next_deadline_ns(const McuDriver* driver) {
+    if (!driver) return NO_DEADLINE;
+
+    uint64_t deadline = NO_DEADLINE;
+    for (int i = 0; i < IRQ_COUNT; i++) {
+        if (driver->irq_due[i] < deadline) deadline = driver->irq_due[i];
+    }
+    if (driver->state == MCU_DRIVER_STARTUP && driver->startup_at < deadline) {
+        deadline = driver->startup_at;
+    }
+    if (driver->state == MCU_DRIVER_ACTIVE && driver->config.idle_timeout_ns > 0) {
+        uint64_t idle_at = driver->idle_since + driver->config.idle_timeout_ns;
+        if (idle_at < deadline) deadline = idle_at;
+    }
+    return deadline;
+}
+
+void tcan1463q1_mcu_driver_service(McuDriver* driver) {
+    if (!driver) return;
+
+    uint64_t now = tcan1463q1_simulator_get_time_ns(driver->sim);
+    while (tcan1463q1_mcu_driver_next_deadline_ns(driver) <= now) {
+        // Interrupts first, then timers
+        bool handled = false;
+        for (int i = 0; i < IRQ_COUNT && !handled; i++) {
+            if (driver->irq_due[i] <= now) {
+                handle_irq(driver, (DriverIrq)i, now);
+                handled = true;
+            }
+        }
+        if (handled) continue;
+
+        if (driver->state == MCU_DRIVER_STARTUP) {
+            go_active(driver, now);
+            continue;
+        }
+
+        // Idle timeout: sleep unless the bus is held dominant
+        PinState rxd;
+        double voltage;
+        tcan1463q1_simulator_get_pin(driver->sim, PIN_RXD, &rxd, &voltage);
+        if (rxd == PIN_STATE_LOW) {
+            driver->idle_since = now;
+            continue;
+        }
+        set_control_pins(driver, false, false);
+        driver->state = MCU_DRIVER_SLEEP;
+        driver->stats.sleeps++;
+    }
+}
+
+void tcan1463q1_mcu_driver_advance(McuDriver* driver, uint64_t duration_ns, uint64_t step_ns) {
+    if (!driver || step_ns == 0) return;
+
+    uint64_t now = tcan1463q1_simulator_get_time_ns(driver->sim);
+    uint64_t end = now + duration_ns;
+    tcan1463q1_mcu_driver_service(driver);
+    while (now < end) {
+        uint64_t until = end - now > step_ns ? now + step_ns : end;
+        uint64_t deadline = tcan1463q1_mcu_driver_next_deadline_ns(driver);
+        if (deadline > now && deadline < until) until = deadline;
+
+        tcan1463q1_simulator_step(driver->sim, until - now);
+        now = until;
+        tcan1463q1_mcu_driver_service(driver);
+    }
+}
+
+void tcan1463q1_mcu_driver_advance_all(McuDriver** drivers, size_t count,
+                                       uint64_t duration_ns, uint64_t step_ns) {
+    if (!drivers) return;
+
+    for (size_t i = 0; i < count; i++) {
+        tcan1463q1_mcu_driver_advance(drivers[i], duration_ns, step_ns);
+    }
+}
+
+McuDriverState tcan1463q1_mcu_driver_get_state(const McuDriver* driver) {
+    return driver ? driver->state : MCU_DRIVER_STARTUP;
+}
+
+void tcan1463q1_mcu_driver_get_stats(const McuDriver* driver, McuDriverStats* stats) {
+    if (!driver || !stats) return;
+    *stats = driver->stats;
+}
@@ -0,0 +1,454 @@
+#include "tcan1463q1_metrics.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define SOURCE_NAME_SIZE 64
+#define COUNTER_WORDS (sizeof(MetricsCounters) / sizeof(uint64_t))
+#define SOCKET_POLL_MS 100      // Longest wait for a socket client
+
+/**
+ * Published counters of one source (seqlock: odd sequence while writing)
+ */
+struct MetricsSlot {
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint64_t> words[COUNTER_WORDS];
+    char name[SOURCE_NAME_SIZE];
+
+    // Previous render, for rates (under render_mutex)
+    bool has_previous;
+    uint64_t previous_steps;
+    uint64_t previous_sim_ns;
+    int64_t previous_wall_ns;
+};
+
+struct MetricsExporter {
+    MetricsConfig config;
+    char* file_path;
+    char* socket_path;
+
+    MetricsSlot* slots;
+    std::atomic<size_t> source_count;
+    std::mutex add_mutex;
+
+    std::mutex render_mutex;
+    std::string last_text;      // Latest export, served to socket clients
+
+    std::thread thread;
+    std::mutex thread_mutex;
+    std::condition_variable wake;
+    bool running;
+    bool stop;
+    int listen_fd;
+};
+
+static_assert(sizeof(MetricsCounters) == COUNTER_WORDS * sizeof(uint64_t),
+              "MetricsCounters must be made of uint64_t words");
+
+static int64_t wall_ns(void) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static char* copy_string(const char* text) {
+    if (!text) return NULL;
+    size_t length = strlen(text) + 1;
+    char* copy = (char*)malloc(length);
+    if (copy) memcpy(copy, text, length);
+    return copy;
+}
+
+static void read_slot(MetricsSlot* slot, MetricsCounters* counters) {
+    uint64_t words[COUNTER_WORDS];
+    uint32_t before, after;
+    do {
+        before = slot->sequence.load(std::memory_order_acquire);
+        for (size_t i = 0; i < COUNTER_WORDS; i++) {
+            words[i] = slot->words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = slot->sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    memcpy(counters, words, sizeof(MetricsCounters));
+}
+
+// Process resident set size (0 if unknown)
+static uint64_t resident_bytes(void) {
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+    unsigned long long size = 0, resident = 0;
+    int fields = fscanf(file, "%llu %llu", &size, &resident);
+    fclose(file);
+    long page = sysconf(_SC_PAGESIZE);
+    return (fields == 2 && page > 0) ? (uint64_t)resident * (uint64_t)page : 0;
+}
+
+static void append(std::string* text, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void append(std::string* text, const char* format, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length <= 0) return;
+    text->append(line, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1);
+}
+
+typedef struct {
+    const char* name;
+    const char* type;
+    const char* help;
+} MetricInfo;
+
+enum {
+    METRIC_SIM_TIME,
+    METRIC_STEPS,
+    METRIC_EVENTS,
+    METRIC_FAULTS,
+    METRIC_QUEUE_DEPTH,
+    METRIC_MEMORY,
+    METRIC_STEP_RATE,
+    METRIC_SIM_WALL_RATIO,
+    METRIC_COUNT
+};
+
+static const MetricInfo metric_info[METRIC_COUNT] = {
+    {"tcan1463q1_sim_time_seconds_total", "counter", "Simulated time"},
+    {"tcan1463q1_steps_total", "counter", "Work items completed (steps, bits)"},
+    {"tcan1463q1_events_total", "counter", "Events handled"},
+    {"tcan1463q1_faults_total", "counter", "Faults and errors seen"},
+    {"tcan1463q1_queue_depth", "gauge", "Work items waiting"},
+    {"tcan1463q1_memory_bytes", "gauge", "Memory held by the source"},
+    {"tcan1463q1_steps_per_second", "gauge", "Steps per wall-clock second over the last interval"},
+    {"tcan1463q1_sim_wall_ratio", "gauge", "Simulated time per wall-clock time over the last interval"},
+};
+
+// Render all sources and advance the rate interval (caller holds render_mutex)
+static void render(MetricsExporter* exporter, std::string* text) {
+    size_t count = exporter->source_count.load(std::memory_order_acquire);
+    int64_t now = wall_ns();
+
+    // One consistent read per source, shared by all its lines
+    std::vector<double> values(count * METRIC_COUNT);
+    for (size_t i = 0; i < count; i++) {
+        MetricsSlot* slot = &exporter->slots[i];
+        MetricsCounters counters;
+        read_slot(slot, &counters);
+
+        double* v = &values[i * METRIC_COUNT];
+        v[METRIC_SIM_TIME] = (double)counters.sim_time_ns * 1e-9;
+        v[METRIC_STEPS] = (double)counters.steps;
+        v[METRIC_EVENTS] = (double)counters.events;
+        v[METRIC_FAULTS] = (double)counters.faults;
+        v[METRIC_QUEUE_DEPTH] = (double)counters.queue_depth;
+        v[METRIC_MEMORY] = (double)counters.memory_bytes;
+        v[METRIC_STEP_RATE] = 0.0;
+        v[METRIC_SIM_WALL_RATIO] = 0.0;
+        if (slot->has_previous && now > slot->previous_wall_ns) {
+            double wall_s = (double)(now - slot->previous_wall_ns) * 1e-9;
+            v[METRIC_STEP_RATE] = (double)(counters.steps - slot->previous_steps) / wall_s;
+            v[METRIC_SIM_WALL_RATIO] =
+                (double)(counters.sim_time_ns - slot->previous_sim_ns) * 1e-9 / wall_s;
+        }
+        slot->has_previous = true;
+        slot->previous_steps = counters.steps;
+        slot->previous_sim_ns = counters.sim_time_ns;
+        slot->previous_wall_ns = now;
+    }
+
+    text->clear();
+    for (int metric = 0; metric < METRIC_COUNT; metric++) {
+        const MetricInfo* info = &metric_info[metric];
+        append(text, "# HELP %s %s\n# TYPE %s %s\n", info->name, info->help, info->name,
+               info->type);
+        for (size_t i = 0; i < count; i++) {
+            append(text, "%s{source=\"%s\"} %.17g\n", info->name, exporter->slots[i].name,
+                   values[i * METRIC_COUNT + metric]);
+        }
+    }
+
+    uint64_t rss = resident_bytes();
+    if (rss) {
+        append(text, "# HELP tcan1463q1_process_resident_memory_bytes Resident memory\n"
+                     "# TYPE tcan1463q1_process_resident_memory_bytes gauge\n"
+                     "tcan1463q1_process_resident_memory_bytes %llu\n",
+               (unsigned long long)rss);
+    }
+}
+
+// Render into last_text and return a copy
+static std::string render_latest(MetricsExporter* exporter) {
+    std::lock_guard<std::mutex> lock(exporter->render_mutex);
+    render(exporter, &exporter->last_text);
+    return exporter->last_text;
+}
+
+static bool write_text_file(const char* path, const std::string& text) {
+    size_t length = strlen(path);
+    char* tmp_path = (char*)malloc(length + 5);
+    if (!tmp_path) return false;
+    memcpy(tmp_path, path, length);
+    memcpy(tmp_path + length, ".tmp", 5);
+
+    bool ok = false;
+    FILE* file = fopen(tmp_path, "w");
+    if (file) {
+        ok = fwrite(text.data(), 1, text.size(), file) == text.size();
+        ok = (fclose(file) == 0) && ok;
+        ok = ok && rename(tmp_path, path) == 0;
+        if (!ok) unlink(tmp_path);
+    }
+    free(tmp_path);
+    return ok;
+}
+
+static int open_socket(const char* path) {
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path)) return -1;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    unlink(path);
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 8) != 0 ||
+        fcntl(fd, F_SETFL, O_NONBLOCK) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Send the latest text to every waiting client
+static void serve_clients(MetricsExporter* exporter) {
+    for (;;) {
+        int client = accept(exporter->listen_fd, NULL, NULL);
+        if (client < 0) return;
+
+        // A stalled client must not hold up the exporter
+        struct timeval timeout = {1, 0};
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        std::string text;
+        {
+            std::lock_guard<std::mutex> lock(exporter->render_mutex);
+            text = exporter->last_text;
+        }
+        size_t sent = 0;
+        while (sent < text.size()) {
+            ssize_t n = send(client, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0 && errno != EINTR) break;
+            if (n > 0) sent += (size_t)n;
+        }
+        close(client);
+    }
+}
+
+static void export_once(MetricsExporter* exporter) {
+    std::string text = render_latest(exporter);
+    if (exporter->file_path) write_text_file(exporter->file_path, text);
+}
+
+static void exporter_thread(MetricsExporter* exporter) {
+    const auto interval = std::chrono::milliseconds(exporter->config.interval_ms);
+    auto next_export = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(exporter->thread_mutex);
+    while (!exporter->stop) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_export) {
+            lock.unlock();
+            export_once(exporter);
+            lock.lock();
+            next_export += interval;
+            if (next_export < now) next_export = now + interval;    // Fell behind
+            continue;
+        }
+        auto until = next_export;
+        if (exporter->listen_fd >= 0) {
+            auto poll_until = now + std::chrono::milliseconds(SOCKET_POLL_MS);
+            if (poll_until < until) until = poll_until;
+        }
+        exporter->wake.wait_until(lock, until);
+        if (exporter->listen_fd >= 0 && !exporter->stop) {
+            lock.unlock();
+            serve_clients(exporter);
+            lock.lock();
+        }
+    }
+}
+
+void tcan1463q1_metrics_config_init(MetricsConfig* config) {
+    if (!config) return;
+
+    memset(config, 0, sizeof(MetricsConfig));
+    config->interval_ms = 10000;
+    config->max_sources = 64;
+}
+
+MetricsExporter* tcan1463q1_metrics_create(const MetricsConfig* config) {
+    if (!config || config->interval_ms == 0 || config->max_sources == 0) return NULL;
+
+    MetricsExporter* exporter = new (std::nothrow) MetricsExporter();
+    if (!exporter) return NULL;
+    exporter->config = *config;
+    exporter->listen_fd = -1;
+    exporter->source_count.store(0);
+    exporter->slots = new (std::nothrow) MetricsSlot[config->max_sources]();
+    exporter->file_path = copy_string(config->file_path);
+    exporter->socket_path = copy_string(config->socket_path);
+    if (!exporter->slots || (config->file_path && !exporter->file_path) ||
+        (config->socket_path && !exporter->socket_path)) {
+        tcan1463q1_metrics_destroy(exporter);
+        return NULL;
+    }
+    exporter->config.file_path = exporter->file_path;
+    exporter->config.socket_path = exporter->socket_path;
+    return exporter;
+}
+
+void tcan1463q1_metrics_destroy(MetricsExporter* exporter) {
+    if (!exporter) return;
+
+    tcan1463q1_metrics_stop(exporter);
+    delete[] exporter->slots;
+    free(exporter->file_path);
+    free(exporter->socket_path);
+    delete exporter;
+}
+
+int tcan1463q1_metrics_add_source(MetricsExporter* exporter, const char* name) {
+    if (!exporter) return -1;
+
+    std::lock_guard<std::mutex> lock(exporter->add_mutex);
+    size_t index = exporter->source_count.load(std::memory_order_relaxed);
+    if (index >= exporter->config.max_sources) return -1;
+
+    MetricsSlot* slot = &exporter->slots[index];
+    size_t length = 0;
+    for (const char* c = name ? name : ""; *c && length < SOURCE_NAME_SIZE - 1; c++) {
+        bool allowed = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') ||
+                       (*c >= '0' && *c <= '9') || *c == '_' || *c == '-' || *c == '.';
+        slot->name[length++] = allowed ? *c : '_';
+    }
+    slot->name[length] = '\0';
+
+    // Readers only see the slot once it is initialized
+    exporter->source_count.store(index + 1, std::memory_order_release);
+    return (int)index;
+}
+
+void tcan1463q1_metrics_publish(MetricsExporter* exporter, int source,
+                                const MetricsCounters* counters) {
+    if (!exporter || !counters || source < 0 ||
+        (size_t)source >= exporter->source_count.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    MetricsSlot* slot = &exporter->slots[source];
+    uint64_t words[COUNTER_WORDS];
+    memcpy(words, counters, sizeof(MetricsCounters));
+
+    uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < COUNTER_WORDS; i++) {
+        slot->words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void tcan1463q1_metrics_publish_network(MetricsExporter* exporter, int source,
+                                        CANNetwork* network) {
+    if (!exporter || !network) return;
+
+    MetricsCounters counters;
+    memset(&counters, 0, sizeof(counters));
+    CANNetworkStats network_stats;
+    tcan1463q1_can_network_get_stats(network, &network_stats);
+    counters.sim_time_ns = tcan1463q1_can_network_get_time_ns(network);
+    counters.steps = network_stats.bits;
+
+    size_t nodes = tcan1463q1_can_network_node_count(network);
+    for (size_t i = 0; i < nodes; i++) {
+        CANController* controller = tcan1463q1_can_network_get_controller(network, i);
+        CANControllerStats stats;
+        tcan1463q1_can_controller_get_stats(controller, &stats);
+        counters.events += stats.tx_frames + stats.rx_frames;
+        for (int type = 0; type < CAN_ERROR_TYPE_COUNT; type++) {
+            counters.faults += stats.errors[type];
+        }
+        counters.queue_depth += tcan1463q1_can_controller_tx_pending(controller);
+    }
+    tcan1463q1_metrics_publish(exporter, source, &counters);
+}
+
+bool tcan1463q1_metrics_start(MetricsExporter* exporter) {
+    if (!exporter) return false;
+
+    std::lock_guard<std::mutex> lock(exporter->thread_mutex);
+    if (exporter->running) return false;
+    if (exporter->socket_path) {
+        exporter->listen_fd = open_socket(exporter->socket_path);
+        if (exporter->listen_fd < 0) return false;
+    }
+    exporter->stop = false;
+    exporter->running = true;
+    exporter->thread = std::thread(exporter_thread, exporter);
+    return true;
+}
+
+void tcan1463q1_metrics_stop(MetricsExporter* exporter) {
+    if (!exporter) return;
+
+    {
+        std::lock_guard<std::mutex> lock(exporter->thread_mutex);
+        if (!exporter->running) return;
+        exporter->stop = true;
+    }
+    exporter->wake.notify_all();
+    exporter->thread.join();
+
+    std::lock_guard<std::mutex> lock(exporter->thread_mutex);
+    exporter->running = false;
+    if (exporter->listen_fd >= 0) {
+        close(exporter->listen_fd);
+        exporter->listen_fd = -1;
+        unlink(exporter->socket_path);
+    }
+}
+
+size_t tcan1463q1_metrics_format(MetricsExporter* exporter, char* buffer, size_t size) {
+    if (!exporter) return 0;
+
+    std::string text = render_latest(exporter);
+    if (buffer && size > 0) {
+        size_t length = text.size() < size - 1 ? text.size() : size - 1;
+        memcpy(buffer, text.data(), length);
+        buffer[length] = '\0';
+    }
+    return text.size();
+}
+
+bool tcan1463q1_metrics_write_file(MetricsExporter* exporter) {
+    if (!exporter || !exporter->file_path) return false;
+
+    return write_text_file(exporter->file_path, render_latest(exporter));
+}
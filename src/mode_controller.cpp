@@ -1,12 +1,7 @@
 #include "mode_controller.h"
+#include "mode_controller_impl.h"
 #include <string.h>
 
-// Convert seconds to nanoseconds
-#define S_TO_NS(s) ((uint64_t)(s * 1000000000ULL))
-
-// tSILENCE timeout range (0.6-1.2s) - using minimum for conservative behavior
-#define TSILENCE_NS S_TO_NS(TSILENCE_MIN_S)
-
 /**
  * Mode transition table
  * Defines valid transitions between operating modes
@@ -82,53 +77,6 @@ bool mode_controller_can_transition(OperatingMode from, OperatingMode to) {
     return false;
 }
 
-/**
- * Determine target mode based on inputs
- * This implements the mode transition logic from the design document
- */
-static OperatingMode determine_target_mode(
-    OperatingMode current_mode,
-    bool en_high,
-    bool nstb_high,
-    bool vsup_valid,
-    bool wakerq_set,
-    uint64_t time_in_mode
-) {
-    // Priority 1: Power loss - always go to Off mode
-    if (!vsup_valid) {
-        return MODE_OFF;
-    }
-    
-    // Priority 2: Check for automatic transitions
-    // Go-to-sleep → Sleep after tSILENCE timeout
-    if (current_mode == MODE_GO_TO_SLEEP && time_in_mode >= TSILENCE_NS) {
-        return MODE_SLEEP;
-    }
-    
-    // Priority 3: Pin-based mode determination
-    if (nstb_high) {
-        // nSTB is high → Normal or Silent mode
-        if (en_high) {
-            return MODE_NORMAL;
-        } else {
-            return MODE_SILENT;
-        }
-    } else {
-        // nSTB is low → Standby, Go-to-sleep, or Sleep
-        if (wakerq_set) {
-            return MODE_STANDBY;
-        } else {
-            // WAKERQ is cleared
-            // If currently in Sleep, stay in Sleep
-            if (current_mode == MODE_SLEEP) {
-                return MODE_SLEEP;
-            }
-            // Otherwise, go to Go-to-sleep (transitional state)
-            return MODE_GO_TO_SLEEP;
-        }
-    }
-}
-
 OperatingMode mode_controller_update(
     ModeState* state,
     bool en_high,
@@ -137,36 +85,9 @@ OperatingMode mode_controller_update(
     bool wakerq_set,
     uint64_t current_time
 ) {
-    if (!state) return MODE_OFF;
-    
-    // Calculate time in current mode
-    uint64_t time_in_mode = 0;
-    if (current_time >= state->mode_entry_time) {
-        time_in_mode = current_time - state->mode_entry_time;
-    }
-    
-    // Determine target mode based on inputs
-    OperatingMode target_mode = determine_target_mode(
-        state->current_mode,
-        en_high,
-        nstb_high,
-        vsup_valid,
-        wakerq_set,
-        time_in_mode
+    return mode_controller_update_impl(
+        DefaultProfile(), state, en_high, nstb_high, vsup_valid, wakerq_set, current_time
     );
-    
-    // Check if transition is valid
-    if (target_mode != state->current_mode) {
-        if (mode_controller_can_transition(state->current_mode, target_mode)) {
-            // Valid transition - update state
-            state->previous_mode = state->current_mode;
-            state->current_mode = target_mode;
-            state->mode_entry_time = current_time;
-        }
-        // If transition is invalid, stay in current mode
-    }
-    
-    return state->current_mode;
 }
 
 OperatingMode mode_controller_get_mode(const ModeState* state) {
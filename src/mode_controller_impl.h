@@ -0,0 +1,103 @@
+#ifndef MODE_CONTROLLER_IMPL_H
+#define MODE_CONTROLLER_IMPL_H
+
+#include "mode_controller.h"
+#include "device_profiles.h"
+
+/**
+ * Profile-specialized mode controller logic
+ */
+
+/**
+ * Determine target mode based on inputs
+ * This implements the mode transition logic from the design document
+ */
+template <typename Profile>
+inline OperatingMode mode_controller_determine_target_mode(
+    const Profile& profile,
+    OperatingMode current_mode,
+    bool en_high,
+    bool nstb_high,
+    bool vsup_valid,
+    bool wakerq_set,
+    uint64_t time_in_mode
+) {
+    // Priority 1: Power loss - always go to Off mode
+    if (!vsup_valid) {
+        return MODE_OFF;
+    }
+    
+    // Priority 2: Check for automatic transitions
+    // Go-to-sleep → Sleep after tSILENCE timeout (minimum of the range)
+    if (current_mode == MODE_GO_TO_SLEEP && time_in_mode >= profile.params.tsilence.min_ns) {
+        return MODE_SLEEP;
+    }
+    
+    // Priority 3: Pin-based mode determination
+    if (nstb_high) {
+        // nSTB is high → Normal or Silent mode
+        if (en_high) {
+            return MODE_NORMAL;
+        } else {
+            return MODE_SILENT;
+        }
+    } else {
+        // nSTB is low → Standby, Go-to-sleep, or Sleep
+        if (wakerq_set) {
+            return MODE_STANDBY;
+        } else {
+            // WAKERQ is cleared
+            // If currently in Sleep, stay in Sleep
+            if (current_mode == MODE_SLEEP) {
+                return MODE_SLEEP;
+            }
+            // Otherwise, go to Go-to-sleep (transitional state)
+            return MODE_GO_TO_SLEEP;
+        }
+    }
+}
+
+template <typename Profile>
+inline OperatingMode mode_controller_update_impl(
+    const Profile& profile,
+    ModeState* state,
+    bool en_high,
+    bool nstb_high,
+    bool vsup_valid,
+    bool wakerq_set,
+    uint64_t current_time
+) {
+    if (!state) return MODE_OFF;
+    
+    // Calculate time in current mode
+    uint64_t time_in_mode = 0;
+    if (current_time >= state->mode_entry_time) {
+        time_in_mode = current_time - state->mode_entry_time;
+    }
+    
+    // Determine target mode based on inputs
+    OperatingMode target_mode = mode_controller_determine_target_mode(
+        profile,
+        state->current_mode,
+        en_high,
+        nstb_high,
+        vsup_valid,
+        wakerq_set,
+        time_in_mode
+    );
+    
+    // Check if transition is valid
+    if (target_mode != state->current_mode) {
+        if (mode_controller_can_transition(state->current_mode, target_mode)) {
+            // Valid transition - update state
+            state->previous_mode = state->current_mode;
+            state->current_mode = target_mode;
+            state->mode_entry_time = current_time;
+        }
+        // If transition is invalid, stay in current mode
+    }
+    
+    return state->current_mode;
+}
+
+#endif // MODE_CONTROLLER_IMPL_H
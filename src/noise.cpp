@@ -0,0 +1,197 @@
+#include "tcan1463q1_noise.h"
+#include "noise_impl.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NOISE_BLOCK 256         // Samples generated per refill
+#define NOISE_MAX_TAPS 4096     // Longest moving average / impulse
+
+// Stream keys: independent sequences per component
+#define STREAM_DIFFERENTIAL 0x6466666572656e74ULL
+#define STREAM_COMMON_MODE  0x636f6d6d6f6e6d64ULL
+#define STREAM_IMPULSE      0x696d70756c736573ULL
+
+struct NoiseSource {
+    NoiseConfig config;
+    uint64_t block_first;       // Index of diff[0] / cm[0]
+    bool valid;
+    double diff[NOISE_BLOCK];
+    double cm[NOISE_BLOCK];
+    double* scratch;            // Generator work space
+};
+
+// SplitMix64 finalizer
+static inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Counter-based generator: random word n of a stream
+static inline uint64_t counter_hash(uint64_t key, uint64_t n) {
+    return mix64(key + n * 0x9e3779b97f4a7c15ULL);
+}
+
+// Unit-variance approximate Gaussian: sum of the four 16-bit fields
+static inline double gauss_from_bits(uint64_t x) {
+    const double mean = 4.0 * 32767.5;
+    const double inv_sigma = 1.0 / sqrt(4.0 * (65536.0 * 65536.0 - 1.0) / 12.0);
+    uint64_t sum = (x & 0xffff) + ((x >> 16) & 0xffff) + ((x >> 32) & 0xffff) + (x >> 48);
+    return ((double)sum - mean) * inv_sigma;
+}
+
+static unsigned impulse_samples(const NoiseConfig* config) {
+    if (config->impulse_rate_hz <= 0.0 || config->impulse_amplitude_v == 0.0) return 0;
+    uint64_t samples = (config->impulse_width_ns + config->sample_period_ns - 1) /
+                       config->sample_period_ns;
+    return samples ? (unsigned)samples : 1;
+}
+
+static bool validate(const NoiseConfig* config) {
+    if (config->sample_period_ns == 0) return false;
+    if (config->bandwidth_taps == 0 || config->bandwidth_taps > NOISE_MAX_TAPS) return false;
+    if (!(config->differential_rms_v >= 0.0) || !(config->common_mode_rms_v >= 0.0)) return false;
+    if (!(config->impulse_rate_hz >= 0.0) || isnan(config->impulse_amplitude_v)) return false;
+    if (config->impulse_width_ns / config->sample_period_ns >= NOISE_MAX_TAPS) return false;
+    return true;
+}
+
+// Samples preceding a block that contribute to it
+static unsigned history(const NoiseConfig* config) {
+    unsigned taps = config->bandwidth_taps;
+    unsigned width = impulse_samples(config);
+    return (taps > width ? taps : width) - 1;
+}
+
+// Output sample i sums work[i + hist - k] for k < taps
+static void moving_sum(const double* work, unsigned hist, unsigned taps, size_t count,
+                       double* out) {
+    for (size_t i = 0; i < count; i++) out[i] = 0.0;
+    for (unsigned k = 0; k < taps; k++) {
+        const double* src = work + hist - k;
+        for (size_t i = 0; i < count; i++) out[i] += src[i];
+    }
+}
+
+/**
+ * Fill count samples from index first; scratch holds 2 * (count + history)
+ * doubles. Each output is a fixed-order sum over its own inputs, so a sample
+ * has the same value whatever block it is generated in.
+ */
+static void noise_fill(const NoiseConfig* config, uint64_t first, size_t count,
+                       double* differential, double* common_mode, double* scratch) {
+    unsigned taps = config->bandwidth_taps;
+    unsigned width = impulse_samples(config);
+    unsigned hist = history(config);
+    size_t n = count + hist;
+    uint64_t base = first - hist;
+    uint64_t seed_key = mix64(config->seed);
+    double* white = scratch;
+    double* impulses = scratch + n;
+
+    if (differential) {
+        uint64_t key = seed_key ^ STREAM_DIFFERENTIAL;
+        double scale = config->differential_rms_v / sqrt((double)taps);
+        for (size_t j = 0; j < n; j++) {
+            white[j] = scale * gauss_from_bits(counter_hash(key, base + j));
+        }
+        moving_sum(white, hist, taps, count, differential);
+
+        if (width) {
+            uint64_t key_imp = seed_key ^ STREAM_IMPULSE;
+            // Impulse starts with probability rate * period per sample
+            double p = config->impulse_rate_hz * (double)config->sample_period_ns * 1e-9;
+            uint64_t threshold = p >= 1.0 ? UINT64_MAX : (uint64_t)(p * 9007199254740992.0);
+            double amplitude = config->impulse_amplitude_v;
+            for (size_t j = 0; j < n; j++) {
+                uint64_t x = counter_hash(key_imp, base + j);
+                double start = (x >> 11) < threshold ? 1.0 : 0.0;
+                double sign = (x & 1) ? 1.0 : -1.0;
+                impulses[j] = start * sign * amplitude;
+            }
+            // Overlapping impulses add up
+            double* sums = white;
+            moving_sum(impulses, hist, width, count, sums);
+            for (size_t i = 0; i < count; i++) differential[i] += sums[i];
+        }
+    }
+
+    if (common_mode) {
+        uint64_t key = seed_key ^ STREAM_COMMON_MODE;
+        double scale = config->common_mode_rms_v / sqrt((double)taps);
+        for (size_t j = 0; j < n; j++) {
+            white[j] = scale * gauss_from_bits(counter_hash(key, base + j));
+        }
+        moving_sum(white, hist, taps, count, common_mode);
+    }
+}
+
+void tcan1463q1_noise_config_init(NoiseConfig* config) {
+    if (!config) return;
+
+    memset(config, 0, sizeof(NoiseConfig));
+    config->seed = 1;
+    config->sample_period_ns = 50;
+    config->bandwidth_taps = 1;
+    config->impulse_width_ns = 100;
+}
+
+bool tcan1463q1_noise_generate(const NoiseConfig* config, uint64_t first, size_t count,
+                               double* differential, double* common_mode) {
+    if (!config || !validate(config)) return false;
+    if (count == 0) return true;
+
+    double* scratch = (double*)malloc(2 * (count + history(config)) * sizeof(double));
+    if (!scratch) return false;
+    noise_fill(config, first, count, differential, common_mode, scratch);
+    free(scratch);
+    return true;
+}
+
+void noise_source_sample(NoiseSource* source, uint64_t time_ns, double* differential,
+                         double* common_mode) {
+    uint64_t index = time_ns / source->config.sample_period_ns;
+    if (!source->valid || index - source->block_first >= NOISE_BLOCK) {
+        // Blocks are aligned, so the sequence is independent of the step pattern
+        source->block_first = index - index % NOISE_BLOCK;
+        noise_fill(&source->config, source->block_first, NOISE_BLOCK, source->diff, source->cm,
+                   source->scratch);
+        source->valid = true;
+    }
+    *differential = source->diff[index - source->block_first];
+    *common_mode = source->cm[index - source->block_first];
+}
+
+void noise_source_destroy(NoiseSource* source) {
+    if (!source) return;
+    free(source->scratch);
+    free(source);
+}
+
+bool tcan1463q1_noise_attach(TCAN1463Q1Simulator* sim, const NoiseConfig* config) {
+    if (!sim || !config || !validate(config)) return false;
+
+    NoiseSource* source = (NoiseSource*)calloc(1, sizeof(NoiseSource));
+    if (!source) return false;
+    source->scratch = (double*)malloc(2 * (NOISE_BLOCK + history(config)) * sizeof(double));
+    if (!source->scratch) {
+        free(source);
+        return false;
+    }
+    source->config = *config;
+
+    noise_source_destroy(sim->noise);
+    sim->noise = source;
+    return true;
+}
+
+void tcan1463q1_noise_detach(TCAN1463Q1Simulator* sim) {
+    if (!sim) return;
+
+    noise_source_destroy(sim->noise);
+    sim->noise = NULL;
+}
@@ -0,0 +1,16 @@
+#ifndef NOISE_IMPL_H
+#define NOISE_IMPL_H
+
+#include "tcan1463q1_noise.h"
+
+/**
+ * Engine side of the bus noise (used by the simulation kernel)
+ */
+
+// Noise at a simulator time: differential and common-mode volts
+void noise_source_sample(NoiseSource* source, uint64_t time_ns, double* differential,
+                         double* common_mode);
+
+void noise_source_destroy(NoiseSource* source);
+
+#endif // NOISE_IMPL_H
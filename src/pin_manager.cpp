@@ -1,58 +1,36 @@
 #include "pin_manager.h"
+#include "voltage_impl.h"
 #include <string.h>
 
-// Pin voltage ranges based on TCAN1463-Q1 datasheet
-static const struct {
-    double min;
-    double max;
-} pin_voltage_ranges[14] = {
-    {0.0, 5.5},    // PIN_TXD - Digital input (VIO domain)
-    {0.0, 5.5},    // PIN_RXD - Digital output (VIO domain)
-    {0.0, 5.5},    // PIN_EN - Digital input (VIO domain)
-    {0.0, 5.5},    // PIN_NSTB - Digital input (VIO domain)
-    {0.0, 5.5},    // PIN_NFAULT - Digital output (VIO domain)
-    {0.0, 5.5},    // PIN_WAKE - Digital input (VIO domain)
-    {0.0, 42.0},   // PIN_INH - Output (VSUP domain, up to 42V)
-    {0.0, 5.5},    // PIN_INH_MASK - Digital input (VIO domain)
-    {-27.0, 42.0}, // PIN_CANH - Bidirectional analog (wide range)
-    {-27.0, 42.0}, // PIN_CANL - Bidirectional analog (wide range)
-    {4.5, 42.0},   // PIN_VSUP - Power supply (4.5V to 42V nominal)
-    {4.5, 5.5},    // PIN_VCC - Logic supply (5V nominal)
-    {1.65, 5.5},   // PIN_VIO - I/O supply (1.8V to 5V)
-    {0.0, 0.0}     // PIN_GND - Ground (always 0V)
+// Pin directions and voltage ranges based on TCAN1463-Q1 datasheet
+static const PinInfo pin_infos[14] = {
+    {true, false, 0.0, 5.5},      // PIN_TXD - Digital input (VIO domain)
+    {false, true, 0.0, 5.5},      // PIN_RXD - Digital output (VIO domain)
+    {true, false, 0.0, 5.5},      // PIN_EN - Digital input (VIO domain)
+    {true, false, 0.0, 5.5},      // PIN_NSTB - Digital input (VIO domain)
+    {false, true, 0.0, 5.5},      // PIN_NFAULT - Digital output (VIO domain)
+    {true, false, 0.0, 5.5},      // PIN_WAKE - Digital input (VIO domain)
+    {false, true, 0.0, 42.0},     // PIN_INH - Output (VSUP domain, up to 42V)
+    {true, false, 0.0, 5.5},      // PIN_INH_MASK - Digital input (VIO domain)
+    {true, true, -27.0, 42.0},    // PIN_CANH - Bidirectional analog (wide range)
+    {true, true, -27.0, 42.0},    // PIN_CANL - Bidirectional analog (wide range)
+    {true, false, 4.5, 42.0},     // PIN_VSUP - Power supply (4.5V to 42V nominal)
+    {true, false, 4.5, 5.5},      // PIN_VCC - Logic supply (5V nominal)
+    {true, false, 1.65, 5.5},     // PIN_VIO - I/O supply (1.8V to 5V)
+    {true, false, 0.0, 0.0}       // PIN_GND - Ground (always 0V)
 };
 
-// Pin direction configuration
-static const struct {
-    bool is_input;
-    bool is_output;
-} pin_directions[14] = {
-    {true, false},  // PIN_TXD - Input
-    {false, true},  // PIN_RXD - Output
-    {true, false},  // PIN_EN - Input
-    {true, false},  // PIN_NSTB - Input
-    {false, true},  // PIN_NFAULT - Output
-    {true, false},  // PIN_WAKE - Input
-    {false, true},  // PIN_INH - Output
-    {true, false},  // PIN_INH_MASK - Input
-    {true, true},   // PIN_CANH - Bidirectional
-    {true, true},   // PIN_CANL - Bidirectional
-    {true, false},  // PIN_VSUP - Power (input)
-    {true, false},  // PIN_VCC - Power (input)
-    {true, false},  // PIN_VIO - Power (input)
-    {true, false}   // PIN_GND - Ground (input)
-};
+const PinInfo* pin_manager_get_info(PinType type) {
+    if (type < 0 || type >= 14) return NULL;
+    return &pin_infos[type];
+}
 
-void pin_init(Pin* pin, PinType type, bool is_input, bool is_output,
-              double min_voltage, double max_voltage) {
+void pin_init(Pin* pin, const PinInfo* info) {
     if (!pin) return;
     
     pin->state = PIN_STATE_LOW;
     pin->voltage = 0.0;
-    pin->is_input = is_input;
-    pin->is_output = is_output;
-    pin->min_voltage = min_voltage;
-    pin->max_voltage = max_voltage;
+    pin->info = info;
 }
 
 bool pin_set_value(Pin* pin, PinState state, double voltage) {
@@ -64,7 +42,7 @@ bool pin_set_value(Pin* pin, PinState state, double voltage) {
     }
     
     pin->state = state;
-    pin->voltage = voltage;
+    pin->voltage = voltage_store(voltage);
     return true;
 }
 
@@ -90,7 +68,7 @@ bool pin_validate_voltage(const Pin* pin, double voltage) {
     }
     
     // Check if voltage is within valid range
-    if (voltage < pin->min_voltage || voltage > pin->max_voltage) {
+    if (voltage < pin->info->min_voltage || voltage > pin->info->max_voltage) {
         return false;
     }
     
@@ -102,12 +80,7 @@ void pin_manager_init(PinManager* manager) {
     
     // Initialize all pins with their properties
     for (int i = 0; i < 14; i++) {
-        pin_init(&manager->pins[i], 
-                (PinType)i,
-                pin_directions[i].is_input,
-                pin_directions[i].is_output,
-                pin_voltage_ranges[i].min,
-                pin_voltage_ranges[i].max);
+        pin_init(&manager->pins[i], &pin_infos[i]);
     }
     
     // Set default states
@@ -149,7 +122,7 @@ bool pin_manager_set_pin(PinManager* manager, PinType pin_type,
     Pin* pin = &manager->pins[pin_type];
     
     // Check if pin is an input (can be set externally)
-    if (!pin->is_input) {
+    if (!pin->info->is_input) {
         return false;  // Cannot set output-only pins
     }
     
@@ -183,19 +156,19 @@ bool pin_manager_get_pin_info(const PinManager* manager, PinType pin_type,
         return false;
     }
     
-    const Pin* pin = &manager->pins[pin_type];
+    const PinInfo* info = manager->pins[pin_type].info;
     
     if (is_input) {
-        *is_input = pin->is_input;
+        *is_input = info->is_input;
     }
     if (is_output) {
-        *is_output = pin->is_output;
+        *is_output = info->is_output;
     }
     if (min_voltage) {
-        *min_voltage = pin->min_voltage;
+        *min_voltage = info->min_voltage;
     }
     if (max_voltage) {
-        *max_voltage = pin->max_voltage;
+        *max_voltage = info->max_voltage;
     }
     
     return true;
@@ -0,0 +1,113 @@
+#ifndef POWER_MONITOR_IMPL_H
+#define POWER_MONITOR_IMPL_H
+
+#include "power_monitor.h"
+#include "device_profiles.h"
+#include "voltage_impl.h"
+
+/**
+ * Profile-specialized power monitor logic
+ */
+
+template <typename Profile>
+inline void power_monitor_update_impl(const Profile& profile, PowerState* state,
+                                      double vsup, double vcc, double vio,
+                                      uint64_t current_time) {
+    const DeviceParams& p = profile.params;
+
+    if (!state) return;
+    
+    // Store previous voltages for comparison
+    double prev_vcc = state->vcc;
+    double prev_vio = state->vio;
+    
+    // Store current voltages
+    state->vsup = vsup;
+    state->vcc = vcc;
+    state->vio = vio;
+    
+    // --- VSUP Monitoring ---
+    // VSUP has no filter time - immediate response
+    // Requirement 4.1: VSUP < UVSUP(F) sets flag and enters Off mode
+    // Requirement 4.4: VSUP > UVSUP(R) clears flag and sets PWRON
+    
+    // Hysteresis logic:
+    // - Falling threshold: p.uvsup_falling (3.5V)
+    // - Rising threshold: p.uvsup_rising (3.85V)
+    // - If flag is NOT set and voltage drops below falling threshold → set flag
+    // - If flag IS set and voltage rises above rising threshold → clear flag and set PWRON
+    // - Otherwise → maintain current state
+    
+    if (!state->uvsup_flag && voltage_key(vsup) <= voltage_key(p.uvsup_falling)) {
+        // Voltage dropped below or at falling threshold → set flag
+        state->uvsup_flag = true;
+    } else if (state->uvsup_flag && voltage_key(vsup) > voltage_key(p.uvsup_rising)) {
+        // Voltage rose above rising threshold → clear flag and set PWRON
+        state->uvsup_flag = false;
+        state->pwron_flag = true;
+    }
+    
+    // --- VCC Monitoring ---
+    // Requirement 4.2: VCC < UVCC(F) for t >= tUV sets flag
+    if (voltage_key(vcc) < voltage_key(p.uvcc_falling)) {
+        // Start timing if not already started
+        if (state->uvcc_start_time == UINT64_MAX) {
+            state->uvcc_start_time = current_time;
+        }
+        
+        // Check if filter time has elapsed
+        uint64_t elapsed_ns = current_time - state->uvcc_start_time;
+        uint64_t tuv_min_ns = p.tuv.min_ns;
+        
+        if (elapsed_ns >= tuv_min_ns && !state->uvcc_flag) {
+            state->uvcc_flag = true;
+        }
+    }
+    // Requirement 4.5: VCC > UVCC(R) clears flag
+    else if (voltage_key(vcc) > voltage_key(p.uvcc_rising)) {
+        if (state->uvcc_flag) {
+            state->uvcc_flag = false;
+        }
+        // Reset timing
+        state->uvcc_start_time = UINT64_MAX;
+    }
+    // Voltage is in hysteresis band - maintain current state but reset timer if rising
+    else {
+        if (voltage_key(vcc) > voltage_key(prev_vcc)) {  // Voltage is rising
+            state->uvcc_start_time = UINT64_MAX;
+        }
+    }
+    
+    // --- VIO Monitoring ---
+    // Requirement 4.3: VIO < UVIO(F) for t >= tUV sets flag
+    if (voltage_key(vio) < voltage_key(p.uvio_falling)) {
+        // Start timing if not already started (and current_time is not 0)
+        if (state->uvio_start_time == UINT64_MAX) {
+            state->uvio_start_time = current_time;
+        }
+        
+        // Check if filter time has elapsed
+        uint64_t elapsed_ns = current_time - state->uvio_start_time;
+        uint64_t tuv_min_ns = p.tuv.min_ns;
+        
+        if (elapsed_ns >= tuv_min_ns && !state->uvio_flag) {
+            state->uvio_flag = true;
+        }
+    }
+    // Requirement 4.6: VIO > UVIO(R) clears flag
+    else if (voltage_key(vio) > voltage_key(p.uvio_rising)) {
+        if (state->uvio_flag) {
+            state->uvio_flag = false;
+        }
+        // Reset timing
+        state->uvio_start_time = UINT64_MAX;
+    }
+    // Voltage is in hysteresis band - maintain current state but reset timer if rising
+    else {
+        if (voltage_key(vio) > voltage_key(prev_vio)) {  // Voltage is rising
+            state->uvio_start_time = UINT64_MAX;
+        }
+    }
+}
+
+#endif // POWER_MONITOR_IMPL_H
@@ -0,0 +1,141 @@
+#include "tcan1463q1_probe.h"
+#include "probe_impl.h"
+#include "device_profiles.h"
+#include "timing_engine.h"
+#include "can_transceiver_impl.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char* const signal_names[PROBE_SIGNAL_COUNT] = {
+    "time", "vdiff", "bus_state", "rxd", "driver_enabled", "mode", "wup_state",
+    "txd_dominant_ns", "bus_dominant_ns"
+};
+
+ProbeSet* tcan1463q1_probe_set_create(uint32_t stride, size_t capacity) {
+    if (stride == 0 || capacity == 0 || capacity % 64 != 0) return NULL;
+
+    ProbeSet* set = (ProbeSet*)calloc(1, sizeof(ProbeSet));
+    if (!set) return NULL;
+    set->stride = stride;
+    set->capacity = capacity;
+    tcan1463q1_probe_set_reset(set);
+    return set;
+}
+
+void tcan1463q1_probe_set_destroy(ProbeSet* set) {
+    free(set);
+}
+
+bool tcan1463q1_probe_set_add(ProbeSet* set, ProbeSignal signal, void* buffer) {
+    if (!set || signal < 0 || signal >= PROBE_SIGNAL_COUNT) return false;
+
+    set->buffers[signal] = buffer;
+    if (buffer) {
+        set->active |= 1u << signal;
+    } else {
+        set->active &= ~(1u << signal);
+    }
+    return true;
+}
+
+uint64_t tcan1463q1_probe_set_samples(const ProbeSet* set) {
+    return set ? set->samples : 0;
+}
+
+void tcan1463q1_probe_set_reset(ProbeSet* set) {
+    if (!set) return;
+    set->countdown = set->stride;
+    set->slot = 0;
+    set->samples = 0;
+}
+
+static inline void store_bit(void* buffer, size_t slot, bool value) {
+    uint64_t* word = (uint64_t*)buffer + slot / 64;
+    uint64_t mask = 1ull << (slot % 64);
+    *word = value ? (*word | mask) : (*word & ~mask);
+}
+
+// Elapsed time of a fault timer (start UINT64_MAX = not running)
+static inline uint64_t timer_elapsed(uint64_t start, uint64_t now) {
+    return start == UINT64_MAX || start > now ? 0 : now - start;
+}
+
+void tcan1463q1_probe_set_sample(ProbeSet* set, TCAN1463Q1Simulator* sim) {
+    if (!set || !sim) return;
+
+    size_t slot = set->slot;
+    uint64_t now = timing_engine_get_time(&sim->timing);
+    double vdiff = sim->pins[PIN_CANH].voltage - sim->pins[PIN_CANL].voltage;
+
+    for (int signal = 0; signal < PROBE_SIGNAL_COUNT; signal++) {
+        if (!(set->active & (1u << signal))) continue;
+        void* buffer = set->buffers[signal];
+
+        switch ((ProbeSignal)signal) {
+            case PROBE_TIME:
+                ((uint64_t*)buffer)[slot] = now;
+                break;
+            case PROBE_VDIFF:
+                ((double*)buffer)[slot] = vdiff;
+                break;
+            case PROBE_BUS_STATE: {
+                RuntimeProfile profile = {*tcan1463q1_simulator_get_device_params(sim)};
+                ((uint8_t*)buffer)[slot] = (uint8_t)can_transceiver_classify_bus_impl(
+                    profile, sim->pins[PIN_CANH].voltage, sim->pins[PIN_CANL].voltage);
+                break;
+            }
+            case PROBE_RXD:
+                store_bit(buffer, slot, sim->can_transceiver.rxd_output);
+                break;
+            case PROBE_DRIVER_ENABLED:
+                store_bit(buffer, slot, tcan1463q1_simulator_can_drive_bus(sim));
+                break;
+            case PROBE_MODE:
+                ((uint8_t*)buffer)[slot] = (uint8_t)sim->mode_state.current_mode;
+                break;
+            case PROBE_WUP_STATE:
+                ((uint8_t*)buffer)[slot] = (uint8_t)sim->wake_state.wup_state;
+                break;
+            case PROBE_TXD_DOMINANT_NS:
+                ((uint64_t*)buffer)[slot] = timer_elapsed(sim->fault_state.txd_dominant_start, now);
+                break;
+            case PROBE_BUS_DOMINANT_NS:
+                ((uint64_t*)buffer)[slot] = timer_elapsed(sim->fault_state.bus_dominant_start, now);
+                break;
+            default:
+                break;
+        }
+    }
+
+    set->samples++;
+    set->slot = (slot + 1 == set->capacity) ? 0 : slot + 1;
+}
+
+ProbeFormat tcan1463q1_probe_signal_format(ProbeSignal signal) {
+    switch (signal) {
+        case PROBE_VDIFF:
+            return PROBE_FORMAT_F64;
+        case PROBE_BUS_STATE:
+        case PROBE_MODE:
+        case PROBE_WUP_STATE:
+            return PROBE_FORMAT_U8;
+        case PROBE_RXD:
+        case PROBE_DRIVER_ENABLED:
+            return PROBE_FORMAT_BIT;
+        default:
+            return PROBE_FORMAT_U64;
+    }
+}
+
+const char* tcan1463q1_probe_signal_name(ProbeSignal signal) {
+    if (signal < 0 || signal >= PROBE_SIGNAL_COUNT) return "unknown";
+    return signal_names[signal];
+}
+
+bool tcan1463q1_probe_get_bit(const uint64_t* words, size_t index) {
+    return words && ((words[index / 64] >> (index % 64)) & 1);
+}
+
+void tcan1463q1_simulator_set_probes(TCAN1463Q1Simulator* sim, ProbeSet* set) {
+    if (sim) sim->probes = set;
+}
@@ -0,0 +1,27 @@
+#ifndef PROBE_IMPL_H
+#define PROBE_IMPL_H
+
+#include "tcan1463q1_probe.h"
+
+/**
+ * Probe set internals, the stride countdown is inlined into the step
+ */
+struct ProbeSet {
+    uint32_t stride;
+    uint32_t countdown;         // Steps until the next sample
+    size_t capacity;
+    size_t slot;                // Next ring slot (samples % capacity)
+    uint64_t samples;
+    uint32_t active;            // Probed signals, bit per ProbeSignal
+    void* buffers[PROBE_SIGNAL_COUNT];
+};
+
+// Count a simulator step, sampling every stride-th one
+inline void probe_set_step(ProbeSet* set, TCAN1463Q1Simulator* sim) {
+    if (--set->countdown == 0) {
+        set->countdown = set->stride;
+        tcan1463q1_probe_set_sample(set, sim);
+    }
+}
+
+#endif // PROBE_IMPL_H
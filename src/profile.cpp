@@ -0,0 +1,598 @@
+#include "tcan1463q1_profile.h"
+#include "tcan1463q1_scenario.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <ctype.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <mutex>
+
+// Maximum profile name length (including terminator)
+#define PROFILE_NAME_SIZE 64
+
+struct DeviceProfile {
+    DeviceParams params;
+    DeviceVariant variant;
+    char name[PROFILE_NAME_SIZE];
+    char* path;             // Cache key, NULL for uncached profiles
+    int refcount;           // Protected by cache_mutex
+    DeviceProfile* next;    // Cache list link
+};
+
+// Profile cache (keyed by resolved path)
+static std::mutex cache_mutex;
+static DeviceProfile* cache_head = NULL;
+
+/**
+ * Profile keys
+ */
+typedef enum {
+    FIELD_VALUE,    // double
+    FIELD_RANGE,    // TimingRangeNs
+    FIELD_TIME,     // uint64_t nanoseconds
+    FIELD_FEATURE   // bool
+} FieldKind;
+
+typedef struct {
+    const char* name;
+    FieldKind kind;
+    size_t offset;
+} ProfileField;
+
+#define FIELD(name, kind) { #name, kind, offsetof(DeviceParams, name) }
+
+static const ProfileField profile_fields[] = {
+    FIELD(uvsup_falling, FIELD_VALUE),
+    FIELD(uvsup_rising, FIELD_VALUE),
+    FIELD(uvcc_falling, FIELD_VALUE),
+    FIELD(uvcc_rising, FIELD_VALUE),
+    FIELD(uvio_falling, FIELD_VALUE),
+    FIELD(uvio_rising, FIELD_VALUE),
+    FIELD(vdiff_dominant, FIELD_VALUE),
+    FIELD(vdiff_recessive, FIELD_VALUE),
+    FIELD(canh_dominant, FIELD_VALUE),
+    FIELD(canl_dominant, FIELD_VALUE),
+    FIELD(canh_recessive, FIELD_VALUE),
+    FIELD(canl_recessive, FIELD_VALUE),
+    FIELD(bias_autonomous, FIELD_VALUE),
+    FIELD(inh_voltage_drop, FIELD_VALUE),
+    FIELD(tsd_celsius, FIELD_VALUE),
+    FIELD(tuv, FIELD_RANGE),
+    FIELD(ttxddto, FIELD_RANGE),
+    FIELD(tbusdom, FIELD_RANGE),
+    FIELD(twk_filter, FIELD_RANGE),
+    FIELD(twk_timeout, FIELD_RANGE),
+    FIELD(tsilence, FIELD_RANGE),
+    FIELD(tprop_loop1, FIELD_RANGE),
+    FIELD(tprop_loop2, FIELD_RANGE),
+    { "tinh_slp_stb", FIELD_TIME, offsetof(DeviceParams, tinh_slp_stb_ns) },
+    FIELD(isup_normal, FIELD_VALUE),
+    FIELD(isup_standby, FIELD_VALUE),
+    FIELD(isup_sleep, FIELD_VALUE),
+    FIELD(isup_bias, FIELD_VALUE),
+    FIELD(icc_recessive, FIELD_VALUE),
+    FIELD(icc_dominant, FIELD_VALUE),
+    FIELD(icc_silent, FIELD_VALUE),
+    FIELD(icc_low_power, FIELD_VALUE),
+    FIELD(iio_normal, FIELD_VALUE),
+    FIELD(iio_low_power, FIELD_VALUE),
+    FIELD(has_inh, FIELD_FEATURE),
+    FIELD(has_inh_mask, FIELD_FEATURE),
+    FIELD(has_wake, FIELD_FEATURE),
+};
+
+#undef FIELD
+
+static const int num_profile_fields = sizeof(profile_fields) / sizeof(ProfileField);
+
+static void set_error(char* error, size_t error_size, int line, const char* fmt, ...) {
+    if (!error || error_size == 0) return;
+
+    int prefix = snprintf(error, error_size, "%d: ", line);
+    if (prefix < 0 || (size_t)prefix >= error_size) return;
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(error + prefix, error_size - prefix, fmt, args);
+    va_end(args);
+}
+
+static char* trim(char* text) {
+    while (isspace((unsigned char)*text)) text++;
+    char* end = text + strlen(text);
+    while (end > text && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+    return text;
+}
+
+// Finite numbers only: strtod also accepts nan and inf
+static bool parse_double(const char* text, double* value) {
+    char* end = NULL;
+    *value = strtod(text, &end);
+    return end != text && *end == '\0' && isfinite(*value);
+}
+
+static bool parse_feature(const char* text, bool* value) {
+    if (strcasecmp(text, "yes") == 0 || strcmp(text, "1") == 0) {
+        *value = true;
+        return true;
+    }
+    if (strcasecmp(text, "no") == 0 || strcmp(text, "0") == 0) {
+        *value = false;
+        return true;
+    }
+    return false;
+}
+
+static bool lookup_variant(const char* name, DeviceVariant* variant) {
+    for (int i = 0; i < DEVICE_VARIANT_COUNT; i++) {
+        if (strcasecmp(tcan1463q1_device_variant_name((DeviceVariant)i), name) == 0) {
+            *variant = (DeviceVariant)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static const ProfileField* lookup_field(const char* name) {
+    for (int i = 0; i < num_profile_fields; i++) {
+        if (strcasecmp(profile_fields[i].name, name) == 0) {
+            return &profile_fields[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Parse one directive line (already trimmed, comments removed)
+ */
+static bool parse_line(DeviceProfile* profile, bool* seen_field, char* line, int line_no,
+                       char* error, size_t error_size) {
+    char* tokens[3];
+    int count = 0;
+    char* save = NULL;
+    for (char* tok = strtok_r(line, " \t", &save); tok; tok = strtok_r(NULL, " \t", &save)) {
+        if (count == 3) {
+            set_error(error, error_size, line_no, "too many values");
+            return false;
+        }
+        tokens[count++] = tok;
+    }
+    const char* key = tokens[0];
+
+    if (strcasecmp(key, "name") == 0) {
+        if (count != 2) {
+            set_error(error, error_size, line_no, "name expects one word");
+            return false;
+        }
+        snprintf(profile->name, sizeof(profile->name), "%s", tokens[1]);
+        return true;
+    }
+
+    if (strcasecmp(key, "base") == 0) {
+        // The base replaces all parameters, so it must come first
+        if (*seen_field) {
+            set_error(error, error_size, line_no, "base must precede parameters");
+            return false;
+        }
+        if (count != 2 || !lookup_variant(tokens[1], &profile->variant)) {
+            set_error(error, error_size, line_no, "unknown base variant '%s'",
+                      count > 1 ? tokens[1] : "");
+            return false;
+        }
+        profile->params = *tcan1463q1_device_get_params(profile->variant);
+        return true;
+    }
+
+    const ProfileField* field = lookup_field(key);
+    if (!field) {
+        set_error(error, error_size, line_no, "unknown parameter '%s'", key);
+        return false;
+    }
+    *seen_field = true;
+
+    char* target = (char*)&profile->params + field->offset;
+    switch (field->kind) {
+        case FIELD_VALUE:
+            if (count != 2 || !parse_double(tokens[1], (double*)target)) {
+                set_error(error, error_size, line_no, "%s expects a number", field->name);
+                return false;
+            }
+            break;
+
+        case FIELD_RANGE: {
+            TimingRangeNs* range = (TimingRangeNs*)target;
+            if (count < 2 ||
+                !tcan1463q1_scenario_parse_duration(tokens[1], &range->min_ns) ||
+                !tcan1463q1_scenario_parse_duration(tokens[count - 1], &range->max_ns)) {
+                set_error(error, error_size, line_no, "%s expects a time or min/max times",
+                          field->name);
+                return false;
+            }
+            break;
+        }
+
+        case FIELD_TIME:
+            if (count != 2 || !tcan1463q1_scenario_parse_duration(tokens[1], (uint64_t*)target)) {
+                set_error(error, error_size, line_no, "%s expects a time", field->name);
+                return false;
+            }
+            break;
+
+        case FIELD_FEATURE:
+            if (count != 2 || !parse_feature(tokens[1], (bool*)target)) {
+                set_error(error, error_size, line_no, "%s expects yes or no", field->name);
+                return false;
+            }
+            break;
+    }
+
+    return true;
+}
+
+static bool check(bool condition, char* error, size_t error_size, const char* message) {
+    if (!condition && error && error_size > 0) {
+        snprintf(error, error_size, "%s", message);
+    }
+    return condition;
+}
+
+bool tcan1463q1_profile_validate_params(const DeviceParams* params,
+                                         char* error, size_t error_size) {
+    if (!check(params != NULL, error, error_size, "no parameters")) return false;
+    const DeviceParams* p = params;
+
+    // Levels and currents must be numbers (the ordering checks below pass inf)
+    for (int i = 0; i < num_profile_fields; i++) {
+        const ProfileField* field = &profile_fields[i];
+        if (field->kind == FIELD_VALUE &&
+            !isfinite(*(const double*)((const char*)p + field->offset))) {
+            if (error && error_size > 0) snprintf(error, error_size, "%s must be finite", field->name);
+            return false;
+        }
+    }
+
+    // Undervoltage hysteresis: falling threshold below rising threshold
+    if (!check(p->uvsup_falling > 0.0 && p->uvsup_falling < p->uvsup_rising,
+               error, error_size, "uvsup_falling must be positive and below uvsup_rising") ||
+        !check(p->uvcc_falling > 0.0 && p->uvcc_falling < p->uvcc_rising,
+               error, error_size, "uvcc_falling must be positive and below uvcc_rising") ||
+        !check(p->uvio_falling > 0.0 && p->uvio_falling < p->uvio_rising,
+               error, error_size, "uvio_falling must be positive and below uvio_rising")) {
+        return false;
+    }
+
+    // Receiver and driver levels
+    if (!check(p->vdiff_recessive < p->vdiff_dominant,
+               error, error_size, "vdiff_recessive must be below vdiff_dominant") ||
+        !check(p->canh_dominant - p->canl_dominant >= p->vdiff_dominant,
+               error, error_size, "dominant driver levels do not reach vdiff_dominant") ||
+        !check(p->canh_recessive - p->canl_recessive <= p->vdiff_recessive,
+               error, error_size, "recessive driver levels exceed vdiff_recessive")) {
+        return false;
+    }
+
+    // Timing ranges
+    const struct {
+        const char* message;
+        TimingRangeNs range;
+    } ranges[] = {
+        {"tuv range is empty or zero", p->tuv},
+        {"ttxddto range is empty or zero", p->ttxddto},
+        {"tbusdom range is empty or zero", p->tbusdom},
+        {"twk_filter range is empty or zero", p->twk_filter},
+        {"twk_timeout range is empty or zero", p->twk_timeout},
+        {"tsilence range is empty or zero", p->tsilence},
+        {"tprop_loop1 range is empty or zero", p->tprop_loop1},
+        {"tprop_loop2 range is empty or zero", p->tprop_loop2},
+    };
+    for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++) {
+        if (!check(ranges[i].range.min_ns > 0 && ranges[i].range.min_ns <= ranges[i].range.max_ns,
+                   error, error_size, ranges[i].message)) {
+            return false;
+        }
+    }
+
+    // A wake-up pattern must fit inside the wake-up timeout
+    if (!check(3 * p->twk_filter.min_ns < p->twk_timeout.max_ns,
+               error, error_size, "twk_filter too long for twk_timeout")) {
+        return false;
+    }
+
+    // Supply currents
+    const double currents[] = {
+        p->isup_normal, p->isup_standby, p->isup_sleep, p->isup_bias,
+        p->icc_recessive, p->icc_dominant, p->icc_silent, p->icc_low_power,
+        p->iio_normal, p->iio_low_power,
+    };
+    for (size_t i = 0; i < sizeof(currents) / sizeof(currents[0]); i++) {
+        if (!check(currents[i] >= 0.0, error, error_size, "supply currents must not be negative")) {
+            return false;
+        }
+    }
+
+    // INH_MASK only makes sense with INH
+    return check(p->has_inh || !p->has_inh_mask,
+                 error, error_size, "has_inh_mask requires has_inh");
+}
+
+DeviceProfile* tcan1463q1_profile_parse(const char* text, char* error, size_t error_size) {
+    if (!text) {
+        set_error(error, error_size, 0, "no text");
+        return NULL;
+    }
+
+    DeviceProfile* profile = (DeviceProfile*)calloc(1, sizeof(DeviceProfile));
+    char* buffer = strdup(text);
+    if (!profile || !buffer) {
+        free(profile);
+        free(buffer);
+        set_error(error, error_size, 0, "out of memory");
+        return NULL;
+    }
+
+    profile->variant = DEVICE_VARIANT_TCAN1463Q1;
+    profile->params = *tcan1463q1_device_get_params(profile->variant);
+    profile->refcount = 1;
+
+    bool ok = true;
+    bool seen_field = false;
+    int line_no = 0;
+    char* cursor = buffer;
+    while (ok && cursor) {
+        char* line = cursor;
+        char* newline = strchr(cursor, '\n');
+        if (newline) {
+            *newline = '\0';
+            cursor = newline + 1;
+        } else {
+            cursor = NULL;
+        }
+        line_no++;
+
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        line = trim(line);
+        if (*line == '\0') continue;
+
+        ok = parse_line(profile, &seen_field, line, line_no, error, error_size);
+    }
+    free(buffer);
+
+    if (ok && !tcan1463q1_profile_validate_params(&profile->params, error, error_size)) {
+        ok = false;
+    }
+
+    if (!ok) {
+        free(profile);
+        return NULL;
+    }
+
+    return profile;
+}
+
+static char* read_file(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    char* text = NULL;
+    size_t length = 0;
+    size_t capacity = 0;
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        if (length + n + 1 > capacity) {
+            size_t new_capacity = capacity ? capacity * 2 : sizeof(chunk) * 2;
+            while (new_capacity < length + n + 1) new_capacity *= 2;
+            char* grown = (char*)realloc(text, new_capacity);
+            if (!grown) {
+                free(text);
+                fclose(file);
+                return NULL;
+            }
+            text = grown;
+            capacity = new_capacity;
+        }
+        memcpy(text + length, chunk, n);
+        length += n;
+    }
+    fclose(file);
+
+    if (!text) return strdup("");
+    text[length] = '\0';
+    return text;
+}
+
+DeviceProfile* tcan1463q1_profile_load(const char* path, char* error, size_t error_size) {
+    if (!path) {
+        set_error(error, error_size, 0, "no path");
+        return NULL;
+    }
+
+    // Resolve the path so different spellings share one cache entry
+    char resolved[PATH_MAX];
+    const char* key = realpath(path, resolved) ? resolved : path;
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        for (DeviceProfile* entry = cache_head; entry; entry = entry->next) {
+            if (strcmp(entry->path, key) == 0) {
+                entry->refcount++;
+                return entry;
+            }
+        }
+    }
+
+    char* text = read_file(path);
+    if (!text) {
+        set_error(error, error_size, 0, "cannot open '%s'", path);
+        return NULL;
+    }
+
+    DeviceProfile* profile = tcan1463q1_profile_parse(text, error, error_size);
+    free(text);
+    if (!profile) return NULL;
+
+    // Default the profile name to the file name
+    if (profile->name[0] == '\0') {
+        const char* base = strrchr(path, '/');
+        snprintf(profile->name, sizeof(profile->name), "%s", base ? base + 1 : path);
+    }
+
+    profile->path = strdup(key);
+    if (!profile->path) {
+        free(profile);
+        set_error(error, error_size, 0, "out of memory");
+        return NULL;
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    // Another thread may have loaded the same file meanwhile
+    for (DeviceProfile* entry = cache_head; entry; entry = entry->next) {
+        if (strcmp(entry->path, key) == 0) {
+            entry->refcount++;
+            free(profile->path);
+            free(profile);
+            return entry;
+        }
+    }
+
+    profile->next = cache_head;
+    cache_head = profile;
+    return profile;
+}
+
+DeviceProfile* tcan1463q1_profile_create(const char* name, DeviceVariant variant,
+                                          const DeviceParams* params,
+                                          char* error, size_t error_size) {
+    if (!params || !tcan1463q1_device_get_params(variant)) {
+        set_error(error, error_size, 0, "invalid parameters or variant");
+        return NULL;
+    }
+    if (!tcan1463q1_profile_validate_params(params, error, error_size)) return NULL;
+
+    DeviceProfile* profile = (DeviceProfile*)calloc(1, sizeof(DeviceProfile));
+    if (!profile) {
+        set_error(error, error_size, 0, "out of memory");
+        return NULL;
+    }
+    profile->params = *params;
+    profile->variant = variant;
+    profile->refcount = 1;
+    snprintf(profile->name, sizeof(profile->name), "%s", name ? name : "custom");
+    return profile;
+}
+
+bool tcan1463q1_profile_set_param(DeviceParams* params, const char* key, double value) {
+    const ProfileField* field = key ? lookup_field(key) : NULL;
+    if (!params || !field) return false;
+
+    char* target = (char*)params + field->offset;
+    switch (field->kind) {
+        case FIELD_VALUE:
+            if (!isfinite(value)) return false;
+            *(double*)target = value;
+            return true;
+
+        case FIELD_RANGE:
+        case FIELD_TIME: {
+            if (!(value >= 0.0) || value > (double)UINT64_MAX) return false;
+            uint64_t ns = (uint64_t)llround(value);
+            if (field->kind == FIELD_RANGE) {
+                ((TimingRangeNs*)target)->min_ns = ns;
+                ((TimingRangeNs*)target)->max_ns = ns;
+            } else {
+                *(uint64_t*)target = ns;
+            }
+            return true;
+        }
+
+        case FIELD_FEATURE:
+            break;
+    }
+    return false;
+}
+
+bool tcan1463q1_profile_get_param(const DeviceParams* params, const char* key, double* value) {
+    const ProfileField* field = key ? lookup_field(key) : NULL;
+    if (!params || !field || !value) return false;
+
+    const char* source = (const char*)params + field->offset;
+    switch (field->kind) {
+        case FIELD_VALUE:
+            *value = *(const double*)source;
+            return true;
+        case FIELD_RANGE:
+            *value = (double)((const TimingRangeNs*)source)->min_ns;
+            return true;
+        case FIELD_TIME:
+            *value = (double)*(const uint64_t*)source;
+            return true;
+        case FIELD_FEATURE:
+            break;
+    }
+    return false;
+}
+
+DeviceProfile* tcan1463q1_profile_acquire(DeviceProfile* profile) {
+    if (!profile) return NULL;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    profile->refcount++;
+    return profile;
+}
+
+void tcan1463q1_profile_release(DeviceProfile* profile) {
+    if (!profile) return;
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        if (--profile->refcount > 0) return;
+
+        // Evict from the cache
+        if (profile->path) {
+            DeviceProfile** current = &cache_head;
+            while (*current) {
+                if (*current == profile) {
+                    *current = profile->next;
+                    break;
+                }
+                current = &(*current)->next;
+            }
+        }
+    }
+
+    free(profile->path);
+    free(profile);
+}
+
+const DeviceParams* tcan1463q1_profile_get_params(const DeviceProfile* profile) {
+    if (!profile) return NULL;
+    return &profile->params;
+}
+
+const char* tcan1463q1_profile_get_name(const DeviceProfile* profile) {
+    if (!profile) return NULL;
+    return profile->name;
+}
+
+DeviceVariant tcan1463q1_profile_get_variant(const DeviceProfile* profile) {
+    if (!profile) return DEVICE_VARIANT_TCAN1463Q1;
+    return profile->variant;
+}
+
+size_t tcan1463q1_profile_cache_count(void) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    size_t count = 0;
+    for (DeviceProfile* entry = cache_head; entry; entry = entry->next) {
+        count++;
+    }
+    return count;
+}
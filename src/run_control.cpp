@@ -0,0 +1,54 @@
+#include "tcan1463q1_run_control.h"
+#include "run_control_impl.h"
+#include <new>
+
+static_assert(std::atomic<bool>::is_always_lock_free, "cancel must be async-signal-safe");
+
+RunControl* tcan1463q1_run_control_create(void) {
+    RunControl* control = new (std::nothrow) RunControl();
+    if (control) tcan1463q1_run_control_reset(control);
+    return control;
+}
+
+void tcan1463q1_run_control_destroy(RunControl* control) {
+    delete control;
+}
+
+void tcan1463q1_run_control_cancel(RunControl* control) {
+    if (control) control->cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool tcan1463q1_run_control_is_cancelled(const RunControl* control) {
+    return run_control_cancelled(control);
+}
+
+void tcan1463q1_run_control_reset(RunControl* control) {
+    if (!control) return;
+
+    control->cancelled.store(false, std::memory_order_relaxed);
+    control->sim_time_ns.store(0, std::memory_order_relaxed);
+    control->actions_completed.store(0, std::memory_order_relaxed);
+    control->runs_finished.store(0, std::memory_order_relaxed);
+}
+
+void tcan1463q1_run_control_get_progress(const RunControl* control, RunProgress* progress) {
+    if (!progress) return;
+
+    if (!control) {
+        progress->sim_time_ns = 0;
+        progress->actions_completed = 0;
+        progress->runs_finished = 0;
+        return;
+    }
+    progress->sim_time_ns = control->sim_time_ns.load(std::memory_order_relaxed);
+    progress->actions_completed = control->actions_completed.load(std::memory_order_relaxed);
+    progress->runs_finished = control->runs_finished.load(std::memory_order_relaxed);
+}
+
+void tcan1463q1_run_control_add_run(RunControl* control) {
+    if (control) control->runs_finished.fetch_add(1, std::memory_order_relaxed);
+}
+
+void tcan1463q1_simulator_set_run_control(TCAN1463Q1Simulator* sim, RunControl* control) {
+    if (sim) sim->run_control = control;
+}
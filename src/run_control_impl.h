@@ -0,0 +1,30 @@
+#ifndef RUN_CONTROL_IMPL_H
+#define RUN_CONTROL_IMPL_H
+
+#include "tcan1463q1_run_control.h"
+#include <atomic>
+
+/**
+ * Run control internals, inlined into the stepping loops
+ */
+struct RunControl {
+    std::atomic<bool> cancelled;
+    std::atomic<uint64_t> sim_time_ns;
+    std::atomic<uint64_t> actions_completed;
+    std::atomic<uint64_t> runs_finished;
+};
+
+// Cancellation check: a relaxed load, false without a control
+inline bool run_control_cancelled(const RunControl* control) {
+    return control && control->cancelled.load(std::memory_order_relaxed);
+}
+
+inline void run_control_add_time(RunControl* control, uint64_t ns) {
+    if (control && ns) control->sim_time_ns.fetch_add(ns, std::memory_order_relaxed);
+}
+
+inline void run_control_add_action(RunControl* control) {
+    if (control) control->actions_completed.fetch_add(1, std::memory_order_relaxed);
+}
+
+#endif // RUN_CONTROL_IMPL_H
@@ -1,4 +1,5 @@
 #include "tcan1463q1_scenario.h"
+#include "run_control_impl.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -205,6 +206,14 @@ bool tcan1463q1_scenario_add_comment(Scenario* scenario, const char* comment) {
     return true;
 }
 
+static ScenarioResult cancelled_result(ScenarioResult result, size_t action_index) {
+    result.success = false;
+    result.cancelled = true;
+    result.error_message = "Cancelled";
+    result.failed_action_index = action_index;
+    return result;
+}
+
 ScenarioResult tcan1463q1_scenario_execute(Scenario* scenario, TCAN1463Q1Simulator* sim) {
     ScenarioResult result = {0};
     
@@ -217,8 +226,17 @@ ScenarioResult tcan1463q1_scenario_execute(Scenario* scenario, TCAN1463Q1Simulat
     tcan1463q1_scenario_reset(scenario);
     
     for (size_t i = 0; i < scenario->action_count; i++) {
+        if (run_control_cancelled(sim->run_control)) {
+            return cancelled_result(result, i);
+        }
+        
         ScenarioResult step_result = tcan1463q1_scenario_execute_step(scenario, sim);
         
+        // A wait cut short by cancellation is not a failure of the scenario
+        if (!step_result.success && run_control_cancelled(sim->run_control)) {
+            return cancelled_result(result, i);
+        }
+        
         result.actions_executed++;
         
         if (step_result.success) {
@@ -230,12 +248,14 @@ ScenarioResult tcan1463q1_scenario_execute(Scenario* scenario, TCAN1463Q1Simulat
             
             if (scenario->stop_on_error) {
                 result.success = false;
+                tcan1463q1_run_control_add_run(sim->run_control);
                 return result;
             }
         }
     }
     
     result.success = (result.actions_failed == 0);
+    tcan1463q1_run_control_add_run(sim->run_control);
     return result;
 }
 
@@ -342,6 +362,7 @@ ScenarioResult tcan1463q1_scenario_execute_step(Scenario* scenario, TCAN1463Q1Si
         result.actions_passed = 0;
         result.actions_failed = 1;
     }
+    run_control_add_action(sim->run_control);
     
     return result;
 }
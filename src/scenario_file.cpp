@@ -0,0 +1,475 @@
+#include "tcan1463q1_scenario.h"
+#include "scenario_impl.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+
+// Maximum number of whitespace separated tokens on one action line
+#define MAX_TOKENS 16
+
+// Name tables (indexed by enum value)
+static const char* const pin_names[14] = {
+    "TXD", "RXD", "EN", "NSTB", "NFAULT", "WAKE", "INH",
+    "INH_MASK", "CANH", "CANL", "VSUP", "VCC", "VIO", "GND"
+};
+
+static const char* const pin_state_names[4] = {
+    "LOW", "HIGH", "HIGH_IMPEDANCE", "ANALOG"
+};
+
+static const char* const mode_names[6] = {
+    "NORMAL", "SILENT", "STANDBY", "GO_TO_SLEEP", "SLEEP", "OFF"
+};
+
+static const char* const flag_names[12] = {
+    "PWRON", "WAKERQ", "WAKESR", "UVSUP", "UVCC", "UVIO",
+    "CBF", "TXDCLP", "TXDDTO", "TXDRXD", "CANDOM", "TSD"
+};
+
+static int lookup_name(const char* const* names, int count, const char* name) {
+    if (!name) return -1;
+    for (int i = 0; i < count; i++) {
+        if (strcasecmp(names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char* tcan1463q1_scenario_pin_name(PinType pin) {
+    if (pin < 0 || pin >= 14) return NULL;
+    return pin_names[pin];
+}
+
+const char* tcan1463q1_scenario_pin_state_name(PinState state) {
+    if (state < 0 || state >= 4) return NULL;
+    return pin_state_names[state];
+}
+
+const char* tcan1463q1_scenario_mode_name(OperatingMode mode) {
+    if (mode < 0 || mode >= 6) return NULL;
+    return mode_names[mode];
+}
+
+const char* tcan1463q1_scenario_flag_name(FlagType flag) {
+    if (flag < 0 || flag >= 12) return NULL;
+    return flag_names[flag];
+}
+
+bool tcan1463q1_scenario_pin_from_name(const char* name, PinType* pin) {
+    int index = lookup_name(pin_names, 14, name);
+    if (index < 0 || !pin) return false;
+    *pin = (PinType)index;
+    return true;
+}
+
+bool tcan1463q1_scenario_pin_state_from_name(const char* name, PinState* state) {
+    int index = lookup_name(pin_state_names, 4, name);
+    if (index < 0 || !state) return false;
+    *state = (PinState)index;
+    return true;
+}
+
+bool tcan1463q1_scenario_mode_from_name(const char* name, OperatingMode* mode) {
+    int index = lookup_name(mode_names, 6, name);
+    if (index < 0 || !mode) return false;
+    *mode = (OperatingMode)index;
+    return true;
+}
+
+bool tcan1463q1_scenario_flag_from_name(const char* name, FlagType* flag) {
+    int index = lookup_name(flag_names, 12, name);
+    if (index < 0 || !flag) return false;
+    *flag = (FlagType)index;
+    return true;
+}
+
+bool tcan1463q1_scenario_parse_duration(const char* text, uint64_t* duration_ns) {
+    if (!text || !duration_ns) return false;
+
+    char* end = NULL;
+    double value = strtod(text, &end);
+    if (end == text || value < 0.0) return false;
+
+    double scale;
+    if (*end == '\0' || strcmp(end, "ns") == 0) {
+        scale = 1.0;
+    } else if (strcmp(end, "us") == 0) {
+        scale = 1e3;
+    } else if (strcmp(end, "ms") == 0) {
+        scale = 1e6;
+    } else if (strcmp(end, "s") == 0) {
+        scale = 1e9;
+    } else {
+        return false;
+    }
+
+    // Round to the nearest nanosecond so "0.5us" is exactly 500ns; reject
+    // inf, nan and anything past the uint64_t range
+    double ns = value * scale + 0.5;
+    if (!isfinite(ns) || ns >= 18446744073709551616.0) return false;
+    *duration_ns = (uint64_t)ns;
+    return true;
+}
+
+static bool parse_double(const char* text, double* value) {
+    if (!text) return false;
+    char* end = NULL;
+    *value = strtod(text, &end);
+    return end != text && *end == '\0';
+}
+
+static void set_error(char* error, size_t error_size, int line, const char* fmt, ...) {
+    if (!error || error_size == 0) return;
+
+    int prefix = snprintf(error, error_size, "%d: ", line);
+    if (prefix < 0 || (size_t)prefix >= error_size) return;
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(error + prefix, error_size - prefix, fmt, args);
+    va_end(args);
+}
+
+static char* trim(char* text) {
+    while (isspace((unsigned char)*text)) text++;
+    char* end = text + strlen(text);
+    while (end > text && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+    return text;
+}
+
+static void replace_string(const char** field, const char* value) {
+    if (*field) free((void*)*field);
+    *field = value ? strdup(value) : NULL;
+}
+
+// Template parameter sink, NULL for plain scenarios
+typedef struct {
+    ScenarioParamFn fn;
+    void* context;
+} ParamSink;
+
+/**
+ * Field filled by argument index of an action keyword
+ */
+static bool param_field(const char* keyword, int index, TemplateField* field) {
+    if (strcasecmp(keyword, "set_pin") == 0 || strcasecmp(keyword, "check_pin") == 0) {
+        bool is_check = (strcasecmp(keyword, "check_pin") == 0);
+        if (index == 1) *field = TEMPLATE_FIELD_STATE;
+        else if (index == 2) *field = TEMPLATE_FIELD_VOLTAGE;
+        else if (index == 3 && is_check) *field = TEMPLATE_FIELD_TOLERANCE;
+        else return false;
+        return true;
+    }
+    if (strcasecmp(keyword, "wait") == 0 && index == 0) {
+        *field = TEMPLATE_FIELD_DURATION;
+        return true;
+    }
+    if (strcasecmp(keyword, "configure") == 0 && index < 6) {
+        *field = (TemplateField)(TEMPLATE_FIELD_VSUP + index);
+        return true;
+    }
+    if (strcasecmp(keyword, "check_mode") == 0 && index == 0) {
+        *field = TEMPLATE_FIELD_MODE;
+        return true;
+    }
+    if (strcasecmp(keyword, "check_flag") == 0 && index == 1) {
+        *field = TEMPLATE_FIELD_FLAG_VALUE;
+        return true;
+    }
+    return false;
+}
+
+// Literal parsed in place of a parameter
+static const char* neutral_value(TemplateField field) {
+    switch (field) {
+        case TEMPLATE_FIELD_STATE: return "LOW";
+        case TEMPLATE_FIELD_MODE: return "NORMAL";
+        default: return "0";
+    }
+}
+
+/**
+ * Parse one action line (already trimmed, comments removed)
+ * Returns false and fills error on failure
+ */
+static bool parse_line(Scenario* scenario, char* line, int line_no, const ParamSink* params,
+                       char* error, size_t error_size) {
+    // Split off the optional " -- description" suffix
+    const char* description = NULL;
+    char* separator = strstr(line, " -- ");
+    if (separator) {
+        *separator = '\0';
+        description = trim(separator + 4);
+        line = trim(line);
+    }
+
+    // Keyword and the remainder of the line
+    char* rest = line;
+    while (*rest && !isspace((unsigned char)*rest)) rest++;
+    if (*rest) {
+        *rest++ = '\0';
+        rest = trim(rest);
+    }
+    const char* keyword = line;
+
+    // Free-text directives take the remainder verbatim
+    if (strcasecmp(keyword, "scenario") == 0) {
+        replace_string(&scenario->name, rest);
+        return true;
+    }
+    if (strcasecmp(keyword, "description") == 0) {
+        replace_string(&scenario->description, rest);
+        return true;
+    }
+    if (strcasecmp(keyword, "comment") == 0) {
+        return tcan1463q1_scenario_add_comment(scenario, rest);
+    }
+
+    // Tokenize arguments
+    char* tokens[MAX_TOKENS];
+    int count = 0;
+    char* save = NULL;
+    for (char* tok = strtok_r(rest, " \t", &save); tok; tok = strtok_r(NULL, " \t", &save)) {
+        if (count == MAX_TOKENS) {
+            set_error(error, error_size, line_no, "too many arguments");
+            return false;
+        }
+        tokens[count++] = tok;
+    }
+
+    // Template parameters: report the binding, parse a neutral value instead
+    for (int i = 0; params && i < count; i++) {
+        if (tokens[i][0] != '$') continue;
+        TemplateField field;
+        if (!param_field(keyword, i, &field)) {
+            set_error(error, error_size, line_no, "parameter '%s' not allowed here", tokens[i]);
+            return false;
+        }
+        if (tokens[i][1] == '\0' ||
+            !params->fn(params->context, scenario->action_count, field, tokens[i] + 1)) {
+            set_error(error, error_size, line_no, "invalid parameter '%s'", tokens[i]);
+            return false;
+        }
+        tokens[i] = (char*)neutral_value(field);
+    }
+
+    if (strcasecmp(keyword, "stop_on_error") == 0) {
+        if (count != 1) {
+            set_error(error, error_size, line_no, "stop_on_error expects yes or no");
+            return false;
+        }
+        if (strcasecmp(tokens[0], "yes") == 0 || strcmp(tokens[0], "1") == 0) {
+            scenario->stop_on_error = true;
+        } else if (strcasecmp(tokens[0], "no") == 0 || strcmp(tokens[0], "0") == 0) {
+            scenario->stop_on_error = false;
+        } else {
+            set_error(error, error_size, line_no, "stop_on_error expects yes or no");
+            return false;
+        }
+        return true;
+    }
+
+    if (strcasecmp(keyword, "configure") == 0) {
+        double values[6];
+        if (count != 6) {
+            set_error(error, error_size, line_no, "configure expects 6 values");
+            return false;
+        }
+        for (int i = 0; i < 6; i++) {
+            if (!parse_double(tokens[i], &values[i])) {
+                set_error(error, error_size, line_no, "invalid number '%s'", tokens[i]);
+                return false;
+            }
+        }
+        return tcan1463q1_scenario_add_configure(scenario, description,
+                                                 values[0], values[1], values[2],
+                                                 values[3], values[4], values[5]);
+    }
+
+    if (strcasecmp(keyword, "set_pin") == 0 || strcasecmp(keyword, "check_pin") == 0) {
+        bool is_check = (strcasecmp(keyword, "check_pin") == 0);
+        int max_args = is_check ? 4 : 3;
+        PinType pin;
+        PinState state;
+        double voltage = 0.0;
+        double tolerance = 0.0;
+
+        if (count < 2 || count > max_args) {
+            set_error(error, error_size, line_no, "%s expects PIN STATE [voltage%s]",
+                      keyword, is_check ? " [tolerance]" : "");
+            return false;
+        }
+        if (!tcan1463q1_scenario_pin_from_name(tokens[0], &pin)) {
+            set_error(error, error_size, line_no, "unknown pin '%s'", tokens[0]);
+            return false;
+        }
+        if (!tcan1463q1_scenario_pin_state_from_name(tokens[1], &state)) {
+            set_error(error, error_size, line_no, "unknown pin state '%s'", tokens[1]);
+            return false;
+        }
+        if (count > 2 && !parse_double(tokens[2], &voltage)) {
+            set_error(error, error_size, line_no, "invalid voltage '%s'", tokens[2]);
+            return false;
+        }
+        if (count > 3 && !parse_double(tokens[3], &tolerance)) {
+            set_error(error, error_size, line_no, "invalid tolerance '%s'", tokens[3]);
+            return false;
+        }
+
+        if (is_check) {
+            return tcan1463q1_scenario_add_check_pin(scenario, description, pin, state,
+                                                     voltage, tolerance);
+        }
+        return tcan1463q1_scenario_add_set_pin(scenario, description, pin, state, voltage);
+    }
+
+    if (strcasecmp(keyword, "wait") == 0) {
+        uint64_t duration_ns;
+        if (count != 1 || !tcan1463q1_scenario_parse_duration(tokens[0], &duration_ns)) {
+            set_error(error, error_size, line_no, "wait expects a duration (e.g. 200us)");
+            return false;
+        }
+        return tcan1463q1_scenario_add_wait(scenario, description, duration_ns);
+    }
+
+    if (strcasecmp(keyword, "check_mode") == 0) {
+        OperatingMode mode;
+        if (count != 1 || !tcan1463q1_scenario_mode_from_name(tokens[0], &mode)) {
+            set_error(error, error_size, line_no, "check_mode expects a mode name");
+            return false;
+        }
+        return tcan1463q1_scenario_add_check_mode(scenario, description, mode);
+    }
+
+    if (strcasecmp(keyword, "check_flag") == 0) {
+        FlagType flag;
+        if (count != 2 || !tcan1463q1_scenario_flag_from_name(tokens[0], &flag)) {
+            set_error(error, error_size, line_no, "check_flag expects FLAG 0|1");
+            return false;
+        }
+        if (strcmp(tokens[1], "0") != 0 && strcmp(tokens[1], "1") != 0) {
+            set_error(error, error_size, line_no, "check_flag value must be 0 or 1");
+            return false;
+        }
+        return tcan1463q1_scenario_add_check_flag(scenario, description, flag,
+                                                  tokens[1][0] == '1');
+    }
+
+    set_error(error, error_size, line_no, "unknown action '%s'", keyword);
+    return false;
+}
+
+Scenario* tcan1463q1_scenario_parse(const char* text, char* error, size_t error_size) {
+    return scenario_parse_with_params(text, NULL, NULL, error, error_size);
+}
+
+Scenario* scenario_parse_with_params(const char* text, ScenarioParamFn fn, void* context,
+                                     char* error, size_t error_size) {
+    ParamSink sink = {fn, context};
+    if (!text) {
+        set_error(error, error_size, 0, "no scenario text");
+        return NULL;
+    }
+
+    Scenario* scenario = tcan1463q1_scenario_create(NULL, NULL);
+    if (!scenario) {
+        set_error(error, error_size, 0, "out of memory");
+        return NULL;
+    }
+
+    // Work on a private copy so lines can be split in place
+    char* buffer = strdup(text);
+    if (!buffer) {
+        tcan1463q1_scenario_destroy(scenario);
+        set_error(error, error_size, 0, "out of memory");
+        return NULL;
+    }
+
+    int line_no = 0;
+    char* cursor = buffer;
+    bool ok = true;
+
+    while (ok && cursor) {
+        char* line = cursor;
+        char* newline = strchr(cursor, '\n');
+        if (newline) {
+            *newline = '\0';
+            cursor = newline + 1;
+        } else {
+            cursor = NULL;
+        }
+        line_no++;
+
+        line = trim(line);
+        if (*line == '\0' || *line == '#') {
+            continue;
+        }
+
+        ok = parse_line(scenario, line, line_no, fn ? &sink : NULL, error, error_size);
+    }
+
+    free(buffer);
+
+    if (!ok) {
+        tcan1463q1_scenario_destroy(scenario);
+        return NULL;
+    }
+
+    return scenario;
+}
+
+Scenario* tcan1463q1_scenario_load_file(const char* path, char* error, size_t error_size) {
+    if (!path) {
+        set_error(error, error_size, 0, "no path");
+        return NULL;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        set_error(error, error_size, 0, "cannot open '%s'", path);
+        return NULL;
+    }
+
+    // Read the whole file; scenario files are small
+    char* text = NULL;
+    size_t length = 0;
+    size_t capacity = 0;
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        if (length + n + 1 > capacity) {
+            size_t new_capacity = capacity ? capacity * 2 : sizeof(chunk) * 2;
+            while (new_capacity < length + n + 1) new_capacity *= 2;
+            char* grown = (char*)realloc(text, new_capacity);
+            if (!grown) {
+                free(text);
+                fclose(file);
+                set_error(error, error_size, 0, "out of memory");
+                return NULL;
+            }
+            text = grown;
+            capacity = new_capacity;
+        }
+        memcpy(text + length, chunk, n);
+        length += n;
+    }
+    fclose(file);
+    if (text) text[length] = '\0';
+
+    Scenario* scenario = tcan1463q1_scenario_parse(text ? text : "", error, error_size);
+    free(text);
+
+    // Default the scenario name to the file name
+    if (scenario && !scenario->name) {
+        const char* base = strrchr(path, '/');
+        replace_string(&scenario->name, base ? base + 1 : path);
+    }
+
+    return scenario;
+}
@@ -0,0 +1,20 @@
+#ifndef SCENARIO_IMPL_H
+#define SCENARIO_IMPL_H
+
+#include "tcan1463q1_template.h"
+
+/**
+ * Scenario file parsing with template parameters
+ *
+ * Every $name argument is reported with the index of the action it
+ * belongs to and the field it fills, and parsed as a neutral value in
+ * its place. Returning false fails the parse.
+ */
+typedef bool (*ScenarioParamFn)(void* context, size_t action_index, TemplateField field,
+                                 const char* name);
+
+// Without fn, $name arguments are invalid like any other bad value
+Scenario* scenario_parse_with_params(const char* text, ScenarioParamFn fn, void* context,
+                                     char* error, size_t error_size);
+
+#endif // SCENARIO_IMPL_H
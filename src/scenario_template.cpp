@@ -0,0 +1,360 @@
+#include "tcan1463q1_template.h"
+#include "tcan1463q1_run_control.h"
+#include "scenario_impl.h"
+#include "run_control_impl.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// One parameter field of one action
+typedef struct {
+    size_t action;
+    TemplateField field;
+    size_t param;
+} TemplateBinding;
+
+struct ScenarioTemplate {
+    const Scenario* scenario;
+    Scenario* owned;                // Parsed scenario, NULL when borrowed
+    char** params;                  // Parameter names
+    size_t param_count;
+    TemplateBinding* bindings;      // Sorted by action
+    size_t binding_count;
+};
+
+static int find_param(const ScenarioTemplate* tmpl, const char* name) {
+    for (size_t i = 0; i < tmpl->param_count; i++) {
+        if (strcmp(tmpl->params[i], name) == 0) return (int)i;
+    }
+    return -1;
+}
+
+static bool add_binding(ScenarioTemplate* tmpl, size_t action, TemplateField field,
+                        const char* name) {
+    int param = find_param(tmpl, name);
+    if (param < 0) {
+        char** params = (char**)realloc(tmpl->params, (tmpl->param_count + 1) * sizeof(char*));
+        if (!params) return false;
+        tmpl->params = params;
+        params[tmpl->param_count] = strdup(name);
+        if (!params[tmpl->param_count]) return false;
+        param = (int)tmpl->param_count++;
+    }
+
+    TemplateBinding* bindings = (TemplateBinding*)realloc(
+        tmpl->bindings, (tmpl->binding_count + 1) * sizeof(TemplateBinding));
+    if (!bindings) return false;
+    tmpl->bindings = bindings;
+
+    // Keep the action order (the parser appends in order)
+    size_t at = tmpl->binding_count;
+    while (at > 0 && bindings[at - 1].action > action) {
+        bindings[at] = bindings[at - 1];
+        at--;
+    }
+    bindings[at].action = action;
+    bindings[at].field = field;
+    bindings[at].param = (size_t)param;
+    tmpl->binding_count++;
+    return true;
+}
+
+static bool field_fits(ScenarioActionType type, TemplateField field) {
+    switch (field) {
+        case TEMPLATE_FIELD_VOLTAGE:
+        case TEMPLATE_FIELD_STATE:
+            return type == ACTION_SET_PIN || type == ACTION_CHECK_PIN;
+        case TEMPLATE_FIELD_TOLERANCE:
+            return type == ACTION_CHECK_PIN;
+        case TEMPLATE_FIELD_DURATION:
+            return type == ACTION_WAIT;
+        case TEMPLATE_FIELD_MODE:
+            return type == ACTION_CHECK_MODE;
+        case TEMPLATE_FIELD_FLAG_VALUE:
+            return type == ACTION_CHECK_FLAG;
+        case TEMPLATE_FIELD_VSUP:
+        case TEMPLATE_FIELD_VCC:
+        case TEMPLATE_FIELD_VIO:
+        case TEMPLATE_FIELD_TJ:
+        case TEMPLATE_FIELD_RL:
+        case TEMPLATE_FIELD_CL:
+            return type == ACTION_CONFIGURE;
+    }
+    return false;
+}
+
+// Write one parameter value into an action copy
+static bool apply_field(ScenarioAction* action, TemplateField field, double value) {
+    if (isnan(value)) return false;
+
+    switch (field) {
+        case TEMPLATE_FIELD_VOLTAGE:
+            if (action->type == ACTION_SET_PIN) action->data.set_pin.voltage = value;
+            else action->data.check_pin.expected_voltage = value;
+            return true;
+        case TEMPLATE_FIELD_STATE: {
+            if (value < PIN_STATE_LOW || value > PIN_STATE_ANALOG || value != floor(value)) {
+                return false;
+            }
+            if (action->type == ACTION_SET_PIN) action->data.set_pin.state = (PinState)value;
+            else action->data.check_pin.expected_state = (PinState)value;
+            return true;
+        }
+        case TEMPLATE_FIELD_TOLERANCE:
+            action->data.check_pin.voltage_tolerance = value;
+            return true;
+        case TEMPLATE_FIELD_DURATION:
+            if (value < 0.0 || value >= 18446744073709551616.0) return false;
+            action->data.wait.duration_ns = (uint64_t)(value + 0.5);
+            return true;
+        case TEMPLATE_FIELD_MODE:
+            if (value < MODE_NORMAL || value > MODE_OFF || value != floor(value)) return false;
+            action->data.check_mode.expected_mode = (OperatingMode)value;
+            return true;
+        case TEMPLATE_FIELD_FLAG_VALUE:
+            action->data.check_flag.expected_value = value != 0.0;
+            return true;
+        case TEMPLATE_FIELD_VSUP: action->data.configure.vsup = value; return true;
+        case TEMPLATE_FIELD_VCC: action->data.configure.vcc = value; return true;
+        case TEMPLATE_FIELD_VIO: action->data.configure.vio = value; return true;
+        case TEMPLATE_FIELD_TJ: action->data.configure.tj_temperature = value; return true;
+        case TEMPLATE_FIELD_RL: action->data.configure.rl_resistance = value; return true;
+        case TEMPLATE_FIELD_CL: action->data.configure.cl_capacitance = value; return true;
+    }
+    return false;
+}
+
+// First binding at or after an action
+static size_t first_binding(const ScenarioTemplate* tmpl, size_t action) {
+    size_t low = 0, high = tmpl->binding_count;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (tmpl->bindings[mid].action < action) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+// Expand an action whose bindings start at bindings[first]
+static bool expand(const ScenarioTemplate* tmpl, const double* row, size_t index,
+                   size_t first, ScenarioAction* action) {
+    *action = tmpl->scenario->actions[index];
+    bool ok = true;
+    for (size_t b = first; b < tmpl->binding_count && tmpl->bindings[b].action == index; b++) {
+        const TemplateBinding* binding = &tmpl->bindings[b];
+        if (!apply_field(action, binding->field, row[binding->param])) ok = false;
+    }
+    return ok;
+}
+
+ScenarioTemplate* tcan1463q1_template_create(const Scenario* scenario) {
+    if (!scenario) return NULL;
+
+    ScenarioTemplate* tmpl = (ScenarioTemplate*)calloc(1, sizeof(ScenarioTemplate));
+    if (!tmpl) return NULL;
+    tmpl->scenario = scenario;
+    return tmpl;
+}
+
+static bool parse_param(void* context, size_t action_index, TemplateField field,
+                        const char* name) {
+    return add_binding((ScenarioTemplate*)context, action_index, field, name);
+}
+
+ScenarioTemplate* tcan1463q1_template_parse(const char* text, char* error, size_t error_size) {
+    ScenarioTemplate* tmpl = (ScenarioTemplate*)calloc(1, sizeof(ScenarioTemplate));
+    if (!tmpl) return NULL;
+
+    tmpl->owned = scenario_parse_with_params(text, parse_param, tmpl, error, error_size);
+    if (!tmpl->owned) {
+        tcan1463q1_template_destroy(tmpl);
+        return NULL;
+    }
+    tmpl->scenario = tmpl->owned;
+    return tmpl;
+}
+
+void tcan1463q1_template_destroy(ScenarioTemplate* tmpl) {
+    if (!tmpl) return;
+
+    for (size_t i = 0; i < tmpl->param_count; i++) free(tmpl->params[i]);
+    free(tmpl->params);
+    free(tmpl->bindings);
+    tcan1463q1_scenario_destroy(tmpl->owned);
+    free(tmpl);
+}
+
+bool tcan1463q1_template_bind(ScenarioTemplate* tmpl, size_t action_index,
+                              TemplateField field, const char* name) {
+    if (!tmpl || !name || !*name || action_index >= tmpl->scenario->action_count) return false;
+    if (!field_fits(tmpl->scenario->actions[action_index].type, field)) return false;
+    return add_binding(tmpl, action_index, field, name);
+}
+
+const Scenario* tcan1463q1_template_get_scenario(const ScenarioTemplate* tmpl) {
+    return tmpl ? tmpl->scenario : NULL;
+}
+
+size_t tcan1463q1_template_param_count(const ScenarioTemplate* tmpl) {
+    return tmpl ? tmpl->param_count : 0;
+}
+
+const char* tcan1463q1_template_param_name(const ScenarioTemplate* tmpl, size_t index) {
+    if (!tmpl || index >= tmpl->param_count) return NULL;
+    return tmpl->params[index];
+}
+
+int tcan1463q1_template_param_index(const ScenarioTemplate* tmpl, const char* name) {
+    if (!tmpl || !name) return -1;
+    return find_param(tmpl, name);
+}
+
+bool tcan1463q1_template_expand_action(const ScenarioTemplate* tmpl, const double* row,
+                                       size_t action_index, ScenarioAction* action) {
+    if (!tmpl || !action || action_index >= tmpl->scenario->action_count) return false;
+    if (!row && tmpl->param_count > 0) return false;
+
+    return expand(tmpl, row, action_index, first_binding(tmpl, action_index), action);
+}
+
+static ScenarioResult cancelled_result(ScenarioResult result, size_t action_index) {
+    result.success = false;
+    result.cancelled = true;
+    result.error_message = "Cancelled";
+    result.failed_action_index = action_index;
+    return result;
+}
+
+ScenarioResult tcan1463q1_template_execute(const ScenarioTemplate* tmpl, const double* row,
+                                           TCAN1463Q1Simulator* sim) {
+    ScenarioResult result{};
+    if (!tcan1463q1_template_execute_lanes(tmpl, row, &sim, 1, &result)) {
+        result.success = false;
+        result.error_message = "Invalid template or simulator";
+    }
+    return result;
+}
+
+bool tcan1463q1_template_execute_lanes(const ScenarioTemplate* tmpl, const double* rows,
+                                       TCAN1463Q1Simulator* const* sims, size_t lanes,
+                                       ScenarioResult* results) {
+    if (!tmpl || !sims || !results || (!rows && tmpl->param_count > 0)) return false;
+    for (size_t lane = 0; lane < lanes; lane++) {
+        if (!sims[lane]) return false;
+    }
+
+    const Scenario* scenario = tmpl->scenario;
+    std::vector<bool> done(lanes, false);
+    memset(results, 0, lanes * sizeof(ScenarioResult));
+
+    // Bindings of action i start at begin for every lane
+    size_t cursor = 0;
+    for (size_t i = 0; i < scenario->action_count; i++) {
+        size_t begin = cursor;
+        while (cursor < tmpl->binding_count && tmpl->bindings[cursor].action == i) cursor++;
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+            if (done[lane]) continue;
+            TCAN1463Q1Simulator* sim = sims[lane];
+            ScenarioResult* result = &results[lane];
+            if (run_control_cancelled(sim->run_control)) {
+                *result = cancelled_result(*result, i);
+                done[lane] = true;
+                continue;
+            }
+
+            // A one-action scenario over the expanded copy
+            ScenarioAction action;
+            ScenarioResult step{};
+            if (expand(tmpl, rows + lane * tmpl->param_count, i, begin, &action)) {
+                Scenario cursor_scenario = *scenario;
+                cursor_scenario.actions = &action;
+                cursor_scenario.action_count = 1;
+                cursor_scenario.current_action = 0;
+                step = tcan1463q1_scenario_execute_step(&cursor_scenario, sim);
+            } else {
+                step.success = false;
+                step.error_message = "Invalid template parameter";
+            }
+
+            // A wait cut short by cancellation is not a failure of the instance
+            if (!step.success && run_control_cancelled(sim->run_control)) {
+                *result = cancelled_result(*result, i);
+                done[lane] = true;
+                continue;
+            }
+
+            result->actions_executed++;
+            if (step.success) {
+                result->actions_passed++;
+            } else {
+                result->actions_failed++;
+                result->error_message = step.error_message;
+                result->failed_action_index = i;
+                if (scenario->stop_on_error) {
+                    tcan1463q1_run_control_add_run(sim->run_control);
+                    done[lane] = true;
+                }
+            }
+        }
+    }
+
+    for (size_t lane = 0; lane < lanes; lane++) {
+        if (done[lane]) continue;
+        results[lane].success = (results[lane].actions_failed == 0);
+        tcan1463q1_run_control_add_run(sims[lane]->run_control);
+    }
+    return true;
+}
+
+bool tcan1463q1_template_run_table(const ScenarioTemplate* tmpl, const double* table,
+                                   size_t row_count, const TCAN1463Q1Simulator* initial,
+                                   size_t lanes, TemplateRowCallback callback, void* user_data) {
+    if (!tmpl || !callback || lanes == 0 || (!table && tmpl->param_count > 0 && row_count > 0)) {
+        return false;
+    }
+    if (lanes > row_count) lanes = row_count;
+    if (lanes == 0) return true;
+
+    TCAN1463Q1Simulator* fresh = NULL;
+    if (!initial) {
+        fresh = tcan1463q1_simulator_create();
+        if (!fresh) return false;
+        initial = fresh;
+    }
+
+    // Lanes are clones of the initial state, restored from one snapshot
+    std::vector<TCAN1463Q1Simulator*> sims(lanes, (TCAN1463Q1Simulator*)NULL);
+    std::vector<ScenarioResult> results(lanes);
+    SimulatorSnapshot* start = NULL;
+    bool ok = true;
+    for (size_t lane = 0; lane < lanes && ok; lane++) {
+        sims[lane] = tcan1463q1_simulator_clone(initial);
+        ok = sims[lane] != NULL;
+        if (ok) tcan1463q1_simulator_set_run_control(sims[lane], initial->run_control);
+    }
+    if (ok) {
+        start = tcan1463q1_simulator_snapshot(sims[0]);
+        ok = start != NULL;
+    }
+
+    for (size_t first = 0; ok && first < row_count; first += lanes) {
+        size_t batch = row_count - first < lanes ? row_count - first : lanes;
+        for (size_t lane = 0; lane < batch; lane++) {
+            if (first > 0) tcan1463q1_simulator_restore(sims[lane], start);
+        }
+        const double* rows = table ? table + first * tmpl->param_count : NULL;
+        tcan1463q1_template_execute_lanes(tmpl, rows, sims.data(), batch, results.data());
+
+        for (size_t lane = 0; lane < batch && ok; lane++) {
+            if (results[lane].cancelled) ok = false;
+            else ok = callback(first + lane, &results[lane], sims[lane], user_data);
+        }
+    }
+
+    tcan1463q1_simulator_snapshot_free(start);
+    for (TCAN1463Q1Simulator* sim : sims) tcan1463q1_simulator_destroy(sim);
+    tcan1463q1_simulator_destroy(fresh);
+    return ok;
+}
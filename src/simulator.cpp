@@ -8,14 +8,214 @@
 #include "bus_bias_controller.h"
 #include "timing_engine.h"
 #include "inh_controller.h"
+#include "supply_meter.h"
+#include "simulator_kernel.h"
+#include "stimulus_impl.h"
+#include "noise_impl.h"
+#include "run_control_impl.h"
+#include "probe_impl.h"
+#include "simulator_impl.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+// Step kernels, one specialization per device variant
+typedef void (*StepKernel)(TCAN1463Q1Simulator* sim, uint64_t delta_ns);
+
+template <typename Profile>
+static void step_variant(TCAN1463Q1Simulator* sim, uint64_t delta_ns) {
+    simulator_step_kernel(Profile(), sim, delta_ns);
+}
+
+static const StepKernel step_kernels[DEVICE_VARIANT_COUNT] = {
+    step_variant<TCAN1463Q1Profile>,
+    step_variant<TCAN1462Q1Profile>,
+};
+
+// Callback lists shared by a simulator and its clones
+struct EventCallbackTable {
+    std::atomic<int> refs;
+    EventCallbackEntry* lists[5];
+};
+
+static void callback_table_release(EventCallbackTable* table) {
+    if (!table || table->refs.fetch_sub(1, std::memory_order_acq_rel) > 1) return;
+    
+    for (int i = 0; i < 5; i++) {
+        EventCallbackEntry* entry = table->lists[i];
+        while (entry) {
+            EventCallbackEntry* next = entry->next;
+            free(entry);
+            entry = next;
+        }
+    }
+    delete table;
+}
+
+/**
+ * Private copy of a table (an empty one for NULL), in order; bound
+ * entries only if keep_bound
+ */
+static EventCallbackTable* callback_table_copy(const EventCallbackTable* shared, bool keep_bound) {
+    EventCallbackTable* table = new (std::nothrow) EventCallbackTable;
+    if (!table) return NULL;
+    table->refs.store(1, std::memory_order_relaxed);
+    memset(table->lists, 0, sizeof(table->lists));
+    
+    for (int i = 0; shared && i < 5; i++) {
+        EventCallbackEntry** tail = &table->lists[i];
+        for (const EventCallbackEntry* entry = shared->lists[i]; entry; entry = entry->next) {
+            if (entry->bound && !keep_bound) continue;
+            EventCallbackEntry* copy = (EventCallbackEntry*)malloc(sizeof(EventCallbackEntry));
+            if (!copy) {
+                callback_table_release(table);
+                return NULL;
+            }
+            *copy = *entry;
+            copy->next = NULL;
+            *tail = copy;
+            tail = &copy->next;
+        }
+    }
+    return table;
+}
+
+static bool callback_table_has_bound(const EventCallbackTable* table) {
+    for (int i = 0; table && i < 5; i++) {
+        for (const EventCallbackEntry* entry = table->lists[i]; entry; entry = entry->next) {
+            if (entry->bound) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * The simulator's table, made private first if it is shared (or created)
+ */
+static EventCallbackTable* callback_table_own(TCAN1463Q1Simulator* sim) {
+    EventCallbackTable* shared = sim->callbacks;
+    if (shared && shared->refs.load(std::memory_order_acquire) == 1) return shared;
+    
+    EventCallbackTable* table = callback_table_copy(shared, true);
+    if (!table) return NULL;
+    
+    callback_table_release(shared);
+    sim->callbacks = table;
+    return table;
+}
+
+// Configuration blocks, interned: one block per distinct configuration
+struct ConfigBlock {
+    SimulatorConfig config;     // First member: simulators point here
+    int refcount;               // Protected by config_mutex
+    ConfigBlock* next;          // Intern list link
+};
+
+// Defaults (middle of the valid timing ranges), never counted or freed
+static const ConfigBlock default_config = {
+    {
+        25.0, 60.0, 100e-12,
+        {
+            (TUV_MIN_MS + TUV_MAX_MS) / 2.0,
+            (TTXDDTO_MIN_MS + TTXDDTO_MAX_MS) / 2.0,
+            (TBUSDOM_MIN_MS + TBUSDOM_MAX_MS) / 2.0,
+            (TWK_FILTER_MIN_US + TWK_FILTER_MAX_US) / 2.0,
+            (TWK_TIMEOUT_MIN_MS + TWK_TIMEOUT_MAX_MS) / 2.0,
+            (TSILENCE_MIN_S + TSILENCE_MAX_S) / 2.0,
+        },
+    },
+    0, NULL
+};
+
+static std::mutex config_mutex;
+static ConfigBlock* config_head = NULL;
+
+static const SimulatorConfig* config_acquire(const SimulatorConfig* config) {
+    if (!config || config == &default_config.config) return config;
+    
+    std::lock_guard<std::mutex> lock(config_mutex);
+    ((ConfigBlock*)config)->refcount++;
+    return config;
+}
+
+static void config_release(const SimulatorConfig* config) {
+    if (!config || config == &default_config.config) return;
+    
+    ConfigBlock* block = (ConfigBlock*)config;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex);
+        if (--block->refcount > 0) return;
+        for (ConfigBlock** link = &config_head; *link; link = &(*link)->next) {
+            if (*link == block) {
+                *link = block->next;
+                break;
+            }
+        }
+    }
+    free(block);
+}
+
+/**
+ * Point the simulator at the block holding config, creating it only if
+ * no simulator uses that configuration yet
+ */
+static bool config_switch(TCAN1463Q1Simulator* sim, const SimulatorConfig* config) {
+    if (memcmp(sim->config, config, sizeof(SimulatorConfig)) == 0) return true;
+    
+    const SimulatorConfig* block = NULL;
+    if (memcmp(&default_config.config, config, sizeof(SimulatorConfig)) == 0) {
+        block = &default_config.config;
+    } else {
+        std::lock_guard<std::mutex> lock(config_mutex);
+        for (ConfigBlock* entry = config_head; entry; entry = entry->next) {
+            if (memcmp(&entry->config, config, sizeof(SimulatorConfig)) == 0) {
+                entry->refcount++;
+                block = &entry->config;
+                break;
+            }
+        }
+        if (!block) {
+            ConfigBlock* entry = (ConfigBlock*)malloc(sizeof(ConfigBlock));
+            if (!entry) return false;
+            entry->config = *config;
+            entry->refcount = 1;
+            entry->next = config_head;
+            config_head = entry;
+            block = &entry->config;
+        }
+    }
+    
+    config_release(sim->config);
+    sim->config = block;
+    return true;
+}
 
 TCAN1463Q1Simulator* tcan1463q1_simulator_create(void) {
+    return tcan1463q1_simulator_create_variant(DEVICE_VARIANT_TCAN1463Q1);
+}
+
+TCAN1463Q1Simulator* tcan1463q1_simulator_create_with_profile(DeviceProfile* profile) {
+    if (!profile) return NULL;
+    
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create_variant(
+        tcan1463q1_profile_get_variant(profile));
+    if (sim) {
+        // All simulators using the profile share its parameter table
+        sim->profile = tcan1463q1_profile_acquire(profile);
+    }
+    return sim;
+}
+
+TCAN1463Q1Simulator* tcan1463q1_simulator_create_variant(DeviceVariant variant) {
+    if (variant < 0 || variant >= DEVICE_VARIANT_COUNT) return NULL;
+    
     TCAN1463Q1Simulator* sim = (TCAN1463Q1Simulator*)malloc(sizeof(TCAN1463Q1Simulator));
     if (sim) {
         memset(sim, 0, sizeof(TCAN1463Q1Simulator));
+        sim->variant = variant;
         
         // Allocate INH controller
         sim->inh_controller = (INHController*)malloc(sizeof(INHController));
@@ -31,44 +231,99 @@ TCAN1463Q1Simulator* tcan1463q1_simulator_create(void) {
 
 void tcan1463q1_simulator_destroy(TCAN1463Q1Simulator* sim) {
     if (sim) {
-        // Free all event callbacks
-        for (int i = 0; i < 5; i++) {
-            EventCallbackEntry* entry = sim->callbacks[i];
-            while (entry) {
-                EventCallbackEntry* next = entry->next;
-                free(entry);
-                entry = next;
-            }
-        }
+        callback_table_release(sim->callbacks);
         
         if (sim->inh_controller) {
             free(sim->inh_controller);
         }
+        stimulus_set_destroy(sim->stimulus);
+        noise_source_destroy(sim->noise);
+        tcan1463q1_profile_release(sim->profile);
+        config_release(sim->config);
         free(sim);
     }
 }
 
+TCAN1463Q1Simulator* tcan1463q1_simulator_clone(const TCAN1463Q1Simulator* sim) {
+    if (!sim) return NULL;
+    
+    TCAN1463Q1Simulator* clone = (TCAN1463Q1Simulator*)malloc(sizeof(TCAN1463Q1Simulator));
+    if (!clone) return NULL;
+    memcpy(clone, sim, sizeof(TCAN1463Q1Simulator));
+    
+    // The INH controller state is the only part kept outside the structure
+    clone->inh_controller = NULL;
+    if (sim->inh_controller) {
+        clone->inh_controller = (INHController*)malloc(sizeof(INHController));
+        if (!clone->inh_controller) {
+            free(clone);
+            return NULL;
+        }
+        *clone->inh_controller = *sim->inh_controller;
+    }
+    
+    // Callbacks bound to the original stay with it; the rest is shared
+    if (callback_table_has_bound(sim->callbacks)) {
+        clone->callbacks = callback_table_copy(sim->callbacks, false);
+        if (!clone->callbacks) {
+            free(clone->inh_controller);
+            free(clone);
+            return NULL;
+        }
+    } else if (clone->callbacks) {
+        clone->callbacks->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // Shared by reference
+    tcan1463q1_profile_acquire(clone->profile);
+    config_acquire(clone->config);
+    
+    clone->stimulus = NULL;
+    clone->noise = NULL;
+    clone->run_control = NULL;
+    clone->probes = NULL;
+    
+    // Not a network node: keep the offset it currently sees
+    if (sim->bus_offset_source) clone->bus_offset = *sim->bus_offset_source;
+    clone->bus_offset_source = NULL;
+    return clone;
+}
+
 void tcan1463q1_simulator_reset(TCAN1463Q1Simulator* sim) {
     if (!sim) return;
     
-    // Save INH controller pointer and callbacks
+    // Save device variant and profile, INH controller pointer, callbacks, stimulus, noise,
+    // run control, probes and bus offset source
+    const SimulatorConfig* config = sim->config;
+    DeviceVariant variant = sim->variant;
+    DeviceProfile* profile = sim->profile;
     INHController* inh_ctrl = sim->inh_controller;
-    EventCallbackEntry* saved_callbacks[5];
-    for (int i = 0; i < 5; i++) {
-        saved_callbacks[i] = sim->callbacks[i];
-    }
+    StimulusSet* stimulus = sim->stimulus;
+    NoiseSource* noise = sim->noise;
+    RunControl* run_control = sim->run_control;
+    ProbeSet* probes = sim->probes;
+    EventCallbackTable* callbacks = sim->callbacks;
+    const double* bus_offset_source = sim->bus_offset_source;
     
     // Initialize all state to default values
     memset(sim, 0, sizeof(TCAN1463Q1Simulator));
     
-    // Restore INH controller pointer and callbacks
+    // Restore device variant and profile, INH controller pointer, callbacks, stimulus, noise,
+    // run control, probes and bus offset source
+    sim->variant = variant;
+    sim->profile = profile;
     sim->inh_controller = inh_ctrl;
-    for (int i = 0; i < 5; i++) {
-        sim->callbacks[i] = saved_callbacks[i];
-    }
+    sim->stimulus = stimulus;
+    sim->noise = noise;
+    sim->run_control = run_control;
+    sim->probes = probes;
+    sim->callbacks = callbacks;
+    sim->bus_offset_source = bus_offset_source;
     
     // Initialize all components
+    // Zeroed first so padding is equal between simulators (state comparison)
     PinManager pin_mgr;
+    memset(&pin_mgr, 0, sizeof(pin_mgr));
     pin_manager_init(&pin_mgr);
     memcpy(sim->pins, pin_mgr.pins, sizeof(sim->pins));
     
@@ -78,6 +333,7 @@ void tcan1463q1_simulator_reset(TCAN1463Q1Simulator* sim) {
     fault_detector_init(&sim->fault_state);
     wake_handler_init(&sim->wake_state);
     bus_bias_controller_init(&sim->bus_bias);
+    supply_meter_init(&sim->supply_meter);
     timing_engine_init(&sim->timing);
     
     if (sim->inh_controller) {
@@ -89,17 +345,8 @@ void tcan1463q1_simulator_reset(TCAN1463Q1Simulator* sim) {
     sim->mode_state.previous_mode = MODE_OFF;
     
     // Set default configuration
-    sim->tj_temperature = 25.0;
-    sim->rl_resistance = 60.0;
-    sim->cl_capacitance = 100e-12;
-    
-    // Set default timing parameters (use middle of valid ranges)
-    sim->timing_params.tuv_ms = (TUV_MIN_MS + TUV_MAX_MS) / 2.0;
-    sim->timing_params.ttxddto_ms = (TTXDDTO_MIN_MS + TTXDDTO_MAX_MS) / 2.0;
-    sim->timing_params.tbusdom_ms = (TBUSDOM_MIN_MS + TBUSDOM_MAX_MS) / 2.0;
-    sim->timing_params.twk_filter_us = (TWK_FILTER_MIN_US + TWK_FILTER_MAX_US) / 2.0;
-    sim->timing_params.twk_timeout_ms = (TWK_TIMEOUT_MIN_MS + TWK_TIMEOUT_MAX_MS) / 2.0;
-    sim->timing_params.tsilence_s = (TSILENCE_MIN_S + TSILENCE_MAX_S) / 2.0;
+    config_release(config);
+    sim->config = &default_config.config;
 }
 
 bool tcan1463q1_simulator_set_pin(TCAN1463Q1Simulator* sim, PinType pin,
@@ -109,6 +356,11 @@ bool tcan1463q1_simulator_set_pin(TCAN1463Q1Simulator* sim, PinType pin,
     // Validate pin index
     if (pin < 0 || pin >= 14) return false;
     
+    // Reject pins the device variant does not have
+    if (!tcan1463q1_device_has_pin(tcan1463q1_simulator_get_device_params(sim), pin)) {
+        return false;
+    }
+    
     // Set pin value using pin manager logic
     return pin_set_value(&sim->pins[pin], state, voltage);
 }
@@ -176,155 +428,74 @@ bool tcan1463q1_simulator_get_pin_info(TCAN1463Q1Simulator* sim, PinType pin,
     
     // Get pin metadata
     Pin* p = &sim->pins[pin];
-    if (is_input) *is_input = p->is_input;
-    if (is_output) *is_output = p->is_output;
-    if (min_voltage) *min_voltage = p->min_voltage;
-    if (max_voltage) *max_voltage = p->max_voltage;
+    if (is_input) *is_input = p->info->is_input;
+    if (is_output) *is_output = p->info->is_output;
+    if (min_voltage) *min_voltage = p->info->min_voltage;
+    if (max_voltage) *max_voltage = p->info->max_voltage;
     
     return true;
 }
 
-void tcan1463q1_simulator_step(TCAN1463Q1Simulator* sim, uint64_t delta_ns) {
-    if (!sim) return;
-    
-    // Get current time BEFORE advancing (this is when pin changes occur)
-    uint64_t time_before_step = timing_engine_get_time(&sim->timing);
-    
-    // Advance simulation time
-    timing_engine_advance(&sim->timing, delta_ns);
-    uint64_t current_time = timing_engine_get_time(&sim->timing);
-    
-    // Read input pin states
-    PinState txd_state, en_state, nstb_state, wake_state, inh_mask_state;
-    double txd_v, en_v, nstb_v, wake_v, inh_mask_v;
-    pin_get_value(&sim->pins[PIN_TXD], &txd_state, &txd_v);
-    pin_get_value(&sim->pins[PIN_EN], &en_state, &en_v);
-    pin_get_value(&sim->pins[PIN_NSTB], &nstb_state, &nstb_v);
-    pin_get_value(&sim->pins[PIN_WAKE], &wake_state, &wake_v);
-    pin_get_value(&sim->pins[PIN_INH_MASK], &inh_mask_state, &inh_mask_v);
-    
-    bool txd_low = (txd_state == PIN_STATE_LOW);
-    bool en_high = (en_state == PIN_STATE_HIGH);
-    bool nstb_high = (nstb_state == PIN_STATE_HIGH);
-    bool wake_pin_high = (wake_state == PIN_STATE_HIGH);
-    bool inh_mask_high = (inh_mask_state == PIN_STATE_HIGH);
-    
-    // Read power supply voltages
-    double vsup, vcc, vio;
-    PinState vsup_state, vcc_state, vio_state;
-    pin_get_value(&sim->pins[PIN_VSUP], &vsup_state, &vsup);
-    pin_get_value(&sim->pins[PIN_VCC], &vcc_state, &vcc);
-    pin_get_value(&sim->pins[PIN_VIO], &vio_state, &vio);
-    
-    // Update power monitor
-    power_monitor_update(&sim->power_state, vsup, vcc, vio, current_time);
-    bool vsup_valid = power_monitor_is_vsup_valid(&sim->power_state);
-    
-    // Update wake handler (using previous bus state for wake-up detection)
-    double canh_voltage_prev, canl_voltage_prev;
-    PinState canh_state_prev, canl_state_prev;
-    pin_get_value(&sim->pins[PIN_CANH], &canh_state_prev, &canh_voltage_prev);
-    pin_get_value(&sim->pins[PIN_CANL], &canl_state_prev, &canl_voltage_prev);
-    double vdiff_prev = canh_voltage_prev - canl_voltage_prev;
-    BusState bus_state_prev = can_transceiver_get_bus_state(vdiff_prev);
-    
-    wake_handler_update(&sim->wake_state, bus_state_prev, wake_pin_high, 
-                       sim->mode_state.current_mode, current_time);
-    bool wakerq = wake_handler_get_wakerq(&sim->wake_state);
-    
-    // Update mode controller
-    OperatingMode old_mode = sim->mode_state.current_mode;
-    OperatingMode new_mode = mode_controller_update(
-        &sim->mode_state, en_high, nstb_high, vsup_valid, wakerq, current_time
-    );
-    
-    // Clear flags on mode transition to Normal
-    if (new_mode == MODE_NORMAL && old_mode != MODE_NORMAL) {
-        power_monitor_clear_pwron_flag(&sim->power_state);
-        wake_handler_clear_flags(&sim->wake_state);
-    }
-    
-    // Update CAN transceiver state machine (before driving bus)
-    can_transceiver_update(&sim->can_transceiver, new_mode, txd_low,
-                          canh_voltage_prev, canl_voltage_prev, current_time);
-    can_transceiver_update_state_machine(&sim->can_transceiver, new_mode,
-                                         bus_state_prev, vsup_valid, current_time);
-    
-    // Update bus bias controller
-    bus_bias_controller_update(&sim->bus_bias, sim->can_transceiver.state,
-                               bus_state_prev, current_time);
-    
-    // Check for mode entry faults
-    if (new_mode == MODE_NORMAL && old_mode != MODE_NORMAL) {
-        fault_detector_check_txdclp(&sim->fault_state, txd_low, new_mode);
-    }
-    
-    // Update INH controller
-    if (sim->inh_controller) {
-        inh_controller_update(sim->inh_controller, new_mode, inh_mask_high,
-                            wakerq, current_time);
-    }
-    
-    // === STEP 1: DRIVE BUS (based on TXD input) ===
-    // CANH/CANL outputs (if driver is enabled)
-    if (sim->can_transceiver.driver_enabled && 
-        !fault_detector_should_disable_driver(&sim->fault_state)) {
-        double canh_out, canl_out;
-        can_transceiver_drive_bus(&sim->can_transceiver, txd_low, &canh_out, &canl_out);
-        pin_set_value(&sim->pins[PIN_CANH], PIN_STATE_ANALOG, canh_out);
-        pin_set_value(&sim->pins[PIN_CANL], PIN_STATE_ANALOG, canl_out);
+/**
+ * State compared across a step to raise events
+ */
+typedef struct {
+    OperatingMode mode;
+    uint32_t flags;
+    PinState pin_states[14];
+    double pin_voltages[14];
+} EventSnapshot;
+
+static void capture_event_snapshot(TCAN1463Q1Simulator* sim, EventSnapshot* snapshot);
+static void fire_step_events(TCAN1463Q1Simulator* sim, const EventSnapshot* before);
+
+static bool has_callbacks(const TCAN1463Q1Simulator* sim) {
+    if (!sim->callbacks) return false;
+    for (int i = 0; i < 5; i++) {
+        if (sim->callbacks->lists[i]) return true;
+    }
+    return false;
+}
+
+static void step_once(TCAN1463Q1Simulator* sim, uint64_t delta_ns) {
+    // Events cost nothing unless someone listens
+    EventSnapshot before;
+    bool observed = has_callbacks(sim);
+    if (observed) capture_event_snapshot(sim, &before);
+    
+    if (sim->profile) {
+        RuntimeProfile profile = {*tcan1463q1_profile_get_params(sim->profile)};
+        simulator_step_kernel(profile, sim, delta_ns);
     } else {
-        // Apply bus bias if in appropriate state
-        double canh_bias, canl_bias;
-        bus_bias_controller_get_bias(&sim->bus_bias, vcc, &canh_bias, &canl_bias);
-        
-        if (sim->bus_bias.state != BIAS_STATE_OFF) {
-            pin_set_value(&sim->pins[PIN_CANH], PIN_STATE_ANALOG, canh_bias);
-            pin_set_value(&sim->pins[PIN_CANL], PIN_STATE_ANALOG, canl_bias);
-        } else {
-            pin_set_value(&sim->pins[PIN_CANH], PIN_STATE_HIGH_IMPEDANCE, 0.0);
-            pin_set_value(&sim->pins[PIN_CANL], PIN_STATE_HIGH_IMPEDANCE, 0.0);
-        }
+        step_kernels[sim->variant](sim, delta_ns);
     }
     
-    // === STEP 2: READ BUS (after driving) ===
-    double canh_voltage, canl_voltage;
-    PinState canh_state, canl_state;
-    pin_get_value(&sim->pins[PIN_CANH], &canh_state, &canh_voltage);
-    pin_get_value(&sim->pins[PIN_CANL], &canl_state, &canl_voltage);
-    
-    // Get bus state from current voltages
-    double vdiff = canh_voltage - canl_voltage;
-    BusState bus_state = can_transceiver_get_bus_state(vdiff);
-    
-    // === STEP 3: UPDATE RXD (based on current bus state with propagation delay) ===
-    // Update RXD output based on current bus state (respects propagation delay)
-    // Use time_before_step for scheduling new updates, current_time for applying pending updates
-    can_transceiver_update_rxd(&sim->can_transceiver, bus_state, current_time, time_before_step);
-    bool rxd_high = sim->can_transceiver.rxd_output;
-    
-    // Update fault detector with current bus state
-    fault_detector_update(&sim->fault_state, txd_low, !rxd_high, bus_state,
-                         sim->tj_temperature, current_time, new_mode);
-    
-    // Update output pins
-    
-    // RXD output
-    PinState rxd_state = rxd_high ? PIN_STATE_HIGH : PIN_STATE_LOW;
-    pin_set_value(&sim->pins[PIN_RXD], rxd_state, rxd_high ? vio : 0.0);
-    
-    // nFAULT output
-    bool nfault_low = fault_detector_get_nfault_state(&sim->fault_state) || wakerq;
-    PinState nfault_state = nfault_low ? PIN_STATE_LOW : PIN_STATE_HIGH;
-    pin_set_value(&sim->pins[PIN_NFAULT], nfault_state, nfault_low ? 0.0 : vio);
+    if (observed) fire_step_events(sim, &before);
+    if (sim->probes) probe_set_step(sim->probes, sim);
+}
+
+void tcan1463q1_simulator_step(TCAN1463Q1Simulator* sim, uint64_t delta_ns) {
+    if (!sim) return;
     
-    // INH output
-    if (sim->inh_controller) {
-        PinState inh_state;
-        double inh_voltage;
-        inh_controller_get_pin_state(sim->inh_controller, &inh_state, &inh_voltage);
-        pin_set_value(&sim->pins[PIN_INH], inh_state, inh_voltage);
+    if (!sim->stimulus) {
+        step_once(sim, delta_ns);
+        run_control_add_time(sim->run_control, delta_ns);
+        return;
     }
+    
+    // Split the step at stimulus edges, applying each as it is reached
+    uint64_t start = timing_engine_get_time(&sim->timing);
+    uint64_t now = start;
+    uint64_t end = now + delta_ns;
+    stimulus_set_apply(sim->stimulus, sim, now);
+    do {
+        uint64_t until = stimulus_set_next_ns(sim->stimulus);
+        if (until > end || until <= now) until = end;
+        step_once(sim, until - now);
+        now = until;
+        stimulus_set_apply(sim->stimulus, sim, now);
+    } while (now < end && !run_control_cancelled(sim->run_control));
+    run_control_add_time(sim->run_control, now - start);
 }
 
 bool tcan1463q1_simulator_run_until(TCAN1463Q1Simulator* sim,
@@ -335,8 +506,12 @@ bool tcan1463q1_simulator_run_until(TCAN1463Q1Simulator* sim,
     uint64_t start_time = timing_engine_get_time(&sim->timing);
     uint64_t elapsed = 0;
     
-    // Run simulation steps until condition is met or timeout
+    // Run simulation steps until condition is met, timeout or cancellation
     while (elapsed < timeout_ns) {
+        if (run_control_cancelled(sim->run_control)) {
+            return false;
+        }
+        
         // Check condition
         if (condition(sim, user_data)) {
             return true;
@@ -353,6 +528,17 @@ bool tcan1463q1_simulator_run_until(TCAN1463Q1Simulator* sim,
     return condition(sim, user_data);
 }
 
+DeviceVariant tcan1463q1_simulator_get_variant(TCAN1463Q1Simulator* sim) {
+    if (!sim) return DEVICE_VARIANT_TCAN1463Q1;
+    return sim->variant;
+}
+
+const DeviceParams* tcan1463q1_simulator_get_device_params(TCAN1463Q1Simulator* sim) {
+    if (!sim) return NULL;
+    if (sim->profile) return tcan1463q1_profile_get_params(sim->profile);
+    return tcan1463q1_device_get_params(sim->variant);
+}
+
 OperatingMode tcan1463q1_simulator_get_mode(TCAN1463Q1Simulator* sim) {
     if (!sim) return MODE_OFF;
     return sim->mode_state.current_mode;
@@ -379,6 +565,83 @@ void tcan1463q1_simulator_get_flags(TCAN1463Q1Simulator* sim,
     if (tsd) *tsd = sim->fault_state.tsd_flag;
 }
 
+uint32_t tcan1463q1_simulator_get_flag_word(TCAN1463Q1Simulator* sim) {
+    if (!sim) return 0;
+    
+    const bool flags[12] = {
+        sim->power_state.pwron_flag,
+        sim->wake_state.wakerq_flag,
+        sim->wake_state.wakesr_flag,
+        sim->power_state.uvsup_flag,
+        sim->power_state.uvcc_flag,
+        sim->power_state.uvio_flag,
+        sim->fault_state.cbf_flag,
+        sim->fault_state.txdclp_flag,
+        sim->fault_state.txddto_flag,
+        sim->fault_state.txdrxd_flag,
+        sim->fault_state.candom_flag,
+        sim->fault_state.tsd_flag,
+    };
+    
+    uint32_t word = 0;
+    for (int i = 0; i < 12; i++) {
+        if (flags[i]) word |= 1u << i;
+    }
+    return word;
+}
+
+uint64_t tcan1463q1_simulator_get_time_ns(TCAN1463Q1Simulator* sim) {
+    return sim ? timing_engine_get_time(&sim->timing) : 0;
+}
+
+void tcan1463q1_simulator_get_observable_state(TCAN1463Q1Simulator* sim,
+                                                SimulatorObservableState* state) {
+    if (!sim || !state) return;
+    
+    state->time_ns = timing_engine_get_time(&sim->timing);
+    state->mode = sim->mode_state.current_mode;
+    state->flags = tcan1463q1_simulator_get_flag_word(sim);
+    for (int i = 0; i < 14; i++) {
+        state->pin_states[i] = sim->pins[i].state;
+        state->pin_voltages[i] = sim->pins[i].voltage;
+    }
+}
+
+void tcan1463q1_simulator_set_remote_dominant(TCAN1463Q1Simulator* sim, bool dominant) {
+    if (sim) sim->remote_dominant = dominant;
+}
+
+void tcan1463q1_simulator_set_bus_offset(TCAN1463Q1Simulator* sim, double volts) {
+    if (sim) sim->bus_offset = volts;
+}
+
+void simulator_set_bus_offset_source(TCAN1463Q1Simulator* sim, const double* source) {
+    // Detached from the network: keep the offset last seen
+    if (!source && sim->bus_offset_source) sim->bus_offset = *sim->bus_offset_source;
+    sim->bus_offset_source = source;
+}
+
+bool tcan1463q1_simulator_can_drive_bus(TCAN1463Q1Simulator* sim) {
+    if (!sim) return false;
+    
+    return sim->can_transceiver.driver_enabled &&
+           !fault_detector_should_disable_driver(&sim->fault_state);
+}
+
+void tcan1463q1_simulator_get_supply_currents(TCAN1463Q1Simulator* sim,
+                                               double currents[SUPPLY_COUNT]) {
+    if (!sim || !currents) return;
+    
+    memcpy(currents, sim->supply_meter.currents, sizeof(sim->supply_meter.currents));
+}
+
+bool tcan1463q1_simulator_get_supply_energy(TCAN1463Q1Simulator* sim, SupplyEnergy* energy) {
+    if (!sim || !energy) return false;
+    
+    supply_meter_get_energy(&sim->supply_meter, timing_engine_get_time(&sim->timing), energy);
+    return true;
+}
+
 void tcan1463q1_simulator_configure(TCAN1463Q1Simulator* sim,
                                      double vsup, double vcc, double vio,
                                      double tj_temperature,
@@ -388,9 +651,12 @@ void tcan1463q1_simulator_configure(TCAN1463Q1Simulator* sim,
     sim->power_state.vsup = vsup;
     sim->power_state.vcc = vcc;
     sim->power_state.vio = vio;
-    sim->tj_temperature = tj_temperature;
-    sim->rl_resistance = rl_resistance;
-    sim->cl_capacitance = cl_capacitance;
+    
+    SimulatorConfig config = *sim->config;
+    config.tj_temperature = tj_temperature;
+    config.rl_resistance = rl_resistance;
+    config.cl_capacitance = cl_capacitance;
+    config_switch(sim, &config);
 }
 
 // Parameter validation functions
@@ -453,9 +719,9 @@ bool tcan1463q1_simulator_set_temperature(TCAN1463Q1Simulator* sim, double tj_te
     if (!tcan1463q1_simulator_validate_temperature(tj_temperature)) return false;
     
     // Set temperature
-    sim->tj_temperature = tj_temperature;
-    
-    return true;
+    SimulatorConfig config = *sim->config;
+    config.tj_temperature = tj_temperature;
+    return config_switch(sim, &config);
 }
 
 bool tcan1463q1_simulator_set_bus_parameters(TCAN1463Q1Simulator* sim,
@@ -466,10 +732,10 @@ bool tcan1463q1_simulator_set_bus_parameters(TCAN1463Q1Simulator* sim,
     if (rl_resistance < 0.0 || cl_capacitance < 0.0) return false;
     
     // Set bus parameters
-    sim->rl_resistance = rl_resistance;
-    sim->cl_capacitance = cl_capacitance;
-    
-    return true;
+    SimulatorConfig config = *sim->config;
+    config.rl_resistance = rl_resistance;
+    config.cl_capacitance = cl_capacitance;
+    return config_switch(sim, &config);
 }
 
 bool tcan1463q1_simulator_set_timing_parameters(TCAN1463Q1Simulator* sim,
@@ -480,9 +746,9 @@ bool tcan1463q1_simulator_set_timing_parameters(TCAN1463Q1Simulator* sim,
     if (!tcan1463q1_simulator_validate_timing_parameters(params)) return false;
     
     // Set timing parameters
-    sim->timing_params = *params;
-    
-    return true;
+    SimulatorConfig config = *sim->config;
+    config.timing_params = *params;
+    return config_switch(sim, &config);
 }
 
 bool tcan1463q1_simulator_get_timing_parameters(TCAN1463Q1Simulator* sim,
@@ -490,7 +756,7 @@ bool tcan1463q1_simulator_get_timing_parameters(TCAN1463Q1Simulator* sim,
     if (!sim || !params) return false;
     
     // Get timing parameters
-    *params = sim->timing_params;
+    *params = sim->config->timing_params;
     
     return true;
 }
@@ -509,8 +775,9 @@ SimulatorSnapshot* tcan1463q1_simulator_snapshot(TCAN1463Q1Simulator* sim) {
         return NULL;
     }
     
-    // Copy simulator state
+    // Copy simulator state; the snapshot holds a reference to the configuration
     memcpy(snapshot->data, sim, snapshot->size);
+    config_acquire(sim->config);
     
     return snapshot;
 }
@@ -519,17 +786,37 @@ bool tcan1463q1_simulator_restore(TCAN1463Q1Simulator* sim,
                                    const SimulatorSnapshot* snapshot) {
     if (!sim || !snapshot || !snapshot->data) return false;
     
-    // Verify snapshot size matches
+    // Verify snapshot size and device variant/profile match
     if (snapshot->size != sizeof(TCAN1463Q1Simulator)) return false;
+    const TCAN1463Q1Simulator* saved = (const TCAN1463Q1Simulator*)snapshot->data;
+    if (saved->variant != sim->variant || saved->profile != sim->profile) return false;
     
-    // Save INH controller pointer
+    // Save INH controller, callbacks, stimulus, noise, run control, probe and
+    // bus offset source pointers
     INHController* inh_ctrl = sim->inh_controller;
+    EventCallbackTable* callbacks = sim->callbacks;
+    StimulusSet* stimulus = sim->stimulus;
+    NoiseSource* noise = sim->noise;
+    RunControl* run_control = sim->run_control;
+    ProbeSet* probes = sim->probes;
+    const double* bus_offset_source = sim->bus_offset_source;
+    
+    // Take the snapshot's configuration before dropping the current one
+    config_acquire(saved->config);
+    config_release(sim->config);
     
     // Restore simulator state
     memcpy(sim, snapshot->data, snapshot->size);
     
-    // Restore INH controller pointer
+    // Restore INH controller, callbacks, stimulus, noise, run control, probe and
+    // bus offset source pointers
     sim->inh_controller = inh_ctrl;
+    sim->callbacks = callbacks;
+    sim->stimulus = stimulus;
+    sim->noise = noise;
+    sim->run_control = run_control;
+    sim->probes = probes;
+    sim->bus_offset_source = bus_offset_source;
     
     return true;
 }
@@ -537,40 +824,243 @@ bool tcan1463q1_simulator_restore(TCAN1463Q1Simulator* sim,
 void tcan1463q1_simulator_snapshot_free(SimulatorSnapshot* snapshot) {
     if (snapshot) {
         if (snapshot->data) {
+            config_release(((const TCAN1463Q1Simulator*)snapshot->data)->config);
             free(snapshot->data);
         }
         free(snapshot);
     }
 }
 
-bool tcan1463q1_simulator_register_callback(TCAN1463Q1Simulator* sim,
-                                             SimulatorEventType event_type,
-                                             EventCallback callback,
-                                             void* user_data) {
+// State without the pointers that differ between otherwise equal simulators
+static void state_image(const TCAN1463Q1Simulator* sim, TCAN1463Q1Simulator* image) {
+    memcpy(image, sim, sizeof(TCAN1463Q1Simulator));
+    image->inh_controller = NULL;
+    image->callbacks = NULL;
+    image->stimulus = NULL;
+    image->noise = NULL;
+    image->run_control = NULL;
+    image->probes = NULL;
+    image->bus_offset_source = NULL;
+}
+
+// FNV-1a
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+bool simulator_is_detached(const TCAN1463Q1Simulator* sim) {
+    return !has_callbacks(sim) && !sim->stimulus && !sim->noise && !sim->run_control &&
+           !sim->probes;
+}
+
+uint64_t simulator_state_hash(const TCAN1463Q1Simulator* sim) {
+    TCAN1463Q1Simulator image;
+    state_image(sim, &image);
+    uint64_t hash = hash_bytes(0xCBF29CE484222325ULL, &image, sizeof(image));
+    if (sim->inh_controller) {
+        hash = hash_bytes(hash, sim->inh_controller, sizeof(INHController));
+    }
+    return hash;
+}
+
+bool simulator_same_state(const TCAN1463Q1Simulator* a, const TCAN1463Q1Simulator* b) {
+    TCAN1463Q1Simulator image_a, image_b;
+    state_image(a, &image_a);
+    state_image(b, &image_b);
+    if (memcmp(&image_a, &image_b, sizeof(TCAN1463Q1Simulator)) != 0) return false;
+    if (!a->inh_controller || !b->inh_controller) return a->inh_controller == b->inh_controller;
+    return memcmp(a->inh_controller, b->inh_controller, sizeof(INHController)) == 0;
+}
+
+bool simulator_same_run_state(const TCAN1463Q1Simulator* a, const TCAN1463Q1Simulator* b) {
+    TCAN1463Q1Simulator image_a, image_b;
+    state_image(a, &image_a);
+    state_image(b, &image_b);
+    image_a.profile = image_b.profile = NULL;
+    image_a.config = image_b.config = NULL;
+    if (memcmp(&image_a, &image_b, sizeof(TCAN1463Q1Simulator)) != 0) return false;
+    if (!a->inh_controller || !b->inh_controller) return a->inh_controller == b->inh_controller;
+    return memcmp(a->inh_controller, b->inh_controller, sizeof(INHController)) == 0;
+}
+
+void simulator_copy_state(TCAN1463Q1Simulator* dst, const TCAN1463Q1Simulator* src) {
+    if (dst == src) return;
+    
+    // Keep the INH controller, callbacks, stimulus, noise, run control, probes
+    // and bus offset source
+    INHController* inh_ctrl = dst->inh_controller;
+    EventCallbackTable* callbacks = dst->callbacks;
+    StimulusSet* stimulus = dst->stimulus;
+    NoiseSource* noise = dst->noise;
+    RunControl* run_control = dst->run_control;
+    ProbeSet* probes = dst->probes;
+    const double* bus_offset_source = dst->bus_offset_source;
+    
+    config_acquire(src->config);
+    config_release(dst->config);
+    memcpy(dst, src, sizeof(TCAN1463Q1Simulator));
+    
+    dst->inh_controller = inh_ctrl;
+    dst->callbacks = callbacks;
+    dst->stimulus = stimulus;
+    dst->noise = noise;
+    dst->run_control = run_control;
+    dst->probes = probes;
+    dst->bus_offset_source = bus_offset_source;
+    if (inh_ctrl && src->inh_controller) *inh_ctrl = *src->inh_controller;
+}
+
+// State image without the clock; stamps that follow the clock (dominant
+// bus activity, the TXD/RXD short timer restarting every step) are equal
+// from step to step
+static void settled_image(const TCAN1463Q1Simulator* sim, TCAN1463Q1Simulator* image) {
+    state_image(sim, image);
+    uint64_t now = timing_engine_get_time(&sim->timing);
+    memset(&image->timing, 0, sizeof(image->timing));
+    if (image->can_transceiver.last_bus_activity_time == now) {
+        image->can_transceiver.last_bus_activity_time = UINT64_MAX;
+    }
+    if (image->bus_bias.last_bus_activity == now) {
+        image->bus_bias.last_bus_activity = UINT64_MAX;
+    }
+    if (image->fault_state.txd_dominant_start == now) {
+        image->fault_state.txd_dominant_start = UINT64_MAX;
+    }
+}
+
+bool simulator_step_settled(TCAN1463Q1Simulator* sim, uint64_t delta_ns) {
+    TCAN1463Q1Simulator before, after;
+    INHController inh_before;
+    settled_image(sim, &before);
+    if (sim->inh_controller) inh_before = *sim->inh_controller;
+
+    tcan1463q1_simulator_step(sim, delta_ns);
+
+    settled_image(sim, &after);
+    if (memcmp(&before, &after, sizeof(TCAN1463Q1Simulator)) != 0) return false;
+    return !sim->inh_controller ||
+           memcmp(&inh_before, sim->inh_controller, sizeof(INHController)) == 0;
+}
+
+// Keep the earliest deadline still ahead of now
+static void earliest(uint64_t* next, uint64_t deadline, uint64_t now) {
+    if (deadline > now && deadline < *next) *next = deadline;
+}
+
+uint64_t simulator_next_deadline_ns(TCAN1463Q1Simulator* sim) {
+    // Noise changes the bus every step, probes sample every step
+    if (sim->noise || sim->probes) return 0;
+
+    const DeviceParams* p = tcan1463q1_simulator_get_device_params(sim);
+    uint64_t now = timing_engine_get_time(&sim->timing);
+    uint64_t next = UINT64_MAX;
+
+    // Undervoltage filters
+    const PowerState* power = &sim->power_state;
+    if (power->uvcc_start_time != UINT64_MAX && !power->uvcc_flag) {
+        earliest(&next, power->uvcc_start_time + p->tuv.min_ns, now);
+    }
+    if (power->uvio_start_time != UINT64_MAX && !power->uvio_flag) {
+        earliest(&next, power->uvio_start_time + p->tuv.min_ns, now);
+    }
+
+    // WUP phase filter and pattern timeout
+    const WakeState* wake = &sim->wake_state;
+    if (wake->wup_state != WUP_STATE_IDLE && wake->wup_state != WUP_STATE_COMPLETE) {
+        if (wake->wup_phase_start != UINT64_MAX) {
+            earliest(&next, wake->wup_phase_start + p->twk_filter.min_ns, now);
+        }
+        if (wake->wup_timeout_start != UINT64_MAX) {
+            earliest(&next, wake->wup_timeout_start + p->twk_timeout.max_ns, now);
+        }
+    }
+
+    // Go-to-sleep to Sleep
+    if (sim->mode_state.current_mode == MODE_GO_TO_SLEEP) {
+        earliest(&next, sim->mode_state.mode_entry_time + p->tsilence.min_ns, now);
+    }
+
+    // Autonomous bias silence timeout, pending RXD edge
+    const CANTransceiver* can = &sim->can_transceiver;
+    if (can->state == CAN_STATE_AUTONOMOUS_ACTIVE) {
+        earliest(&next, can->last_bus_activity_time + timing_range_mid_ns(p->tsilence) + 1, now);
+    }
+    if (can->rxd_pending) {
+        earliest(&next, can->rxd_update_time, now);
+    }
+
+    // Dominant timeouts (a stamp at now restarts every step and never expires)
+    const FaultState* fault = &sim->fault_state;
+    if (fault->txd_dominant_start != UINT64_MAX && fault->txd_dominant_start != now) {
+        earliest(&next, fault->txd_dominant_start + p->ttxddto.min_ns, now);
+    }
+    if (fault->bus_dominant_start != UINT64_MAX) {
+        earliest(&next, fault->bus_dominant_start + p->tbusdom.min_ns, now);
+    }
+
+    // INH assertion delay after a wake-up
+    if (sim->inh_controller && sim->inh_controller->pending_inh_assertion) {
+        earliest(&next, sim->inh_controller->wake_event_time + p->tinh_slp_stb_ns, now);
+    }
+
+    if (sim->stimulus) {
+        earliest(&next, stimulus_set_next_ns(sim->stimulus), now);
+    }
+    return next;
+}
+
+static bool register_callback(TCAN1463Q1Simulator* sim, SimulatorEventType event_type,
+                              EventCallback callback, void* user_data, bool bound) {
     if (!sim || !callback) return false;
     if (event_type < 0 || event_type >= 5) return false;
     
+    EventCallbackTable* table = callback_table_own(sim);
+    if (!table) return false;
+    
     // Create new callback entry
     EventCallbackEntry* entry = (EventCallbackEntry*)malloc(sizeof(EventCallbackEntry));
     if (!entry) return false;
     
     entry->callback = callback;
     entry->user_data = user_data;
-    entry->next = sim->callbacks[event_type];
+    entry->bound = bound;
+    entry->next = table->lists[event_type];
     
     // Add to front of linked list
-    sim->callbacks[event_type] = entry;
+    table->lists[event_type] = entry;
     
     return true;
 }
 
+bool tcan1463q1_simulator_register_callback(TCAN1463Q1Simulator* sim,
+                                             SimulatorEventType event_type,
+                                             EventCallback callback,
+                                             void* user_data) {
+    return register_callback(sim, event_type, callback, user_data, false);
+}
+
+bool tcan1463q1_simulator_register_bound_callback(TCAN1463Q1Simulator* sim,
+                                                   SimulatorEventType event_type,
+                                                   EventCallback callback,
+                                                   void* user_data) {
+    return register_callback(sim, event_type, callback, user_data, true);
+}
+
 bool tcan1463q1_simulator_unregister_callback(TCAN1463Q1Simulator* sim,
                                                SimulatorEventType event_type,
                                                EventCallback callback) {
     if (!sim || !callback) return false;
     if (event_type < 0 || event_type >= 5) return false;
     
-    EventCallbackEntry** current = &sim->callbacks[event_type];
+    if (!sim->callbacks) return false;
+    EventCallbackTable* table = callback_table_own(sim);
+    if (!table) return false;
+    
+    EventCallbackEntry** current = &table->lists[event_type];
     
     while (*current) {
         if ((*current)->callback == callback) {
@@ -590,7 +1080,9 @@ static void fire_event(TCAN1463Q1Simulator* sim, const SimulatorEvent* event) {
     if (!sim || !event) return;
     if (event->type < 0 || event->type >= 5) return;
     
-    EventCallbackEntry* entry = sim->callbacks[event->type];
+    if (!sim->callbacks) return;
+    
+    EventCallbackEntry* entry = sim->callbacks->lists[event->type];
     while (entry) {
         if (entry->callback) {
             entry->callback(event, entry->user_data);
@@ -598,3 +1090,73 @@ static void fire_event(TCAN1463Q1Simulator* sim, const SimulatorEvent* event) {
         entry = entry->next;
     }
 }
+
+static void capture_event_snapshot(TCAN1463Q1Simulator* sim, EventSnapshot* snapshot) {
+    snapshot->mode = sim->mode_state.current_mode;
+    snapshot->flags = tcan1463q1_simulator_get_flag_word(sim);
+    for (int i = 0; i < 14; i++) {
+        snapshot->pin_states[i] = sim->pins[i].state;
+        snapshot->pin_voltages[i] = sim->pins[i].voltage;
+    }
+}
+
+// Fault flags of the flag word (bit index = position in get_flags)
+static const struct {
+    int bit;
+    const char* name;
+} fault_flags[] = {
+    {3, "UVSUP"}, {4, "UVCC"}, {5, "UVIO"}, {6, "CBF"}, {7, "TXDCLP"},
+    {8, "TXDDTO"}, {9, "TXDRXD"}, {10, "CANDOM"}, {11, "TSD"},
+};
+
+/**
+ * Raise events for what changed during a step: mode, flags, faults, wake-up
+ * and pin states (analog voltage changes alone are not pin changes)
+ */
+static void fire_step_events(TCAN1463Q1Simulator* sim, const EventSnapshot* before) {
+    SimulatorEvent event;
+    memset(&event, 0, sizeof(event));
+    event.timestamp = timing_engine_get_time(&sim->timing);
+    event.sim = sim;
+    
+    OperatingMode mode = sim->mode_state.current_mode;
+    if (mode != before->mode) {
+        event.type = EVENT_MODE_CHANGE;
+        event.data.mode_change.old_mode = before->mode;
+        event.data.mode_change.new_mode = mode;
+        fire_event(sim, &event);
+    }
+    
+    uint32_t flags = tcan1463q1_simulator_get_flag_word(sim);
+    uint32_t changed = flags ^ before->flags;
+    if (changed) {
+        for (size_t i = 0; i < sizeof(fault_flags) / sizeof(fault_flags[0]); i++) {
+            uint32_t bit = 1u << fault_flags[i].bit;
+            if (!(changed & bit)) continue;
+            event.type = EVENT_FAULT_DETECTED;
+            event.data.fault.fault_name = fault_flags[i].name;
+            event.data.fault.is_set = (flags & bit) != 0;
+            fire_event(sim, &event);
+        }
+        
+        // WAKERQ set
+        if (changed & flags & (1u << 1)) {
+            event.type = EVENT_WAKE_UP;
+            fire_event(sim, &event);
+        }
+        
+        event.type = EVENT_FLAG_CHANGE;
+        fire_event(sim, &event);
+    }
+    
+    for (int i = 0; i < 14; i++) {
+        if (sim->pins[i].state == before->pin_states[i]) continue;
+        event.type = EVENT_PIN_CHANGE;
+        event.data.pin_change.pin = (PinType)i;
+        event.data.pin_change.old_state = before->pin_states[i];
+        event.data.pin_change.new_state = sim->pins[i].state;
+        event.data.pin_change.old_voltage = before->pin_voltages[i];
+        event.data.pin_change.new_voltage = sim->pins[i].voltage;
+        fire_event(sim, &event);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef SIMULATOR_IMPL_H
+#define SIMULATOR_IMPL_H
+
+#include "tcan1463q1_simulator.h"
+
+/**
+ * Simulator state comparison and copying, for callers that simulate one
+ * simulator on behalf of others (CAN network equivalence classes)
+ *
+ * The state is everything the step reads or writes: the structure with
+ * the INH controller contents, without callbacks and attachments. Two
+ * simulators with the same state and the same inputs stay the same.
+ */
+
+// Nothing attached that a step would drive or report to (callbacks,
+// stimulus, noise, run control, probes)
+bool simulator_is_detached(const TCAN1463Q1Simulator* sim);
+// Hash of the state; equal states hash equal
+uint64_t simulator_state_hash(const TCAN1463Q1Simulator* sim);
+bool simulator_same_state(const TCAN1463Q1Simulator* a, const TCAN1463Q1Simulator* b);
+// As simulator_same_state for runs with different profiles (parameter
+// sweeps): the profile and configuration are not compared
+bool simulator_same_run_state(const TCAN1463Q1Simulator* a, const TCAN1463Q1Simulator* b);
+// Copy the state of src into dst, keeping dst's callbacks and attachments
+void simulator_copy_state(TCAN1463Q1Simulator* dst, const TCAN1463Q1Simulator* src);
+// Read the bus offset from *source (a CAN network's per-node array) instead
+// of sim->bus_offset; NULL detaches, keeping the value last read
+void simulator_set_bus_offset_source(TCAN1463Q1Simulator* sim, const double* source);
+
+/**
+ * Quiescence, for callers that step in fine steps (lockstep reference)
+ *
+ * Once a step with unchanged inputs changes nothing but the time, further
+ * such steps change nothing until the next deadline (a timer expiring, a
+ * pending RXD edge, a stimulus edge): the interval up to it can be crossed
+ * in one step with the same result.
+ */
+
+// Step; true if the step changed nothing but the time
+bool simulator_step_settled(TCAN1463Q1Simulator* sim, uint64_t delta_ns);
+// Earliest time after now at which a step can change the state again
+// (UINT64_MAX if never, 0 if every step can: noise or probes attached)
+uint64_t simulator_next_deadline_ns(TCAN1463Q1Simulator* sim);
+
+#endif // SIMULATOR_IMPL_H
@@ -0,0 +1,207 @@
+#ifndef SIMULATOR_KERNEL_H
+#define SIMULATOR_KERNEL_H
+
+#include "tcan1463q1_simulator.h"
+#include "device_profiles.h"
+#include "pin_manager.h"
+#include "timing_engine.h"
+#include "power_monitor_impl.h"
+#include "wake_handler_impl.h"
+#include "mode_controller_impl.h"
+#include "can_transceiver_impl.h"
+#include "bus_bias_controller_impl.h"
+#include "fault_detector_impl.h"
+#include "inh_controller_impl.h"
+#include "supply_meter_impl.h"
+#include "noise_impl.h"
+
+// Keep offset bus voltages inside the CANH/CANL pin range
+inline double bus_offset_clamp(double volts) {
+    return volts < -27.0 ? -27.0 : (volts > 42.0 ? 42.0 : volts);
+}
+
+/**
+ * Simulation step kernel specialized for a device profile
+ *
+ * Thresholds and timings come from profile.params as compile-time
+ * constants; features the profile lacks are compiled out.
+ */
+template <typename Profile>
+void simulator_step_kernel(const Profile& profile, TCAN1463Q1Simulator* sim,
+                           uint64_t delta_ns) {
+    const DeviceParams& p = profile.params;
+    
+    // Get current time BEFORE advancing (this is when pin changes occur)
+    uint64_t time_before_step = timing_engine_get_time(&sim->timing);
+    
+    // Advance simulation time
+    timing_engine_advance(&sim->timing, delta_ns);
+    uint64_t current_time = timing_engine_get_time(&sim->timing);
+    
+    // Read input pin states
+    PinState txd_state, en_state, nstb_state, wake_state, inh_mask_state;
+    double txd_v, en_v, nstb_v, wake_v, inh_mask_v;
+    pin_get_value(&sim->pins[PIN_TXD], &txd_state, &txd_v);
+    pin_get_value(&sim->pins[PIN_EN], &en_state, &en_v);
+    pin_get_value(&sim->pins[PIN_NSTB], &nstb_state, &nstb_v);
+    pin_get_value(&sim->pins[PIN_WAKE], &wake_state, &wake_v);
+    pin_get_value(&sim->pins[PIN_INH_MASK], &inh_mask_state, &inh_mask_v);
+    
+    bool txd_low = (txd_state == PIN_STATE_LOW);
+    bool en_high = (en_state == PIN_STATE_HIGH);
+    bool nstb_high = (nstb_state == PIN_STATE_HIGH);
+    // Absent pins read as inactive
+    bool wake_pin_high = p.has_wake && (wake_state == PIN_STATE_HIGH);
+    bool inh_mask_high = p.has_inh_mask && (inh_mask_state == PIN_STATE_HIGH);
+    
+    // Read power supply voltages
+    double vsup, vcc, vio;
+    PinState vsup_state, vcc_state, vio_state;
+    pin_get_value(&sim->pins[PIN_VSUP], &vsup_state, &vsup);
+    pin_get_value(&sim->pins[PIN_VCC], &vcc_state, &vcc);
+    pin_get_value(&sim->pins[PIN_VIO], &vio_state, &vio);
+    
+    // Update power monitor
+    power_monitor_update_impl(profile, &sim->power_state, vsup, vcc, vio, current_time);
+    bool vsup_valid = power_monitor_is_vsup_valid(&sim->power_state);
+    
+    // Update wake handler (using previous bus state for wake-up detection)
+    double canh_voltage_prev, canl_voltage_prev;
+    PinState canh_state_prev, canl_state_prev;
+    pin_get_value(&sim->pins[PIN_CANH], &canh_state_prev, &canh_voltage_prev);
+    pin_get_value(&sim->pins[PIN_CANL], &canl_state_prev, &canl_voltage_prev);
+    BusState bus_state_prev = can_transceiver_classify_bus_impl(profile, canh_voltage_prev,
+                                                                canl_voltage_prev);
+    
+    wake_handler_update_impl(profile, &sim->wake_state, bus_state_prev, wake_pin_high,
+                             sim->mode_state.current_mode, current_time);
+    bool wakerq = wake_handler_get_wakerq(&sim->wake_state);
+    
+    // Update mode controller
+    OperatingMode old_mode = sim->mode_state.current_mode;
+    OperatingMode new_mode = mode_controller_update_impl(
+        profile, &sim->mode_state, en_high, nstb_high, vsup_valid, wakerq, current_time
+    );
+    
+    // Clear flags on mode transition to Normal
+    if (new_mode == MODE_NORMAL && old_mode != MODE_NORMAL) {
+        power_monitor_clear_pwron_flag(&sim->power_state);
+        wake_handler_clear_flags(&sim->wake_state);
+    }
+    
+    // Update CAN transceiver state machine (before driving bus)
+    can_transceiver_update_impl(profile, &sim->can_transceiver, new_mode, txd_low,
+                                canh_voltage_prev, canl_voltage_prev, current_time);
+    can_transceiver_update_state_machine_impl(profile, &sim->can_transceiver, new_mode,
+                                              bus_state_prev, vsup_valid, current_time);
+    
+    // Update bus bias controller
+    bus_bias_controller_update(&sim->bus_bias, sim->can_transceiver.state,
+                               bus_state_prev, current_time);
+    
+    // Check for mode entry faults
+    if (new_mode == MODE_NORMAL && old_mode != MODE_NORMAL) {
+        fault_detector_check_txdclp(&sim->fault_state, txd_low, new_mode);
+    }
+    
+    // Update INH controller
+    if (p.has_inh && sim->inh_controller) {
+        inh_controller_update_impl(profile, sim->inh_controller, new_mode, inh_mask_high,
+                                   wakerq, current_time);
+    }
+    
+    // === STEP 1: DRIVE BUS (based on TXD input) ===
+    // CANH/CANL outputs (if driver is enabled)
+    bool driver_dominant = false;
+    if (sim->can_transceiver.driver_enabled && 
+        !fault_detector_should_disable_driver(&sim->fault_state)) {
+        double canh_out, canl_out;
+        can_transceiver_drive_bus_impl(profile, &sim->can_transceiver, txd_low, &canh_out, &canl_out);
+        pin_set_value(&sim->pins[PIN_CANH], PIN_STATE_ANALOG, canh_out);
+        pin_set_value(&sim->pins[PIN_CANL], PIN_STATE_ANALOG, canl_out);
+        driver_dominant = voltage_key(canh_out - canl_out) >= voltage_key(p.vdiff_dominant);
+    } else {
+        // Apply bus bias if in appropriate state
+        double canh_bias, canl_bias;
+        bus_bias_controller_get_bias_impl(profile, &sim->bus_bias, vcc, &canh_bias, &canl_bias);
+        
+        if (sim->bus_bias.state != BIAS_STATE_OFF) {
+            pin_set_value(&sim->pins[PIN_CANH], PIN_STATE_ANALOG, canh_bias);
+            pin_set_value(&sim->pins[PIN_CANL], PIN_STATE_ANALOG, canl_bias);
+        } else {
+            pin_set_value(&sim->pins[PIN_CANH], PIN_STATE_HIGH_IMPEDANCE, 0.0);
+            pin_set_value(&sim->pins[PIN_CANL], PIN_STATE_HIGH_IMPEDANCE, 0.0);
+        }
+    }
+    
+    // Wired-AND with the rest of the network: dominant wins
+    if (sim->remote_dominant) {
+        pin_set_value(&sim->pins[PIN_CANH], PIN_STATE_ANALOG, p.canh_dominant);
+        pin_set_value(&sim->pins[PIN_CANL], PIN_STATE_ANALOG, p.canl_dominant);
+    }
+    
+    // Bus common mode against this node's ground (ground shift, disturbance)
+    const double bus_offset = sim->bus_offset_source ? *sim->bus_offset_source : sim->bus_offset;
+    if (bus_offset != 0.0 && sim->pins[PIN_CANH].state == PIN_STATE_ANALOG) {
+        pin_set_value(&sim->pins[PIN_CANH], PIN_STATE_ANALOG,
+                      bus_offset_clamp(sim->pins[PIN_CANH].voltage + bus_offset));
+        pin_set_value(&sim->pins[PIN_CANL], PIN_STATE_ANALOG,
+                      bus_offset_clamp(sim->pins[PIN_CANL].voltage + bus_offset));
+    }
+    
+    // EMC noise, split symmetrically between the lines
+    if (sim->noise && sim->pins[PIN_CANH].state == PIN_STATE_ANALOG) {
+        double noise_diff, noise_cm;
+        noise_source_sample(sim->noise, current_time, &noise_diff, &noise_cm);
+        pin_set_value(&sim->pins[PIN_CANH], PIN_STATE_ANALOG,
+                      bus_offset_clamp(sim->pins[PIN_CANH].voltage + noise_cm + 0.5 * noise_diff));
+        pin_set_value(&sim->pins[PIN_CANL], PIN_STATE_ANALOG,
+                      bus_offset_clamp(sim->pins[PIN_CANL].voltage + noise_cm - 0.5 * noise_diff));
+    }
+    
+    // === STEP 2: READ BUS (after driving) ===
+    double canh_voltage, canl_voltage;
+    PinState canh_state, canl_state;
+    pin_get_value(&sim->pins[PIN_CANH], &canh_state, &canh_voltage);
+    pin_get_value(&sim->pins[PIN_CANL], &canl_state, &canl_voltage);
+    
+    // Get bus state from current voltages
+    BusState bus_state = can_transceiver_classify_bus_impl(profile, canh_voltage, canl_voltage);
+    
+    // === STEP 3: UPDATE RXD (based on current bus state with propagation delay) ===
+    // Update RXD output based on current bus state (respects propagation delay)
+    // Use time_before_step for scheduling new updates, current_time for applying pending updates
+    can_transceiver_update_rxd_impl(profile, &sim->can_transceiver, bus_state, current_time,
+                                    time_before_step);
+    bool rxd_high = sim->can_transceiver.rxd_output;
+    
+    // Update fault detector with current bus state
+    fault_detector_update_impl(profile, &sim->fault_state, txd_low, !rxd_high, bus_state,
+                               sim->config->tj_temperature, current_time, new_mode);
+    
+    // Update output pins
+    
+    // RXD output
+    PinState rxd_state = rxd_high ? PIN_STATE_HIGH : PIN_STATE_LOW;
+    pin_set_value(&sim->pins[PIN_RXD], rxd_state, rxd_high ? vio : 0.0);
+    
+    // nFAULT output
+    bool nfault_low = fault_detector_get_nfault_state(&sim->fault_state) || wakerq;
+    PinState nfault_state = nfault_low ? PIN_STATE_LOW : PIN_STATE_HIGH;
+    pin_set_value(&sim->pins[PIN_NFAULT], nfault_state, nfault_low ? 0.0 : vio);
+    
+    // INH output
+    if (p.has_inh && sim->inh_controller) {
+        PinState inh_state;
+        double inh_voltage;
+        inh_controller_get_pin_state_impl(profile, sim->inh_controller, &inh_state, &inh_voltage);
+        pin_set_value(&sim->pins[PIN_INH], inh_state, inh_voltage);
+    }
+    
+    // Supply accounting (only does work when the load point changes)
+    supply_meter_update_impl(profile, &sim->supply_meter, new_mode, driver_dominant,
+                             sim->bus_bias.state, vsup, vcc, vio, sim->config->rl_resistance,
+                             current_time);
+}
+
+#endif // SIMULATOR_KERNEL_H
@@ -0,0 +1,265 @@
+#include "tcan1463q1_stimulus.h"
+#include "stimulus_impl.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_EDGE UINT64_MAX
+
+typedef struct {
+    int id;
+    StimulusConfig config;
+    uint8_t* pattern;           // Owned copy of config.pattern
+    uint64_t next_ns;           // Next edge; re-evaluated when reached
+    uint64_t last_ns;           // Time of the last evaluation
+    uint64_t prbs_index;        // Bit index of prbs_state
+    uint32_t prbs_state;
+} StimulusGenerator;
+
+struct StimulusSet {
+    StimulusGenerator* generators;
+    size_t count;
+    size_t capacity;
+    int next_id;
+};
+
+// PRBS feedback taps (x^order + x^tap + 1)
+static unsigned prbs_tap(unsigned order) {
+    switch (order) {
+        case 7:  return 6;
+        case 15: return 14;
+        case 31: return 28;
+        default: return 0;
+    }
+}
+
+void tcan1463q1_stimulus_config_init(StimulusConfig* config, StimulusType type, PinType pin) {
+    if (!config) return;
+
+    memset(config, 0, sizeof(StimulusConfig));
+    config->type = type;
+    config->pin = pin;
+    config->period_ns = 2000;
+    config->high_ns = 1000;
+    config->prbs_order = 7;
+    config->idle_high = true;
+    config->high_v = 3.3;
+    config->offset_v = 12.0;
+    config->amplitude_v = 0.5;
+    config->ripple_period_ns = 100000;
+    if (type == STIMULUS_RIPPLE) config->period_ns = 1000;
+}
+
+void tcan1463q1_stimulus_config_wup(StimulusConfig* config, uint64_t phase_ns, uint64_t start_ns) {
+    static const uint8_t wup_pattern = 0x40;   // 0 1 0: dominant, recessive, dominant
+
+    tcan1463q1_stimulus_config_init(config, STIMULUS_PATTERN, PIN_TXD);
+    if (!config) return;
+    config->bus = true;
+    config->start_ns = start_ns;
+    config->period_ns = phase_ns;
+    config->pattern = &wup_pattern;
+    config->pattern_bits = 3;
+    config->resolution_ns = 1000;
+}
+
+static bool validate(TCAN1463Q1Simulator* sim, const StimulusConfig* config) {
+    if (config->period_ns == 0) return false;
+
+    if (!config->bus) {
+        bool is_input = false;
+        if (!tcan1463q1_simulator_get_pin_info(sim, config->pin, &is_input, NULL, NULL, NULL) ||
+            !is_input) {
+            return false;
+        }
+    } else if (config->type == STIMULUS_RIPPLE) {
+        return false;
+    }
+
+    switch (config->type) {
+        case STIMULUS_SQUARE:  return true;
+        case STIMULUS_PATTERN: return config->pattern && config->pattern_bits > 0;
+        case STIMULUS_PRBS:    return prbs_tap(config->prbs_order) != 0;
+        case STIMULUS_RIPPLE:  return config->ripple_period_ns > 0;
+        default:               return false;
+    }
+}
+
+/**
+ * PRBS bit at an index; steps the LFSR forward from the cached position
+ */
+static bool prbs_bit(StimulusGenerator* gen, uint64_t index) {
+    unsigned order = gen->config.prbs_order;
+    unsigned tap = prbs_tap(order);
+    uint32_t mask = (1u << order) - 1;
+
+    if (index < gen->prbs_index) {
+        gen->prbs_index = 0;
+        gen->prbs_state = mask;
+    }
+    while (gen->prbs_index < index) {
+        uint32_t feedback = ((gen->prbs_state >> (order - 1)) ^ (gen->prbs_state >> (tap - 1))) & 1u;
+        gen->prbs_state = ((gen->prbs_state << 1) | feedback) & mask;
+        gen->prbs_index++;
+    }
+    return (gen->prbs_state & 1u) != 0;
+}
+
+/**
+ * Value of a generator at a time and the time of its next edge
+ * @param high Digital level
+ * @param voltage Analog voltage (ripple)
+ * @return Time of the next edge after now
+ */
+static uint64_t evaluate(StimulusGenerator* gen, uint64_t now, bool* high, double* voltage) {
+    const StimulusConfig* c = &gen->config;
+    *high = c->idle_high;
+    *voltage = c->offset_v;
+
+    if (now < c->start_ns) return c->start_ns;
+    if (c->stop_ns && now >= c->stop_ns) return NO_EDGE;
+
+    uint64_t rel = now - c->start_ns;
+    uint64_t index = rel / c->period_ns;
+    uint64_t next = c->start_ns + (index + 1) * c->period_ns;
+
+    switch (c->type) {
+        case STIMULUS_SQUARE: {
+            uint64_t phase = rel % c->period_ns;
+            if (c->high_ns == 0 || c->high_ns >= c->period_ns) {
+                *high = c->high_ns != 0;
+                next = NO_EDGE;
+            } else {
+                *high = phase < c->high_ns;
+                next = now - phase + (*high ? c->high_ns : c->period_ns);
+            }
+            break;
+        }
+        case STIMULUS_PATTERN:
+            if (!c->repeat && index >= c->pattern_bits) return NO_EDGE;
+            index %= c->pattern_bits;
+            *high = (gen->pattern[index / 8] >> (7 - index % 8)) & 1u;
+            break;
+        case STIMULUS_PRBS:
+            *high = prbs_bit(gen, index);
+            break;
+        case STIMULUS_RIPPLE: {
+            double t = (double)(index * c->period_ns);
+            *voltage = c->offset_v +
+                       c->amplitude_v * sin(2.0 * M_PI * t / (double)c->ripple_period_ns);
+            break;
+        }
+    }
+
+    if (c->stop_ns && next > c->stop_ns) next = c->stop_ns;
+    if (c->resolution_ns && next - now > c->resolution_ns) next = now + c->resolution_ns;
+    return next;
+}
+
+static void drive(StimulusGenerator* gen, TCAN1463Q1Simulator* sim, bool high, double voltage) {
+    const StimulusConfig* c = &gen->config;
+    if (c->bus) {
+        tcan1463q1_simulator_set_remote_dominant(sim, !high);
+    } else if (c->type == STIMULUS_RIPPLE) {
+        tcan1463q1_simulator_set_pin(sim, c->pin, PIN_STATE_ANALOG, voltage);
+    } else {
+        tcan1463q1_simulator_set_pin(sim, c->pin, high ? PIN_STATE_HIGH : PIN_STATE_LOW,
+                                     high ? c->high_v : c->low_v);
+    }
+}
+
+void stimulus_set_apply(StimulusSet* set, TCAN1463Q1Simulator* sim, uint64_t now) {
+    for (size_t i = 0; i < set->count; i++) {
+        StimulusGenerator* gen = &set->generators[i];
+        // Re-evaluate on an edge, or when time moved back (reset, restore)
+        if (now < gen->next_ns && now >= gen->last_ns) continue;
+
+        bool high;
+        double voltage;
+        gen->next_ns = evaluate(gen, now, &high, &voltage);
+        gen->last_ns = now;
+        drive(gen, sim, high, voltage);
+    }
+}
+
+uint64_t stimulus_set_next_ns(const StimulusSet* set) {
+    uint64_t next = NO_EDGE;
+    for (size_t i = 0; i < set->count; i++) {
+        if (set->generators[i].next_ns < next) next = set->generators[i].next_ns;
+    }
+    return next;
+}
+
+void stimulus_set_destroy(StimulusSet* set) {
+    if (!set) return;
+
+    for (size_t i = 0; i < set->count; i++) {
+        free(set->generators[i].pattern);
+    }
+    free(set->generators);
+    free(set);
+}
+
+int tcan1463q1_stimulus_attach(TCAN1463Q1Simulator* sim, const StimulusConfig* config) {
+    if (!sim || !config || !validate(sim, config)) return -1;
+
+    if (!sim->stimulus) {
+        sim->stimulus = (StimulusSet*)calloc(1, sizeof(StimulusSet));
+        if (!sim->stimulus) return -1;
+    }
+    StimulusSet* set = sim->stimulus;
+
+    if (set->count == set->capacity) {
+        size_t capacity = set->capacity ? set->capacity * 2 : 4;
+        StimulusGenerator* generators = (StimulusGenerator*)realloc(
+            set->generators, capacity * sizeof(StimulusGenerator));
+        if (!generators) return -1;
+        set->generators = generators;
+        set->capacity = capacity;
+    }
+
+    StimulusGenerator* gen = &set->generators[set->count];
+    memset(gen, 0, sizeof(StimulusGenerator));
+    gen->config = *config;
+    gen->config.pattern = NULL;
+    if (config->type == STIMULUS_PATTERN) {
+        size_t bytes = (config->pattern_bits + 7) / 8;
+        gen->pattern = (uint8_t*)malloc(bytes);
+        if (!gen->pattern) return -1;
+        memcpy(gen->pattern, config->pattern, bytes);
+    }
+    gen->prbs_state = (1u << config->prbs_order) - 1;
+    gen->id = set->next_id++;
+
+    // First evaluation at the current time
+    gen->next_ns = 0;
+    gen->last_ns = 0;
+    set->count++;
+    stimulus_set_apply(set, sim, tcan1463q1_simulator_get_time_ns(sim));
+    return gen->id;
+}
+
+bool tcan1463q1_stimulus_detach(TCAN1463Q1Simulator* sim, int id) {
+    if (!sim || !sim->stimulus) return false;
+
+    StimulusSet* set = sim->stimulus;
+    for (size_t i = 0; i < set->count; i++) {
+        if (set->generators[i].id != id) continue;
+        free(set->generators[i].pattern);
+        set->generators[i] = set->generators[--set->count];
+        return true;
+    }
+    return false;
+}
+
+void tcan1463q1_stimulus_detach_all(TCAN1463Q1Simulator* sim) {
+    if (!sim) return;
+
+    stimulus_set_destroy(sim->stimulus);
+    sim->stimulus = NULL;
+}
+
+uint64_t tcan1463q1_stimulus_next_edge_ns(TCAN1463Q1Simulator* sim) {
+    if (!sim || !sim->stimulus) return NO_EDGE;
+    return stimulus_set_next_ns(sim->stimulus);
+}
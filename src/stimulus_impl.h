@@ -0,0 +1,18 @@
+#ifndef STIMULUS_IMPL_H
+#define STIMULUS_IMPL_H
+
+#include "tcan1463q1_stimulus.h"
+
+/**
+ * Engine side of the stimulus generators (used by the simulator step)
+ */
+
+// Apply every generator edge due at now
+void stimulus_set_apply(StimulusSet* set, TCAN1463Q1Simulator* sim, uint64_t now);
+
+// Earliest pending edge (UINT64_MAX if none)
+uint64_t stimulus_set_next_ns(const StimulusSet* set);
+
+void stimulus_set_destroy(StimulusSet* set);
+
+#endif // STIMULUS_IMPL_H
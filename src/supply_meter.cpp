@@ -0,0 +1,86 @@
+#include "supply_meter.h"
+#include "supply_meter_impl.h"
+#include "tcan1463q1_simulator.h"
+#include <string.h>
+
+void supply_meter_init(SupplyMeter* meter) {
+    if (!meter) return;
+
+    // Starts unpowered in Off mode: all currents zero
+    memset(meter, 0, sizeof(SupplyMeter));
+    meter->mode = MODE_OFF;
+    meter->bias = BIAS_STATE_OFF;
+}
+
+void supply_meter_update(SupplyMeter* meter, OperatingMode mode, bool driver_dominant,
+                         BusBiasState bias, double vsup, double vcc, double vio,
+                         double rl_resistance, uint64_t current_time) {
+    supply_meter_update_impl(DefaultProfile(), meter, mode, driver_dominant, bias,
+                             vsup, vcc, vio, rl_resistance, current_time);
+}
+
+/**
+ * Add an interval of the current load point to a set of totals
+ */
+static void accumulate(const SupplyMeter* meter, uint64_t duration_ns, SupplyEnergy* energy) {
+    double seconds = duration_ns * 1e-9;
+
+    energy->residency_ns[meter->mode] += duration_ns;
+    for (int rail = 0; rail < SUPPLY_COUNT; rail++) {
+        double charge = meter->currents[rail] * seconds;
+        energy->charge[meter->mode][rail] += charge;
+        energy->energy[meter->mode][rail] += charge * meter->voltages[rail];
+    }
+}
+
+void supply_meter_close_interval(SupplyMeter* meter, uint64_t current_time) {
+    if (!meter || current_time < meter->interval_start) return;
+
+    accumulate(meter, current_time - meter->interval_start, &meter->closed);
+    meter->interval_start = current_time;
+}
+
+void supply_meter_get_energy(const SupplyMeter* meter, uint64_t current_time,
+                             SupplyEnergy* energy) {
+    if (!meter || !energy) return;
+
+    *energy = meter->closed;
+    if (current_time > meter->interval_start) {
+        accumulate(meter, current_time - meter->interval_start, energy);
+    }
+}
+
+void tcan1463q1_supply_energy_merge(SupplyEnergy* total, const SupplyEnergy* energy) {
+    if (!total || !energy) return;
+
+    for (int mode = 0; mode < OPERATING_MODE_COUNT; mode++) {
+        total->residency_ns[mode] += energy->residency_ns[mode];
+        for (int rail = 0; rail < SUPPLY_COUNT; rail++) {
+            total->charge[mode][rail] += energy->charge[mode][rail];
+            total->energy[mode][rail] += energy->energy[mode][rail];
+        }
+    }
+    total->transitions += energy->transitions;
+}
+
+double tcan1463q1_supply_energy_total(const SupplyEnergy* energy, SupplyRail rail) {
+    if (!energy || rail < 0 || rail >= SUPPLY_COUNT) return 0.0;
+
+    double total = 0.0;
+    for (int mode = 0; mode < OPERATING_MODE_COUNT; mode++) {
+        total += energy->energy[mode][rail];
+    }
+    return total;
+}
+
+double tcan1463q1_supply_energy_average_current(const SupplyEnergy* energy, SupplyRail rail) {
+    if (!energy || rail < 0 || rail >= SUPPLY_COUNT) return 0.0;
+
+    double charge = 0.0;
+    uint64_t duration_ns = 0;
+    for (int mode = 0; mode < OPERATING_MODE_COUNT; mode++) {
+        charge += energy->charge[mode][rail];
+        duration_ns += energy->residency_ns[mode];
+    }
+    return duration_ns > 0 ? charge / (duration_ns * 1e-9) : 0.0;
+}
@@ -0,0 +1,94 @@
+#ifndef SUPPLY_METER_IMPL_H
+#define SUPPLY_METER_IMPL_H
+
+#include "supply_meter.h"
+#include "device_profiles.h"
+
+/**
+ * Profile-specialized supply meter logic
+ */
+
+template <typename Profile>
+inline void supply_meter_get_currents_impl(const Profile& profile, OperatingMode mode,
+                                           bool driver_dominant, BusBiasState bias,
+                                           const double voltages[SUPPLY_COUNT],
+                                           double rl_resistance,
+                                           double currents[SUPPLY_COUNT]) {
+    const DeviceParams& p = profile.params;
+    bool active = (mode == MODE_NORMAL || mode == MODE_SILENT);
+
+    // VSUP: low-power logic, plus the autonomous bias source
+    double isup;
+    switch (mode) {
+        case MODE_NORMAL:
+        case MODE_SILENT:
+            isup = p.isup_normal;
+            break;
+        case MODE_STANDBY:
+        case MODE_GO_TO_SLEEP:
+            isup = p.isup_standby;
+            break;
+        default:
+            isup = p.isup_sleep;
+            break;
+    }
+    if (bias == BIAS_STATE_AUTONOMOUS_ACTIVE) {
+        isup += p.isup_bias;
+    }
+
+    // VCC: CAN driver and receiver; dominant adds the bus load current
+    double icc;
+    if (mode == MODE_NORMAL) {
+        icc = p.icc_recessive;
+        if (driver_dominant) {
+            icc = p.icc_dominant;
+            if (rl_resistance > 0.0) {
+                icc += (p.canh_dominant - p.canl_dominant) / rl_resistance;
+            }
+        }
+    } else if (mode == MODE_SILENT) {
+        icc = p.icc_silent;
+    } else {
+        icc = p.icc_low_power;
+    }
+
+    double iio = active ? p.iio_normal : p.iio_low_power;
+
+    // Unpowered rails draw nothing
+    currents[SUPPLY_VSUP] = voltages[SUPPLY_VSUP] > 0.0 ? isup : 0.0;
+    currents[SUPPLY_VCC] = voltages[SUPPLY_VCC] > 0.0 ? icc : 0.0;
+    currents[SUPPLY_VIO] = voltages[SUPPLY_VIO] > 0.0 ? iio : 0.0;
+}
+
+template <typename Profile>
+inline void supply_meter_update_impl(const Profile& profile, SupplyMeter* meter,
+                                     OperatingMode mode, bool driver_dominant,
+                                     BusBiasState bias, double vsup, double vcc, double vio,
+                                     double rl_resistance, uint64_t current_time) {
+    if (!meter) return;
+
+    // Currents are constant within a load point: nothing to do per step.
+    // The bus load only enters the dominant ICC (VOD / RL).
+    bool loaded = mode == MODE_NORMAL && driver_dominant;
+    if (mode == meter->mode && driver_dominant == meter->driver_dominant &&
+        bias == meter->bias && vsup == meter->voltages[SUPPLY_VSUP] &&
+        vcc == meter->voltages[SUPPLY_VCC] && vio == meter->voltages[SUPPLY_VIO] &&
+        (!loaded || rl_resistance == meter->rl_resistance)) {
+        return;
+    }
+
+    supply_meter_close_interval(meter, current_time);
+    meter->closed.transitions++;
+
+    meter->mode = mode;
+    meter->driver_dominant = driver_dominant;
+    meter->bias = bias;
+    meter->voltages[SUPPLY_VSUP] = vsup;
+    meter->voltages[SUPPLY_VCC] = vcc;
+    meter->voltages[SUPPLY_VIO] = vio;
+    meter->rl_resistance = rl_resistance;
+    supply_meter_get_currents_impl(profile, mode, driver_dominant, bias, meter->voltages,
+                                   rl_resistance, meter->currents);
+}
+
+#endif // SUPPLY_METER_IMPL_H
@@ -0,0 +1,360 @@
+#include "tcan1463q1_timing_analyzer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Records read per block from an edge trace (1 MiB)
+#define TRACE_BLOCK_RECORDS 65536
+
+// Longest pulse (in bits) used for receiver symmetry; longer pulses are idle
+#define SYMMETRY_MAX_BITS 10
+
+/**
+ * Matching of TXD edges to one downstream signal (RXD or bus)
+ */
+typedef struct {
+    bool pending;               // TXD edge waiting for its downstream edge
+    uint64_t pending_time;
+    bool pending_level;
+    bool last_delay_valid;      // Previous edge was matched (asymmetry needs both)
+    int64_t last_delay;
+    uint64_t unmatched;
+} EdgeMatcher;
+
+enum { MATCH_RXD, MATCH_BUS, MATCH_COUNT };
+
+struct TimingAnalyzer {
+    TimingAnalyzerConfig config;
+    uint64_t bit_time_ns;
+    bool have_level[EDGE_SIGNAL_COUNT];
+    bool levels[EDGE_SIGNAL_COUNT];
+    uint64_t last_edge[EDGE_SIGNAL_COUNT];
+    EdgeMatcher matchers[MATCH_COUNT];
+    uint64_t edges;
+    TimingHistogram histograms[TIMING_METRIC_COUNT];
+};
+
+static void histogram_add(TimingHistogram* h, int64_t bin_width, int64_t value, uint64_t time) {
+    if (h->count == 0 || value < h->min_ns) h->min_ns = value;
+    if (h->count == 0 || value > h->max_ns) h->max_ns = value;
+    if (h->count == 0 || llabs(value) > llabs(h->worst_ns)) {
+        h->worst_ns = value;
+        h->worst_time_ns = time;
+    }
+    h->count++;
+    h->sum_ns += (double)value;
+
+    // Floor division so negative values land in the right bin
+    int64_t bin = value / bin_width;
+    if (value % bin_width != 0 && value < 0) bin--;
+    bin += TIMING_HISTOGRAM_BINS / 2;
+
+    if (bin < 0) {
+        h->underflow++;
+    } else if (bin >= TIMING_HISTOGRAM_BINS) {
+        h->overflow++;
+    } else {
+        h->bins[bin]++;
+    }
+}
+
+void tcan1463q1_timing_analyzer_config_init(TimingAnalyzerConfig* config) {
+    if (!config) return;
+
+    config->bitrate = 500000;
+    config->bin_width_ns = 10;
+}
+
+TimingAnalyzer* tcan1463q1_timing_analyzer_create(const TimingAnalyzerConfig* config) {
+    TimingAnalyzer* analyzer = (TimingAnalyzer*)malloc(sizeof(TimingAnalyzer));
+    if (!analyzer) return NULL;
+
+    if (config) {
+        analyzer->config = *config;
+    } else {
+        tcan1463q1_timing_analyzer_config_init(&analyzer->config);
+    }
+    if (analyzer->config.bin_width_ns <= 0) analyzer->config.bin_width_ns = 1;
+
+    tcan1463q1_timing_analyzer_reset(analyzer);
+    return analyzer;
+}
+
+void tcan1463q1_timing_analyzer_destroy(TimingAnalyzer* analyzer) {
+    free(analyzer);
+}
+
+void tcan1463q1_timing_analyzer_reset(TimingAnalyzer* analyzer) {
+    if (!analyzer) return;
+
+    TimingAnalyzerConfig config = analyzer->config;
+    memset(analyzer, 0, sizeof(TimingAnalyzer));
+    analyzer->config = config;
+    analyzer->bit_time_ns = config.bitrate ? 1000000000ULL / config.bitrate : 0;
+}
+
+/**
+ * Match a downstream edge against the pending TXD edge
+ */
+static void match_edge(TimingAnalyzer* analyzer, int match, bool level, uint64_t time,
+                       TimingMetric delay_metric, TimingMetric asymmetry_metric) {
+    EdgeMatcher* m = &analyzer->matchers[match];
+    int64_t bin_width = analyzer->config.bin_width_ns;
+
+    if (!m->pending || m->pending_level != level || time < m->pending_time) {
+        // Caused by another node (or a glitch): breaks the pulse pairing
+        m->last_delay_valid = false;
+        return;
+    }
+
+    int64_t delay = (int64_t)(time - m->pending_time);
+    histogram_add(&analyzer->histograms[delay_metric + (level ? 1 : 0)], bin_width, delay, time);
+
+    // The pulse that just ended had the opposite polarity; its width
+    // differs from the TXD pulse by the difference of the two delays
+    if (m->last_delay_valid) {
+        TimingMetric metric = (TimingMetric)(asymmetry_metric + (level ? 0 : 1));
+        histogram_add(&analyzer->histograms[metric], bin_width, delay - m->last_delay, time);
+    }
+
+    m->pending = false;
+    m->last_delay = delay;
+    m->last_delay_valid = true;
+}
+
+static void receiver_symmetry(TimingAnalyzer* analyzer, bool level, uint64_t time) {
+    uint64_t bit = analyzer->bit_time_ns;
+    if (bit == 0 || !analyzer->have_level[EDGE_SIGNAL_RXD]) return;
+
+    uint64_t width = time - analyzer->last_edge[EDGE_SIGNAL_RXD];
+    uint64_t bits = (width + bit / 2) / bit;
+    if (bits == 0 || bits > SYMMETRY_MAX_BITS) return;
+
+    // Pulse polarity is the level before this edge
+    TimingMetric metric = level ? TIMING_RXD_SYMMETRY_DOMINANT : TIMING_RXD_SYMMETRY_RECESSIVE;
+    histogram_add(&analyzer->histograms[metric], analyzer->config.bin_width_ns,
+                  (int64_t)width - (int64_t)(bits * bit), time);
+}
+
+/**
+ * Process one edge; inlined into the block loop of feed()
+ */
+static inline void process_edge(TimingAnalyzer* analyzer, EdgeSignal signal, bool level,
+                                uint64_t time_ns) {
+    if (signal >= EDGE_SIGNAL_COUNT) return;
+    if (analyzer->have_level[signal] && analyzer->levels[signal] == level) return;
+
+    // The first sample of a signal only establishes its level
+    bool is_edge = analyzer->have_level[signal];
+
+    switch (signal) {
+        case EDGE_SIGNAL_TXD:
+            if (!is_edge) break;
+            for (int i = 0; i < MATCH_COUNT; i++) {
+                EdgeMatcher* m = &analyzer->matchers[i];
+                // Signals absent from the trace are not counted as unmatched
+                bool traced = analyzer->have_level[i == MATCH_RXD ? EDGE_SIGNAL_RXD : EDGE_SIGNAL_BUS];
+                if (m->pending && traced) {
+                    m->unmatched++;
+                    m->last_delay_valid = false;
+                }
+                m->pending = true;
+                m->pending_time = time_ns;
+                m->pending_level = level;
+            }
+            break;
+
+        case EDGE_SIGNAL_RXD:
+            if (!is_edge) break;
+            match_edge(analyzer, MATCH_RXD, level, time_ns,
+                       TIMING_LOOP_DELAY_DOMINANT, TIMING_RXD_ASYMMETRY_DOMINANT);
+            receiver_symmetry(analyzer, level, time_ns);
+            break;
+
+        case EDGE_SIGNAL_BUS:
+            if (!is_edge) break;
+            match_edge(analyzer, MATCH_BUS, level, time_ns,
+                       TIMING_BUS_DELAY_DOMINANT, TIMING_BUS_ASYMMETRY_DOMINANT);
+            break;
+
+        default:
+            break;
+    }
+
+    if (is_edge) analyzer->edges++;
+    analyzer->have_level[signal] = true;
+    analyzer->levels[signal] = level;
+    analyzer->last_edge[signal] = time_ns;
+}
+
+void tcan1463q1_timing_analyzer_feed_edge(TimingAnalyzer* analyzer, EdgeSignal signal,
+                                          bool level, uint64_t time_ns) {
+    if (!analyzer) return;
+    process_edge(analyzer, signal, level, time_ns);
+}
+
+void tcan1463q1_timing_analyzer_feed(TimingAnalyzer* analyzer, const EdgeRecord* edges,
+                                     size_t count) {
+    if (!analyzer || !edges) return;
+
+    for (size_t i = 0; i < count; i++) {
+        process_edge(analyzer, (EdgeSignal)edges[i].signal, edges[i].level != 0,
+                     edges[i].time_ns);
+    }
+}
+
+int64_t tcan1463q1_timing_analyzer_process_file(TimingAnalyzer* analyzer, FILE* file) {
+    if (!analyzer || !file) return -1;
+
+    EdgeRecord* block = (EdgeRecord*)malloc(TRACE_BLOCK_RECORDS * sizeof(EdgeRecord));
+    if (!block) return -1;
+
+    int64_t total = 0;
+    size_t partial = 0;     // Bytes of a record split across reads
+    for (;;) {
+        size_t bytes = fread((char*)block + partial, 1,
+                             TRACE_BLOCK_RECORDS * sizeof(EdgeRecord) - partial, file);
+        bytes += partial;
+        size_t records = bytes / sizeof(EdgeRecord);
+        partial = bytes % sizeof(EdgeRecord);
+
+        tcan1463q1_timing_analyzer_feed(analyzer, block, records);
+        total += (int64_t)records;
+
+        if (partial) memmove(block, block + records, partial);
+        if (feof(file) || ferror(file)) break;
+    }
+
+    bool failed = ferror(file) || partial != 0;
+    free(block);
+    return failed ? -1 : total;
+}
+
+size_t tcan1463q1_edge_probe_sample(EdgeProbe* probe, TCAN1463Q1Simulator* sim,
+                                    EdgeRecord edges[EDGE_SIGNAL_COUNT]) {
+    if (!probe || !sim || !edges) return 0;
+
+    SimulatorObservableState state;
+    tcan1463q1_simulator_get_observable_state(sim, &state);
+    const DeviceParams* params = tcan1463q1_simulator_get_device_params(sim);
+
+    bool levels[EDGE_SIGNAL_COUNT];
+    levels[EDGE_SIGNAL_TXD] = state.pin_states[PIN_TXD] == PIN_STATE_HIGH;
+    levels[EDGE_SIGNAL_RXD] = state.pin_states[PIN_RXD] == PIN_STATE_HIGH;
+
+    // Bus level with the receiver thresholds; the indeterminate band keeps
+    // the previous level
+    double vdiff = state.pin_voltages[PIN_CANH] - state.pin_voltages[PIN_CANL];
+    if (vdiff >= params->vdiff_dominant) {
+        levels[EDGE_SIGNAL_BUS] = false;
+    } else if (vdiff <= params->vdiff_recessive || !probe->valid) {
+        levels[EDGE_SIGNAL_BUS] = true;
+    } else {
+        levels[EDGE_SIGNAL_BUS] = probe->levels[EDGE_SIGNAL_BUS];
+    }
+
+    size_t count = 0;
+    for (int i = 0; i < EDGE_SIGNAL_COUNT; i++) {
+        if (probe->valid && levels[i] != probe->levels[i]) {
+            EdgeRecord* edge = &edges[count++];
+            memset(edge, 0, sizeof(EdgeRecord));
+            edge->time_ns = state.time_ns;
+            edge->signal = (uint8_t)i;
+            edge->level = levels[i] ? 1 : 0;
+        }
+        probe->levels[i] = levels[i];
+    }
+    probe->valid = true;
+    return count;
+}
+
+void tcan1463q1_timing_analyzer_observe(TimingAnalyzer* analyzer, EdgeProbe* probe,
+                                        TCAN1463Q1Simulator* sim) {
+    if (!analyzer || !probe || !sim) return;
+
+    // Seed the analyzer with the initial levels on the first sample
+    bool first = !probe->valid;
+    EdgeRecord edges[EDGE_SIGNAL_COUNT];
+    size_t count = tcan1463q1_edge_probe_sample(probe, sim, edges);
+    if (first) {
+        SimulatorObservableState state;
+        tcan1463q1_simulator_get_observable_state(sim, &state);
+        for (int i = 0; i < EDGE_SIGNAL_COUNT; i++) {
+            tcan1463q1_timing_analyzer_feed_edge(analyzer, (EdgeSignal)i, probe->levels[i],
+                                                 state.time_ns);
+        }
+    }
+    tcan1463q1_timing_analyzer_feed(analyzer, edges, count);
+}
+
+const TimingHistogram* tcan1463q1_timing_analyzer_get_histogram(const TimingAnalyzer* analyzer,
+                                                                 TimingMetric metric) {
+    if (!analyzer || metric >= TIMING_METRIC_COUNT) return NULL;
+    return &analyzer->histograms[metric];
+}
+
+uint64_t tcan1463q1_timing_analyzer_edge_count(const TimingAnalyzer* analyzer) {
+    return analyzer ? analyzer->edges : 0;
+}
+
+uint64_t tcan1463q1_timing_analyzer_unmatched(const TimingAnalyzer* analyzer, EdgeSignal signal) {
+    if (!analyzer) return 0;
+    if (signal == EDGE_SIGNAL_RXD) return analyzer->matchers[MATCH_RXD].unmatched;
+    if (signal == EDGE_SIGNAL_BUS) return analyzer->matchers[MATCH_BUS].unmatched;
+    return 0;
+}
+
+const char* tcan1463q1_timing_metric_name(TimingMetric metric) {
+    switch (metric) {
+        case TIMING_LOOP_DELAY_DOMINANT: return "loop_delay_dominant";
+        case TIMING_LOOP_DELAY_RECESSIVE: return "loop_delay_recessive";
+        case TIMING_BUS_DELAY_DOMINANT: return "bus_delay_dominant";
+        case TIMING_BUS_DELAY_RECESSIVE: return "bus_delay_recessive";
+        case TIMING_RXD_ASYMMETRY_DOMINANT: return "rxd_asymmetry_dominant";
+        case TIMING_RXD_ASYMMETRY_RECESSIVE: return "rxd_asymmetry_recessive";
+        case TIMING_BUS_ASYMMETRY_DOMINANT: return "bus_asymmetry_dominant";
+        case TIMING_BUS_ASYMMETRY_RECESSIVE: return "bus_asymmetry_recessive";
+        case TIMING_RXD_SYMMETRY_DOMINANT: return "rxd_symmetry_dominant";
+        case TIMING_RXD_SYMMETRY_RECESSIVE: return "rxd_symmetry_recessive";
+        default: return "UNKNOWN";
+    }
+}
+
+void tcan1463q1_timing_analyzer_print(const TimingAnalyzer* analyzer, FILE* out) {
+    if (!analyzer || !out) return;
+
+    int64_t width = analyzer->config.bin_width_ns;
+    fprintf(out, "Edges: %llu (unmatched TXD edges: rxd=%llu bus=%llu), bit time %llu ns\n",
+            (unsigned long long)analyzer->edges,
+            (unsigned long long)analyzer->matchers[MATCH_RXD].unmatched,
+            (unsigned long long)analyzer->matchers[MATCH_BUS].unmatched,
+            (unsigned long long)analyzer->bit_time_ns);
+
+    for (int m = 0; m < TIMING_METRIC_COUNT; m++) {
+        const TimingHistogram* h = &analyzer->histograms[m];
+        fprintf(out, "%-24s", tcan1463q1_timing_metric_name((TimingMetric)m));
+        if (h->count == 0) {
+            fprintf(out, " no samples\n");
+            continue;
+        }
+        fprintf(out, " n=%llu min=%lld mean=%.1f max=%lld worst=%lld@%llu ns\n",
+                (unsigned long long)h->count, (long long)h->min_ns, h->sum_ns / (double)h->count,
+                (long long)h->max_ns, (long long)h->worst_ns,
+                (unsigned long long)h->worst_time_ns);
+
+        if (h->underflow) {
+            fprintf(out, "    < %lld: %llu\n", (long long)(-(TIMING_HISTOGRAM_BINS / 2) * width),
+                    (unsigned long long)h->underflow);
+        }
+        for (int i = 0; i < TIMING_HISTOGRAM_BINS; i++) {
+            if (h->bins[i] == 0) continue;
+            int64_t low = (int64_t)(i - TIMING_HISTOGRAM_BINS / 2) * width;
+            fprintf(out, "    [%lld, %lld): %llu\n", (long long)low, (long long)(low + width),
+                    (unsigned long long)h->bins[i]);
+        }
+        if (h->overflow) {
+            fprintf(out, "    >= %lld: %llu\n", (long long)((TIMING_HISTOGRAM_BINS / 2) * width),
+                    (unsigned long long)h->overflow);
+        }
+    }
+}
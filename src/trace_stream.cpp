@@ -0,0 +1,288 @@
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE             // vmsplice, F_SETPIPE_SZ
+#endif
+#endif
+
+#include "tcan1463q1_trace_stream.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+#define DEFAULT_CHUNK_BYTES (1u << 20)
+#define TRACE_PIN_COUNT     (PIN_INH_MASK + 1)  // Digital pins TXD..INH_MASK
+#define TRACE_FLAG_COUNT    12                  // Bits used in the flag word
+
+struct TraceStream {
+    int fd;
+    bool owns_fd;
+    bool is_socket;
+    bool splice;                // vmsplice full chunks (Linux pipe)
+    bool failed;
+
+    // Chunks are mmap'ed so pages still referenced by the pipe outlive close
+    uint8_t* chunks[2];
+    int chunk_count;
+    int current;
+    size_t chunk_bytes;
+    size_t used;
+
+    uint32_t classes;
+    bool observed;
+    PinState pins[TRACE_PIN_COUNT];
+    uint32_t flags;
+    OperatingMode mode;
+
+    TraceStreamStats stats;
+};
+
+void tcan1463q1_trace_stream_config_init(TraceStreamConfig* config) {
+    if (!config) return;
+    config->chunk_bytes = DEFAULT_CHUNK_BYTES;
+    config->classes = TRACE_ALL;
+}
+
+// Set up vmsplice: the pipe must hold no more than one chunk, so that a
+// full chunk entering it means the previous one has been read
+static bool setup_splice(TraceStream* stream) {
+#if defined(__linux__) && defined(F_SETPIPE_SZ)
+    fcntl(stream->fd, F_SETPIPE_SZ, (int)stream->chunk_bytes);
+    int capacity = fcntl(stream->fd, F_GETPIPE_SZ);
+    return capacity > 0 && (size_t)capacity <= stream->chunk_bytes;
+#else
+    (void)stream;
+    return false;
+#endif
+}
+
+TraceStream* tcan1463q1_trace_stream_open_fd(int fd, const TraceStreamConfig* config) {
+    if (fd < 0) return NULL;
+
+    TraceStreamConfig defaults;
+    if (!config) {
+        tcan1463q1_trace_stream_config_init(&defaults);
+        config = &defaults;
+    }
+
+    TraceStream* stream = (TraceStream*)calloc(1, sizeof(TraceStream));
+    if (!stream) return NULL;
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t bytes = config->chunk_bytes ? config->chunk_bytes : DEFAULT_CHUNK_BYTES;
+    stream->chunk_bytes = (bytes + page - 1) / page * page;
+    stream->fd = fd;
+    stream->classes = config->classes;
+
+    struct stat info;
+    if (fstat(fd, &info) == 0) {
+        stream->is_socket = S_ISSOCK(info.st_mode);
+        stream->splice = S_ISFIFO(info.st_mode) && setup_splice(stream);
+    }
+
+    stream->chunk_count = stream->splice ? 2 : 1;
+    for (int i = 0; i < stream->chunk_count; i++) {
+        void* chunk = mmap(NULL, stream->chunk_bytes, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (chunk == MAP_FAILED) {
+            for (int j = 0; j < i; j++) munmap(stream->chunks[j], stream->chunk_bytes);
+            free(stream);
+            return NULL;
+        }
+        stream->chunks[i] = (uint8_t*)chunk;
+    }
+    return stream;
+}
+
+TraceStream* tcan1463q1_trace_stream_connect(const char* socket_path,
+                                             const TraceStreamConfig* config) {
+    if (!socket_path) return NULL;
+
+    struct sockaddr_un address;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) return NULL;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return NULL;
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    TraceStream* stream = tcan1463q1_trace_stream_open_fd(fd, config);
+    if (!stream) {
+        close(fd);
+        return NULL;
+    }
+    stream->owns_fd = true;
+    return stream;
+}
+
+// Copying write of a whole buffer
+static bool write_all(TraceStream* stream, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = stream->is_socket ? send(stream->fd, data, size, MSG_NOSIGNAL)
+                                      : write(stream->fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        stream->stats.writes++;
+        stream->stats.bytes += (uint64_t)n;
+        data += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static bool splice_all(TraceStream* stream, uint8_t* data, size_t size) {
+#ifdef __linux__
+    while (size > 0) {
+        struct iovec iov = { data, size };
+        ssize_t n = vmsplice(stream->fd, &iov, 1, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        stream->stats.writes++;
+        stream->stats.bytes += (uint64_t)n;
+        stream->stats.spliced_bytes += (uint64_t)n;
+        data += n;
+        size -= (size_t)n;
+    }
+    return true;
+#else
+    return write_all(stream, data, size);
+#endif
+}
+
+// Hand over the current chunk. Only full chunks are spliced; a spliced
+// chunk is left to the pipe until the other one has been spliced after it.
+static bool emit(TraceStream* stream) {
+    if (stream->failed || stream->used == 0) return !stream->failed;
+
+    uint8_t* chunk = stream->chunks[stream->current];
+    bool ok;
+    if (stream->splice && stream->used == stream->chunk_bytes) {
+        ok = splice_all(stream, chunk, stream->used);
+        stream->current = (stream->current + 1) % stream->chunk_count;
+    } else {
+        ok = write_all(stream, chunk, stream->used);
+    }
+    stream->used = 0;
+    if (!ok) stream->failed = true;
+    return ok;
+}
+
+bool tcan1463q1_trace_stream_write(TraceStream* stream, const EdgeRecord* records,
+                                   size_t count) {
+    if (!stream || (!records && count)) return false;
+    if (stream->failed) return false;
+
+    const uint8_t* data = (const uint8_t*)records;
+    size_t size = count * sizeof(EdgeRecord);
+    while (size > 0) {
+        size_t room = stream->chunk_bytes - stream->used;
+        size_t n = size < room ? size : room;
+        memcpy(stream->chunks[stream->current] + stream->used, data, n);
+        stream->used += n;
+        data += n;
+        size -= n;
+        if (stream->used == stream->chunk_bytes && !emit(stream)) return false;
+    }
+    stream->stats.records += count;
+    return true;
+}
+
+static void add_record(EdgeRecord* records, size_t* count, uint64_t time_ns, int signal,
+                       int level) {
+    EdgeRecord* record = &records[(*count)++];
+    memset(record, 0, sizeof(EdgeRecord));
+    record->time_ns = time_ns;
+    record->signal = (uint8_t)signal;
+    record->level = (uint8_t)level;
+}
+
+bool tcan1463q1_trace_stream_observe(TraceStream* stream, EdgeProbe* probe,
+                                     TCAN1463Q1Simulator* sim) {
+    if (!stream || !probe || !sim) return false;
+
+    EdgeRecord records[EDGE_SIGNAL_COUNT + TRACE_PIN_COUNT + TRACE_FLAG_COUNT + 1];
+    size_t count = 0;
+    bool first = !stream->observed;
+    stream->observed = true;
+
+    SimulatorObservableState state;
+    tcan1463q1_simulator_get_observable_state(sim, &state);
+
+    if (stream->classes & TRACE_EDGES) {
+        bool fresh = !probe->valid;
+        count = tcan1463q1_edge_probe_sample(probe, sim, records);
+        if (fresh) {
+            for (int i = 0; i < EDGE_SIGNAL_COUNT; i++) {
+                add_record(records, &count, state.time_ns, i, probe->levels[i] ? 1 : 0);
+            }
+        }
+    }
+
+    if (stream->classes & TRACE_PINS) {
+        for (int i = 0; i < TRACE_PIN_COUNT; i++) {
+            if (first || state.pin_states[i] != stream->pins[i]) {
+                add_record(records, &count, state.time_ns, TRACE_SIGNAL_PIN_BASE + i,
+                           state.pin_states[i]);
+            }
+            stream->pins[i] = state.pin_states[i];
+        }
+    }
+
+    if (stream->classes & TRACE_FLAGS) {
+        uint32_t changed = first ? (1u << TRACE_FLAG_COUNT) - 1 : state.flags ^ stream->flags;
+        for (int i = 0; i < TRACE_FLAG_COUNT; i++) {
+            if (changed & (1u << i)) {
+                add_record(records, &count, state.time_ns, TRACE_SIGNAL_FLAG_BASE + i,
+                           (state.flags >> i) & 1);
+            }
+        }
+        stream->flags = state.flags;
+    }
+
+    if (stream->classes & TRACE_MODE) {
+        if (first || state.mode != stream->mode) {
+            add_record(records, &count, state.time_ns, TRACE_SIGNAL_MODE, state.mode);
+        }
+        stream->mode = state.mode;
+    }
+
+    return tcan1463q1_trace_stream_write(stream, records, count);
+}
+
+bool tcan1463q1_trace_stream_flush(TraceStream* stream) {
+    if (!stream) return false;
+    return emit(stream);
+}
+
+bool tcan1463q1_trace_stream_close(TraceStream* stream) {
+    if (!stream) return false;
+
+    bool ok = emit(stream);
+    // Unmapping leaves pages the pipe still references to the pipe
+    for (int i = 0; i < stream->chunk_count; i++) {
+        munmap(stream->chunks[i], stream->chunk_bytes);
+    }
+    if (stream->owns_fd) close(stream->fd);
+    free(stream);
+    return ok;
+}
+
+void tcan1463q1_trace_stream_get_stats(const TraceStream* stream, TraceStreamStats* stats) {
+    if (!stats) return;
+    if (!stream) {
+        memset(stats, 0, sizeof(TraceStreamStats));
+        return;
+    }
+    *stats = stream->stats;
+}
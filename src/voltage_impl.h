@@ -0,0 +1,55 @@
+#ifndef VOLTAGE_IMPL_H
+#define VOLTAGE_IMPL_H
+
+#include <math.h>
+#include <stdint.h>
+
+/**
+ * Voltage representation for threshold tests
+ *
+ * Built with TCAN1463Q1_FIXED_POINT, pin voltages are stored on a 1 uV grid
+ * and every threshold test compares integer microvolts, so classification
+ * gives bit-identical results on every host regardless of floating-point
+ * code generation (x87 excess precision, FMA contraction). Otherwise
+ * voltages are compared as doubles.
+ *
+ * Kernels compare voltage_key(a) against voltage_key(threshold); with
+ * constant profile thresholds the threshold key folds at compile time.
+ */
+
+// Nearest microvolt (ties to even), saturated to the int32_t range (+-2147 V)
+inline int32_t voltage_to_uv(double volts) {
+    double uv = volts * 1e6;
+    if (!(uv > (double)INT32_MIN)) return INT32_MIN;    // Also NaN
+    if (uv >= (double)INT32_MAX) return INT32_MAX;
+    return (int32_t)nearbyint(uv);
+}
+
+inline double voltage_from_uv(int32_t uv) {
+    return (double)uv / 1e6;
+}
+
+#ifdef TCAN1463Q1_FIXED_POINT
+typedef int32_t VoltageKey;
+
+inline VoltageKey voltage_key(double volts) {
+    return voltage_to_uv(volts);
+}
+
+// Value stored in a pin
+inline double voltage_store(double volts) {
+    return voltage_from_uv(voltage_to_uv(volts));
+}
+#else
+typedef double VoltageKey;
+
+inline VoltageKey voltage_key(double volts) {
+    return volts;
+}
+
+inline double voltage_store(double volts) {
+    return volts;
+}
+#endif
+
+#endif // VOLTAGE_IMPL_H
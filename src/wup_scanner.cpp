@@ -0,0 +1,331 @@
+#include "tcan1463q1_wup_scanner.h"
+#include "wake_handler.h"
+#include "wake_handler_impl.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+// Smallest chunk worth a worker thread (records or samples)
+#define MIN_CHUNK 65536
+
+/**
+ * Bus edges from an edge trace (other signals are skipped)
+ */
+struct EdgeSource {
+    const EdgeRecord* edges;
+    size_t count;
+
+    bool valid(size_t i) const { return edges[i].signal == EDGE_SIGNAL_BUS; }
+    uint64_t time(size_t i) const { return edges[i].time_ns; }
+    bool recessive(size_t i) const { return edges[i].level != 0; }
+};
+
+/**
+ * Uniformly sampled bus level
+ */
+struct SampleSource {
+    const uint8_t* samples;
+    size_t count;
+    uint64_t start_ns;
+    uint64_t period_ns;
+
+    bool valid(size_t) const { return true; }
+    uint64_t time(size_t i) const { return start_ns + (uint64_t)i * period_ns; }
+    bool recessive(size_t i) const { return samples[i] != 0; }
+};
+
+/**
+ * Evaluation grid: origin + k * step
+ */
+struct Grid {
+    uint64_t origin;
+    uint64_t step;
+
+    // First grid point at or after t
+    uint64_t at_or_after(uint64_t t) const {
+        if (t <= origin) return origin;
+        return origin + (t - origin + step - 1) / step * step;
+    }
+};
+
+/**
+ * Wake handler state machine for one corner
+ */
+struct Detector {
+    DeviceParams params;        // Parameters with the corner applied
+    WakeState state;
+    bool rearm_wait;            // Pattern found, waiting for a recessive sample
+    std::vector<WUPMatch> matches;
+
+    explicit Detector(const WUPScanConfig& config)
+        : params(*tcan1463q1_device_get_params(DEVICE_VARIANT_TCAN1463Q1)), rearm_wait(false) {
+        // The wake handler uses the minimum filter and maximum timeout
+        params.twk_filter.min_ns = config.filter_ns;
+        params.twk_timeout.max_ns = config.timeout_ns;
+        wake_handler_init(&state);
+    }
+
+    // One wake handler evaluation; returns true if the state changed
+    bool evaluate(BusState bus, uint64_t time) {
+        if (rearm_wait) {
+            if (bus == BUS_STATE_DOMINANT) return false;
+            rearm_wait = false;
+        }
+
+        WakeState before = state;
+        wake_handler_process_wup_impl(RuntimeProfile{params}, &state, bus, time);
+
+        if (state.wup_state == WUP_STATE_COMPLETE) {
+            WUPMatch match = {before.wup_timeout_start, time};
+            matches.push_back(match);
+            wake_handler_init(&state);
+            rearm_wait = true;
+            return true;
+        }
+        return state.wup_state != before.wup_state ||
+               state.wup_phase_start != before.wup_phase_start ||
+               state.wup_timeout_start != before.wup_timeout_start;
+    }
+
+    // Earliest time an unchanged evaluation could start changing the state
+    uint64_t next_deadline() const {
+        if (state.wup_state == WUP_STATE_IDLE || state.wup_state == WUP_STATE_COMPLETE) {
+            return UINT64_MAX;
+        }
+        uint64_t phase = state.wup_phase_start + params.twk_filter.min_ns;
+        uint64_t timeout = state.wup_timeout_start + params.twk_timeout.max_ns;
+        return phase < timeout ? phase : timeout;
+    }
+
+    /**
+     * Evaluate the grid points of a constant bus level in [start, end).
+     * With the bus unchanged, an evaluation that leaves the state alone
+     * keeps doing so until a filter or timeout deadline passes, so only
+     * the grid points after changes and at deadlines are visited.
+     */
+    void run(BusState bus, uint64_t start, uint64_t end, const Grid& grid) {
+        if (rearm_wait && bus == BUS_STATE_DOMINANT) return;
+
+        uint64_t t = grid.at_or_after(start);
+        while (t < end) {
+            if (evaluate(bus, t)) {
+                t += grid.step;
+                continue;
+            }
+            uint64_t deadline = next_deadline();
+            if (deadline == UINT64_MAX) break;
+            uint64_t next = grid.at_or_after(deadline);
+            t = next > t ? next : t + grid.step;
+        }
+    }
+};
+
+/**
+ * A record where every corner's detector is known to be idle: a dominant
+ * edge after a recessive run longer than the largest filter time plus two
+ * steps (a recessive phase completes, then resets on the next sample), or
+ * the start of the recording
+ */
+template <typename Source>
+static bool is_sync_point(const Source& src, size_t i, uint64_t min_run) {
+    if (i == 0) return true;
+    if (!src.valid(i) || src.recessive(i)) return false;
+
+    uint64_t t = src.time(i);
+    size_t j = i;
+    while (j > 0) {
+        j--;
+        if (!src.valid(j)) continue;
+        if (!src.recessive(j)) return false;
+        if (t - src.time(j) > min_run) return true;
+    }
+    // Recessive (or no bus record) since the start: idle as well
+    return true;
+}
+
+template <typename Source>
+static size_t find_sync_point(const Source& src, size_t from, uint64_t min_run) {
+    size_t i = from;
+    while (i < src.count && !is_sync_point(src, i, min_run)) i++;
+    return i;
+}
+
+/**
+ * Scan records [begin, end) starting idle; the last level lasts until until_ns
+ */
+template <typename Source>
+static void scan_range(const Source& src, size_t begin, size_t end, uint64_t until_ns,
+                       const Grid& grid, std::vector<Detector>& detectors) {
+    bool have_level = false;
+    bool level = true;
+    uint64_t level_start = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        if (!src.valid(i)) continue;
+        bool recessive = src.recessive(i);
+        if (have_level && recessive == level) continue;
+
+        uint64_t t = src.time(i);
+        if (have_level) {
+            BusState bus = level ? BUS_STATE_RECESSIVE : BUS_STATE_DOMINANT;
+            for (Detector& d : detectors) d.run(bus, level_start, t, grid);
+        }
+        level = recessive;
+        level_start = t;
+        have_level = true;
+    }
+
+    if (have_level) {
+        BusState bus = level ? BUS_STATE_RECESSIVE : BUS_STATE_DOMINANT;
+        for (Detector& d : detectors) d.run(bus, level_start, until_ns, grid);
+    }
+}
+
+static bool valid_configs(const WUPScanConfig* configs, size_t config_count,
+                          WUPScanResult* results) {
+    if (!configs || config_count == 0 || !results) return false;
+
+    for (size_t c = 0; c < config_count; c++) {
+        results[c].matches = NULL;
+        results[c].count = 0;
+    }
+    for (size_t c = 0; c < config_count; c++) {
+        if (configs[c].filter_ns == 0 || configs[c].timeout_ns == 0) return false;
+    }
+    return true;
+}
+
+template <typename Source>
+static bool scan(const Source& src, uint64_t end_ns, const Grid& grid,
+                 const WUPScanConfig* configs, size_t config_count,
+                 unsigned threads, WUPScanResult* results) {
+    if (!valid_configs(configs, config_count, results) || grid.step == 0) return false;
+
+    uint64_t min_run = 0;
+    for (size_t c = 0; c < config_count; c++) {
+        if (configs[c].filter_ns > min_run) min_run = configs[c].filter_ns;
+    }
+    min_run += 2 * grid.step;
+
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    size_t max_chunks = src.count / MIN_CHUNK;
+    if (threads > max_chunks) threads = max_chunks ? (unsigned)max_chunks : 1;
+
+    std::vector<std::vector<Detector>> workers(threads);
+    for (auto& detectors : workers) {
+        for (size_t c = 0; c < config_count; c++) detectors.emplace_back(configs[c]);
+    }
+
+    // Each worker aligns both ends of its nominal chunk to sync points, so
+    // the ranges tile the recording without overlap
+    auto run = [&](unsigned k) {
+        size_t begin = find_sync_point(src, src.count / threads * k, min_run);
+        size_t end = (k + 1 == threads)
+                         ? src.count
+                         : find_sync_point(src, src.count / threads * (k + 1), min_run);
+        if (begin >= end) return;
+        uint64_t until = end < src.count ? src.time(end) : end_ns;
+        scan_range(src, begin, end, until, grid, workers[k]);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned k = 1; k < threads; k++) pool.emplace_back(run, k);
+    run(0);
+    for (std::thread& t : pool) t.join();
+
+    // Concatenate per corner in chunk order
+    for (size_t c = 0; c < config_count; c++) {
+        size_t total = 0;
+        for (auto& detectors : workers) total += detectors[c].matches.size();
+        if (total == 0) continue;
+
+        results[c].matches = (WUPMatch*)malloc(total * sizeof(WUPMatch));
+        if (!results[c].matches) {
+            for (size_t r = 0; r < config_count; r++) tcan1463q1_wup_scan_result_free(&results[r]);
+            return false;
+        }
+        for (auto& detectors : workers) {
+            const std::vector<WUPMatch>& m = detectors[c].matches;
+            if (m.empty()) continue;
+            memcpy(results[c].matches + results[c].count, m.data(), m.size() * sizeof(WUPMatch));
+            results[c].count += m.size();
+        }
+    }
+    return true;
+}
+
+void tcan1463q1_wup_scan_config_init(WUPScanConfig* config, const DeviceParams* params) {
+    if (!config) return;
+    if (!params) params = tcan1463q1_device_get_params(DEVICE_VARIANT_TCAN1463Q1);
+
+    config->filter_ns = params->twk_filter.min_ns;
+    config->timeout_ns = params->twk_timeout.max_ns;
+}
+
+bool tcan1463q1_wup_scan_edges(const EdgeRecord* edges, size_t count,
+                               uint64_t end_ns, uint64_t step_ns,
+                               const WUPScanConfig* configs, size_t config_count,
+                               unsigned threads, WUPScanResult* results) {
+    if (!edges && count > 0) return false;
+
+    EdgeSource src = {edges, count};
+    Grid grid = {0, step_ns};
+    return scan(src, end_ns, grid, configs, config_count, threads, results);
+}
+
+bool tcan1463q1_wup_scan_samples(const uint8_t* samples, size_t count,
+                                 uint64_t start_ns, uint64_t period_ns,
+                                 const WUPScanConfig* configs, size_t config_count,
+                                 unsigned threads, WUPScanResult* results) {
+    if ((!samples && count > 0) || period_ns == 0) return false;
+
+    SampleSource src = {samples, count, start_ns, period_ns};
+    Grid grid = {start_ns, period_ns};
+    return scan(src, start_ns + (uint64_t)count * period_ns, grid, configs, config_count,
+                threads, results);
+}
+
+bool tcan1463q1_wup_scan_file(const char* path, uint64_t step_ns,
+                              const WUPScanConfig* configs, size_t config_count,
+                              unsigned threads, WUPScanResult* results) {
+    if (!valid_configs(configs, config_count, results) || !path || step_ns == 0) return false;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size % sizeof(EdgeRecord) != 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t count = (size_t)st.st_size / sizeof(EdgeRecord);
+    if (count == 0) {
+        close(fd);
+        return true;
+    }
+
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    const EdgeRecord* edges = (const EdgeRecord*)map;
+    bool ok = tcan1463q1_wup_scan_edges(edges, count, edges[count - 1].time_ns, step_ns,
+                                        configs, config_count, threads, results);
+    munmap(map, (size_t)st.st_size);
+    return ok;
+}
+
+void tcan1463q1_wup_scan_result_free(WUPScanResult* result) {
+    if (!result) return;
+
+    free(result->matches);
+    result->matches = NULL;
+    result->count = 0;
+}
@@ -65,6 +65,24 @@ TEST_F(CAPITest, ResetWithInvalidHandle) {
     EXPECT_EQ(result, TCAN_ERROR_INVALID_HANDLE);
 }
 
+TEST_F(CAPITest, Clone) {
+    ASSERT_EQ(tcan_simulator_create(&handle), TCAN_SUCCESS);
+    ASSERT_EQ(tcan_simulator_set_supply_voltages(handle, 12.0, 5.0, 3.3), TCAN_SUCCESS);
+    ASSERT_EQ(tcan_simulator_set_pin(handle, TCAN_PIN_EN, TCAN_PIN_STATE_HIGH, 3.3), TCAN_SUCCESS);
+    ASSERT_EQ(tcan_simulator_set_pin(handle, TCAN_PIN_NSTB, TCAN_PIN_STATE_HIGH, 3.3), TCAN_SUCCESS);
+    ASSERT_EQ(tcan_simulator_step(handle, 1000000), TCAN_SUCCESS);
+    
+    TCAN1463Q1SimHandle clone = nullptr;
+    ASSERT_EQ(tcan_simulator_clone(handle, &clone), TCAN_SUCCESS);
+    TCAN_OperatingMode mode;
+    ASSERT_EQ(tcan_simulator_get_mode(clone, &mode), TCAN_SUCCESS);
+    EXPECT_EQ(mode, TCAN_MODE_NORMAL);
+    EXPECT_EQ(tcan_simulator_destroy(clone), TCAN_SUCCESS);
+    
+    EXPECT_EQ(tcan_simulator_clone(nullptr, &clone), TCAN_ERROR_INVALID_HANDLE);
+    EXPECT_EQ(tcan_simulator_clone(handle, nullptr), TCAN_ERROR_NULL_POINTER);
+}
+
 // ========================================================================
 // Pin I/O Function Tests
 // ========================================================================
@@ -499,6 +517,99 @@ TEST_F(CAPITest, RestoreWithInvalidSnapshot) {
     EXPECT_EQ(result, TCAN_ERROR_INVALID_SNAPSHOT);
 }
 
+// ========================================================================
+// Batch Function Tests
+// ========================================================================
+
+TEST_F(CAPITest, BatchStepPopulation) {
+    TCAN1463Q1SimHandle handles[4];
+    for (TCAN1463Q1SimHandle& h : handles) {
+        ASSERT_EQ(tcan_simulator_create(&h), TCAN_SUCCESS);
+        ASSERT_EQ(tcan_simulator_set_supply_voltages(h, 12.0, 5.0, 3.3), TCAN_SUCCESS);
+    }
+    
+    // EN high on the even ones only, nSTB high on all
+    TCAN_PinState en[4] = {TCAN_PIN_STATE_HIGH, TCAN_PIN_STATE_LOW,
+                           TCAN_PIN_STATE_HIGH, TCAN_PIN_STATE_LOW};
+    double en_v[4] = {3.3, 0.0, 3.3, 0.0};
+    TCAN_PinState nstb[4] = {TCAN_PIN_STATE_HIGH, TCAN_PIN_STATE_HIGH,
+                             TCAN_PIN_STATE_HIGH, TCAN_PIN_STATE_HIGH};
+    double nstb_v[4] = {3.3, 3.3, 3.3, 3.3};
+    ASSERT_EQ(tcan_simulator_batch_set_pin(handles, 4, TCAN_PIN_EN, en, en_v), TCAN_SUCCESS);
+    ASSERT_EQ(tcan_simulator_batch_set_pin(handles, 4, TCAN_PIN_NSTB, nstb, nstb_v), TCAN_SUCCESS);
+    
+    // One simulator is already ahead; the others catch up with it
+    ASSERT_EQ(tcan_simulator_step(handles[3], 2000000), TCAN_SUCCESS);
+    ASSERT_EQ(tcan_simulator_batch_step_to(handles, 4, 1000000), TCAN_SUCCESS);
+    uint64_t times[4];
+    ASSERT_EQ(tcan_simulator_batch_get_times(handles, 4, times), TCAN_SUCCESS);
+    EXPECT_EQ(times[0], 1000000u);
+    EXPECT_EQ(times[2], 1000000u);
+    EXPECT_EQ(times[3], 2000000u);
+    
+    TCAN_OperatingMode modes[4];
+    uint32_t flags[4];
+    ASSERT_EQ(tcan_simulator_batch_get_modes(handles, 4, modes), TCAN_SUCCESS);
+    ASSERT_EQ(tcan_simulator_batch_get_flag_words(handles, 4, flags), TCAN_SUCCESS);
+    for (int i = 0; i < 4; i++) {
+        TCAN_OperatingMode mode;
+        int pwron, uvsup;
+        ASSERT_EQ(tcan_simulator_get_mode(handles[i], &mode), TCAN_SUCCESS);
+        ASSERT_EQ(tcan_simulator_get_flags(
+            handles[i], &pwron, nullptr, nullptr, &uvsup,
+            nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr
+        ), TCAN_SUCCESS);
+        EXPECT_EQ(modes[i], mode);
+        EXPECT_EQ((flags[i] & TCAN_FLAG_PWRON) != 0, pwron != 0);
+        EXPECT_EQ((flags[i] & TCAN_FLAG_UVSUP) != 0, uvsup != 0);
+    }
+    EXPECT_EQ(modes[0], TCAN_MODE_NORMAL);
+    EXPECT_NE(modes[1], TCAN_MODE_NORMAL);
+    
+    for (TCAN1463Q1SimHandle h : handles) {
+        tcan_simulator_destroy(h);
+    }
+}
+
+TEST_F(CAPITest, BatchRejectsInvalidArguments) {
+    ASSERT_EQ(tcan_simulator_create(&handle), TCAN_SUCCESS);
+    TCAN1463Q1SimHandle handles[2] = {handle, nullptr};
+    TCAN_PinState states[2] = {TCAN_PIN_STATE_LOW, TCAN_PIN_STATE_LOW};
+    double voltages[2] = {0.0, 0.0};
+    TCAN_OperatingMode modes[2];
+    uint64_t times[1];
+    
+    // A bad handle anywhere leaves every simulator alone
+    EXPECT_EQ(tcan_simulator_batch_step_to(handles, 2, 1000), TCAN_ERROR_INVALID_HANDLE);
+    ASSERT_EQ(tcan_simulator_batch_get_times(handles, 1, times), TCAN_SUCCESS);
+    EXPECT_EQ(times[0], 0u);
+    EXPECT_EQ(tcan_simulator_batch_get_modes(handles, 2, modes), TCAN_ERROR_INVALID_HANDLE);
+    EXPECT_EQ(tcan_simulator_batch_set_pin(handles, 2, TCAN_PIN_TXD, states, voltages),
+              TCAN_ERROR_INVALID_HANDLE);
+    
+    EXPECT_EQ(tcan_simulator_batch_set_pin(handles, 1, (TCAN_PinType)99, states, voltages),
+              TCAN_ERROR_INVALID_PIN);
+    
+    // A rejected voltage anywhere leaves every simulator alone
+    TCAN1463Q1SimHandle pair[2];
+    ASSERT_EQ(tcan_simulator_create(&pair[0]), TCAN_SUCCESS);
+    ASSERT_EQ(tcan_simulator_create(&pair[1]), TCAN_SUCCESS);
+    TCAN_PinState analog[2] = {TCAN_PIN_STATE_ANALOG, TCAN_PIN_STATE_ANALOG};
+    double vsup[2] = {24.0, 99.0};
+    EXPECT_EQ(tcan_simulator_batch_set_pin(pair, 2, TCAN_PIN_VSUP, analog, vsup),
+              TCAN_ERROR_INVALID_VOLTAGE);
+    TCAN_PinState state;
+    double voltage;
+    ASSERT_EQ(tcan_simulator_get_pin(pair[0], TCAN_PIN_VSUP, &state, &voltage), TCAN_SUCCESS);
+    EXPECT_EQ(voltage, 12.0);
+    for (TCAN1463Q1SimHandle h : pair) tcan_simulator_destroy(h);
+    EXPECT_EQ(tcan_simulator_batch_set_pin(handles, 1, TCAN_PIN_TXD, nullptr, voltages),
+              TCAN_ERROR_NULL_POINTER);
+    EXPECT_EQ(tcan_simulator_batch_get_flag_words(handles, 1, nullptr), TCAN_ERROR_NULL_POINTER);
+    EXPECT_EQ(tcan_simulator_batch_step_to(nullptr, 1, 1000), TCAN_ERROR_NULL_POINTER);
+    EXPECT_EQ(tcan_simulator_batch_step_to(nullptr, 0, 1000), TCAN_SUCCESS);
+}
+
 // ========================================================================
 // Error String Function Tests
 // ========================================================================
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_can_controller.h"
+#include <string.h>
+#include <vector>
+
+// Unit tests for the CAN protocol controller on an ideal wired-AND bus
+
+static const CANBitTiming kTiming = {500000, 0.8};
+
+// Optional per-node corruption of the sampled level
+typedef bool (*BitFilter)(size_t node, uint64_t bit, bool level);
+
+static void run_ideal_bus(const std::vector<CANController*>& nodes, uint64_t bits,
+                          BitFilter filter = nullptr, uint64_t* bit_counter = nullptr,
+                          size_t muted_node = SIZE_MAX) {
+    uint64_t local = 0;
+    uint64_t* counter = bit_counter ? bit_counter : &local;
+    for (uint64_t b = 0; b < bits; b++, (*counter)++) {
+        bool bus = true;
+        for (size_t i = 0; i < nodes.size(); i++) {
+            bool level = tcan1463q1_can_controller_tx_bit(nodes[i]);
+            if (i != muted_node) bus = bus && level;
+        }
+        for (size_t i = 0; i < nodes.size(); i++) {
+            bool level = filter ? filter(i, *counter, bus) : bus;
+            tcan1463q1_can_controller_rx_bit(nodes[i], level);
+        }
+    }
+}
+
+static CANFrame make_frame(uint32_t id, bool extended, uint8_t dlc) {
+    CANFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.id = id;
+    frame.extended = extended;
+    frame.dlc = dlc;
+    for (int i = 0; i < 8; i++) frame.data[i] = (uint8_t)(0xA5 ^ (i * 0x11) ^ id);
+    return frame;
+}
+
+class CANControllerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 4; i++) {
+            nodes.push_back(tcan1463q1_can_controller_create(&kTiming));
+            ASSERT_NE(nodes.back(), nullptr);
+        }
+        // Integrate: 11 recessive bits
+        run_ideal_bus(nodes, 11);
+    }
+
+    void TearDown() override {
+        for (CANController* node : nodes) tcan1463q1_can_controller_destroy(node);
+    }
+
+    std::vector<CANController*> nodes;
+};
+
+TEST(CANControllerConfigTest, BitTimingValidation) {
+    CANBitTiming timing = {500000, 0.8};
+    EXPECT_TRUE(tcan1463q1_can_controller_validate_timing(&timing));
+
+    CANController* controller = tcan1463q1_can_controller_create(&timing);
+    ASSERT_NE(controller, nullptr);
+    EXPECT_EQ(tcan1463q1_can_controller_get_bit_time_ns(controller), 2000u);
+    EXPECT_EQ(tcan1463q1_can_controller_get_sample_offset_ns(controller), 1600u);
+    tcan1463q1_can_controller_destroy(controller);
+
+    timing.sample_point = 0.3;
+    EXPECT_FALSE(tcan1463q1_can_controller_validate_timing(&timing));
+    timing = {2000000, 0.8};
+    EXPECT_EQ(tcan1463q1_can_controller_create(&timing), nullptr);
+}
+
+TEST_F(CANControllerTest, BaseAndExtendedFramesRoundTrip) {
+    CANFrame sent[3] = {
+        make_frame(0x123, false, 8),
+        make_frame(0x1ABCDE01, true, 3),
+        make_frame(0x7FF, false, 0),
+    };
+    sent[2].rtr = true;
+    sent[2].dlc = 4;
+    for (const CANFrame& frame : sent) {
+        ASSERT_TRUE(tcan1463q1_can_controller_send(nodes[0], &frame));
+    }
+
+    run_ideal_bus(nodes, 600);
+    EXPECT_EQ(tcan1463q1_can_controller_tx_pending(nodes[0]), 0u);
+
+    for (size_t n = 1; n < nodes.size(); n++) {
+        for (const CANFrame& expected : sent) {
+            CANFrame frame;
+            ASSERT_TRUE(tcan1463q1_can_controller_receive(nodes[n], &frame));
+            EXPECT_EQ(frame.id, expected.id);
+            EXPECT_EQ(frame.extended, expected.extended);
+            EXPECT_EQ(frame.rtr, expected.rtr);
+            EXPECT_EQ(frame.dlc, expected.dlc);
+            if (!expected.rtr) {
+                EXPECT_EQ(memcmp(frame.data, expected.data, expected.dlc), 0);
+            }
+        }
+        CANFrame extra;
+        EXPECT_FALSE(tcan1463q1_can_controller_receive(nodes[n], &extra));
+    }
+
+    // The transmitter does not receive its own frames
+    CANFrame own;
+    EXPECT_FALSE(tcan1463q1_can_controller_receive(nodes[0], &own));
+
+    CANControllerStats stats;
+    tcan1463q1_can_controller_get_stats(nodes[0], &stats);
+    EXPECT_EQ(stats.tx_frames, 3u);
+    EXPECT_EQ(tcan1463q1_can_controller_get_tec(nodes[0]), 0u);
+}
+
+TEST_F(CANControllerTest, ArbitrationOrdersByPriority) {
+    CANFrame a = make_frame(0x300, false, 2);
+    CANFrame b = make_frame(0x100, false, 2);
+    CANFrame c = make_frame(0x200, false, 2);
+    tcan1463q1_can_controller_send(nodes[0], &a);
+    tcan1463q1_can_controller_send(nodes[1], &b);
+    tcan1463q1_can_controller_send(nodes[2], &c);
+
+    run_ideal_bus(nodes, 400);
+
+    uint32_t order[3];
+    for (int i = 0; i < 3; i++) {
+        CANFrame frame;
+        ASSERT_TRUE(tcan1463q1_can_controller_receive(nodes[3], &frame));
+        order[i] = frame.id;
+    }
+    EXPECT_EQ(order[0], 0x100u);
+    EXPECT_EQ(order[1], 0x200u);
+    EXPECT_EQ(order[2], 0x300u);
+
+    CANControllerStats stats;
+    tcan1463q1_can_controller_get_stats(nodes[0], &stats);
+    EXPECT_EQ(stats.arbitration_lost, 2u);
+    EXPECT_EQ(stats.tx_frames, 1u);
+    for (int e = 0; e < CAN_ERROR_TYPE_COUNT; e++) EXPECT_EQ(stats.errors[e], 0u);
+}
+
+TEST_F(CANControllerTest, StuffErrorOnSixEqualBits) {
+    // SOF plus six dominant bits on an otherwise idle bus
+    for (int i = 0; i < 7; i++) tcan1463q1_can_controller_rx_bit(nodes[0], false);
+
+    CANControllerStats stats;
+    tcan1463q1_can_controller_get_stats(nodes[0], &stats);
+    EXPECT_EQ(stats.errors[CAN_ERROR_STUFF], 1u);
+    EXPECT_EQ(tcan1463q1_can_controller_get_rec(nodes[0]), 1u);
+    // Error-active receivers send a dominant error flag
+    EXPECT_FALSE(tcan1463q1_can_controller_tx_bit(nodes[0]));
+}
+
+static uint64_t corrupt_bit = 0;
+
+static bool corrupt_receiver(size_t node, uint64_t bit, bool level) {
+    return (node == 1 && bit == corrupt_bit) ? !level : level;
+}
+
+TEST_F(CANControllerTest, CorruptedBitIsRetransmitted) {
+    CANFrame frame = make_frame(0x555, false, 8);
+    tcan1463q1_can_controller_send(nodes[0], &frame);
+
+    // Flip one data bit as seen by node 1 only
+    uint64_t bit = 0;
+    corrupt_bit = 11 + 40;
+    run_ideal_bus(nodes, 600, corrupt_receiver, &bit);
+
+    CANControllerStats rx_stats, tx_stats;
+    tcan1463q1_can_controller_get_stats(nodes[1], &rx_stats);
+    tcan1463q1_can_controller_get_stats(nodes[0], &tx_stats);
+    EXPECT_EQ(rx_stats.errors[CAN_ERROR_CRC] + rx_stats.errors[CAN_ERROR_STUFF], 1u);
+    EXPECT_EQ(tx_stats.tx_frames, 1u);
+
+    // Node 1's error frame destroyed the first attempt for everyone;
+    // the retransmission arrives once everywhere
+    CANFrame received;
+    ASSERT_TRUE(tcan1463q1_can_controller_receive(nodes[1], &received));
+    EXPECT_EQ(received.id, 0x555u);
+    EXPECT_FALSE(tcan1463q1_can_controller_receive(nodes[1], &received));
+    EXPECT_EQ(tcan1463q1_can_controller_get_tec(nodes[0]), 8u - 1u);
+}
+
+TEST(CANControllerSoloTest, MissingAckStopsAtErrorPassive) {
+    CANController* node = tcan1463q1_can_controller_create(&kTiming);
+    std::vector<CANController*> nodes = {node};
+    run_ideal_bus(nodes, 11);
+
+    CANFrame frame = make_frame(0x42, false, 1);
+    tcan1463q1_can_controller_send(node, &frame);
+    run_ideal_bus(nodes, 20000);
+
+    // ACK errors raise TEC to error passive, where they no longer count
+    EXPECT_EQ(tcan1463q1_can_controller_get_error_state(node), CAN_ERROR_PASSIVE);
+    EXPECT_EQ(tcan1463q1_can_controller_get_tec(node), 128u);
+    EXPECT_EQ(tcan1463q1_can_controller_tx_pending(node), 1u);
+
+    CANControllerStats stats;
+    tcan1463q1_can_controller_get_stats(node, &stats);
+    EXPECT_GT(stats.errors[CAN_ERROR_ACK], 16u);
+    EXPECT_EQ(stats.bus_off_count, 0u);
+    tcan1463q1_can_controller_destroy(node);
+}
+
+TEST_F(CANControllerTest, BitErrorsLeadToBusOffAndRecovery) {
+    // Node 0 cannot drive the bus (as with a transceiver that is not in
+    // Normal mode): every SOF is read back recessive
+    tcan1463q1_can_controller_set_auto_recovery(nodes[0], false);
+    CANFrame frame = make_frame(0x10, false, 1);
+    tcan1463q1_can_controller_send(nodes[0], &frame);
+
+    run_ideal_bus(nodes, 2000, nullptr, nullptr, 0);
+    EXPECT_EQ(tcan1463q1_can_controller_get_error_state(nodes[0]), CAN_BUS_OFF);
+    EXPECT_GT(tcan1463q1_can_controller_get_tec(nodes[0]), 255u);
+    EXPECT_EQ(tcan1463q1_can_controller_get_error_state(nodes[1]), CAN_ERROR_ACTIVE);
+
+    CANControllerStats stats;
+    tcan1463q1_can_controller_get_stats(nodes[0], &stats);
+    EXPECT_EQ(stats.errors[CAN_ERROR_BIT], 32u);
+    EXPECT_EQ(stats.bus_off_count, 1u);
+
+    // Without a request the controller stays bus-off
+    run_ideal_bus(nodes, 128 * 11 + 10, nullptr, nullptr, 0);
+    EXPECT_EQ(tcan1463q1_can_controller_get_error_state(nodes[0]), CAN_BUS_OFF);
+
+    // Recovery takes 128 sequences of 11 recessive bits
+    EXPECT_TRUE(tcan1463q1_can_controller_request_recovery(nodes[0]));
+    run_ideal_bus(nodes, 128 * 11 - 1, nullptr, nullptr, 0);
+    EXPECT_EQ(tcan1463q1_can_controller_get_error_state(nodes[0]), CAN_BUS_OFF);
+    run_ideal_bus(nodes, 1, nullptr, nullptr, 0);
+    EXPECT_EQ(tcan1463q1_can_controller_get_error_state(nodes[0]), CAN_ERROR_ACTIVE);
+    EXPECT_EQ(tcan1463q1_can_controller_get_tec(nodes[0]), 0u);
+
+    // With the driver restored the queued frame goes out
+    run_ideal_bus(nodes, 200);
+    EXPECT_EQ(tcan1463q1_can_controller_tx_pending(nodes[0]), 0u);
+    CANFrame received;
+    EXPECT_TRUE(tcan1463q1_can_controller_receive(nodes[1], &received));
+}
+
+TEST(CANControllerNamesTest, Names) {
+    EXPECT_STREQ(tcan1463q1_can_error_state_name(CAN_ERROR_PASSIVE), "ERROR_PASSIVE");
+    EXPECT_STREQ(tcan1463q1_can_error_type_name(CAN_ERROR_ACK), "ACK");
+    EXPECT_EQ(tcan1463q1_can_error_type_name(CAN_ERROR_TYPE_COUNT), nullptr);
+}
@@ -0,0 +1,403 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_can_network.h"
+#include <string.h>
+#include <vector>
+
+// Integration tests: protocol controllers on transceiver simulators
+
+static const CANBitTiming kTiming = {500000, 0.8};
+
+static TCAN1463Q1Simulator* create_normal_node() {
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_step(sim, 1000000);
+    return sim;
+}
+
+class CANNetworkTest : public ::testing::Test {
+protected:
+    void build(size_t count) {
+        network = tcan1463q1_can_network_create(&kTiming);
+        ASSERT_NE(network, nullptr);
+        for (size_t i = 0; i < count; i++) {
+            sims.push_back(create_normal_node());
+            ASSERT_EQ(tcan1463q1_simulator_get_mode(sims.back()), MODE_NORMAL);
+            ASSERT_EQ(tcan1463q1_can_network_add_node(network, sims.back()), (int)i);
+        }
+        // Controllers integrate on the idle bus
+        tcan1463q1_can_network_run_bits(network, 11);
+    }
+
+    void TearDown() override {
+        tcan1463q1_can_network_destroy(network);
+        for (TCAN1463Q1Simulator* sim : sims) tcan1463q1_simulator_destroy(sim);
+    }
+
+    CANController* controller(size_t node) {
+        return tcan1463q1_can_network_get_controller(network, node);
+    }
+
+    CANNetwork* network = nullptr;
+    std::vector<TCAN1463Q1Simulator*> sims;
+};
+
+TEST_F(CANNetworkTest, FrameCrossesTransceivers) {
+    build(2);
+
+    CANFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.id = 0x2A5;
+    frame.dlc = 2;
+    frame.data[0] = 0xDE;
+    frame.data[1] = 0xAD;
+    ASSERT_TRUE(tcan1463q1_can_controller_send(controller(0), &frame));
+
+    tcan1463q1_can_network_run_bits(network, 200);
+
+    CANFrame received;
+    ASSERT_TRUE(tcan1463q1_can_controller_receive(controller(1), &received));
+    EXPECT_EQ(received.id, 0x2A5u);
+    EXPECT_EQ(received.data[1], 0xAD);
+    EXPECT_EQ(tcan1463q1_can_controller_get_tec(controller(0)), 0u);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sims[0]), MODE_NORMAL);
+
+    CANNetworkStats stats;
+    tcan1463q1_can_network_get_stats(network, &stats);
+    EXPECT_EQ(stats.bits, 211u);
+    EXPECT_GT(stats.dominant_bits, 0u);
+}
+
+TEST_F(CANNetworkTest, SixtyNodesAtFullLoad) {
+    const size_t kNodes = 60;
+    build(kNodes);
+
+    // Every node queues a frame at once: back-to-back arbitration
+    for (size_t i = 0; i < kNodes; i++) {
+        CANFrame frame;
+        memset(&frame, 0, sizeof(frame));
+        frame.id = (uint32_t)(0x700 - i);
+        frame.dlc = 8;
+        memset(frame.data, (int)i, sizeof(frame.data));
+        ASSERT_TRUE(tcan1463q1_can_controller_send(controller(i), &frame));
+    }
+
+    // Node 0 (lowest priority) drains its RX queue like an MCU would
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 100 && !tcan1463q1_can_network_tx_idle(network); i++) {
+        tcan1463q1_can_network_run_bits(network, 100);
+        CANFrame frame;
+        while (tcan1463q1_can_controller_receive(controller(0), &frame)) {
+            ids.push_back(frame.id);
+        }
+    }
+    ASSERT_TRUE(tcan1463q1_can_network_tx_idle(network));
+
+    // All other frames arrive in priority order
+    ASSERT_EQ(ids.size(), kNodes - 1);
+    for (size_t i = 1; i < ids.size(); i++) {
+        EXPECT_GT(ids[i], ids[i - 1]);
+    }
+
+    for (size_t i = 0; i < kNodes; i++) {
+        CANControllerStats stats;
+        tcan1463q1_can_controller_get_stats(controller(i), &stats);
+        EXPECT_EQ(stats.tx_frames, 1u);
+        EXPECT_EQ(stats.rx_frames, kNodes - 1);
+        EXPECT_EQ(tcan1463q1_can_controller_get_error_state(controller(i)), CAN_ERROR_ACTIVE);
+    }
+
+    // TXD dominant timeout never triggers on valid traffic
+    bool pwron, wakerq, wakesr, uvsup, uvcc, uvio, cbf, txdclp, txddto, txdrxd, candom, tsd;
+    tcan1463q1_simulator_get_flags(sims[0], &pwron, &wakerq, &wakesr, &uvsup, &uvcc, &uvio,
+                                   &cbf, &txdclp, &txddto, &txdrxd, &candom, &tsd);
+    EXPECT_FALSE(txddto);
+}
+
+TEST_F(CANNetworkTest, TransceiverInStandbyEscalatesToBusOff) {
+    build(3);
+
+    // Node 0's transceiver leaves Normal mode: its driver is disabled
+    tcan1463q1_simulator_set_pin(sims[0], PIN_NSTB, PIN_STATE_LOW, 0.0);
+    tcan1463q1_can_controller_set_auto_recovery(controller(0), false);
+
+    CANFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.id = 0x100;
+    frame.dlc = 1;
+    tcan1463q1_can_controller_send(controller(0), &frame);
+    frame.id = 0x200;
+    tcan1463q1_can_controller_send(controller(1), &frame);
+
+    tcan1463q1_can_network_run_bits(network, 3000);
+
+    EXPECT_NE(tcan1463q1_simulator_get_mode(sims[0]), MODE_NORMAL);
+    EXPECT_EQ(tcan1463q1_can_controller_get_error_state(controller(0)), CAN_BUS_OFF);
+
+    // The healthy nodes keep communicating
+    CANFrame received;
+    EXPECT_TRUE(tcan1463q1_can_controller_receive(controller(2), &received));
+    EXPECT_EQ(received.id, 0x200u);
+    EXPECT_EQ(tcan1463q1_can_controller_get_error_state(controller(1)), CAN_ERROR_ACTIVE);
+    EXPECT_EQ(tcan1463q1_can_controller_get_error_state(controller(2)), CAN_ERROR_ACTIVE);
+}
+
+static CANFrame make_test_frame(uint32_t id) {
+    CANFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.id = id;
+    frame.dlc = 1;
+    frame.data[0] = 0x3C;
+    return frame;
+}
+
+TEST_F(CANNetworkTest, GroundShiftInsideCommonModeRange) {
+    build(3);
+    const double ground[3] = {0.0, 3.0, -4.0};
+    ASSERT_TRUE(tcan1463q1_can_network_set_ground_offsets(network, ground, 3));
+    EXPECT_FALSE(tcan1463q1_can_network_set_ground_offsets(network, ground, 2));
+    tcan1463q1_can_network_set_common_mode(network, 2.0);
+
+    CANFrame frame = make_test_frame(0x155);
+    ASSERT_TRUE(tcan1463q1_can_controller_send(controller(1), &frame));
+    tcan1463q1_can_network_run_bits(network, 200);
+
+    CANFrame received;
+    EXPECT_TRUE(tcan1463q1_can_controller_receive(controller(0), &received));
+    EXPECT_TRUE(tcan1463q1_can_controller_receive(controller(2), &received));
+    EXPECT_EQ(tcan1463q1_can_controller_get_tec(controller(1)), 0u);
+
+    // Idle bus: level set by every node's bias, seen against each ground
+    double level = (0.0 + 3.0 - 4.0) / 3.0 + 2.0;
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_NEAR(tcan1463q1_can_network_get_bus_offset(network, i), level - ground[i], 1e-12);
+    }
+    PinState state;
+    double canh;
+    tcan1463q1_simulator_get_pin(sims[2], PIN_CANH, &state, &canh);
+    EXPECT_GT(canh, 7.0);
+}
+
+TEST_F(CANNetworkTest, NodesKeepTheirOffsetAcrossGrowthAndDestroy) {
+    build(8);
+    ASSERT_TRUE(tcan1463q1_can_network_set_ground_offset(network, 0, 4.0));
+    // Ninth node: the offset arrays move
+    sims.push_back(create_normal_node());
+    ASSERT_EQ(tcan1463q1_can_network_add_node(network, sims.back()), 8);
+    tcan1463q1_can_network_run_bits(network, 20);
+
+    PinState state;
+    double canh_shifted, canh_added;
+    tcan1463q1_simulator_get_pin(sims[0], PIN_CANH, &state, &canh_shifted);
+    tcan1463q1_simulator_get_pin(sims[8], PIN_CANH, &state, &canh_added);
+    EXPECT_NEAR(tcan1463q1_can_network_get_bus_offset(network, 8), 4.0 / 9.0, 1e-12);
+    EXPECT_NEAR(canh_added - canh_shifted, 4.0, 1e-9);
+
+    // Without the network the nodes keep the offset last seen
+    tcan1463q1_can_network_destroy(network);
+    network = nullptr;
+    tcan1463q1_simulator_step(sims[0], 1000);
+    tcan1463q1_simulator_step(sims[8], 1000);
+    tcan1463q1_simulator_get_pin(sims[0], PIN_CANH, &state, &canh_shifted);
+    tcan1463q1_simulator_get_pin(sims[8], PIN_CANH, &state, &canh_added);
+    EXPECT_NEAR(canh_added - canh_shifted, 4.0, 1e-9);
+}
+
+TEST_F(CANNetworkTest, NodeBeyondCommonModeRangeLosesTheBus) {
+    build(3);
+    ASSERT_TRUE(tcan1463q1_can_network_set_ground_offset(network, 2, -15.0));
+    EXPECT_FALSE(tcan1463q1_can_network_set_ground_offset(network, 3, 0.0));
+
+    CANFrame frame = make_test_frame(0x0A0);
+    ASSERT_TRUE(tcan1463q1_can_controller_send(controller(0), &frame));
+    tcan1463q1_can_network_run_bits(network, 200);
+
+    CANFrame received;
+    EXPECT_TRUE(tcan1463q1_can_controller_receive(controller(1), &received));
+    EXPECT_FALSE(tcan1463q1_can_controller_receive(controller(2), &received));
+}
+
+TEST_F(CANNetworkTest, ListenerClassesMatchFullSimulation) {
+    const size_t kNodes = 40;
+    const size_t kTransmitters = 4;
+    build(kNodes);
+
+    // Identical second network, simulated node by node
+    CANNetwork* full = tcan1463q1_can_network_create(&kTiming);
+    ASSERT_NE(full, nullptr);
+    std::vector<TCAN1463Q1Simulator*> full_sims;
+    for (size_t i = 0; i < kNodes; i++) {
+        full_sims.push_back(create_normal_node());
+        ASSERT_EQ(tcan1463q1_can_network_add_node(full, full_sims.back()), (int)i);
+    }
+    tcan1463q1_can_network_run_bits(full, 11);
+    tcan1463q1_can_network_set_collapse(network, true);
+
+    for (size_t i = 0; i < kTransmitters; i++) {
+        CANFrame frame;
+        memset(&frame, 0, sizeof(frame));
+        frame.id = (uint32_t)(0x100 + i);
+        frame.dlc = 4;
+        memset(frame.data, (int)i, sizeof(frame.data));
+        ASSERT_TRUE(tcan1463q1_can_controller_send(controller(i), &frame));
+        ASSERT_TRUE(tcan1463q1_can_controller_send(
+            tcan1463q1_can_network_get_controller(full, i), &frame));
+    }
+
+    CANNetworkStats before;
+    tcan1463q1_can_network_get_stats(network, &before);
+    tcan1463q1_can_network_run_bits(network, 600);
+    tcan1463q1_can_network_run_bits(full, 600);
+
+    // Transmitters and one class of listeners
+    CANNetworkStats stats;
+    tcan1463q1_can_network_get_stats(network, &stats);
+    EXPECT_LE(stats.node_bits - before.node_bits, 600u * (kTransmitters + 1));
+    EXPECT_TRUE(tcan1463q1_can_network_tx_idle(network));
+
+    for (size_t i = 0; i < kNodes; i++) {
+        CANControllerStats a, b;
+        tcan1463q1_can_controller_get_stats(controller(i), &a);
+        tcan1463q1_can_controller_get_stats(tcan1463q1_can_network_get_controller(full, i), &b);
+        EXPECT_EQ(memcmp(&a, &b, sizeof(a)), 0) << "node " << i;
+        EXPECT_EQ(a.rx_frames, i < kTransmitters ? kTransmitters - 1 : kTransmitters);
+
+        SimulatorObservableState sa, sb;
+        tcan1463q1_simulator_get_observable_state(sims[i], &sa);
+        tcan1463q1_simulator_get_observable_state(full_sims[i], &sb);
+        EXPECT_EQ(sa.time_ns, sb.time_ns);
+        EXPECT_EQ(sa.mode, sb.mode);
+        EXPECT_EQ(sa.flags, sb.flags);
+    }
+
+    tcan1463q1_can_network_destroy(full);
+    for (TCAN1463Q1Simulator* sim : full_sims) tcan1463q1_simulator_destroy(sim);
+}
+
+static void count_and_sync(CANNetwork* network, uint64_t, void* user_data) {
+    tcan1463q1_can_network_sync(network);
+    ++*(int*)user_data;
+}
+
+TEST_F(CANNetworkTest, ChangedNodeLeavesItsClass) {
+    build(8);
+    tcan1463q1_can_network_set_collapse(network, true);
+    tcan1463q1_can_network_run_bits(network, 10);
+    CANNetworkStats stats;
+    tcan1463q1_can_network_get_stats(network, &stats);
+    EXPECT_EQ(stats.node_bits, 8u * 11 + 10);
+
+    // Node 5 goes to standby between runs, node 2 queues a frame
+    tcan1463q1_simulator_set_pin(sims[5], PIN_NSTB, PIN_STATE_LOW, 0.0);
+    CANFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.id = 0x42;
+    frame.dlc = 1;
+    ASSERT_TRUE(tcan1463q1_can_controller_send(controller(2), &frame));
+    tcan1463q1_can_network_run_bits(network, 200);
+
+    CANNetworkStats after;
+    tcan1463q1_can_network_get_stats(network, &after);
+    EXPECT_EQ(after.node_bits - stats.node_bits, 200u * 3);
+    EXPECT_NE(tcan1463q1_simulator_get_mode(sims[5]), MODE_NORMAL);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sims[4]), MODE_NORMAL);
+    CANFrame received;
+    ASSERT_TRUE(tcan1463q1_can_controller_receive(controller(7), &received));
+    EXPECT_EQ(received.id, 0x42u);
+
+    // Syncing from the bit callback keeps every node current at every bit
+    int bits = 0;
+    tcan1463q1_can_network_set_bit_callback(network, count_and_sync, &bits);
+    tcan1463q1_can_network_run_bits(network, 5);
+    EXPECT_EQ(bits, 5);
+    EXPECT_EQ(tcan1463q1_simulator_get_time_ns(sims[7]), tcan1463q1_can_network_get_time_ns(network) + 1000000u);
+}
+
+static TCAN1463Q1Simulator* create_sleeping_node() {
+    TCAN1463Q1Simulator* sim = create_normal_node();
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_LOW, 0.0);
+    tcan1463q1_simulator_step(sim, 1000);
+    tcan1463q1_simulator_step(sim, 700000000);
+    return sim;
+}
+
+TEST_F(CANNetworkTest, LazySleepMatchesFullSimulation) {
+    const size_t kAwake = 2;
+    const size_t kAsleep = 6;
+    CANNetwork* networks[2];
+    std::vector<TCAN1463Q1Simulator*> all[2];
+    for (int n = 0; n < 2; n++) {
+        networks[n] = tcan1463q1_can_network_create(&kTiming);
+        ASSERT_NE(networks[n], nullptr);
+        for (size_t i = 0; i < kAwake + kAsleep; i++) {
+            all[n].push_back(i < kAwake ? create_normal_node() : create_sleeping_node());
+            tcan1463q1_can_network_add_node(networks[n], all[n].back());
+        }
+        ASSERT_EQ(tcan1463q1_simulator_get_mode(all[n].back()), MODE_SLEEP);
+    }
+    network = networks[0];
+    sims = all[0];
+    tcan1463q1_can_network_set_lazy_sleep(network, true);
+
+    // Idle bus: only the awake nodes are stepped after the first bit
+    tcan1463q1_can_network_run_bits(networks[0], 1000);
+    tcan1463q1_can_network_run_bits(networks[1], 1000);
+    CANNetworkStats stats;
+    tcan1463q1_can_network_get_stats(network, &stats);
+    EXPECT_EQ(stats.node_bits, (kAwake + kAsleep) + 999 * kAwake);
+
+    // A frame is a wake-up pattern for the sleeping nodes
+    CANFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.id = 0x0F0;
+    frame.dlc = 2;
+    for (int n = 0; n < 2; n++) {
+        ASSERT_TRUE(tcan1463q1_can_controller_send(
+            tcan1463q1_can_network_get_controller(networks[n], 0), &frame));
+        tcan1463q1_can_network_run_bits(networks[n], 2000);
+    }
+
+    // Idle past tSILENCE: the bias timeout of the woken nodes falls inside
+    // the parked window, then a frame wakes everyone again
+    for (int n = 0; n < 2; n++) {
+        tcan1463q1_can_network_run_bits(networks[n], 500000);
+        ASSERT_TRUE(tcan1463q1_can_controller_send(
+            tcan1463q1_can_network_get_controller(networks[n], 1), &frame));
+        tcan1463q1_can_network_run_bits(networks[n], 2000);
+    }
+
+    for (size_t i = 0; i < kAwake + kAsleep; i++) {
+        SimulatorObservableState lazy, full;
+        tcan1463q1_simulator_get_observable_state(all[0][i], &lazy);
+        tcan1463q1_simulator_get_observable_state(all[1][i], &full);
+        EXPECT_EQ(lazy.time_ns, full.time_ns) << "node " << i;
+        EXPECT_EQ(lazy.mode, full.mode) << "node " << i;
+        EXPECT_EQ(lazy.flags, full.flags) << "node " << i;
+        EXPECT_EQ(memcmp(lazy.pin_states, full.pin_states, sizeof(lazy.pin_states)), 0);
+        for (int pin = 0; pin < 14; pin++) {
+            EXPECT_NEAR(lazy.pin_voltages[pin], full.pin_voltages[pin], 1e-9) << "node " << i;
+        }
+
+        SupplyEnergy lazy_energy, full_energy;
+        ASSERT_TRUE(tcan1463q1_simulator_get_supply_energy(all[0][i], &lazy_energy));
+        ASSERT_TRUE(tcan1463q1_simulator_get_supply_energy(all[1][i], &full_energy));
+        for (int rail = 0; rail < SUPPLY_COUNT; rail++) {
+            double lazy_total = tcan1463q1_supply_energy_total(&lazy_energy, (SupplyRail)rail);
+            double full_total = tcan1463q1_supply_energy_total(&full_energy, (SupplyRail)rail);
+            EXPECT_NEAR(lazy_total, full_total, 1e-9 * full_total) << "node " << i << " rail " << rail;
+        }
+
+        CANControllerStats a, b;
+        tcan1463q1_can_controller_get_stats(tcan1463q1_can_network_get_controller(networks[0], i), &a);
+        tcan1463q1_can_controller_get_stats(tcan1463q1_can_network_get_controller(networks[1], i), &b);
+        EXPECT_EQ(memcmp(&a, &b, sizeof(a)), 0) << "node " << i;
+    }
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(all[0].back()), MODE_STANDBY);
+
+    tcan1463q1_can_network_destroy(networks[1]);
+    for (TCAN1463Q1Simulator* sim : all[1]) tcan1463q1_simulator_destroy(sim);
+}
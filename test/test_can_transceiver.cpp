@@ -188,6 +188,33 @@ TEST_F(CANTransceiverTest, StateTransitionAutonomousActiveToInactiveOnSilence) {
     EXPECT_EQ(transceiver.state, CAN_STATE_AUTONOMOUS_INACTIVE);
 }
 
+// Bus activity is tracked per transceiver, not shared between instances
+TEST_F(CANTransceiverTest, SilenceTimeoutIsPerInstance) {
+    CANTransceiver other;
+    can_transceiver_init(&other);
+    
+    transceiver.state = CAN_STATE_AUTONOMOUS_ACTIVE;
+    other.state = CAN_STATE_AUTONOMOUS_ACTIVE;
+    
+    // Only the first transceiver sees early bus activity
+    can_transceiver_update_state_machine(&transceiver, MODE_STANDBY,
+                                         BUS_STATE_DOMINANT, true, 1000000);
+    
+    // The second one sees activity much later
+    uint64_t late = 1000000 + 1500000000ULL;
+    can_transceiver_update_state_machine(&other, MODE_STANDBY,
+                                         BUS_STATE_DOMINANT, true, late);
+    
+    // Silence timeout only applies to the first transceiver
+    can_transceiver_update_state_machine(&transceiver, MODE_STANDBY,
+                                         BUS_STATE_RECESSIVE, true, late);
+    can_transceiver_update_state_machine(&other, MODE_STANDBY,
+                                         BUS_STATE_RECESSIVE, true, late + 1000);
+    
+    EXPECT_EQ(transceiver.state, CAN_STATE_AUTONOMOUS_INACTIVE);
+    EXPECT_EQ(other.state, CAN_STATE_AUTONOMOUS_ACTIVE);
+}
+
 // Test CAN state machine: Active to Autonomous Active on mode exit with bus activity
 TEST_F(CANTransceiverTest, StateTransitionActiveToAutonomousActiveOnModeExit) {
     transceiver.state = CAN_STATE_ACTIVE;
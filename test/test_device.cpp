@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_simulator.h"
+#include "tcan1463q1_device.h"
+#include "device_profiles.h"
+
+// Unit tests for device variant profiles
+
+// Profiles are usable in constant expressions
+static_assert(TCAN1463Q1Profile::params.twk_filter.min_ns == 500, "tWK_FILTER(min) folded");
+static_assert(timing_range_mid_ns(TCAN1463Q1Profile::params.tsilence) == 900000000ULL,
+              "tSILENCE midpoint folded");
+static_assert(!TCAN1462Q1Profile::params.has_wake, "TCAN1462-Q1 has no WAKE pin");
+
+static void power_up_normal(TCAN1463Q1Simulator* sim) {
+    tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_step(sim, 1000);
+}
+
+TEST(DeviceTest, VariantLookup) {
+    EXPECT_STREQ(tcan1463q1_device_variant_name(DEVICE_VARIANT_TCAN1463Q1), "TCAN1463-Q1");
+    EXPECT_STREQ(tcan1463q1_device_variant_name(DEVICE_VARIANT_TCAN1462Q1), "TCAN1462-Q1");
+    EXPECT_EQ(tcan1463q1_device_variant_name(DEVICE_VARIANT_COUNT), nullptr);
+    EXPECT_EQ(tcan1463q1_device_get_params(DEVICE_VARIANT_COUNT), nullptr);
+
+    const DeviceParams* params = tcan1463q1_device_get_params(DEVICE_VARIANT_TCAN1463Q1);
+    ASSERT_NE(params, nullptr);
+    EXPECT_DOUBLE_EQ(params->uvsup_falling, UVSUP_FALLING_MIN);
+    EXPECT_EQ(params->tuv.min_ns, 100000000ULL);
+    EXPECT_EQ(params->ttxddto.min_ns, 1200000ULL);
+    EXPECT_EQ(params->twk_timeout.max_ns, 2000000ULL);
+}
+
+TEST(DeviceTest, PinPresence) {
+    const DeviceParams* full = tcan1463q1_device_get_params(DEVICE_VARIANT_TCAN1463Q1);
+    const DeviceParams* reduced = tcan1463q1_device_get_params(DEVICE_VARIANT_TCAN1462Q1);
+
+    EXPECT_TRUE(tcan1463q1_device_has_pin(full, PIN_INH));
+    EXPECT_TRUE(tcan1463q1_device_has_pin(full, PIN_WAKE));
+    EXPECT_FALSE(tcan1463q1_device_has_pin(reduced, PIN_INH));
+    EXPECT_FALSE(tcan1463q1_device_has_pin(reduced, PIN_INH_MASK));
+    EXPECT_FALSE(tcan1463q1_device_has_pin(reduced, PIN_WAKE));
+    EXPECT_TRUE(tcan1463q1_device_has_pin(reduced, PIN_TXD));
+    EXPECT_FALSE(tcan1463q1_device_has_pin(nullptr, PIN_TXD));
+}
+
+TEST(DeviceTest, CreateVariant) {
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    ASSERT_NE(sim, nullptr);
+    EXPECT_EQ(tcan1463q1_simulator_get_variant(sim), DEVICE_VARIANT_TCAN1463Q1);
+    tcan1463q1_simulator_destroy(sim);
+
+    sim = tcan1463q1_simulator_create_variant(DEVICE_VARIANT_TCAN1462Q1);
+    ASSERT_NE(sim, nullptr);
+    EXPECT_EQ(tcan1463q1_simulator_get_variant(sim), DEVICE_VARIANT_TCAN1462Q1);
+
+    // Variant survives reset
+    tcan1463q1_simulator_reset(sim);
+    EXPECT_EQ(tcan1463q1_simulator_get_variant(sim), DEVICE_VARIANT_TCAN1462Q1);
+    tcan1463q1_simulator_destroy(sim);
+
+    EXPECT_EQ(tcan1463q1_simulator_create_variant(DEVICE_VARIANT_COUNT), nullptr);
+}
+
+TEST(DeviceTest, ReducedVariantHasNoInhOrWake) {
+    TCAN1463Q1Simulator* full = tcan1463q1_simulator_create_variant(DEVICE_VARIANT_TCAN1463Q1);
+    TCAN1463Q1Simulator* reduced = tcan1463q1_simulator_create_variant(DEVICE_VARIANT_TCAN1462Q1);
+    ASSERT_NE(full, nullptr);
+    ASSERT_NE(reduced, nullptr);
+
+    EXPECT_FALSE(tcan1463q1_simulator_set_pin(reduced, PIN_WAKE, PIN_STATE_HIGH, 12.0));
+    EXPECT_FALSE(tcan1463q1_simulator_set_pin(reduced, PIN_INH_MASK, PIN_STATE_HIGH, 3.3));
+
+    power_up_normal(full);
+    power_up_normal(reduced);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(full), MODE_NORMAL);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(reduced), MODE_NORMAL);
+
+    // INH is driven high in Normal mode only on the full variant
+    PinState inh_state;
+    double inh_voltage;
+    tcan1463q1_simulator_get_pin(full, PIN_INH, &inh_state, &inh_voltage);
+    EXPECT_EQ(inh_state, PIN_STATE_HIGH);
+    tcan1463q1_simulator_get_pin(reduced, PIN_INH, &inh_state, &inh_voltage);
+    EXPECT_EQ(inh_state, PIN_STATE_HIGH_IMPEDANCE);
+
+    // Both variants share the CAN path
+    tcan1463q1_simulator_set_pin(full, PIN_TXD, PIN_STATE_LOW, 0.0);
+    tcan1463q1_simulator_set_pin(reduced, PIN_TXD, PIN_STATE_LOW, 0.0);
+    tcan1463q1_simulator_step(full, 1000);
+    tcan1463q1_simulator_step(reduced, 1000);
+    PinState full_rxd, reduced_rxd;
+    double voltage;
+    tcan1463q1_simulator_get_pin(full, PIN_RXD, &full_rxd, &voltage);
+    tcan1463q1_simulator_get_pin(reduced, PIN_RXD, &reduced_rxd, &voltage);
+    EXPECT_EQ(full_rxd, PIN_STATE_LOW);
+    EXPECT_EQ(reduced_rxd, full_rxd);
+
+    tcan1463q1_simulator_destroy(full);
+    tcan1463q1_simulator_destroy(reduced);
+}
+
+TEST(DeviceTest, SnapshotRestoreRequiresSameVariant) {
+    TCAN1463Q1Simulator* full = tcan1463q1_simulator_create_variant(DEVICE_VARIANT_TCAN1463Q1);
+    TCAN1463Q1Simulator* reduced = tcan1463q1_simulator_create_variant(DEVICE_VARIANT_TCAN1462Q1);
+    ASSERT_NE(full, nullptr);
+    ASSERT_NE(reduced, nullptr);
+
+    SimulatorSnapshot* snapshot = tcan1463q1_simulator_snapshot(full);
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_FALSE(tcan1463q1_simulator_restore(reduced, snapshot));
+    EXPECT_TRUE(tcan1463q1_simulator_restore(full, snapshot));
+
+    tcan1463q1_simulator_snapshot_free(snapshot);
+    tcan1463q1_simulator_destroy(full);
+    tcan1463q1_simulator_destroy(reduced);
+}
@@ -162,3 +162,34 @@ TEST_F(EventSystemTest, UserDataPassthrough) {
     // Note: We can't test that user_data is actually passed through
     // without firing an event, but we verify registration succeeds
 }
+
+static void count_user_data_callback(const SimulatorEvent* event, void* user_data) {
+    (*(int*)user_data)++;
+}
+
+TEST_F(EventSystemTest, StepRaisesModeAndPinEvents) {
+    int pin_events = 0;
+    tcan1463q1_simulator_register_callback(sim, EVENT_MODE_CHANGE, mode_change_callback, nullptr);
+    tcan1463q1_simulator_register_callback(sim, EVENT_PIN_CHANGE, count_user_data_callback,
+                                           &pin_events);
+    
+    tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+    // Caller-driven pins do not raise events
+    EXPECT_EQ(pin_events, 0);
+    
+    tcan1463q1_simulator_step(sim, 1000);
+    EXPECT_EQ(mode_change_count, 1);
+    EXPECT_GT(pin_events, 0);
+    
+    // Nothing changes on a quiet bus
+    int settled = pin_events;
+    tcan1463q1_simulator_step(sim, 1000);
+    tcan1463q1_simulator_step(sim, 1000);
+    EXPECT_EQ(pin_events, settled);
+    EXPECT_EQ(mode_change_count, 1);
+}
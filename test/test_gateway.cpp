@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_gateway.h"
+#include <string.h>
+#include <vector>
+
+// Integration tests: two bus segments joined by a gateway
+
+static const CANBitTiming kTiming = {500000, 0.8};
+
+static TCAN1463Q1Simulator* create_node(bool asleep) {
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_step(sim, 1000000);
+    if (asleep) {
+        // Power-up lands in Normal; nSTB low goes to Sleep after tSILENCE
+        tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_LOW, 0.0);
+        tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_LOW, 0.0);
+        for (int i = 0; i < 7; i++) tcan1463q1_simulator_step(sim, 100000000);
+    }
+    return sim;
+}
+
+static CANFrame make_frame(uint32_t id, bool extended, uint8_t value) {
+    CANFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.id = id;
+    frame.extended = extended;
+    frame.dlc = 2;
+    frame.data[0] = value;
+    frame.data[1] = (uint8_t)~value;
+    return frame;
+}
+
+/**
+ * Segment A: gateway + node; segment B: gateway + node
+ */
+class GatewayTest : public ::testing::Test {
+protected:
+    void build(const GatewayConfig* config, bool sleeping_b = false, bool sleeping_gateway_a = false) {
+        for (int s = 0; s < 2; s++) {
+            networks[s] = tcan1463q1_can_network_create(&kTiming);
+            ASSERT_NE(networks[s], nullptr);
+            gateway_sims[s] = create_node(s == 0 && sleeping_gateway_a);
+            node_sims[s] = create_node(s == 1 && sleeping_b);
+            ASSERT_EQ(tcan1463q1_can_network_add_node(networks[s], node_sims[s]), 0);
+        }
+        gateway = tcan1463q1_gateway_create(networks[0], networks[1], gateway_sims[0],
+                                            gateway_sims[1], config);
+        ASSERT_NE(gateway, nullptr);
+        // Controllers integrate on the idle buses
+        tcan1463q1_gateway_run_for(gateway, 30000, 1);
+    }
+
+    void TearDown() override {
+        tcan1463q1_gateway_destroy(gateway);
+        for (int s = 0; s < 2; s++) {
+            tcan1463q1_can_network_destroy(networks[s]);
+            tcan1463q1_simulator_destroy(gateway_sims[s]);
+            tcan1463q1_simulator_destroy(node_sims[s]);
+        }
+    }
+
+    CANController* node(int segment) {
+        return tcan1463q1_can_network_get_controller(networks[segment], 0);
+    }
+
+    void route(GatewaySegment source, uint32_t id, uint32_t target, bool extended = false) {
+        GatewayRoute r = {source, id, extended, target, extended};
+        ASSERT_TRUE(tcan1463q1_gateway_add_route(gateway, &r));
+    }
+
+    CANNetwork* networks[2] = {nullptr, nullptr};
+    TCAN1463Q1Simulator* gateway_sims[2] = {nullptr, nullptr};
+    TCAN1463Q1Simulator* node_sims[2] = {nullptr, nullptr};
+    Gateway* gateway = nullptr;
+};
+
+TEST_F(GatewayTest, ForwardsRoutedFramesWithRemappedIds) {
+    GatewayConfig config;
+    tcan1463q1_gateway_config_init(&config);
+    build(&config);
+    route(GATEWAY_SEGMENT_A, 0x100, 0x200);
+    route(GATEWAY_SEGMENT_B, 0x300, 0x300);
+
+    CANFrame routed = make_frame(0x100, false, 0x5A);
+    CANFrame unrouted = make_frame(0x101, false, 0x11);
+    ASSERT_TRUE(tcan1463q1_can_controller_send(node(0), &routed));
+    ASSERT_TRUE(tcan1463q1_can_controller_send(node(0), &unrouted));
+    CANFrame reverse = make_frame(0x300, false, 0x77);
+    ASSERT_TRUE(tcan1463q1_can_controller_send(node(1), &reverse));
+
+    tcan1463q1_gateway_run_for(gateway, 2000000, 1);
+
+    CANFrame received;
+    ASSERT_TRUE(tcan1463q1_can_controller_receive(node(1), &received));
+    EXPECT_EQ(received.id, 0x200u);
+    EXPECT_EQ(received.data[0], 0x5A);
+    EXPECT_FALSE(tcan1463q1_can_controller_receive(node(1), &received));
+    ASSERT_TRUE(tcan1463q1_can_controller_receive(node(0), &received));
+    EXPECT_EQ(received.id, 0x300u);
+
+    GatewayStats stats;
+    tcan1463q1_gateway_get_stats(gateway, &stats);
+    EXPECT_EQ(stats.received[GATEWAY_SEGMENT_A], 2u);
+    EXPECT_EQ(stats.unrouted[GATEWAY_SEGMENT_A], 1u);
+    EXPECT_EQ(stats.forwarded[GATEWAY_SEGMENT_A], 1u);
+    EXPECT_EQ(stats.forwarded[GATEWAY_SEGMENT_B], 1u);
+    EXPECT_EQ(stats.dropped[GATEWAY_SEGMENT_A], 0u);
+}
+
+TEST_F(GatewayTest, ForwardsIntoCollapsedSegment) {
+    GatewayConfig config;
+    tcan1463q1_gateway_config_init(&config);
+    build(&config);
+    route(GATEWAY_SEGMENT_B, 0x300, 0x301);
+    // The idle gateway node equals the listener on A but is driven from the bit callback
+    tcan1463q1_can_network_set_collapse(networks[0], true);
+    tcan1463q1_can_network_set_lazy_sleep(networks[0], true);
+
+    CANFrame frame = make_frame(0x300, false, 0x42);
+    ASSERT_TRUE(tcan1463q1_can_controller_send(node(1), &frame));
+    tcan1463q1_gateway_run_for(gateway, 2000000, 1);
+
+    CANFrame received;
+    ASSERT_TRUE(tcan1463q1_can_controller_receive(node(0), &received));
+    EXPECT_EQ(received.id, 0x301u);
+    EXPECT_EQ(received.data[0], 0x42);
+    GatewayStats stats;
+    tcan1463q1_gateway_get_stats(gateway, &stats);
+    EXPECT_EQ(stats.forwarded[GATEWAY_SEGMENT_B], 1u);
+}
+
+TEST_F(GatewayTest, HoldsFramesForTheProcessingLatency) {
+    GatewayConfig config;
+    tcan1463q1_gateway_config_init(&config);
+    config.latency_ns[GATEWAY_SEGMENT_A] = 500000;
+    build(&config);
+    route(GATEWAY_SEGMENT_A, 0x123, 0x123);
+
+    // Frames are handed over at the first bit boundary after the latency
+    EXPECT_EQ(tcan1463q1_gateway_get_lookahead_ns(gateway), 100000u - 2000u);
+    CANFrame frame = make_frame(0x123, false, 1);
+    ASSERT_TRUE(tcan1463q1_can_controller_send(node(0), &frame));
+    tcan1463q1_gateway_run_for(gateway, 2000000, 1);
+
+    GatewayStats stats;
+    tcan1463q1_gateway_get_stats(gateway, &stats);
+    ASSERT_EQ(stats.forwarded[GATEWAY_SEGMENT_A], 1u);
+    EXPECT_GE(stats.max_delay_ns[GATEWAY_SEGMENT_A], 500000u);
+    EXPECT_LT(stats.max_delay_ns[GATEWAY_SEGMENT_A], 502000u);
+}
+
+TEST_F(GatewayTest, DropsFramesBeyondQueueDepth) {
+    GatewayConfig config;
+    tcan1463q1_gateway_config_init(&config);
+    config.latency_ns[GATEWAY_SEGMENT_A] = 3000000;
+    config.latency_ns[GATEWAY_SEGMENT_B] = 3000000;
+    config.queue_depth[GATEWAY_SEGMENT_A] = 2;
+    build(&config);
+    route(GATEWAY_SEGMENT_A, 0x010, 0x010);
+
+    // Five frames arrive within one latency window
+    for (uint8_t i = 0; i < 5; i++) {
+        CANFrame frame = make_frame(0x010, false, i);
+        ASSERT_TRUE(tcan1463q1_can_controller_send(node(0), &frame));
+    }
+    tcan1463q1_gateway_run_for(gateway, 10000000, 1);
+
+    GatewayStats stats;
+    tcan1463q1_gateway_get_stats(gateway, &stats);
+    EXPECT_EQ(stats.received[GATEWAY_SEGMENT_A], 5u);
+    EXPECT_EQ(stats.dropped[GATEWAY_SEGMENT_A], 3u);
+    EXPECT_EQ(stats.forwarded[GATEWAY_SEGMENT_A], 2u);
+
+    // The oldest frames survive, in order
+    CANFrame received;
+    ASSERT_TRUE(tcan1463q1_can_controller_receive(node(1), &received));
+    EXPECT_EQ(received.data[0], 0);
+    ASSERT_TRUE(tcan1463q1_can_controller_receive(node(1), &received));
+    EXPECT_EQ(received.data[0], 1);
+}
+
+TEST_F(GatewayTest, RoutingTableLookups) {
+    build(NULL);
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        GatewayRoute r = {GATEWAY_SEGMENT_B, 0x1000000 + i * 7919, true, i, false};
+        ASSERT_TRUE(tcan1463q1_gateway_add_route(gateway, &r));
+    }
+    route(GATEWAY_SEGMENT_A, 0x7FF, 0x001);
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        const GatewayRoute* r = tcan1463q1_gateway_find_route(gateway, GATEWAY_SEGMENT_B,
+                                                              0x1000000 + i * 7919, true);
+        ASSERT_NE(r, nullptr);
+        EXPECT_EQ(r->target_id, i);
+    }
+    EXPECT_EQ(tcan1463q1_gateway_find_route(gateway, GATEWAY_SEGMENT_A, 0x1000000, true), nullptr);
+    EXPECT_EQ(tcan1463q1_gateway_find_route(gateway, GATEWAY_SEGMENT_B, 0x7FF, false), nullptr);
+    EXPECT_NE(tcan1463q1_gateway_find_route(gateway, GATEWAY_SEGMENT_A, 0x7FF, false), nullptr);
+
+    // Duplicates and out-of-range identifiers are rejected
+    GatewayRoute duplicate = {GATEWAY_SEGMENT_A, 0x7FF, false, 0x002, false};
+    EXPECT_FALSE(tcan1463q1_gateway_add_route(gateway, &duplicate));
+    GatewayRoute invalid = {GATEWAY_SEGMENT_A, 0x800, false, 0x001, false};
+    EXPECT_FALSE(tcan1463q1_gateway_add_route(gateway, &invalid));
+}
+
+TEST_F(GatewayTest, ForwardsWakeUpToSleepingSegment) {
+    GatewayConfig config;
+    tcan1463q1_gateway_config_init(&config);
+    config.wake_forwarding = true;
+    config.wake_frame = make_frame(0x500, false, 0);
+    build(&config, true, true);
+    ASSERT_EQ(tcan1463q1_simulator_get_mode(gateway_sims[0]), MODE_SLEEP);
+    ASSERT_EQ(tcan1463q1_simulator_get_mode(node_sims[1]), MODE_SLEEP);
+
+    // Traffic on segment A wakes the gateway, which wakes segment B
+    CANFrame frame = make_frame(0x0F0, false, 0x0F);
+    ASSERT_TRUE(tcan1463q1_can_controller_send(node(0), &frame));
+    tcan1463q1_gateway_run_for(gateway, 3000000, 1);
+
+    GatewayStats stats;
+    tcan1463q1_gateway_get_stats(gateway, &stats);
+    EXPECT_EQ(stats.wakeups_forwarded, 1u);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(gateway_sims[0]), MODE_NORMAL);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(gateway_sims[1]), MODE_NORMAL);
+
+    bool wakerq = false;
+    tcan1463q1_simulator_get_flags(node_sims[1], NULL, &wakerq, NULL, NULL, NULL, NULL,
+                                   NULL, NULL, NULL, NULL, NULL, NULL);
+    EXPECT_TRUE(wakerq);
+}
+
+// The segments of a window may run on separate threads without changing results
+TEST(GatewayParallelTest, ThreadedWindowsMatchSequential) {
+    GatewayStats results[2];
+    std::vector<uint32_t> received_ids[2];
+
+    for (unsigned run = 0; run < 2; run++) {
+        CANNetwork* networks[2];
+        TCAN1463Q1Simulator* sims[6];
+        for (int i = 0; i < 6; i++) sims[i] = create_node(false);
+        for (int s = 0; s < 2; s++) {
+            networks[s] = tcan1463q1_can_network_create(&kTiming);
+            tcan1463q1_can_network_add_node(networks[s], sims[s * 3]);
+            tcan1463q1_can_network_add_node(networks[s], sims[s * 3 + 1]);
+        }
+
+        GatewayConfig config;
+        tcan1463q1_gateway_config_init(&config);
+        config.latency_ns[GATEWAY_SEGMENT_B] = 250000;
+        Gateway* gateway = tcan1463q1_gateway_create(networks[0], networks[1], sims[2], sims[5],
+                                                     &config);
+        ASSERT_NE(gateway, nullptr);
+        for (uint32_t id = 0x100; id < 0x110; id++) {
+            GatewayRoute a = {GATEWAY_SEGMENT_A, id, false, id + 0x100, false};
+            GatewayRoute b = {GATEWAY_SEGMENT_B, id + 0x400, false, id + 0x500, false};
+            tcan1463q1_gateway_add_route(gateway, &a);
+            tcan1463q1_gateway_add_route(gateway, &b);
+        }
+        tcan1463q1_gateway_run_for(gateway, 30000, 1);
+
+        for (uint32_t i = 0; i < 8; i++) {
+            CANFrame a = make_frame(0x100 + i * 2, false, (uint8_t)i);
+            CANFrame b = make_frame(0x500 + i, false, (uint8_t)i);
+            tcan1463q1_can_controller_send(tcan1463q1_can_network_get_controller(networks[0], i % 2), &a);
+            tcan1463q1_can_controller_send(tcan1463q1_can_network_get_controller(networks[1], i % 2), &b);
+        }
+        tcan1463q1_gateway_run_for(gateway, 8000000, run == 0 ? 1 : 2);
+
+        tcan1463q1_gateway_get_stats(gateway, &results[run]);
+        CANFrame frame;
+        for (int s = 0; s < 2; s++) {
+            while (tcan1463q1_can_controller_receive(
+                       tcan1463q1_can_network_get_controller(networks[s], 0), &frame)) {
+                received_ids[run].push_back(frame.id);
+            }
+        }
+
+        tcan1463q1_gateway_destroy(gateway);
+        for (int s = 0; s < 2; s++) tcan1463q1_can_network_destroy(networks[s]);
+        for (int i = 0; i < 6; i++) tcan1463q1_simulator_destroy(sims[i]);
+    }
+
+    EXPECT_EQ(memcmp(&results[0], &results[1], sizeof(GatewayStats)), 0);
+    EXPECT_EQ(received_ids[0], received_ids[1]);
+    EXPECT_EQ(results[0].forwarded[GATEWAY_SEGMENT_A], 8u);
+    EXPECT_EQ(results[0].forwarded[GATEWAY_SEGMENT_B], 8u);
+}
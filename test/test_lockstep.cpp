@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_lockstep.h"
+#include "tcan1463q1_profile.h"
+#include <string.h>
+
+// Unit tests for lockstep differential validation
+
+static const char* kDominantScenario =
+    "scenario Lockstep Dominant\n"
+    "configure 5.0 5.0 3.3 25.0 60.0 100e-12\n"
+    "wait 340us\n"
+    "set_pin EN HIGH 3.3\n"
+    "set_pin NSTB HIGH 3.3\n"
+    "wait 200us\n"
+    "check_mode NORMAL\n"
+    "set_pin TXD LOW 0.0\n"
+    "wait 5us\n"
+    "set_pin TXD HIGH 3.3\n"
+    "wait 5us\n";
+
+class LockstepTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        fast = tcan1463q1_simulator_create();
+        reference = tcan1463q1_simulator_create();
+        char error[128] = {0};
+        scenario = tcan1463q1_scenario_parse(kDominantScenario, error, sizeof(error));
+        ASSERT_NE(scenario, nullptr) << error;
+
+        tcan1463q1_lockstep_config_init(&config);
+        config.reference_step_ns = 10;
+    }
+
+    void TearDown() override {
+        tcan1463q1_scenario_destroy(scenario);
+        tcan1463q1_simulator_destroy(fast);
+        tcan1463q1_simulator_destroy(reference);
+    }
+
+    TCAN1463Q1Simulator* fast;
+    TCAN1463Q1Simulator* reference;
+    Scenario* scenario;
+    LockstepConfig config;
+};
+
+TEST_F(LockstepTest, CompareReportsDifferingFields) {
+    SimulatorObservableState a, b;
+    tcan1463q1_simulator_get_observable_state(fast, &a);
+    b = a;
+
+    LockstepDifference difference;
+    EXPECT_TRUE(tcan1463q1_lockstep_compare(&a, &b, 1e-9, &difference));
+
+    b.mode = MODE_SLEEP;
+    b.flags ^= 1u << FLAG_TXDDTO;
+    b.pin_states[PIN_RXD] = PIN_STATE_LOW;
+    b.pin_voltages[PIN_CANH] += 0.1;
+    EXPECT_FALSE(tcan1463q1_lockstep_compare(&a, &b, 1e-9, &difference));
+    EXPECT_TRUE(difference.mode);
+    EXPECT_EQ(difference.flags, 1u << FLAG_TXDDTO);
+    EXPECT_EQ(difference.pin_states, 1u << PIN_RXD);
+    EXPECT_EQ(difference.pin_voltages, 1u << PIN_CANH);
+
+    // Within tolerance the voltages match
+    EXPECT_TRUE(tcan1463q1_lockstep_compare(&a, &a, 0.0, nullptr));
+    b = a;
+    b.pin_voltages[PIN_CANH] += 0.05;
+    EXPECT_TRUE(tcan1463q1_lockstep_compare(&a, &b, 0.1, nullptr));
+}
+
+TEST_F(LockstepTest, FlagWordMatchesFlags) {
+    tcan1463q1_simulator_set_pin(fast, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_step(fast, 1000);
+
+    bool f[12];
+    tcan1463q1_simulator_get_flags(fast, &f[0], &f[1], &f[2], &f[3], &f[4], &f[5],
+                                   &f[6], &f[7], &f[8], &f[9], &f[10], &f[11]);
+    uint32_t word = tcan1463q1_simulator_get_flag_word(fast);
+    for (int i = 0; i <= FLAG_TSD; i++) {
+        EXPECT_EQ(((word >> i) & 1u) != 0, f[i]) << "flag " << i;
+    }
+}
+
+TEST_F(LockstepTest, MatchingSimulatorsDoNotDiverge) {
+    LockstepResult result;
+    EXPECT_TRUE(tcan1463q1_lockstep_run_scenario(scenario, fast, reference, &config, &result));
+    EXPECT_FALSE(result.diverged);
+    EXPECT_GT(result.checkpoints, 0u);
+    EXPECT_EQ(result.reference_steps, 550000u / 10);
+
+    // Fast side in fixed chunks: one checkpoint per chunk
+    tcan1463q1_simulator_reset(fast);
+    tcan1463q1_simulator_reset(reference);
+    config.fast_step_ns = 1000;
+    EXPECT_TRUE(tcan1463q1_lockstep_run_scenario(scenario, fast, reference, &config, &result));
+    EXPECT_GT(result.checkpoints, 550u);
+}
+
+TEST_F(LockstepTest, DivergenceIsReportedWithBothStates) {
+    // Reference runs a corner with a weaker dominant CANH level
+    DeviceProfile* profile = tcan1463q1_profile_parse("canh_dominant 3.3\n", nullptr, 0);
+    ASSERT_NE(profile, nullptr);
+    TCAN1463Q1Simulator* corner = tcan1463q1_simulator_create_with_profile(profile);
+    tcan1463q1_profile_release(profile);
+
+    LockstepResult result;
+    EXPECT_FALSE(tcan1463q1_lockstep_run_scenario(scenario, fast, corner, &config, &result));
+    EXPECT_TRUE(result.diverged);
+    // Found on the first step after TXD goes low
+    ASSERT_GT(result.action_index, 0u);
+    EXPECT_EQ(scenario->actions[result.action_index].type, ACTION_WAIT);
+    EXPECT_EQ(scenario->actions[result.action_index - 1].data.set_pin.pin, PIN_TXD);
+    EXPECT_TRUE(result.difference.pin_voltages & (1u << PIN_CANH));
+    EXPECT_FALSE(result.difference.mode);
+    EXPECT_EQ(result.fast.time_ns, result.reference.time_ns);
+
+    char report[2048];
+    tcan1463q1_lockstep_format(&result, report, sizeof(report));
+    EXPECT_NE(strstr(report, "Divergence at"), nullptr);
+    EXPECT_NE(strstr(report, "reference:"), nullptr);
+
+    tcan1463q1_simulator_destroy(corner);
+}
+
+TEST_F(LockstepTest, FormatReportsTruncationLength) {
+    LockstepResult result;
+    ASSERT_TRUE(tcan1463q1_lockstep_run_scenario(scenario, fast, reference, &config, &result));
+
+    char small[8];
+    int length = tcan1463q1_lockstep_format(&result, small, sizeof(small));
+    EXPECT_GT(length, (int)sizeof(small));
+    EXPECT_EQ(strlen(small), sizeof(small) - 1);
+}
+
+TEST_F(LockstepTest, QuiescentIntervalsMatchSteppingThrough) {
+    // Long dominant TXD: TXDDTO, RXD edges and bus timers in one run
+    Scenario* timeouts = tcan1463q1_scenario_parse(
+        "configure 5.0 5.0 3.3 25.0 60.0 100e-12\n"
+        "wait 340us\n"
+        "set_pin EN HIGH 3.3\n"
+        "set_pin NSTB HIGH 3.3\n"
+        "wait 200us\n"
+        "set_pin TXD LOW 0.0\n"
+        "wait 3ms\n"
+        "set_pin TXD HIGH 3.3\n"
+        "wait 1ms\n"
+        "set_pin NSTB LOW 0.0\n"
+        "wait 2ms\n", nullptr, 0);
+    ASSERT_NE(timeouts, nullptr);
+
+    // Same verdict, at the same point, with the same reference state
+    LockstepResult skipped, stepped;
+    bool skipped_ok = tcan1463q1_lockstep_run_scenario(timeouts, fast, reference, &config,
+                                                       &skipped);
+    SimulatorObservableState a;
+    tcan1463q1_simulator_get_observable_state(reference, &a);
+
+    tcan1463q1_simulator_reset(fast);
+    tcan1463q1_simulator_reset(reference);
+    config.skip_quiescent = false;
+    EXPECT_EQ(tcan1463q1_lockstep_run_scenario(timeouts, fast, reference, &config, &stepped),
+              skipped_ok);
+    SimulatorObservableState b;
+    tcan1463q1_simulator_get_observable_state(reference, &b);
+
+    EXPECT_GT(skipped.reference_skipped, skipped.reference_steps / 2);
+    EXPECT_EQ(stepped.reference_skipped, 0u);
+    EXPECT_EQ(skipped.action_index, stepped.action_index);
+    EXPECT_EQ(skipped.reference_steps, stepped.reference_steps);
+    EXPECT_EQ(skipped.checkpoints, stepped.checkpoints);
+    EXPECT_EQ(a.time_ns, b.time_ns);
+    EXPECT_NE(a.flags & (1u << FLAG_TXDDTO), 0u);
+    EXPECT_TRUE(tcan1463q1_lockstep_compare(&a, &b, 0.0, nullptr));
+    tcan1463q1_scenario_destroy(timeouts);
+}
+
+TEST_F(LockstepTest, ExecuteScenarioEvaluatesChecksInOnePass) {
+    ScenarioResult lockstep_result;
+    LockstepResult result;
+    EXPECT_TRUE(tcan1463q1_lockstep_execute_scenario(scenario, fast, reference, &config,
+                                                      &lockstep_result, &result));
+    EXPECT_TRUE(lockstep_result.success);
+    EXPECT_EQ(lockstep_result.actions_executed, scenario->action_count);
+
+    // A failing check ends the run like tcan1463q1_scenario_execute
+    tcan1463q1_scenario_add_check_mode(scenario, NULL, MODE_SLEEP);
+    tcan1463q1_scenario_add_wait(scenario, NULL, 1000);
+    tcan1463q1_simulator_reset(fast);
+    tcan1463q1_simulator_reset(reference);
+    EXPECT_TRUE(tcan1463q1_lockstep_execute_scenario(scenario, fast, reference, &config,
+                                                      &lockstep_result, &result));
+    EXPECT_FALSE(result.diverged);
+
+    TCAN1463Q1Simulator* plain = tcan1463q1_simulator_create();
+    ScenarioResult expected = tcan1463q1_scenario_execute(scenario, plain);
+    EXPECT_FALSE(lockstep_result.success);
+    EXPECT_EQ(lockstep_result.actions_executed, expected.actions_executed);
+    EXPECT_EQ(lockstep_result.actions_failed, expected.actions_failed);
+    EXPECT_EQ(lockstep_result.failed_action_index, expected.failed_action_index);
+    EXPECT_STREQ(lockstep_result.error_message, expected.error_message);
+    EXPECT_EQ(tcan1463q1_simulator_get_time_ns(fast), tcan1463q1_simulator_get_time_ns(plain));
+    tcan1463q1_simulator_destroy(plain);
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_margin.h"
+
+// Unit tests for the timing-margin finder
+
+class MarginTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Normal mode, then TXD held dominant 2.01 ms: passes while tTXDDTO > 2.01 ms
+        // (fails with the default 1.2 ms)
+        scenario = tcan1463q1_scenario_create("txd_dominant", NULL);
+        ASSERT_NE(scenario, nullptr);
+        tcan1463q1_scenario_add_set_pin(scenario, "VSUP", PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+        tcan1463q1_scenario_add_set_pin(scenario, "VCC", PIN_VCC, PIN_STATE_ANALOG, 5.0);
+        tcan1463q1_scenario_add_set_pin(scenario, "VIO", PIN_VIO, PIN_STATE_ANALOG, 3.3);
+        tcan1463q1_scenario_add_set_pin(scenario, "EN", PIN_EN, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_scenario_add_set_pin(scenario, "nSTB", PIN_NSTB, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_scenario_add_set_pin(scenario, "TXD high", PIN_TXD, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_scenario_add_wait(scenario, "settle", 1000000);
+        tcan1463q1_scenario_add_check_mode(scenario, "normal", MODE_NORMAL);
+        tcan1463q1_scenario_add_set_pin(scenario, "TXD low", PIN_TXD, PIN_STATE_LOW, 0.0);
+        tcan1463q1_scenario_add_wait(scenario, "timer starts", 10000);
+        tcan1463q1_scenario_add_wait(scenario, "long dominant", 2000000);
+        tcan1463q1_scenario_add_check_flag(scenario, "no timeout", FLAG_TXDDTO, false);
+
+        tcan1463q1_margin_config_init(&config);
+        config.jobs = 4;
+    }
+
+    void TearDown() override {
+        tcan1463q1_scenario_destroy(scenario);
+    }
+
+    Scenario* scenario = nullptr;
+    MarginConfig config;
+};
+
+TEST_F(MarginTest, FindsTxdTimeoutBoundary) {
+    MarginParam param = {"ttxddto", 1000000.0, 4000000.0, 1000.0};
+    MarginResult result;
+    ASSERT_TRUE(tcan1463q1_margin_find(scenario, &config, &param, 1, &result));
+
+    EXPECT_TRUE(result.found);
+    EXPECT_FALSE(result.cancelled);
+    EXPECT_FALSE(result.pass_at_low);
+    EXPECT_LE(result.fail_value, 2010000.0);
+    EXPECT_GT(result.pass_value, 2010000.0);
+    EXPECT_LE(result.pass_value - result.fail_value, 1000.0);
+    EXPECT_EQ(result.base_value, 1200000.0);
+    EXPECT_DOUBLE_EQ(result.margin, result.pass_value - 1200000.0);
+    // Everything up to the long dominant wait is shared
+    EXPECT_EQ(result.prefix_actions, 10u);
+    // Far fewer runs than a 1 us grid over the bracket
+    EXPECT_LT(result.evaluations, 60u);
+}
+
+TEST_F(MarginTest, PrefixSnapshotDoesNotChangeResults) {
+    MarginParam param = {"ttxddto", 1000000.0, 4000000.0, 100.0};
+    MarginResult shared, full;
+    ASSERT_TRUE(tcan1463q1_margin_find(scenario, &config, &param, 1, &shared));
+    config.prefix_actions = 0;
+    ASSERT_TRUE(tcan1463q1_margin_find(scenario, &config, &param, 1, &full));
+
+    EXPECT_EQ(full.prefix_actions, 0u);
+    EXPECT_EQ(shared.pass_value, full.pass_value);
+    EXPECT_EQ(shared.fail_value, full.fail_value);
+    EXPECT_EQ(shared.evaluations, full.evaluations);
+}
+
+static void add_bus(Scenario* scenario, bool dominant) {
+    // The wake handler samples the bus as set before each step
+    tcan1463q1_scenario_add_set_pin(scenario, "CANH", PIN_CANH, PIN_STATE_ANALOG, dominant ? 3.5 : 2.5);
+    tcan1463q1_scenario_add_set_pin(scenario, "CANL", PIN_CANL, PIN_STATE_ANALOG, dominant ? 1.5 : 2.5);
+}
+
+TEST_F(MarginTest, WupPhaseAcrossActionsIsNotShared) {
+    // WUP in Sleep with 1 us phases; the first dominant phase completes at
+    // the low end (twk_filter <= 1 us) but not at the high end, while pins
+    // and flags still agree until the last phase
+    Scenario* wup = tcan1463q1_scenario_create("wup", NULL);
+    ASSERT_NE(wup, nullptr);
+    tcan1463q1_scenario_add_set_pin(wup, "VSUP", PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_scenario_add_set_pin(wup, "VCC", PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_scenario_add_set_pin(wup, "VIO", PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_scenario_add_set_pin(wup, "EN", PIN_EN, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_scenario_add_set_pin(wup, "nSTB", PIN_NSTB, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_scenario_add_set_pin(wup, "TXD", PIN_TXD, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_scenario_add_wait(wup, "settle", 1000000);
+    tcan1463q1_scenario_add_set_pin(wup, "EN low", PIN_EN, PIN_STATE_LOW, 0.0);
+    tcan1463q1_scenario_add_set_pin(wup, "nSTB low", PIN_NSTB, PIN_STATE_LOW, 0.0);
+    tcan1463q1_scenario_add_wait(wup, "go to sleep", 1000);
+    tcan1463q1_scenario_add_wait(wup, "tSILENCE", 1500000000);
+    add_bus(wup, true);
+    tcan1463q1_scenario_add_wait(wup, "first dominant", 100);
+    add_bus(wup, true);
+    tcan1463q1_scenario_add_wait(wup, "filter", 1000);
+    add_bus(wup, false);
+    tcan1463q1_scenario_add_wait(wup, "recessive", 1000);
+    add_bus(wup, true);
+    tcan1463q1_scenario_add_wait(wup, "second dominant", 2500);
+    tcan1463q1_scenario_add_check_flag(wup, "woken", FLAG_WAKERQ, true);
+
+    MarginParam param = {"twk_filter", 500.0, 3000.0, 1.0};
+    MarginResult shared, full;
+    ASSERT_TRUE(tcan1463q1_margin_find(wup, &config, &param, 1, &shared));
+    config.prefix_actions = 0;
+    ASSERT_TRUE(tcan1463q1_margin_find(wup, &config, &param, 1, &full));
+
+    EXPECT_TRUE(full.found);
+    EXPECT_EQ(full.pass_value, 1000.0);
+    EXPECT_EQ(full.fail_value, 1001.0);
+    EXPECT_EQ(shared.pass_value, full.pass_value);
+    EXPECT_EQ(shared.fail_value, full.fail_value);
+    // Shared up to the wait that finishes the first phase at the low end only
+    EXPECT_EQ(shared.prefix_actions, 16u);
+    tcan1463q1_scenario_destroy(wup);
+}
+
+TEST_F(MarginTest, SeveralParametersAndNoBoundary) {
+    MarginParam params[2] = {
+        {"tuv", 50000000.0, 400000000.0, 1000.0},
+        {"ttxddto", 2500000.0, 3000000.0, 1000.0},
+    };
+    MarginParam found = {"ttxddto", 1000000.0, 4000000.0, 1000.0};
+    MarginResult results[2];
+    ASSERT_TRUE(tcan1463q1_margin_find(scenario, &config, params, 2, results));
+    for (const MarginResult& result : results) {
+        EXPECT_FALSE(result.found);
+        EXPECT_EQ(result.evaluations, 2u);
+    }
+    EXPECT_FALSE(results[0].pass_at_low);
+    EXPECT_TRUE(results[1].pass_at_low);
+
+    params[1] = found;
+    config.jobs = 1;
+    ASSERT_TRUE(tcan1463q1_margin_find(scenario, &config, params, 2, results));
+    EXPECT_FALSE(results[0].found);
+    EXPECT_TRUE(results[1].found);
+    EXPECT_LE(results[1].fail_value, 2010000.0);
+    EXPECT_GT(results[1].pass_value, 2010000.0);
+}
+
+TEST_F(MarginTest, BaseProfileAndRejectedValues) {
+    DeviceProfile* base = tcan1463q1_profile_parse("ttxddto 3ms 4ms\n", NULL, 0);
+    ASSERT_NE(base, nullptr);
+    config.base = base;
+
+    // Receiver thresholds below vdiff_recessive are rejected and count as failing
+    MarginParam params[2] = {
+        {"ttxddto", 1000000.0, 4000000.0, 1000.0},
+        {"vdiff_dominant", 0.0, 0.9, 0.01},
+    };
+    MarginResult results[2];
+    ASSERT_TRUE(tcan1463q1_margin_find(scenario, &config, params, 2, results));
+    EXPECT_EQ(results[0].base_value, 3000000.0);
+    EXPECT_LT(results[0].margin, 0.0);
+    EXPECT_TRUE(results[1].found);
+    EXPECT_FALSE(results[1].pass_at_low);
+    EXPECT_LE(results[1].fail_value, 0.5);
+    EXPECT_GT(results[1].pass_value, 0.5);
+    tcan1463q1_profile_release(base);
+}
+
+TEST_F(MarginTest, RejectsInvalidArgumentsAndCancels) {
+    MarginResult result;
+    MarginParam unknown = {"tfoo", 0.0, 1.0, 0.1};
+    MarginParam feature = {"has_wake", 0.0, 1.0, 0.1};
+    MarginParam empty = {"ttxddto", 2000000.0, 1000000.0, 1000.0};
+    MarginParam no_tolerance = {"ttxddto", 1000000.0, 2000000.0, 0.0};
+    EXPECT_FALSE(tcan1463q1_margin_find(scenario, &config, &unknown, 1, &result));
+    EXPECT_FALSE(tcan1463q1_margin_find(scenario, &config, &feature, 1, &result));
+    EXPECT_FALSE(tcan1463q1_margin_find(scenario, &config, &empty, 1, &result));
+    EXPECT_FALSE(tcan1463q1_margin_find(scenario, &config, &no_tolerance, 1, &result));
+    EXPECT_FALSE(tcan1463q1_margin_find(NULL, &config, &unknown, 1, &result));
+
+    RunControl* control = tcan1463q1_run_control_create();
+    tcan1463q1_run_control_cancel(control);
+    config.run_control = control;
+    MarginParam param = {"ttxddto", 1000000.0, 4000000.0, 1000.0};
+    EXPECT_FALSE(tcan1463q1_margin_find(scenario, &config, &param, 1, &result));
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_FALSE(result.found);
+    tcan1463q1_run_control_destroy(control);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_mcu_driver.h"
+#include <vector>
+
+// Integration tests: driver state machine reacting to simulator pin events
+
+static TCAN1463Q1Simulator* create_powered_sim() {
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_LOW, 0.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_LOW, 0.0);
+    return sim;
+}
+
+class McuDriverTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        sim = create_powered_sim();
+        tcan1463q1_mcu_driver_config_init(&config);
+    }
+
+    void TearDown() override {
+        tcan1463q1_mcu_driver_destroy(driver);
+        tcan1463q1_simulator_destroy(sim);
+    }
+
+    void attach() {
+        driver = tcan1463q1_mcu_driver_create(sim, &config);
+        ASSERT_NE(driver, nullptr);
+    }
+
+    // Remote node sends a wake-up pattern: dominant, recessive, dominant
+    void send_wup() {
+        for (int phase = 0; phase < 3; phase++) {
+            tcan1463q1_simulator_set_remote_dominant(sim, phase != 1);
+            tcan1463q1_mcu_driver_advance(driver, 5000, 1000);
+        }
+        tcan1463q1_simulator_set_remote_dominant(sim, false);
+    }
+
+    McuDriverStats stats() {
+        McuDriverStats s;
+        tcan1463q1_mcu_driver_get_stats(driver, &s);
+        return s;
+    }
+
+    TCAN1463Q1Simulator* sim = nullptr;
+    McuDriver* driver = nullptr;
+    McuDriverConfig config;
+};
+
+TEST_F(McuDriverTest, ConfiguresTransceiverAfterStartupDelay) {
+    attach();
+    tcan1463q1_mcu_driver_advance(driver, 90000, 10000);
+    EXPECT_EQ(tcan1463q1_mcu_driver_get_state(driver), MCU_DRIVER_STARTUP);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_OFF);
+
+    tcan1463q1_mcu_driver_advance(driver, 20000, 10000);
+    EXPECT_EQ(tcan1463q1_mcu_driver_get_state(driver), MCU_DRIVER_ACTIVE);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_NORMAL);
+}
+
+TEST_F(McuDriverTest, SleepsAfterNetworkIdle) {
+    config.idle_timeout_ns = 2000000;
+    attach();
+    tcan1463q1_mcu_driver_advance(driver, 1000000, 10000);
+    ASSERT_EQ(tcan1463q1_mcu_driver_get_state(driver), MCU_DRIVER_ACTIVE);
+
+    // Bus traffic restarts the idle timer
+    tcan1463q1_simulator_set_remote_dominant(sim, true);
+    tcan1463q1_mcu_driver_advance(driver, 10000, 1000);
+    tcan1463q1_simulator_set_remote_dominant(sim, false);
+    tcan1463q1_mcu_driver_advance(driver, 1500000, 10000);
+    EXPECT_EQ(tcan1463q1_mcu_driver_get_state(driver), MCU_DRIVER_ACTIVE);
+
+    tcan1463q1_mcu_driver_advance(driver, 1000000, 10000);
+    EXPECT_EQ(tcan1463q1_mcu_driver_get_state(driver), MCU_DRIVER_SLEEP);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_GO_TO_SLEEP);
+    EXPECT_EQ(stats().sleeps, 1u);
+}
+
+TEST_F(McuDriverTest, WakesOnBusWakeUpAfterIsrLatency) {
+    config.idle_timeout_ns = 1000000;
+    config.isr_latency_ns = 7000;
+    attach();
+    tcan1463q1_mcu_driver_advance(driver, 700000000, 1000000);
+    ASSERT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_SLEEP);
+
+    send_wup();
+    tcan1463q1_mcu_driver_advance(driver, 100000, 10000);
+
+    McuDriverStats s = stats();
+    EXPECT_EQ(tcan1463q1_mcu_driver_get_state(driver), MCU_DRIVER_ACTIVE);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_NORMAL);
+    EXPECT_EQ(s.wakeups, 1u);
+    EXPECT_GE(s.flag_reads, 1u);
+    // Handlers run exactly one ISR latency after the edge
+    EXPECT_EQ(s.worst_latency_ns, 7000u);
+}
+
+TEST_F(McuDriverTest, GoesSilentWhileBusFaultFlagged) {
+    config.idle_timeout_ns = 0;
+    config.silent_on_fault = true;
+    attach();
+    tcan1463q1_mcu_driver_advance(driver, 200000, 10000);
+    ASSERT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_NORMAL);
+
+    // Stuck-dominant TXD trips the dominant timeout
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_LOW, 0.0);
+    tcan1463q1_mcu_driver_advance(driver, 5000000, 10000);
+
+    McuDriverStats s = stats();
+    EXPECT_GE(s.faults, 1u);
+    EXPECT_NE(s.last_flags & (1u << 8), 0u);     // TXDDTO
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_SILENT);
+}
+
+TEST_F(McuDriverTest, QuietSimulatorRaisesNoInterrupts) {
+    config.idle_timeout_ns = 0;
+    attach();
+    tcan1463q1_mcu_driver_advance(driver, 200000, 10000);
+    McuDriverStats before = stats();
+
+    tcan1463q1_mcu_driver_advance(driver, 10000000, 1000);
+    EXPECT_EQ(stats().interrupts, before.interrupts);
+    EXPECT_EQ(tcan1463q1_mcu_driver_next_deadline_ns(driver), UINT64_MAX);
+}
+
+static void count_clone_edges(const SimulatorEvent* event, void* user_data) {
+    std::vector<TCAN1463Q1Simulator*>* sources = (std::vector<TCAN1463Q1Simulator*>*)user_data;
+    sources->push_back(event->sim);
+}
+
+TEST_F(McuDriverTest, ClonesDoNotDriveTheDriver) {
+    config.idle_timeout_ns = 1000000;
+    std::vector<TCAN1463Q1Simulator*> sources;
+    ASSERT_TRUE(tcan1463q1_simulator_register_callback(sim, EVENT_PIN_CHANGE,
+                                                       count_clone_edges, &sources));
+    attach();
+    tcan1463q1_mcu_driver_advance(driver, 700000000, 1000000);
+    ASSERT_EQ(tcan1463q1_mcu_driver_get_state(driver), MCU_DRIVER_SLEEP);
+
+    // A wake-up on the clone reaches the shared callback, not the driver
+    TCAN1463Q1Simulator* clone = tcan1463q1_simulator_clone(sim);
+    ASSERT_NE(clone, nullptr);
+    sources.clear();
+    for (int phase = 0; phase < 3; phase++) {
+        tcan1463q1_simulator_set_remote_dominant(clone, phase != 1);
+        for (int i = 0; i < 5; i++) tcan1463q1_simulator_step(clone, 1000);
+    }
+    tcan1463q1_mcu_driver_advance(driver, 100000, 10000);
+    EXPECT_EQ(stats().interrupts, 0u);
+    EXPECT_EQ(tcan1463q1_mcu_driver_get_state(driver), MCU_DRIVER_SLEEP);
+    ASSERT_FALSE(sources.empty());
+    for (TCAN1463Q1Simulator* source : sources) EXPECT_EQ(source, clone);
+
+    // The clone keeps running once the driver is gone
+    tcan1463q1_mcu_driver_destroy(driver);
+    driver = nullptr;
+    tcan1463q1_simulator_set_remote_dominant(clone, false);
+    for (int i = 0; i < 100; i++) tcan1463q1_simulator_step(clone, 1000);
+    tcan1463q1_simulator_destroy(clone);
+}
+
+TEST(McuDriverFleetTest, AdvancesManyEcusOnOneThread) {
+    const size_t count = 500;
+    std::vector<TCAN1463Q1Simulator*> sims(count);
+    std::vector<McuDriver*> drivers(count);
+
+    McuDriverConfig config;
+    tcan1463q1_mcu_driver_config_init(&config);
+    for (size_t i = 0; i < count; i++) {
+        sims[i] = create_powered_sim();
+        config.startup_delay_ns = 10000 * (i % 10 + 1);
+        config.idle_timeout_ns = 1000000;
+        drivers[i] = tcan1463q1_mcu_driver_create(sims[i], &config);
+        ASSERT_NE(drivers[i], nullptr);
+    }
+
+    tcan1463q1_mcu_driver_advance_all(drivers.data(), count, 500000, 100000);
+    for (size_t i = 0; i < count; i++) {
+        EXPECT_EQ(tcan1463q1_mcu_driver_get_state(drivers[i]), MCU_DRIVER_ACTIVE);
+    }
+    tcan1463q1_mcu_driver_advance_all(drivers.data(), count, 1000000, 100000);
+    for (size_t i = 0; i < count; i++) {
+        EXPECT_EQ(tcan1463q1_mcu_driver_get_state(drivers[i]), MCU_DRIVER_SLEEP);
+        tcan1463q1_mcu_driver_destroy(drivers[i]);
+        tcan1463q1_simulator_destroy(sims[i]);
+    }
+}
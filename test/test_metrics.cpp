@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_metrics.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+// Unit tests for the metrics exporter
+
+// Render once (every call starts a new rate interval)
+static std::string format(MetricsExporter* exporter) {
+    std::string text(65536, '\0');
+    size_t length = tcan1463q1_metrics_format(exporter, &text[0], text.size());
+    EXPECT_LT(length, text.size());
+    text.resize(length);
+    return text;
+}
+
+// Value of a metric line for a source (NAN if absent)
+static double metric_value(const std::string& text, const char* name, const char* source) {
+    std::string prefix = std::string(name) + "{source=\"" + source + "\"} ";
+    size_t pos = text.find(prefix);
+    if (pos == std::string::npos) return NAN;
+    return strtod(text.c_str() + pos + prefix.size(), NULL);
+}
+
+static std::string read_file(const std::string& path) {
+    std::string text;
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file) return text;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, n);
+    fclose(file);
+    return text;
+}
+
+TEST(MetricsTest, FormatsPublishedCounters) {
+    MetricsConfig config;
+    tcan1463q1_metrics_config_init(&config);
+    MetricsExporter* exporter = tcan1463q1_metrics_create(&config);
+    ASSERT_NE(exporter, nullptr);
+
+    int source = tcan1463q1_metrics_add_source(exporter, "sweep 1\"");
+    ASSERT_EQ(source, 0);
+    MetricsCounters counters = {2500000000ULL, 1000, 40, 3, 7, 4096};
+    tcan1463q1_metrics_publish(exporter, source, &counters);
+
+    std::string text = format(exporter);
+    EXPECT_NE(text.find("# TYPE tcan1463q1_steps_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE tcan1463q1_queue_depth gauge\n"), std::string::npos);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_sim_time_seconds_total", "sweep_1_"), 2.5);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_steps_total", "sweep_1_"), 1000);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_events_total", "sweep_1_"), 40);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_faults_total", "sweep_1_"), 3);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_queue_depth", "sweep_1_"), 7);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_memory_bytes", "sweep_1_"), 4096);
+
+    // Truncated output keeps the full length
+    char small[16];
+    EXPECT_GT(tcan1463q1_metrics_format(exporter, small, sizeof(small)), sizeof(small));
+    EXPECT_EQ(strlen(small), sizeof(small) - 1);
+
+    tcan1463q1_metrics_destroy(exporter);
+}
+
+TEST(MetricsTest, RatesOverInterval) {
+    MetricsConfig config;
+    tcan1463q1_metrics_config_init(&config);
+    MetricsExporter* exporter = tcan1463q1_metrics_create(&config);
+    ASSERT_NE(exporter, nullptr);
+    int source = tcan1463q1_metrics_add_source(exporter, "run");
+
+    MetricsCounters counters = {0, 0, 0, 0, 0, 0};
+    tcan1463q1_metrics_publish(exporter, source, &counters);
+    format(exporter);
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    counters.steps = 1000;
+    counters.sim_time_ns = 100000000;      // 100 ms simulated
+    tcan1463q1_metrics_publish(exporter, source, &counters);
+    std::string text = format(exporter);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double rate = metric_value(text, "tcan1463q1_steps_per_second", "run");
+    double ratio = metric_value(text, "tcan1463q1_sim_wall_ratio", "run");
+    EXPECT_GE(rate, 1000 / elapsed * 0.99);
+    EXPECT_LE(rate, 1000 / 0.05);
+    EXPECT_GE(ratio, 0.1 / elapsed * 0.99);
+    EXPECT_LE(ratio, 2.0);
+
+    tcan1463q1_metrics_destroy(exporter);
+}
+
+TEST(MetricsTest, ReadsConsistentCountersWhilePublishing) {
+    MetricsConfig config;
+    tcan1463q1_metrics_config_init(&config);
+    MetricsExporter* exporter = tcan1463q1_metrics_create(&config);
+    ASSERT_NE(exporter, nullptr);
+    int source = tcan1463q1_metrics_add_source(exporter, "writer");
+
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (uint64_t i = 1; !done.load(); i++) {
+            MetricsCounters counters = {i, i, i, i, i, i};
+            tcan1463q1_metrics_publish(exporter, source, &counters);
+        }
+    });
+    for (int i = 0; i < 200; i++) {
+        std::string text = format(exporter);
+        double steps = metric_value(text, "tcan1463q1_steps_total", "writer");
+        EXPECT_EQ(metric_value(text, "tcan1463q1_events_total", "writer"), steps);
+        EXPECT_EQ(metric_value(text, "tcan1463q1_memory_bytes", "writer"), steps);
+    }
+    done = true;
+    writer.join();
+    tcan1463q1_metrics_destroy(exporter);
+}
+
+TEST(MetricsTest, WritesTextfileAtomically) {
+    std::string path = ::testing::TempDir() + "tcan1463q1_metrics_test.prom";
+    MetricsConfig config;
+    tcan1463q1_metrics_config_init(&config);
+    config.file_path = path.c_str();
+    MetricsExporter* exporter = tcan1463q1_metrics_create(&config);
+    ASSERT_NE(exporter, nullptr);
+
+    int source = tcan1463q1_metrics_add_source(exporter, "net");
+    MetricsCounters counters = {0, 12, 0, 0, 0, 0};
+    tcan1463q1_metrics_publish(exporter, source, &counters);
+    ASSERT_TRUE(tcan1463q1_metrics_write_file(exporter));
+
+    std::string text = read_file(path);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_steps_total", "net"), 12);
+    EXPECT_NE(access(path.c_str(), F_OK), -1);
+    EXPECT_EQ(access((path + ".tmp").c_str(), F_OK), -1);
+
+    tcan1463q1_metrics_destroy(exporter);
+    unlink(path.c_str());
+}
+
+TEST(MetricsTest, BackgroundThreadExportsToFileAndSocket) {
+    std::string file_path = ::testing::TempDir() + "tcan1463q1_metrics_bg.prom";
+    std::string socket_path = ::testing::TempDir() + "tcan1463q1_metrics.sock";
+    unlink(file_path.c_str());
+    MetricsConfig config;
+    tcan1463q1_metrics_config_init(&config);
+    config.file_path = file_path.c_str();
+    config.socket_path = socket_path.c_str();
+    config.interval_ms = 20;
+    MetricsExporter* exporter = tcan1463q1_metrics_create(&config);
+    ASSERT_NE(exporter, nullptr);
+    int source = tcan1463q1_metrics_add_source(exporter, "bg");
+    MetricsCounters counters = {0, 5, 0, 0, 0, 0};
+    tcan1463q1_metrics_publish(exporter, source, &counters);
+
+    ASSERT_TRUE(tcan1463q1_metrics_start(exporter));
+    EXPECT_FALSE(tcan1463q1_metrics_start(exporter));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_DOUBLE_EQ(metric_value(read_file(file_path), "tcan1463q1_steps_total", "bg"), 5);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    ASSERT_EQ(connect(fd, (struct sockaddr*)&address, sizeof(address)), 0);
+    std::string text;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) text.append(buffer, (size_t)n);
+    close(fd);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_steps_total", "bg"), 5);
+
+    tcan1463q1_metrics_stop(exporter);
+    EXPECT_EQ(access(socket_path.c_str(), F_OK), -1);
+    tcan1463q1_metrics_destroy(exporter);
+    unlink(file_path.c_str());
+}
+
+TEST(MetricsTest, PublishesNetworkCounters) {
+    MetricsConfig config;
+    tcan1463q1_metrics_config_init(&config);
+    MetricsExporter* exporter = tcan1463q1_metrics_create(&config);
+    ASSERT_NE(exporter, nullptr);
+    int source = tcan1463q1_metrics_add_source(exporter, "bus");
+
+    CANBitTiming timing = {500000, 0.8};
+    CANNetwork* network = tcan1463q1_can_network_create(&timing);
+    ASSERT_NE(network, nullptr);
+    tcan1463q1_can_network_run_bits(network, 10);
+    tcan1463q1_metrics_publish_network(exporter, source, network);
+
+    std::string text = format(exporter);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_steps_total", "bus"), 10);
+    EXPECT_DOUBLE_EQ(metric_value(text, "tcan1463q1_sim_time_seconds_total", "bus"), 20e-6);
+
+    tcan1463q1_can_network_destroy(network);
+    tcan1463q1_metrics_destroy(exporter);
+}
+
+TEST(MetricsTest, RejectsInvalidUse) {
+    MetricsConfig config;
+    tcan1463q1_metrics_config_init(&config);
+    config.interval_ms = 0;
+    EXPECT_EQ(tcan1463q1_metrics_create(&config), nullptr);
+
+    tcan1463q1_metrics_config_init(&config);
+    config.max_sources = 1;
+    MetricsExporter* exporter = tcan1463q1_metrics_create(&config);
+    ASSERT_NE(exporter, nullptr);
+    EXPECT_EQ(tcan1463q1_metrics_add_source(exporter, "a"), 0);
+    EXPECT_EQ(tcan1463q1_metrics_add_source(exporter, "b"), -1);
+    EXPECT_FALSE(tcan1463q1_metrics_write_file(exporter));
+
+    // Unknown sources are ignored
+    MetricsCounters counters = {1, 1, 1, 1, 1, 1};
+    tcan1463q1_metrics_publish(exporter, 5, &counters);
+    tcan1463q1_metrics_destroy(exporter);
+}
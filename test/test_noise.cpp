@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_noise.h"
+#include <math.h>
+#include <vector>
+
+// Unit tests for EMC noise injection
+
+static void count_rxd_changes(const SimulatorEvent* event, void* user_data) {
+    if (event->data.pin_change.pin == PIN_RXD) (*(int*)user_data)++;
+}
+
+static double rms(const std::vector<double>& v) {
+    double sum = 0.0;
+    for (double x : v) sum += x * x;
+    return sqrt(sum / v.size());
+}
+
+static double lag1_correlation(const std::vector<double>& v) {
+    double num = 0.0, den = 0.0;
+    for (size_t i = 0; i < v.size(); i++) {
+        den += v[i] * v[i];
+        if (i + 1 < v.size()) num += v[i] * v[i + 1];
+    }
+    return num / den;
+}
+
+TEST(NoiseGenerateTest, ReproducibleAndRandomAccess) {
+    NoiseConfig config;
+    tcan1463q1_noise_config_init(&config);
+    config.seed = 42;
+    config.differential_rms_v = 0.1;
+    config.common_mode_rms_v = 0.5;
+    config.bandwidth_taps = 5;
+    config.impulse_rate_hz = 1e5;
+    config.impulse_amplitude_v = 2.0;
+
+    std::vector<double> d1(1000), c1(1000), d2(1000), c2(1000);
+    ASSERT_TRUE(tcan1463q1_noise_generate(&config, 0, 1000, d1.data(), c1.data()));
+    ASSERT_TRUE(tcan1463q1_noise_generate(&config, 0, 1000, d2.data(), c2.data()));
+    EXPECT_EQ(d1, d2);
+    EXPECT_EQ(c1, c2);
+
+    // Any stretch can be generated on its own, bit for bit
+    ASSERT_TRUE(tcan1463q1_noise_generate(&config, 0, 300, d2.data(), c2.data()));
+    ASSERT_TRUE(tcan1463q1_noise_generate(&config, 300, 700, d2.data() + 300, c2.data() + 300));
+    EXPECT_EQ(d1, d2);
+    EXPECT_EQ(c1, c2);
+
+    config.seed = 43;
+    ASSERT_TRUE(tcan1463q1_noise_generate(&config, 0, 1000, d2.data(), NULL));
+    EXPECT_NE(d1, d2);
+}
+
+TEST(NoiseGenerateTest, RmsAndBandwidth) {
+    NoiseConfig config;
+    tcan1463q1_noise_config_init(&config);
+    config.differential_rms_v = 0.2;
+    config.common_mode_rms_v = 1.0;
+
+    const size_t n = 100000;
+    std::vector<double> diff(n), cm(n);
+    ASSERT_TRUE(tcan1463q1_noise_generate(&config, 0, n, diff.data(), cm.data()));
+    EXPECT_NEAR(rms(diff), 0.2, 0.01);
+    EXPECT_NEAR(rms(cm), 1.0, 0.05);
+    EXPECT_LT(fabs(lag1_correlation(diff)), 0.02);
+
+    // Band-limited: same RMS, strongly correlated neighbours
+    config.bandwidth_taps = 8;
+    ASSERT_TRUE(tcan1463q1_noise_generate(&config, 0, n, diff.data(), NULL));
+    EXPECT_NEAR(rms(diff), 0.2, 0.01);
+    EXPECT_GT(lag1_correlation(diff), 0.8);
+}
+
+TEST(NoiseGenerateTest, ImpulseRate) {
+    NoiseConfig config;
+    tcan1463q1_noise_config_init(&config);
+    config.impulse_rate_hz = 1e5;          // 1 per 10 us: ~200 in 2 ms
+    config.impulse_amplitude_v = 3.0;
+    config.impulse_width_ns = 50;
+
+    const size_t n = 40000;                // 2 ms at 50 ns
+    std::vector<double> diff(n);
+    ASSERT_TRUE(tcan1463q1_noise_generate(&config, 0, n, diff.data(), NULL));
+    int impulses = 0;
+    for (double v : diff) {
+        if (v != 0.0) {
+            EXPECT_NEAR(fabs(v), 3.0, 1e-12);
+            impulses++;
+        }
+    }
+    EXPECT_NEAR(impulses, 200, 45);
+}
+
+TEST(NoiseGenerateTest, RejectsInvalidConfig) {
+    NoiseConfig config;
+    tcan1463q1_noise_config_init(&config);
+    double out[4];
+    config.sample_period_ns = 0;
+    EXPECT_FALSE(tcan1463q1_noise_generate(&config, 0, 4, out, NULL));
+    tcan1463q1_noise_config_init(&config);
+    config.bandwidth_taps = 0;
+    EXPECT_FALSE(tcan1463q1_noise_generate(&config, 0, 4, out, NULL));
+    tcan1463q1_noise_config_init(&config);
+    config.differential_rms_v = -1.0;
+    EXPECT_FALSE(tcan1463q1_noise_generate(&config, 0, 4, out, NULL));
+}
+
+class NoiseSimulatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        sim = tcan1463q1_simulator_create();
+        ASSERT_NE(sim, nullptr);
+        tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+        tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+        tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+        tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_step(sim, 1000000);
+    }
+
+    void TearDown() override {
+        tcan1463q1_simulator_destroy(sim);
+    }
+
+    // RXD changes over 10000 steps of 100 ns on a recessive bus
+    int run_recessive() {
+        int changes = 0;
+        tcan1463q1_simulator_register_callback(sim, EVENT_PIN_CHANGE, count_rxd_changes, &changes);
+        for (int i = 0; i < 10000; i++) tcan1463q1_simulator_step(sim, 100);
+        tcan1463q1_simulator_unregister_callback(sim, EVENT_PIN_CHANGE, count_rxd_changes);
+        return changes;
+    }
+
+    TCAN1463Q1Simulator* sim = nullptr;
+};
+
+TEST_F(NoiseSimulatorTest, DifferentialNoiseCorruptsReception) {
+    NoiseConfig config;
+    tcan1463q1_noise_config_init(&config);
+    config.differential_rms_v = 0.02;
+    ASSERT_TRUE(tcan1463q1_noise_attach(sim, &config));
+    EXPECT_EQ(run_recessive(), 0);
+
+    config.differential_rms_v = 1.0;
+    ASSERT_TRUE(tcan1463q1_noise_attach(sim, &config));
+    EXPECT_GT(run_recessive(), 10);
+
+    tcan1463q1_noise_detach(sim);
+    tcan1463q1_simulator_step(sim, 10000);
+    EXPECT_EQ(run_recessive(), 0);
+}
+
+TEST_F(NoiseSimulatorTest, CommonModeNoiseIsRejected) {
+    NoiseConfig config;
+    tcan1463q1_noise_config_init(&config);
+    config.common_mode_rms_v = 2.0;
+    config.bandwidth_taps = 4;
+    ASSERT_TRUE(tcan1463q1_noise_attach(sim, &config));
+    EXPECT_EQ(run_recessive(), 0);
+}
+
+TEST_F(NoiseSimulatorTest, SameSeedReplaysAfterRestore) {
+    NoiseConfig config;
+    tcan1463q1_noise_config_init(&config);
+    config.differential_rms_v = 0.5;
+    config.impulse_rate_hz = 1e5;
+    config.impulse_amplitude_v = 2.0;
+    ASSERT_TRUE(tcan1463q1_noise_attach(sim, &config));
+
+    SimulatorSnapshot* snapshot = tcan1463q1_simulator_snapshot(sim);
+    std::vector<double> first, second;
+    PinState state;
+    double voltage;
+    for (int i = 0; i < 500; i++) {
+        tcan1463q1_simulator_step(sim, 70);
+        tcan1463q1_simulator_get_pin(sim, PIN_CANH, &state, &voltage);
+        first.push_back(voltage);
+    }
+    ASSERT_TRUE(tcan1463q1_simulator_restore(sim, snapshot));
+    for (int i = 0; i < 500; i++) {
+        tcan1463q1_simulator_step(sim, 70);
+        tcan1463q1_simulator_get_pin(sim, PIN_CANH, &state, &voltage);
+        second.push_back(voltage);
+    }
+    EXPECT_EQ(first, second);
+    tcan1463q1_simulator_snapshot_free(snapshot);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <rapidcheck.h>
 #include "pin_manager.h"
+#include "voltage_impl.h"
 
 class PinManagerTest : public ::testing::Test {
 protected:
@@ -354,7 +355,31 @@ TEST(PinManagerPropertyTest, PinValueRoundTripConsistency) {
         RC_ASSERT(get_result);
         
         // Property: The read values should match what was set
+        // (on the microvolt grid in fixed-point builds)
         RC_ASSERT(read_state == state);
-        RC_ASSERT(read_voltage == voltage);
+        RC_ASSERT(read_voltage == voltage_store(voltage));
     });
 }
+
+// Voltage keys: nearest microvolt, saturating
+TEST(VoltageKeyTest, MicrovoltConversion) {
+    EXPECT_EQ(voltage_to_uv(0.9), 900000);
+    EXPECT_EQ(voltage_to_uv(-0.5), -500000);
+    EXPECT_EQ(voltage_to_uv(3.8499996), 3850000);
+    EXPECT_EQ(voltage_to_uv(3.8499994), 3849999);
+    EXPECT_EQ(voltage_to_uv(1e6), INT32_MAX);
+    EXPECT_EQ(voltage_to_uv(-1e6), INT32_MIN);
+    EXPECT_EQ(voltage_to_uv(NAN), INT32_MIN);
+    EXPECT_EQ(voltage_from_uv(voltage_to_uv(12.000001)), 12.000001);
+}
+
+#ifdef TCAN1463Q1_FIXED_POINT
+// Stored pin voltages sit on the microvolt grid
+TEST_F(PinManagerTest, FixedPointStoresMicrovolts) {
+    PinState state;
+    double voltage;
+    ASSERT_TRUE(pin_manager_set_pin(&manager, PIN_VSUP, PIN_STATE_ANALOG, 13.50000049));
+    ASSERT_TRUE(pin_manager_get_pin(&manager, PIN_VSUP, &state, &voltage));
+    EXPECT_EQ(voltage, voltage_from_uv(13500000));
+}
+#endif
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_probe.h"
+#include <string.h>
+
+// Unit tests for internal signal probes
+
+class ProbeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        sim = tcan1463q1_simulator_create();
+        ASSERT_NE(sim, nullptr);
+    }
+
+    void TearDown() override {
+        tcan1463q1_simulator_destroy(sim);
+        tcan1463q1_probe_set_destroy(set);
+    }
+
+    void power_up() {
+        tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+        tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+        tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+        tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_step(sim, 1000000);
+        ASSERT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_NORMAL);
+    }
+
+    TCAN1463Q1Simulator* sim = nullptr;
+    ProbeSet* set = nullptr;
+};
+
+TEST_F(ProbeTest, RejectsInvalidArguments) {
+    EXPECT_EQ(tcan1463q1_probe_set_create(0, 64), nullptr);
+    EXPECT_EQ(tcan1463q1_probe_set_create(1, 0), nullptr);
+    EXPECT_EQ(tcan1463q1_probe_set_create(1, 100), nullptr);
+
+    set = tcan1463q1_probe_set_create(1, 128);
+    ASSERT_NE(set, nullptr);
+    uint64_t buffer[128];
+    EXPECT_FALSE(tcan1463q1_probe_set_add(set, PROBE_SIGNAL_COUNT, buffer));
+    EXPECT_FALSE(tcan1463q1_probe_set_add(NULL, PROBE_TIME, buffer));
+
+    EXPECT_EQ(tcan1463q1_probe_signal_format(PROBE_RXD), PROBE_FORMAT_BIT);
+    EXPECT_EQ(tcan1463q1_probe_signal_format(PROBE_VDIFF), PROBE_FORMAT_F64);
+    EXPECT_EQ(tcan1463q1_probe_signal_format(PROBE_MODE), PROBE_FORMAT_U8);
+    EXPECT_EQ(tcan1463q1_probe_signal_format(PROBE_TXD_DOMINANT_NS), PROBE_FORMAT_U64);
+    EXPECT_STREQ(tcan1463q1_probe_signal_name(PROBE_WUP_STATE), "wup_state");
+}
+
+TEST_F(ProbeTest, StrideAndRingWrap) {
+    set = tcan1463q1_probe_set_create(2, 64);
+    ASSERT_NE(set, nullptr);
+    uint64_t times[64];
+    ASSERT_TRUE(tcan1463q1_probe_set_add(set, PROBE_TIME, times));
+    tcan1463q1_simulator_set_probes(sim, set);
+
+    for (int i = 0; i < 200; i++) tcan1463q1_simulator_step(sim, 10);
+    ASSERT_EQ(tcan1463q1_probe_set_samples(set), 100u);
+
+    // Sample n was taken after step 2(n + 1); the oldest kept is sample 36
+    size_t oldest = 100 % 64;
+    EXPECT_EQ(times[oldest], 740u);
+    EXPECT_EQ(times[(oldest + 63) % 64], 2000u);
+    for (size_t i = 1; i < 64; i++) {
+        EXPECT_EQ(times[(oldest + i) % 64] - times[(oldest + i - 1) % 64], 20u);
+    }
+
+    // Detached probes are left alone
+    tcan1463q1_simulator_set_probes(sim, NULL);
+    tcan1463q1_simulator_step(sim, 10);
+    EXPECT_EQ(tcan1463q1_probe_set_samples(set), 100u);
+
+    tcan1463q1_probe_set_reset(set);
+    EXPECT_EQ(tcan1463q1_probe_set_samples(set), 0u);
+    tcan1463q1_probe_set_sample(set, sim);
+    EXPECT_EQ(times[0], 2010u);
+}
+
+TEST_F(ProbeTest, SamplesDominantBit) {
+    power_up();
+    set = tcan1463q1_probe_set_create(1, 256);
+    ASSERT_NE(set, nullptr);
+    double vdiff[256];
+    uint8_t bus[256], mode[256], wup[256];
+    uint64_t rxd[4], driver[4], txd_timer[256];
+    ASSERT_TRUE(tcan1463q1_probe_set_add(set, PROBE_VDIFF, vdiff));
+    ASSERT_TRUE(tcan1463q1_probe_set_add(set, PROBE_BUS_STATE, bus));
+    ASSERT_TRUE(tcan1463q1_probe_set_add(set, PROBE_MODE, mode));
+    ASSERT_TRUE(tcan1463q1_probe_set_add(set, PROBE_WUP_STATE, wup));
+    ASSERT_TRUE(tcan1463q1_probe_set_add(set, PROBE_RXD, rxd));
+    ASSERT_TRUE(tcan1463q1_probe_set_add(set, PROBE_DRIVER_ENABLED, driver));
+    ASSERT_TRUE(tcan1463q1_probe_set_add(set, PROBE_TXD_DOMINANT_NS, txd_timer));
+    tcan1463q1_simulator_set_probes(sim, set);
+
+    // 2 us recessive, 2 us dominant, 2 us recessive in 25 ns steps
+    for (int bit = 0; bit < 3; bit++) {
+        bool dominant = bit == 1;
+        tcan1463q1_simulator_set_pin(sim, PIN_TXD, dominant ? PIN_STATE_LOW : PIN_STATE_HIGH,
+                                     dominant ? 0.0 : 3.3);
+        for (int step = 0; step < 80; step++) tcan1463q1_simulator_step(sim, 25);
+    }
+    ASSERT_EQ(tcan1463q1_probe_set_samples(set), 240u);
+
+    EXPECT_TRUE(tcan1463q1_probe_get_bit(rxd, 0));
+    EXPECT_EQ(bus[0], BUS_STATE_RECESSIVE);
+    EXPECT_LT(vdiff[0], 0.5);
+    EXPECT_EQ(txd_timer[0], 0u);
+    // End of the dominant bit
+    EXPECT_FALSE(tcan1463q1_probe_get_bit(rxd, 159));
+    EXPECT_EQ(bus[159], BUS_STATE_DOMINANT);
+    EXPECT_GT(vdiff[159], 1.5);
+    EXPECT_GT(txd_timer[159], 1500u);
+    EXPECT_GT(txd_timer[159], txd_timer[120]);
+    EXPECT_TRUE(tcan1463q1_probe_get_bit(rxd, 239));
+    EXPECT_EQ(txd_timer[239], 0u);
+
+    size_t low = 0;
+    for (size_t i = 0; i < 240; i++) {
+        EXPECT_TRUE(tcan1463q1_probe_get_bit(driver, i));
+        EXPECT_EQ(mode[i], MODE_NORMAL);
+        EXPECT_EQ(wup[i], WUP_STATE_IDLE);
+        if (!tcan1463q1_probe_get_bit(rxd, i)) low++;
+    }
+    EXPECT_GT(low, 70u);
+    EXPECT_LT(low, 90u);
+}
+
+TEST_F(ProbeTest, KeptAcrossResetAndRestore) {
+    set = tcan1463q1_probe_set_create(1, 64);
+    ASSERT_NE(set, nullptr);
+    uint8_t mode[64];
+    ASSERT_TRUE(tcan1463q1_probe_set_add(set, PROBE_MODE, mode));
+    tcan1463q1_simulator_set_probes(sim, set);
+
+    SimulatorSnapshot* snapshot = tcan1463q1_simulator_snapshot(sim);
+    tcan1463q1_simulator_set_probes(sim, NULL);
+    ASSERT_TRUE(tcan1463q1_simulator_restore(sim, snapshot));
+    EXPECT_EQ(sim->probes, nullptr);
+    tcan1463q1_simulator_snapshot_free(snapshot);
+
+    tcan1463q1_simulator_set_probes(sim, set);
+    tcan1463q1_simulator_reset(sim);
+    EXPECT_EQ(sim->probes, set);
+    tcan1463q1_simulator_step(sim, 1000);
+    EXPECT_EQ(tcan1463q1_probe_set_samples(set), 1u);
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_simulator.h"
+#include "tcan1463q1_profile.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Unit tests for runtime device profiles
+
+static std::string write_temp_profile(const char* text) {
+    char path[] = "/tmp/tcan1463q1_profile_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return std::string();
+    FILE* file = fdopen(fd, "w");
+    fputs(text, file);
+    fclose(file);
+    return path;
+}
+
+TEST(ProfileTest, ParsesValuesRangesAndFeatures) {
+    char error[128] = {0};
+    DeviceProfile* profile = tcan1463q1_profile_parse(
+        "# corner\n"
+        "name slow\n"
+        "base TCAN1462-Q1\n"
+        "uvcc_falling 3.8   # volts\n"
+        "tuv 120ms 340ms\n"
+        "twk_filter 1.5us\n"
+        "tinh_slp_stb 80us\n",
+        error, sizeof(error));
+    ASSERT_NE(profile, nullptr) << error;
+
+    const DeviceParams* params = tcan1463q1_profile_get_params(profile);
+    EXPECT_STREQ(tcan1463q1_profile_get_name(profile), "slow");
+    EXPECT_EQ(tcan1463q1_profile_get_variant(profile), DEVICE_VARIANT_TCAN1462Q1);
+    EXPECT_DOUBLE_EQ(params->uvcc_falling, 3.8);
+    EXPECT_EQ(params->tuv.min_ns, 120000000ULL);
+    EXPECT_EQ(params->tuv.max_ns, 340000000ULL);
+    EXPECT_EQ(params->twk_filter.min_ns, 1500ULL);
+    EXPECT_EQ(params->twk_filter.max_ns, 1500ULL);
+    EXPECT_EQ(params->tinh_slp_stb_ns, 80000ULL);
+    EXPECT_FALSE(params->has_wake);
+
+    // Unspecified parameters come from the base variant
+    EXPECT_EQ(params->ttxddto.min_ns,
+              tcan1463q1_device_get_params(DEVICE_VARIANT_TCAN1462Q1)->ttxddto.min_ns);
+
+    tcan1463q1_profile_release(profile);
+}
+
+TEST(ProfileTest, RejectsInvalidProfiles) {
+    char error[128] = {0};
+
+    EXPECT_EQ(tcan1463q1_profile_parse("tuv 100ms\nfoo 1\n", error, sizeof(error)), nullptr);
+    EXPECT_STREQ(error, "2: unknown parameter 'foo'");
+
+    EXPECT_EQ(tcan1463q1_profile_parse("tuv 100ms\nbase TCAN1462-Q1\n", error, sizeof(error)),
+              nullptr);
+    EXPECT_STREQ(error, "2: base must precede parameters");
+
+    EXPECT_EQ(tcan1463q1_profile_parse("has_wake maybe\n", error, sizeof(error)), nullptr);
+    EXPECT_EQ(tcan1463q1_profile_parse("tuv 10 minutes\n", error, sizeof(error)), nullptr);
+    EXPECT_EQ(tcan1463q1_profile_parse("canh_dominant inf\n", error, sizeof(error)), nullptr);
+    EXPECT_STREQ(error, "1: canh_dominant expects a number");
+    EXPECT_EQ(tcan1463q1_profile_parse("isup_normal nan\n", error, sizeof(error)), nullptr);
+
+    // Validation runs after parsing
+    EXPECT_EQ(tcan1463q1_profile_parse("uvcc_falling 4.5\n", error, sizeof(error)), nullptr);
+    EXPECT_STREQ(error, "uvcc_falling must be positive and below uvcc_rising");
+
+    EXPECT_EQ(tcan1463q1_profile_parse("tbusdom 3ms 2ms\n", error, sizeof(error)), nullptr);
+    EXPECT_STREQ(error, "tbusdom range is empty or zero");
+
+    EXPECT_EQ(tcan1463q1_profile_parse("has_inh no\n", error, sizeof(error)), nullptr);
+    EXPECT_STREQ(error, "has_inh_mask requires has_inh");
+}
+
+TEST(ProfileTest, LoadIsCachedAndShared) {
+    std::string path = write_temp_profile("tuv 200ms\n");
+    ASSERT_FALSE(path.empty());
+
+    size_t cached_before = tcan1463q1_profile_cache_count();
+    DeviceProfile* first = tcan1463q1_profile_load(path.c_str(), NULL, 0);
+    DeviceProfile* second = tcan1463q1_profile_load(path.c_str(), NULL, 0);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(tcan1463q1_profile_cache_count(), cached_before + 1);
+    EXPECT_STREQ(tcan1463q1_profile_get_name(first), strrchr(path.c_str(), '/') + 1);
+
+    // Simulators share the cached parameter table
+    TCAN1463Q1Simulator* a = tcan1463q1_simulator_create_with_profile(first);
+    TCAN1463Q1Simulator* b = tcan1463q1_simulator_create_with_profile(first);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(tcan1463q1_simulator_get_device_params(a), tcan1463q1_profile_get_params(first));
+    EXPECT_EQ(tcan1463q1_simulator_get_device_params(a), tcan1463q1_simulator_get_device_params(b));
+
+    // The cache entry lives as long as any reference does
+    tcan1463q1_profile_release(first);
+    tcan1463q1_profile_release(second);
+    tcan1463q1_simulator_destroy(a);
+    EXPECT_EQ(tcan1463q1_profile_cache_count(), cached_before + 1);
+    tcan1463q1_simulator_destroy(b);
+    EXPECT_EQ(tcan1463q1_profile_cache_count(), cached_before);
+
+    remove(path.c_str());
+    EXPECT_EQ(tcan1463q1_profile_load("/nonexistent/corner.prof", NULL, 0), nullptr);
+}
+
+TEST(ProfileTest, SimulatorUsesProfileTimings) {
+    // Shorter tSILENCE: Go-to-sleep reaches Sleep after 0.6 s by default
+    DeviceProfile* profile = tcan1463q1_profile_parse("tsilence 100ms 1.2s\n", NULL, 0);
+    ASSERT_NE(profile, nullptr);
+
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create_with_profile(profile);
+    TCAN1463Q1Simulator* reference = tcan1463q1_simulator_create();
+    ASSERT_NE(sim, nullptr);
+    ASSERT_NE(reference, nullptr);
+    tcan1463q1_profile_release(profile);
+
+    TCAN1463Q1Simulator* sims[2] = {sim, reference};
+    for (TCAN1463Q1Simulator* s : sims) {
+        tcan1463q1_simulator_set_pin(s, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+        tcan1463q1_simulator_set_pin(s, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+        tcan1463q1_simulator_set_pin(s, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+        tcan1463q1_simulator_set_pin(s, PIN_TXD, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_set_pin(s, PIN_EN, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_set_pin(s, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_step(s, 1000);
+        tcan1463q1_simulator_set_pin(s, PIN_NSTB, PIN_STATE_LOW, 0.0);
+        tcan1463q1_simulator_step(s, 1000);
+        ASSERT_EQ(tcan1463q1_simulator_get_mode(s), MODE_GO_TO_SLEEP);
+        tcan1463q1_simulator_step(s, 200000000ULL);
+        tcan1463q1_simulator_step(s, 1000);
+    }
+
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_SLEEP);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(reference), MODE_GO_TO_SLEEP);
+
+    // Profile survives reset
+    tcan1463q1_simulator_reset(sim);
+    EXPECT_NE(sim->profile, nullptr);
+
+    tcan1463q1_simulator_destroy(sim);
+    tcan1463q1_simulator_destroy(reference);
+}
+
+TEST(ProfileTest, CreateFromParamsAndSetByKey) {
+    DeviceParams params = *tcan1463q1_device_get_params(DEVICE_VARIANT_TCAN1462Q1);
+    EXPECT_TRUE(tcan1463q1_profile_set_param(&params, "ttxddto", 2000000.4));
+    EXPECT_EQ(params.ttxddto.min_ns, 2000000u);
+    EXPECT_EQ(params.ttxddto.max_ns, 2000000u);
+    EXPECT_TRUE(tcan1463q1_profile_set_param(&params, "TINH_SLP_STB", 50000.0));
+    EXPECT_EQ(params.tinh_slp_stb_ns, 50000u);
+    EXPECT_TRUE(tcan1463q1_profile_set_param(&params, "vdiff_dominant", 0.8));
+    EXPECT_FALSE(tcan1463q1_profile_set_param(&params, "has_wake", 1.0));
+    EXPECT_FALSE(tcan1463q1_profile_set_param(&params, "tuv", -1.0));
+    EXPECT_FALSE(tcan1463q1_profile_set_param(&params, "icc_dominant", HUGE_VAL));
+    EXPECT_FALSE(tcan1463q1_profile_set_param(&params, "tfoo", 1.0));
+
+    double value = 0.0;
+    EXPECT_TRUE(tcan1463q1_profile_get_param(&params, "vdiff_dominant", &value));
+    EXPECT_EQ(value, 0.8);
+    EXPECT_TRUE(tcan1463q1_profile_get_param(&params, "tbusdom", &value));
+    EXPECT_EQ(value, (double)params.tbusdom.min_ns);
+    EXPECT_FALSE(tcan1463q1_profile_get_param(&params, "has_inh", &value));
+
+    DeviceProfile* profile = tcan1463q1_profile_create("slow", DEVICE_VARIANT_TCAN1462Q1,
+                                                       &params, NULL, 0);
+    ASSERT_NE(profile, nullptr);
+    EXPECT_STREQ(tcan1463q1_profile_get_name(profile), "slow");
+    EXPECT_EQ(tcan1463q1_profile_get_variant(profile), DEVICE_VARIANT_TCAN1462Q1);
+    EXPECT_EQ(tcan1463q1_profile_get_params(profile)->ttxddto.min_ns, 2000000u);
+    tcan1463q1_profile_release(profile);
+
+    char error[128] = "";
+    params.vdiff_dominant = 0.1;
+    EXPECT_EQ(tcan1463q1_profile_create(NULL, DEVICE_VARIANT_TCAN1462Q1, &params, error,
+                                        sizeof(error)), nullptr);
+    EXPECT_NE(error[0], '\0');
+
+    // Non-finite levels and currents pass the ordering checks but not validation
+    params.vdiff_dominant = 0.8;
+    params.isup_normal = HUGE_VAL;
+    EXPECT_FALSE(tcan1463q1_profile_validate_params(&params, error, sizeof(error)));
+    EXPECT_STREQ(error, "isup_normal must be finite");
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_run_control.h"
+#include "tcan1463q1_scenario.h"
+#include "tcan1463q1_lockstep.h"
+#include "tcan1463q1_stimulus.h"
+#include <chrono>
+#include <thread>
+
+// Unit tests for cooperative cancellation and progress reporting
+
+static bool never(TCAN1463Q1Simulator*, void*) {
+    return false;
+}
+
+class RunControlTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        control = tcan1463q1_run_control_create();
+        ASSERT_NE(control, nullptr);
+        sim = tcan1463q1_simulator_create();
+        ASSERT_NE(sim, nullptr);
+        tcan1463q1_simulator_set_run_control(sim, control);
+    }
+
+    void TearDown() override {
+        tcan1463q1_simulator_destroy(sim);
+        tcan1463q1_run_control_destroy(control);
+    }
+
+    void cancel_after(int ms) {
+        canceller = std::thread([this, ms]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+            tcan1463q1_run_control_cancel(control);
+        });
+    }
+
+    RunControl* control = nullptr;
+    TCAN1463Q1Simulator* sim = nullptr;
+    std::thread canceller;
+};
+
+TEST_F(RunControlTest, CancelStopsRunUntilFromAnotherThread) {
+    cancel_after(20);
+    // Would take hours without cancellation
+    EXPECT_FALSE(tcan1463q1_simulator_run_until(sim, never, NULL, UINT64_MAX / 2));
+    canceller.join();
+
+    EXPECT_TRUE(tcan1463q1_run_control_is_cancelled(control));
+    RunProgress progress;
+    tcan1463q1_run_control_get_progress(control, &progress);
+    EXPECT_GT(progress.sim_time_ns, 0u);
+    EXPECT_EQ(progress.sim_time_ns, tcan1463q1_simulator_get_time_ns(sim));
+}
+
+TEST_F(RunControlTest, ScenarioCountsProgress) {
+    Scenario* scenario = tcan1463q1_scenario_create("waits", NULL);
+    ASSERT_NE(scenario, nullptr);
+    tcan1463q1_scenario_add_set_pin(scenario, "TXD high", PIN_TXD, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_scenario_add_wait(scenario, "first", 5000);
+    tcan1463q1_scenario_add_comment(scenario, "between");
+    tcan1463q1_scenario_add_wait(scenario, "second", 7000);
+    ScenarioResult result = tcan1463q1_scenario_execute(scenario, sim);
+    EXPECT_TRUE(result.success);
+    EXPECT_FALSE(result.cancelled);
+
+    RunProgress progress;
+    tcan1463q1_run_control_get_progress(control, &progress);
+    EXPECT_EQ(progress.actions_completed, scenario->action_count);
+    EXPECT_EQ(progress.runs_finished, 1u);
+    EXPECT_EQ(progress.sim_time_ns, 12000u);
+
+    tcan1463q1_run_control_reset(control);
+    tcan1463q1_run_control_get_progress(control, &progress);
+    EXPECT_EQ(progress.actions_completed, 0u);
+    EXPECT_EQ(progress.runs_finished, 0u);
+    tcan1463q1_scenario_destroy(scenario);
+}
+
+TEST_F(RunControlTest, CancelledScenarioStopsWithoutFailure) {
+    Scenario* scenario = tcan1463q1_scenario_create("stuck", "Waits for ever");
+    ASSERT_NE(scenario, nullptr);
+    tcan1463q1_scenario_add_wait(scenario, "settle", 1000);
+    tcan1463q1_scenario_add_wait_until(scenario, "never", never, NULL, UINT64_MAX / 2);
+    tcan1463q1_scenario_add_wait(scenario, "after", 1000);
+
+    cancel_after(20);
+    ScenarioResult result = tcan1463q1_scenario_execute(scenario, sim);
+    canceller.join();
+    EXPECT_FALSE(result.success);
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_EQ(result.failed_action_index, 1u);
+    EXPECT_EQ(result.actions_executed, 1u);
+    EXPECT_EQ(result.actions_failed, 0u);
+
+    RunProgress progress;
+    tcan1463q1_run_control_get_progress(control, &progress);
+    EXPECT_EQ(progress.runs_finished, 0u);
+
+    // Nothing runs while cancelled
+    result = tcan1463q1_scenario_execute(scenario, sim);
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_EQ(result.actions_executed, 0u);
+    tcan1463q1_scenario_destroy(scenario);
+}
+
+TEST_F(RunControlTest, StepStopsAtStimulusEdgeWhenCancelled) {
+    StimulusConfig config;
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_SQUARE, PIN_TXD);
+    config.period_ns = 4000;
+    ASSERT_GE(tcan1463q1_stimulus_attach(sim, &config), 0);
+
+    tcan1463q1_run_control_cancel(control);
+    uint64_t start = tcan1463q1_simulator_get_time_ns(sim);
+    tcan1463q1_simulator_step(sim, 1000000);
+    EXPECT_LE(tcan1463q1_simulator_get_time_ns(sim) - start, 4000u);
+}
+
+TEST_F(RunControlTest, KeptAcrossResetAndRestore) {
+    SimulatorSnapshot* snapshot = tcan1463q1_simulator_snapshot(sim);
+    tcan1463q1_simulator_set_run_control(sim, NULL);
+    ASSERT_TRUE(tcan1463q1_simulator_restore(sim, snapshot));
+    EXPECT_EQ(sim->run_control, nullptr);
+    tcan1463q1_simulator_snapshot_free(snapshot);
+
+    tcan1463q1_simulator_set_run_control(sim, control);
+    tcan1463q1_simulator_reset(sim);
+    EXPECT_EQ(sim->run_control, control);
+}
+
+TEST_F(RunControlTest, CancelledLockstepRun) {
+    TCAN1463Q1Simulator* reference = tcan1463q1_simulator_create();
+    ASSERT_NE(reference, nullptr);
+    Scenario* scenario = tcan1463q1_scenario_power_up_sequence();
+    ASSERT_NE(scenario, nullptr);
+
+    tcan1463q1_run_control_cancel(control);
+    LockstepResult result;
+    EXPECT_FALSE(tcan1463q1_lockstep_run_scenario(scenario, sim, reference, NULL, &result));
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_FALSE(result.diverged);
+    EXPECT_EQ(tcan1463q1_simulator_get_time_ns(sim), 0u);
+
+    tcan1463q1_scenario_destroy(scenario);
+    tcan1463q1_simulator_destroy(reference);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_scenario.h"
+#include <stdio.h>
+#include <string.h>
+
+// Unit tests for scenario file parsing
+
+static const char* kPowerUpScenario =
+    "# Power-up test\n"
+    "scenario Power-Up From File\n"
+    "description Off to Normal\n"
+    "\n"
+    "configure 5.0 5.0 3.3 25.0 60.0 100e-12 -- Supplies\n"
+    "wait 340us -- tPWRUP\n"
+    "set_pin EN HIGH 3.3\n"
+    "set_pin nstb high 3.3 -- Set nSTB high\n"
+    "wait 200us\n"
+    "check_mode NORMAL\n"
+    "check_flag PWRON 0\n"
+    "comment done\n";
+
+TEST(ScenarioFileTest, ParsesActionsAndMetadata) {
+    char error[128] = {0};
+    Scenario* scenario = tcan1463q1_scenario_parse(kPowerUpScenario, error, sizeof(error));
+    ASSERT_NE(scenario, nullptr) << error;
+
+    EXPECT_STREQ(scenario->name, "Power-Up From File");
+    EXPECT_STREQ(scenario->description, "Off to Normal");
+    ASSERT_EQ(scenario->action_count, 8u);
+
+    EXPECT_EQ(scenario->actions[0].type, ACTION_CONFIGURE);
+    EXPECT_STREQ(scenario->actions[0].description, "Supplies");
+    EXPECT_DOUBLE_EQ(scenario->actions[0].data.configure.cl_capacitance, 100e-12);
+
+    EXPECT_EQ(scenario->actions[1].type, ACTION_WAIT);
+    EXPECT_EQ(scenario->actions[1].data.wait.duration_ns, 340000ULL);
+
+    EXPECT_EQ(scenario->actions[3].type, ACTION_SET_PIN);
+    EXPECT_EQ(scenario->actions[3].data.set_pin.pin, PIN_NSTB);
+    EXPECT_EQ(scenario->actions[3].data.set_pin.state, PIN_STATE_HIGH);
+    EXPECT_STREQ(scenario->actions[3].description, "Set nSTB high");
+
+    EXPECT_EQ(scenario->actions[5].type, ACTION_CHECK_MODE);
+    EXPECT_EQ(scenario->actions[5].data.check_mode.expected_mode, MODE_NORMAL);
+    EXPECT_EQ(scenario->actions[6].data.check_flag.flag, FLAG_PWRON);
+    EXPECT_FALSE(scenario->actions[6].data.check_flag.expected_value);
+    EXPECT_EQ(scenario->actions[7].type, ACTION_COMMENT);
+
+    tcan1463q1_scenario_destroy(scenario);
+}
+
+TEST(ScenarioFileTest, ParsedScenarioExecutes) {
+    Scenario* scenario = tcan1463q1_scenario_parse(kPowerUpScenario, NULL, 0);
+    ASSERT_NE(scenario, nullptr);
+
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    ASSERT_NE(sim, nullptr);
+
+    ScenarioResult result = tcan1463q1_scenario_execute(scenario, sim);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.actions_passed, 8u);
+
+    tcan1463q1_simulator_destroy(sim);
+    tcan1463q1_scenario_destroy(scenario);
+}
+
+TEST(ScenarioFileTest, DurationUnits) {
+    uint64_t ns = 0;
+    EXPECT_TRUE(tcan1463q1_scenario_parse_duration("1500", &ns));
+    EXPECT_EQ(ns, 1500ULL);
+    EXPECT_TRUE(tcan1463q1_scenario_parse_duration("0.5us", &ns));
+    EXPECT_EQ(ns, 500ULL);
+    EXPECT_TRUE(tcan1463q1_scenario_parse_duration("1.2ms", &ns));
+    EXPECT_EQ(ns, 1200000ULL);
+    EXPECT_TRUE(tcan1463q1_scenario_parse_duration("1s", &ns));
+    EXPECT_EQ(ns, 1000000000ULL);
+
+    EXPECT_FALSE(tcan1463q1_scenario_parse_duration("10 min", &ns));
+    EXPECT_FALSE(tcan1463q1_scenario_parse_duration("-1ms", &ns));
+    EXPECT_FALSE(tcan1463q1_scenario_parse_duration("", &ns));
+    EXPECT_FALSE(tcan1463q1_scenario_parse_duration("1e400", &ns));
+    EXPECT_FALSE(tcan1463q1_scenario_parse_duration("nan", &ns));
+    EXPECT_FALSE(tcan1463q1_scenario_parse_duration("20000000000s", &ns));
+
+    char error[128] = {0};
+    EXPECT_EQ(tcan1463q1_scenario_parse("wait 1e400\n", error, sizeof(error)), nullptr);
+    EXPECT_STREQ(error, "1: wait expects a duration (e.g. 200us)");
+}
+
+TEST(ScenarioFileTest, ErrorsReportLineNumber) {
+    char error[128] = {0};
+
+    Scenario* scenario = tcan1463q1_scenario_parse("wait 1us\nset_pin FOO HIGH\n",
+                                                   error, sizeof(error));
+    EXPECT_EQ(scenario, nullptr);
+    EXPECT_STREQ(error, "2: unknown pin 'FOO'");
+
+    scenario = tcan1463q1_scenario_parse("\n\njump 5\n", error, sizeof(error));
+    EXPECT_EQ(scenario, nullptr);
+    EXPECT_STREQ(error, "3: unknown action 'jump'");
+
+    scenario = tcan1463q1_scenario_parse("check_flag WAKERQ 2\n", error, sizeof(error));
+    EXPECT_EQ(scenario, nullptr);
+
+    scenario = tcan1463q1_scenario_parse("configure 5 5 3.3\n", error, sizeof(error));
+    EXPECT_EQ(scenario, nullptr);
+}
+
+TEST(ScenarioFileTest, StopOnErrorDirective) {
+    Scenario* scenario = tcan1463q1_scenario_parse("stop_on_error no\ncheck_mode SLEEP\n",
+                                                   NULL, 0);
+    ASSERT_NE(scenario, nullptr);
+    EXPECT_FALSE(scenario->stop_on_error);
+    tcan1463q1_scenario_destroy(scenario);
+}
+
+TEST(ScenarioFileTest, LoadFileDefaultsNameToFileName) {
+    char path[] = "/tmp/tcan1463q1_scenario_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    FILE* file = fdopen(fd, "w");
+    ASSERT_NE(file, nullptr);
+    fputs("wait 1ms\ncheck_mode OFF\n", file);
+    fclose(file);
+
+    Scenario* scenario = tcan1463q1_scenario_load_file(path, NULL, 0);
+    ASSERT_NE(scenario, nullptr);
+    EXPECT_STREQ(scenario->name, strrchr(path, '/') + 1);
+    EXPECT_EQ(scenario->action_count, 2u);
+
+    tcan1463q1_scenario_destroy(scenario);
+    remove(path);
+
+    EXPECT_EQ(tcan1463q1_scenario_load_file("/nonexistent/file.scn", NULL, 0), nullptr);
+}
+
+TEST(ScenarioFileTest, NameLookupsRoundTrip) {
+    for (int i = 0; i < 14; i++) {
+        PinType pin;
+        ASSERT_TRUE(tcan1463q1_scenario_pin_from_name(
+            tcan1463q1_scenario_pin_name((PinType)i), &pin));
+        EXPECT_EQ(pin, (PinType)i);
+    }
+    for (int i = 0; i < 6; i++) {
+        OperatingMode mode;
+        ASSERT_TRUE(tcan1463q1_scenario_mode_from_name(
+            tcan1463q1_scenario_mode_name((OperatingMode)i), &mode));
+        EXPECT_EQ(mode, (OperatingMode)i);
+    }
+    for (int i = 0; i < 12; i++) {
+        FlagType flag;
+        ASSERT_TRUE(tcan1463q1_scenario_flag_from_name(
+            tcan1463q1_scenario_flag_name((FlagType)i), &flag));
+        EXPECT_EQ(flag, (FlagType)i);
+    }
+    EXPECT_EQ(tcan1463q1_scenario_pin_name((PinType)14), nullptr);
+}
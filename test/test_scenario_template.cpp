@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_template.h"
+#include <string.h>
+
+// Unit tests for parametrized scenario templates
+
+static const char* kPowerUpTemplate =
+    "scenario Power-up corners\n"
+    "set_pin VSUP ANALOG $vsup -- Supply\n"
+    "set_pin VCC ANALOG 5.0\n"
+    "set_pin VIO ANALOG 3.3\n"
+    "set_pin EN HIGH 3.3\n"
+    "set_pin NSTB HIGH 3.3\n"
+    "set_pin TXD $txd 3.3\n"
+    "wait $settle\n"
+    "check_mode $mode\n"
+    "check_pin RXD $txd\n";
+
+// vsup, txd, settle, mode
+static const double kRows[3][4] = {
+    {12.0, PIN_STATE_HIGH, 1000000.0, MODE_NORMAL},
+    {12.0, PIN_STATE_LOW, 1000000.0, MODE_NORMAL},
+    {24.0, PIN_STATE_HIGH, 1000000.0, MODE_STANDBY},
+};
+
+class ScenarioTemplateTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char error[128] = {0};
+        tmpl = tcan1463q1_template_parse(kPowerUpTemplate, error, sizeof(error));
+        ASSERT_NE(tmpl, nullptr) << error;
+    }
+
+    void TearDown() override {
+        tcan1463q1_template_destroy(tmpl);
+    }
+
+    // The same instance built the usual way
+    static Scenario* materialize(const double* row) {
+        Scenario* scenario = tcan1463q1_scenario_create("instance", NULL);
+        tcan1463q1_scenario_add_set_pin(scenario, "Supply", PIN_VSUP, PIN_STATE_ANALOG, row[0]);
+        tcan1463q1_scenario_add_set_pin(scenario, NULL, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+        tcan1463q1_scenario_add_set_pin(scenario, NULL, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+        tcan1463q1_scenario_add_set_pin(scenario, NULL, PIN_EN, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_scenario_add_set_pin(scenario, NULL, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_scenario_add_set_pin(scenario, NULL, PIN_TXD, (PinState)row[1], 3.3);
+        tcan1463q1_scenario_add_wait(scenario, NULL, (uint64_t)row[2]);
+        tcan1463q1_scenario_add_check_mode(scenario, NULL, (OperatingMode)row[3]);
+        tcan1463q1_scenario_add_check_pin(scenario, NULL, PIN_RXD, (PinState)row[1], 0.0, 0.0);
+        return scenario;
+    }
+
+    ScenarioTemplate* tmpl = nullptr;
+};
+
+TEST_F(ScenarioTemplateTest, ParsesParametersAndExpandsActions) {
+    ASSERT_EQ(tcan1463q1_template_param_count(tmpl), 4u);
+    EXPECT_STREQ(tcan1463q1_template_param_name(tmpl, 0), "vsup");
+    EXPECT_STREQ(tcan1463q1_template_param_name(tmpl, 3), "mode");
+    EXPECT_EQ(tcan1463q1_template_param_index(tmpl, "txd"), 1);
+    EXPECT_EQ(tcan1463q1_template_param_index(tmpl, "vcc"), -1);
+
+    const Scenario* scenario = tcan1463q1_template_get_scenario(tmpl);
+    ASSERT_EQ(scenario->action_count, 9u);
+    EXPECT_STREQ(scenario->name, "Power-up corners");
+
+    ScenarioAction action;
+    ASSERT_TRUE(tcan1463q1_template_expand_action(tmpl, kRows[2], 0, &action));
+    EXPECT_EQ(action.type, ACTION_SET_PIN);
+    EXPECT_EQ(action.data.set_pin.pin, PIN_VSUP);
+    EXPECT_DOUBLE_EQ(action.data.set_pin.voltage, 24.0);
+    // Descriptions are the template's, not copies
+    EXPECT_EQ(action.description, scenario->actions[0].description);
+
+    ASSERT_TRUE(tcan1463q1_template_expand_action(tmpl, kRows[1], 8, &action));
+    EXPECT_EQ(action.data.check_pin.expected_state, PIN_STATE_LOW);
+    ASSERT_TRUE(tcan1463q1_template_expand_action(tmpl, kRows[0], 6, &action));
+    EXPECT_EQ(action.data.wait.duration_ns, 1000000u);
+    ASSERT_TRUE(tcan1463q1_template_expand_action(tmpl, kRows[2], 7, &action));
+    EXPECT_EQ(action.data.check_mode.expected_mode, MODE_STANDBY);
+    EXPECT_FALSE(tcan1463q1_template_expand_action(tmpl, kRows[0], 9, &action));
+}
+
+TEST_F(ScenarioTemplateTest, LanesMatchMaterializedScenarios) {
+    TCAN1463Q1Simulator* lanes[3];
+    for (TCAN1463Q1Simulator*& sim : lanes) sim = tcan1463q1_simulator_create();
+    ScenarioResult results[3];
+    ASSERT_TRUE(tcan1463q1_template_execute_lanes(tmpl, &kRows[0][0], lanes, 3, results));
+
+    for (int i = 0; i < 3; i++) {
+        Scenario* scenario = materialize(kRows[i]);
+        TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+        ScenarioResult expected = tcan1463q1_scenario_execute(scenario, sim);
+
+        EXPECT_EQ(results[i].success, expected.success) << "row " << i;
+        EXPECT_EQ(results[i].actions_executed, expected.actions_executed);
+        EXPECT_EQ(results[i].failed_action_index, expected.failed_action_index);
+
+        SimulatorObservableState a, b;
+        tcan1463q1_simulator_get_observable_state(lanes[i], &a);
+        tcan1463q1_simulator_get_observable_state(sim, &b);
+        EXPECT_EQ(a.time_ns, b.time_ns);
+        EXPECT_EQ(a.mode, b.mode);
+        EXPECT_EQ(a.flags, b.flags);
+        EXPECT_EQ(memcmp(a.pin_states, b.pin_states, sizeof(a.pin_states)), 0);
+
+        tcan1463q1_simulator_destroy(sim);
+        tcan1463q1_scenario_destroy(scenario);
+        tcan1463q1_simulator_destroy(lanes[i]);
+    }
+    EXPECT_TRUE(results[0].success);
+    EXPECT_FALSE(results[2].success);
+    EXPECT_EQ(results[2].failed_action_index, 7u);
+}
+
+struct TableTally {
+    size_t rows;
+    size_t passed;
+    size_t stop_after;
+};
+
+static bool tally_row(size_t row, const ScenarioResult* result,
+                      const TCAN1463Q1Simulator* sim, void* user_data) {
+    TableTally* tally = (TableTally*)user_data;
+    EXPECT_EQ(row, tally->rows);
+    EXPECT_NE(sim, nullptr);
+    tally->rows++;
+    if (result->success) tally->passed++;
+    return tally->rows != tally->stop_after;
+}
+
+TEST_F(ScenarioTemplateTest, RunsLargeTableInBatches) {
+    // Normal-mode instances across VSUP; every fourth one expects the wrong mode
+    const size_t rows = 2000;
+    double* table = (double*)malloc(rows * 4 * sizeof(double));
+    ASSERT_NE(table, nullptr);
+    for (size_t r = 0; r < rows; r++) {
+        double* row = &table[r * 4];
+        row[0] = 6.0 + (double)(r % 30);
+        row[1] = PIN_STATE_HIGH;
+        row[2] = 500000.0 + (double)(r % 7) * 1000.0;
+        row[3] = r % 4 == 3 ? MODE_STANDBY : MODE_NORMAL;
+    }
+
+    TableTally tally = {0, 0, 0};
+    ASSERT_TRUE(tcan1463q1_template_run_table(tmpl, table, rows, NULL, 16, tally_row, &tally));
+    EXPECT_EQ(tally.rows, rows);
+    EXPECT_EQ(tally.passed, rows - rows / 4);
+
+    // The callback can stop the run
+    TableTally stopped = {0, 0, 21};
+    EXPECT_FALSE(tcan1463q1_template_run_table(tmpl, table, rows, NULL, 8, tally_row, &stopped));
+    EXPECT_EQ(stopped.rows, 21u);
+    free(table);
+}
+
+TEST_F(ScenarioTemplateTest, RejectsInvalidBindingsAndValues) {
+    char error[128] = {0};
+    EXPECT_EQ(tcan1463q1_template_parse("set_pin $pin HIGH 3.3\n", error, sizeof(error)), nullptr);
+    EXPECT_STREQ(error, "1: parameter '$pin' not allowed here");
+    EXPECT_EQ(tcan1463q1_template_parse("wait $\n", error, sizeof(error)), nullptr);
+    EXPECT_STREQ(error, "1: invalid parameter '$'");
+    // Plain scenarios do not take parameters
+    EXPECT_EQ(tcan1463q1_scenario_parse("wait $settle\n", NULL, 0), nullptr);
+
+    // Values outside the field's range fail the action
+    double row[4] = {12.0, 7.0, 1000.0, MODE_NORMAL};
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    ScenarioResult result = tcan1463q1_template_execute(tmpl, row, sim);
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.failed_action_index, 5u);
+    EXPECT_STREQ(result.error_message, "Invalid template parameter");
+    tcan1463q1_simulator_destroy(sim);
+
+    // Programmatic templates over a borrowed scenario
+    Scenario* scenario = tcan1463q1_scenario_create("borrowed", NULL);
+    tcan1463q1_scenario_add_wait(scenario, NULL, 100);
+    tcan1463q1_scenario_add_check_mode(scenario, NULL, MODE_OFF);
+    ScenarioTemplate* custom = tcan1463q1_template_create(scenario);
+    ASSERT_NE(custom, nullptr);
+    EXPECT_FALSE(tcan1463q1_template_bind(custom, 0, TEMPLATE_FIELD_VOLTAGE, "t"));
+    EXPECT_FALSE(tcan1463q1_template_bind(custom, 2, TEMPLATE_FIELD_DURATION, "t"));
+    EXPECT_TRUE(tcan1463q1_template_bind(custom, 1, TEMPLATE_FIELD_MODE, "mode"));
+    EXPECT_TRUE(tcan1463q1_template_bind(custom, 0, TEMPLATE_FIELD_DURATION, "t"));
+    EXPECT_EQ(tcan1463q1_template_param_count(custom), 2u);
+
+    ScenarioAction action;
+    double values[2] = {MODE_SLEEP, 250.0};
+    ASSERT_TRUE(tcan1463q1_template_expand_action(custom, values, 0, &action));
+    EXPECT_EQ(action.data.wait.duration_ns, 250u);
+    ASSERT_TRUE(tcan1463q1_template_expand_action(custom, values, 1, &action));
+    EXPECT_EQ(action.data.check_mode.expected_mode, MODE_SLEEP);
+    tcan1463q1_template_destroy(custom);
+    tcan1463q1_scenario_destroy(scenario);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <rapidcheck.h>
 #include "tcan1463q1_simulator.h"
+#include "tcan1463q1_profile.h"
 
 class SimulatorTest : public ::testing::Test {
 protected:
@@ -569,7 +570,7 @@ TEST_F(SimulatorTest, SetTemperature_Valid) {
     // Valid temperature should be set successfully
     bool success = tcan1463q1_simulator_set_temperature(sim, 85.0);
     EXPECT_TRUE(success);
-    EXPECT_DOUBLE_EQ(sim->tj_temperature, 85.0);
+    EXPECT_DOUBLE_EQ(sim->config->tj_temperature, 85.0);
 }
 
 TEST_F(SimulatorTest, SetTemperature_Invalid) {
@@ -585,8 +586,8 @@ TEST_F(SimulatorTest, SetBusParameters_Valid) {
     // Valid bus parameters should be set successfully
     bool success = tcan1463q1_simulator_set_bus_parameters(sim, 120.0, 50e-12);
     EXPECT_TRUE(success);
-    EXPECT_DOUBLE_EQ(sim->rl_resistance, 120.0);
-    EXPECT_DOUBLE_EQ(sim->cl_capacitance, 50e-12);
+    EXPECT_DOUBLE_EQ(sim->config->rl_resistance, 120.0);
+    EXPECT_DOUBLE_EQ(sim->config->cl_capacitance, 50e-12);
 }
 
 TEST_F(SimulatorTest, SetBusParameters_Invalid) {
@@ -680,6 +681,110 @@ TEST_F(SimulatorTest, SnapshotRestoreWithTimingParameters) {
     tcan1463q1_simulator_snapshot_free(snapshot);
 }
 
+static void count_pin_changes(const SimulatorEvent* event, void* user_data) {
+    if (event->type == EVENT_PIN_CHANGE) ++*(int*)user_data;
+}
+
+TEST_F(SimulatorTest, CloneCopiesStateAndSharesCallbacks) {
+    tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_step(sim, 1000000);
+    int original_events = 0;
+    ASSERT_TRUE(tcan1463q1_simulator_register_callback(sim, EVENT_PIN_CHANGE,
+                                                       count_pin_changes, &original_events));
+
+    TCAN1463Q1Simulator* clone = tcan1463q1_simulator_clone(sim);
+    ASSERT_NE(clone, nullptr);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(clone), MODE_NORMAL);
+    EXPECT_EQ(tcan1463q1_simulator_get_time_ns(clone), tcan1463q1_simulator_get_time_ns(sim));
+    EXPECT_EQ(clone->callbacks, sim->callbacks);
+    EXPECT_NE(clone->inh_controller, sim->inh_controller);
+
+    // The registration is shared: the clone's events reach the original's callback
+    tcan1463q1_simulator_set_pin(clone, PIN_TXD, PIN_STATE_LOW, 0.0);
+    tcan1463q1_simulator_step(clone, 1000);
+    EXPECT_GT(original_events, 0);
+
+    // Changing the clone's registrations leaves the original's alone
+    int clone_events = 0;
+    ASSERT_TRUE(tcan1463q1_simulator_register_callback(clone, EVENT_PIN_CHANGE,
+                                                       count_pin_changes, &clone_events));
+    EXPECT_NE(clone->callbacks, sim->callbacks);
+    ASSERT_TRUE(tcan1463q1_simulator_unregister_callback(sim, EVENT_PIN_CHANGE,
+                                                         count_pin_changes));
+    original_events = 0;
+    tcan1463q1_simulator_set_pin(clone, PIN_TXD, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_step(clone, 1000);
+    EXPECT_GT(clone_events, 0);
+    EXPECT_GT(original_events, 0);
+
+    // The clone runs on its own
+    tcan1463q1_simulator_set_pin(clone, PIN_NSTB, PIN_STATE_LOW, 0.0);
+    tcan1463q1_simulator_step(clone, 1000);
+    EXPECT_NE(tcan1463q1_simulator_get_mode(clone), MODE_NORMAL);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_NORMAL);
+    tcan1463q1_simulator_destroy(clone);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_NORMAL);
+}
+
+TEST_F(SimulatorTest, ClonesOfProfileSimulatorShareProfile) {
+    DeviceProfile* profile = tcan1463q1_profile_parse("ttxddto 3ms 4ms\n", NULL, 0);
+    ASSERT_NE(profile, nullptr);
+    TCAN1463Q1Simulator* base = tcan1463q1_simulator_create_with_profile(profile);
+    tcan1463q1_profile_release(profile);
+    ASSERT_NE(base, nullptr);
+
+    TCAN1463Q1Simulator* clones[4];
+    for (TCAN1463Q1Simulator*& clone : clones) {
+        clone = tcan1463q1_simulator_clone(base);
+        ASSERT_NE(clone, nullptr);
+        EXPECT_EQ(clone->profile, base->profile);
+    }
+    // Each clone holds a reference of its own
+    tcan1463q1_simulator_destroy(base);
+    for (TCAN1463Q1Simulator* clone : clones) {
+        EXPECT_EQ(tcan1463q1_simulator_get_device_params(clone)->ttxddto.min_ns, 3000000u);
+        tcan1463q1_simulator_destroy(clone);
+    }
+    EXPECT_EQ(tcan1463q1_simulator_clone(NULL), nullptr);
+}
+
+TEST_F(SimulatorTest, EqualConfigurationsShareOneBlock) {
+    TCAN1463Q1Simulator* other = tcan1463q1_simulator_create();
+    ASSERT_NE(other, nullptr);
+    const SimulatorConfig* defaults = sim->config;
+    EXPECT_EQ(other->config, defaults);
+    EXPECT_EQ(sim->pins[PIN_CANH].info, other->pins[PIN_CANH].info);
+
+    // A new setting gets a block of its own, the same setting elsewhere reuses it
+    ASSERT_TRUE(tcan1463q1_simulator_set_temperature(sim, 85.0));
+    EXPECT_NE(sim->config, defaults);
+    EXPECT_DOUBLE_EQ(other->config->tj_temperature, 25.0);
+    ASSERT_TRUE(tcan1463q1_simulator_set_temperature(other, 85.0));
+    EXPECT_EQ(other->config, sim->config);
+
+    // Snapshots and clones keep the block alive
+    SimulatorSnapshot* snapshot = tcan1463q1_simulator_snapshot(sim);
+    TCAN1463Q1Simulator* clone = tcan1463q1_simulator_clone(sim);
+    ASSERT_NE(clone, nullptr);
+    EXPECT_EQ(clone->config, sim->config);
+    tcan1463q1_simulator_reset(sim);
+    tcan1463q1_simulator_set_temperature(other, 25.0);
+    EXPECT_EQ(sim->config, defaults);
+    EXPECT_EQ(other->config, defaults);
+    EXPECT_DOUBLE_EQ(clone->config->tj_temperature, 85.0);
+    ASSERT_TRUE(tcan1463q1_simulator_restore(sim, snapshot));
+    EXPECT_EQ(sim->config, clone->config);
+    tcan1463q1_simulator_snapshot_free(snapshot);
+    tcan1463q1_simulator_destroy(clone);
+    EXPECT_DOUBLE_EQ(sim->config->tj_temperature, 85.0);
+
+    tcan1463q1_simulator_destroy(other);
+}
+
 // ============================================================================
 // Property-Based Tests for Configuration
 // ============================================================================
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_stimulus.h"
+#include <math.h>
+#include <vector>
+
+// Unit tests for in-engine stimulus generators
+
+static void count_rxd_falls(const SimulatorEvent* event, void* user_data) {
+    if (event->data.pin_change.pin == PIN_RXD &&
+        event->data.pin_change.new_state == PIN_STATE_LOW) {
+        (*(int*)user_data)++;
+    }
+}
+
+class StimulusTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        sim = tcan1463q1_simulator_create();
+        ASSERT_NE(sim, nullptr);
+        tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+        tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+        tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+        tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+        tcan1463q1_simulator_step(sim, 1000000);
+    }
+
+    void TearDown() override {
+        tcan1463q1_simulator_destroy(sim);
+    }
+
+    bool pin_high(PinType pin) {
+        PinState state;
+        double voltage;
+        tcan1463q1_simulator_get_pin(sim, pin, &state, &voltage);
+        return state == PIN_STATE_HIGH;
+    }
+
+    TCAN1463Q1Simulator* sim = nullptr;
+};
+
+TEST_F(StimulusTest, SquareWaveRunsInsideOneStep) {
+    int rxd_falls = 0;
+    tcan1463q1_simulator_register_callback(sim, EVENT_PIN_CHANGE, count_rxd_falls, &rxd_falls);
+
+    StimulusConfig config;
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_SQUARE, PIN_TXD);
+    config.start_ns = tcan1463q1_simulator_get_time_ns(sim);
+    config.period_ns = 4000;
+    config.high_ns = 2000;
+    ASSERT_GE(tcan1463q1_stimulus_attach(sim, &config), 0);
+
+    // 50 periods in a single call
+    tcan1463q1_simulator_step(sim, 200000);
+    EXPECT_NEAR(rxd_falls, 50, 1);
+}
+
+TEST_F(StimulusTest, ReportsNextEdge) {
+    uint64_t now = tcan1463q1_simulator_get_time_ns(sim);
+    EXPECT_EQ(tcan1463q1_stimulus_next_edge_ns(sim), UINT64_MAX);
+
+    StimulusConfig config;
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_SQUARE, PIN_WAKE);
+    config.start_ns = now + 1000;
+    config.period_ns = 10000;
+    config.high_ns = 500;
+    config.idle_high = false;
+    ASSERT_GE(tcan1463q1_stimulus_attach(sim, &config), 0);
+    EXPECT_EQ(tcan1463q1_stimulus_next_edge_ns(sim), now + 1000);
+
+    tcan1463q1_simulator_step(sim, 1200);
+    EXPECT_TRUE(pin_high(PIN_WAKE));
+    EXPECT_EQ(tcan1463q1_stimulus_next_edge_ns(sim), now + 1500);
+
+    tcan1463q1_simulator_step(sim, 5000);
+    EXPECT_FALSE(pin_high(PIN_WAKE));
+    EXPECT_EQ(tcan1463q1_stimulus_next_edge_ns(sim), now + 11000);
+}
+
+TEST_F(StimulusTest, BusWakeUpPatternWakesSleepingTransceiver) {
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_LOW, 0.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_LOW, 0.0);
+    for (int i = 0; i < 7; i++) tcan1463q1_simulator_step(sim, 100000000);
+    ASSERT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_SLEEP);
+
+    StimulusConfig config;
+    tcan1463q1_stimulus_config_wup(&config, 5000, tcan1463q1_simulator_get_time_ns(sim) + 1000);
+    ASSERT_GE(tcan1463q1_stimulus_attach(sim, &config), 0);
+
+    tcan1463q1_simulator_step(sim, 50000);
+    EXPECT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_STANDBY);
+    // The pattern has ended: bus recessive, no further edges
+    EXPECT_FALSE(sim->remote_dominant);
+    EXPECT_EQ(tcan1463q1_stimulus_next_edge_ns(sim), UINT64_MAX);
+}
+
+TEST_F(StimulusTest, Prbs7IsMaximalLength) {
+    StimulusConfig config;
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_PRBS, PIN_TXD);
+    config.start_ns = tcan1463q1_simulator_get_time_ns(sim);
+    config.period_ns = 1000;
+    ASSERT_GE(tcan1463q1_stimulus_attach(sim, &config), 0);
+
+    std::vector<bool> bits;
+    for (int i = 0; i < 254; i++) {
+        bits.push_back(pin_high(PIN_TXD));
+        tcan1463q1_simulator_step(sim, 1000);
+    }
+    int ones = 0;
+    for (int i = 0; i < 127; i++) {
+        EXPECT_EQ(bits[i], bits[i + 127]) << "bit " << i;
+        if (bits[i]) ones++;
+    }
+    EXPECT_EQ(ones, 64);
+}
+
+TEST_F(StimulusTest, SupplyRippleFollowsSine) {
+    StimulusConfig config;
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_RIPPLE, PIN_VSUP);
+    uint64_t start = tcan1463q1_simulator_get_time_ns(sim);
+    config.start_ns = start;
+    config.amplitude_v = 1.0;
+    config.ripple_period_ns = 100000;
+    ASSERT_GE(tcan1463q1_stimulus_attach(sim, &config), 0);
+
+    tcan1463q1_simulator_step(sim, 25000);     // Quarter period: peak
+    PinState state;
+    double voltage;
+    tcan1463q1_simulator_get_pin(sim, PIN_VSUP, &state, &voltage);
+    EXPECT_EQ(state, PIN_STATE_ANALOG);
+    EXPECT_NEAR(voltage, 13.0, 1e-9);
+
+    tcan1463q1_simulator_step(sim, 50000);     // Trough
+    tcan1463q1_simulator_get_pin(sim, PIN_VSUP, &state, &voltage);
+    EXPECT_NEAR(voltage, 11.0, 1e-9);
+}
+
+TEST_F(StimulusTest, FollowsTimeBackAfterRestore) {
+    StimulusConfig config;
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_PRBS, PIN_TXD);
+    config.start_ns = tcan1463q1_simulator_get_time_ns(sim);
+    config.period_ns = 1000;
+    config.prbs_order = 15;
+    ASSERT_GE(tcan1463q1_stimulus_attach(sim, &config), 0);
+
+    SimulatorSnapshot* snapshot = tcan1463q1_simulator_snapshot(sim);
+    std::vector<bool> first, second;
+    for (int i = 0; i < 40; i++) {
+        tcan1463q1_simulator_step(sim, 1000);
+        first.push_back(pin_high(PIN_TXD));
+    }
+    ASSERT_TRUE(tcan1463q1_simulator_restore(sim, snapshot));
+    for (int i = 0; i < 40; i++) {
+        tcan1463q1_simulator_step(sim, 1000);
+        second.push_back(pin_high(PIN_TXD));
+    }
+    EXPECT_EQ(first, second);
+    tcan1463q1_simulator_snapshot_free(snapshot);
+}
+
+TEST_F(StimulusTest, AttachAndDetach) {
+    StimulusConfig config;
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_SQUARE, PIN_RXD);
+    EXPECT_EQ(tcan1463q1_stimulus_attach(sim, &config), -1);     // Output pin
+
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_SQUARE, PIN_TXD);
+    config.period_ns = 0;
+    EXPECT_EQ(tcan1463q1_stimulus_attach(sim, &config), -1);
+
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_PRBS, PIN_TXD);
+    config.prbs_order = 8;
+    EXPECT_EQ(tcan1463q1_stimulus_attach(sim, &config), -1);
+
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_RIPPLE, PIN_VSUP);
+    config.bus = true;
+    EXPECT_EQ(tcan1463q1_stimulus_attach(sim, &config), -1);
+
+    tcan1463q1_stimulus_config_init(&config, STIMULUS_SQUARE, PIN_TXD);
+    int first = tcan1463q1_stimulus_attach(sim, &config);
+    config.pin = PIN_WAKE;
+    int second = tcan1463q1_stimulus_attach(sim, &config);
+    ASSERT_GE(first, 0);
+    ASSERT_GT(second, first);
+
+    EXPECT_TRUE(tcan1463q1_stimulus_detach(sim, first));
+    EXPECT_FALSE(tcan1463q1_stimulus_detach(sim, first));
+    EXPECT_NE(tcan1463q1_stimulus_next_edge_ns(sim), UINT64_MAX);
+    tcan1463q1_stimulus_detach_all(sim);
+    EXPECT_EQ(tcan1463q1_stimulus_next_edge_ns(sim), UINT64_MAX);
+}
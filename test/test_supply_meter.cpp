@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <rapidcheck.h>
+#include "supply_meter.h"
+#include "tcan1463q1_simulator.h"
+#include "device_profiles.h"
+#include <cmath>
+#include <string.h>
+
+// Test fixture for Supply Meter tests
+class SupplyMeterTest : public ::testing::Test {
+protected:
+    SupplyMeter meter;
+    const DeviceParams& p = TCAN1463Q1Profile::params;
+    
+    void SetUp() override {
+        supply_meter_init(&meter);
+    }
+};
+
+// Unit Tests
+
+TEST_F(SupplyMeterTest, InitializesUnpowered) {
+    EXPECT_EQ(meter.mode, MODE_OFF);
+    for (int rail = 0; rail < SUPPLY_COUNT; rail++) {
+        EXPECT_EQ(meter.currents[rail], 0.0);
+    }
+    
+    SupplyEnergy energy;
+    supply_meter_get_energy(&meter, 1000000ULL, &energy);
+    EXPECT_EQ(energy.residency_ns[MODE_OFF], 1000000ULL);
+    EXPECT_EQ(tcan1463q1_supply_energy_total(&energy, SUPPLY_VSUP), 0.0);
+}
+
+TEST_F(SupplyMeterTest, IntegratesPerResidencyInterval) {
+    // 1 ms in Sleep, then 1 ms in Normal recessive
+    supply_meter_update(&meter, MODE_SLEEP, false, BIAS_STATE_AUTONOMOUS_INACTIVE,
+                        12.0, 5.0, 3.3, 60.0, 0);
+    for (uint64_t t = 1000; t <= 1000000ULL; t += 1000) {
+        supply_meter_update(&meter, MODE_SLEEP, false, BIAS_STATE_AUTONOMOUS_INACTIVE,
+                            12.0, 5.0, 3.3, 60.0, t);
+    }
+    supply_meter_update(&meter, MODE_NORMAL, false, BIAS_STATE_ACTIVE,
+                        12.0, 5.0, 3.3, 60.0, 1000000ULL);
+    
+    // Repeated updates at the same load point do not add intervals
+    EXPECT_EQ(meter.closed.transitions, 2u);
+    
+    SupplyEnergy energy;
+    supply_meter_get_energy(&meter, 2000000ULL, &energy);
+    EXPECT_EQ(energy.residency_ns[MODE_SLEEP], 1000000ULL);
+    EXPECT_EQ(energy.residency_ns[MODE_NORMAL], 1000000ULL);
+    EXPECT_NEAR(energy.charge[MODE_SLEEP][SUPPLY_VSUP], p.isup_sleep * 1e-3, 1e-15);
+    EXPECT_NEAR(energy.energy[MODE_SLEEP][SUPPLY_VSUP], 12.0 * p.isup_sleep * 1e-3, 1e-15);
+    EXPECT_NEAR(energy.energy[MODE_NORMAL][SUPPLY_VCC], 5.0 * p.icc_recessive * 1e-3, 1e-12);
+    
+    // Reading does not close the open interval
+    EXPECT_EQ(meter.closed.residency_ns[MODE_NORMAL], 0ULL);
+}
+
+TEST_F(SupplyMeterTest, DominantDriverAddsBusLoadCurrent) {
+    supply_meter_update(&meter, MODE_NORMAL, true, BIAS_STATE_ACTIVE,
+                        12.0, 5.0, 3.3, 60.0, 0);
+    double expected = p.icc_dominant + (p.canh_dominant - p.canl_dominant) / 60.0;
+    EXPECT_NEAR(meter.currents[SUPPLY_VCC], expected, 1e-12);
+    
+    // A new bus load while dominant starts a new interval
+    supply_meter_update(&meter, MODE_NORMAL, true, BIAS_STATE_ACTIVE,
+                        12.0, 5.0, 3.3, 120.0, 500);
+    double reloaded = p.icc_dominant + (p.canh_dominant - p.canl_dominant) / 120.0;
+    EXPECT_NEAR(meter.currents[SUPPLY_VCC], reloaded, 1e-12);
+    EXPECT_EQ(meter.closed.transitions, 2u);
+    
+    supply_meter_update(&meter, MODE_NORMAL, false, BIAS_STATE_ACTIVE,
+                        12.0, 5.0, 3.3, 60.0, 1000);
+    EXPECT_NEAR(meter.currents[SUPPLY_VCC], p.icc_recessive, 1e-12);
+    // Recessive current does not depend on the bus load
+    supply_meter_update(&meter, MODE_NORMAL, false, BIAS_STATE_ACTIVE,
+                        12.0, 5.0, 3.3, 120.0, 1500);
+    EXPECT_EQ(meter.closed.transitions, 3u);
+    
+    SupplyEnergy energy;
+    supply_meter_get_energy(&meter, 1000, &energy);
+    EXPECT_NEAR(energy.charge[MODE_NORMAL][SUPPLY_VCC], (expected + reloaded) * 500e-9, 1e-15);
+}
+
+TEST_F(SupplyMeterTest, AutonomousBiasAddsSupplyCurrent) {
+    supply_meter_update(&meter, MODE_SLEEP, false, BIAS_STATE_AUTONOMOUS_ACTIVE,
+                        12.0, 0.0, 0.0, 60.0, 0);
+    EXPECT_NEAR(meter.currents[SUPPLY_VSUP], p.isup_sleep + p.isup_bias, 1e-12);
+    
+    // Unpowered rails draw nothing
+    EXPECT_EQ(meter.currents[SUPPLY_VCC], 0.0);
+    EXPECT_EQ(meter.currents[SUPPLY_VIO], 0.0);
+}
+
+TEST_F(SupplyMeterTest, FleetMergeAndAverages) {
+    SupplyEnergy a, b, total;
+    memset(&total, 0, sizeof(total));
+    
+    supply_meter_update(&meter, MODE_SLEEP, false, BIAS_STATE_AUTONOMOUS_INACTIVE,
+                        12.0, 5.0, 3.3, 60.0, 0);
+    supply_meter_get_energy(&meter, 1000000000ULL, &a);
+    supply_meter_get_energy(&meter, 3000000000ULL, &b);
+    tcan1463q1_supply_energy_merge(&total, &a);
+    tcan1463q1_supply_energy_merge(&total, &b);
+    
+    EXPECT_EQ(total.residency_ns[MODE_SLEEP], 4000000000ULL);
+    EXPECT_EQ(total.transitions, 2u);
+    EXPECT_NEAR(tcan1463q1_supply_energy_total(&total, SUPPLY_VSUP), 4.0 * 12.0 * p.isup_sleep,
+                1e-12);
+    EXPECT_NEAR(tcan1463q1_supply_energy_average_current(&total, SUPPLY_VSUP), p.isup_sleep,
+                1e-12);
+}
+
+// Simulator integration
+
+TEST(SupplyEnergyTest, ParkingRunAccumulatesSleepResidency) {
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    ASSERT_NE(sim, nullptr);
+    
+    // Power up to Normal, then drop nSTB and park
+    tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_step(sim, 1000000);
+    ASSERT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_NORMAL);
+    
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_LOW, 0.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_LOW, 0.0);
+    for (int i = 0; i < 20; i++) {
+        tcan1463q1_simulator_step(sim, 100000000);  // 100 ms
+    }
+    SupplyEnergy before;
+    ASSERT_TRUE(tcan1463q1_simulator_get_supply_energy(sim, &before));
+    ASSERT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_SLEEP);
+    
+    // One hour parked: a single long step
+    tcan1463q1_simulator_step(sim, 3600ULL * 1000000000ULL);
+    SupplyEnergy after;
+    tcan1463q1_simulator_get_supply_energy(sim, &after);
+    
+    EXPECT_EQ(after.transitions, before.transitions);
+    EXPECT_EQ(after.residency_ns[MODE_SLEEP] - before.residency_ns[MODE_SLEEP],
+              3600ULL * 1000000000ULL);
+    
+    double currents[SUPPLY_COUNT];
+    tcan1463q1_simulator_get_supply_currents(sim, currents);
+    double expected = currents[SUPPLY_VSUP] * 3600.0 * 12.0;
+    EXPECT_NEAR(after.energy[MODE_SLEEP][SUPPLY_VSUP] - before.energy[MODE_SLEEP][SUPPLY_VSUP],
+                expected, expected * 1e-9);
+    EXPECT_GT(before.residency_ns[MODE_NORMAL], 0ULL);
+    
+    tcan1463q1_simulator_destroy(sim);
+}
+
+TEST(SupplyEnergyTest, ProfileOverridesSupplyCurrents) {
+    char error[128] = {0};
+    DeviceProfile* profile = tcan1463q1_profile_parse("isup_sleep 20e-6\n", error, sizeof(error));
+    ASSERT_NE(profile, nullptr) << error;
+    EXPECT_DOUBLE_EQ(tcan1463q1_profile_get_params(profile)->isup_sleep, 20e-6);
+    tcan1463q1_profile_release(profile);
+    
+    EXPECT_EQ(tcan1463q1_profile_parse("icc_dominant -1e-3\n", error, sizeof(error)), nullptr);
+}
+
+// Property Tests
+
+// Total charge equals the sum of current x residency for any split of a
+// constant load point into steps
+TEST(SupplyMeterPropertyTest, ChargeIndependentOfStepSize) {
+    rc::check("Charge independent of step size property", []() {
+        auto steps = *rc::gen::inRange(1, 1000);
+        auto step_ns = *rc::gen::inRange(1ULL, 100000000ULL);
+        SupplyMeter meter;
+        supply_meter_init(&meter);
+        
+        uint64_t t = 0;
+        supply_meter_update(&meter, MODE_STANDBY, false, BIAS_STATE_AUTONOMOUS_INACTIVE,
+                            12.0, 5.0, 3.3, 60.0, t);
+        for (int i = 0; i < steps; i++) {
+            t += step_ns;
+            supply_meter_update(&meter, MODE_STANDBY, false, BIAS_STATE_AUTONOMOUS_INACTIVE,
+                                12.0, 5.0, 3.3, 60.0, t);
+        }
+        
+        SupplyEnergy energy;
+        supply_meter_get_energy(&meter, t, &energy);
+        double expected = meter.currents[SUPPLY_VSUP] * t * 1e-9;
+        RC_ASSERT(std::abs(energy.charge[MODE_STANDBY][SUPPLY_VSUP] - expected) <= expected * 1e-12);
+        RC_ASSERT(energy.transitions == 1u);
+    });
+}
@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include <rapidcheck.h>
+#include "tcan1463q1_timing_analyzer.h"
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Test fixture for Timing Analyzer tests
+class TimingAnalyzerTest : public ::testing::Test {
+protected:
+    TimingAnalyzer* analyzer = nullptr;
+
+    void SetUp() override {
+        TimingAnalyzerConfig config;
+        tcan1463q1_timing_analyzer_config_init(&config);
+        config.bitrate = 500000;
+        config.bin_width_ns = 10;
+        analyzer = tcan1463q1_timing_analyzer_create(&config);
+        ASSERT_NE(analyzer, nullptr);
+    }
+
+    void TearDown() override {
+        tcan1463q1_timing_analyzer_destroy(analyzer);
+    }
+
+    // Idle levels: everything recessive at t=0
+    void idle() {
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_TXD, true, 0);
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_RXD, true, 0);
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_BUS, true, 0);
+    }
+
+    // One TXD pulse echoed on the bus and RXD with the given delays
+    void pulse(uint64_t start, uint64_t width, uint64_t fall_delay, uint64_t rise_delay) {
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_TXD, false, start);
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_BUS, false, start + fall_delay / 2);
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_RXD, false, start + fall_delay);
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_TXD, true, start + width);
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_BUS, true,
+                                             start + width + rise_delay / 2);
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_RXD, true,
+                                             start + width + rise_delay);
+    }
+
+    const TimingHistogram* histogram(TimingMetric metric) {
+        return tcan1463q1_timing_analyzer_get_histogram(analyzer, metric);
+    }
+};
+
+// Unit Tests
+
+TEST_F(TimingAnalyzerTest, MeasuresLoopDelayPerDirection) {
+    idle();
+    pulse(10000, 2000, 120, 160);
+    pulse(20000, 4000, 130, 150);
+
+    const TimingHistogram* dominant = histogram(TIMING_LOOP_DELAY_DOMINANT);
+    EXPECT_EQ(dominant->count, 2u);
+    EXPECT_EQ(dominant->min_ns, 120);
+    EXPECT_EQ(dominant->max_ns, 130);
+    EXPECT_EQ(dominant->worst_ns, 130);
+    EXPECT_EQ(dominant->worst_time_ns, 20130u);
+    EXPECT_EQ(dominant->bins[TIMING_HISTOGRAM_BINS / 2 + 12], 1u);
+    EXPECT_EQ(dominant->bins[TIMING_HISTOGRAM_BINS / 2 + 13], 1u);
+
+    const TimingHistogram* recessive = histogram(TIMING_LOOP_DELAY_RECESSIVE);
+    EXPECT_EQ(recessive->count, 2u);
+    EXPECT_DOUBLE_EQ(recessive->sum_ns, 310.0);
+
+    EXPECT_EQ(histogram(TIMING_BUS_DELAY_DOMINANT)->min_ns, 60);
+    EXPECT_EQ(tcan1463q1_timing_analyzer_edge_count(analyzer), 12u);
+    EXPECT_EQ(tcan1463q1_timing_analyzer_unmatched(analyzer, EDGE_SIGNAL_RXD), 0u);
+}
+
+TEST_F(TimingAnalyzerTest, MeasuresBitWidthAsymmetry) {
+    idle();
+    pulse(10000, 2000, 120, 160);
+    pulse(20000, 4000, 130, 150);
+
+    // Dominant RXD pulses are longer by rise - fall delay
+    const TimingHistogram* dominant = histogram(TIMING_RXD_ASYMMETRY_DOMINANT);
+    ASSERT_EQ(dominant->count, 2u);
+    EXPECT_EQ(dominant->min_ns, 20);
+    EXPECT_EQ(dominant->max_ns, 40);
+
+    // Recessive pulse between them: fall delay of the second minus rise of the first
+    const TimingHistogram* recessive = histogram(TIMING_RXD_ASYMMETRY_RECESSIVE);
+    ASSERT_EQ(recessive->count, 1u);
+    EXPECT_EQ(recessive->worst_ns, -30);
+    EXPECT_EQ(recessive->bins[TIMING_HISTOGRAM_BINS / 2 - 3], 1u);
+
+    EXPECT_EQ(histogram(TIMING_BUS_ASYMMETRY_DOMINANT)->max_ns, 20);
+}
+
+TEST_F(TimingAnalyzerTest, ReceiverSymmetryAgainstBitrate) {
+    idle();
+    // 2 us bit time: a 2-bit dominant RXD pulse 25 ns short, then a
+    // 1-bit recessive pulse 40 ns long
+    tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_RXD, false, 100000);
+    tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_RXD, true, 103975);
+    tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_RXD, false, 106015);
+
+    const TimingHistogram* dominant = histogram(TIMING_RXD_SYMMETRY_DOMINANT);
+    ASSERT_EQ(dominant->count, 1u);
+    EXPECT_EQ(dominant->worst_ns, -25);
+    const TimingHistogram* recessive = histogram(TIMING_RXD_SYMMETRY_RECESSIVE);
+    ASSERT_EQ(recessive->count, 1u);
+    EXPECT_EQ(recessive->worst_ns, 40);
+
+    // The idle period before the first edge is not a bit
+    EXPECT_EQ(recessive->count + dominant->count, 2u);
+
+    // Edges from another transmitter are not loop delays
+    EXPECT_EQ(histogram(TIMING_LOOP_DELAY_DOMINANT)->count, 0u);
+}
+
+TEST_F(TimingAnalyzerTest, CountsUnmatchedTransmitEdges) {
+    idle();
+    // Driver disabled: TXD toggles, RXD and bus stay recessive
+    tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_TXD, false, 1000);
+    tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_TXD, true, 3000);
+    tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_TXD, false, 5000);
+
+    EXPECT_EQ(tcan1463q1_timing_analyzer_unmatched(analyzer, EDGE_SIGNAL_RXD), 2u);
+    EXPECT_EQ(tcan1463q1_timing_analyzer_unmatched(analyzer, EDGE_SIGNAL_BUS), 2u);
+    EXPECT_EQ(histogram(TIMING_LOOP_DELAY_DOMINANT)->count, 0u);
+}
+
+TEST_F(TimingAnalyzerTest, OutOfRangeValuesGoToOverflow) {
+    idle();
+    pulse(10000, 2000, 100, 5000);
+
+    const TimingHistogram* recessive = histogram(TIMING_LOOP_DELAY_RECESSIVE);
+    EXPECT_EQ(recessive->overflow, 1u);
+    EXPECT_EQ(recessive->max_ns, 5000);
+    const TimingHistogram* asymmetry = histogram(TIMING_RXD_ASYMMETRY_DOMINANT);
+    EXPECT_EQ(asymmetry->overflow, 1u);
+}
+
+TEST_F(TimingAnalyzerTest, RecordedTraceMatchesLiveFeed) {
+    std::vector<EdgeRecord> records;
+    auto add = [&records](uint64_t t, EdgeSignal signal, bool level) {
+        EdgeRecord record;
+        memset(&record, 0, sizeof(record));
+        record.time_ns = t;
+        record.signal = (uint8_t)signal;
+        record.level = level ? 1 : 0;
+        records.push_back(record);
+    };
+    add(0, EDGE_SIGNAL_TXD, true);
+    add(0, EDGE_SIGNAL_RXD, true);
+    // Enough pulses to span several read blocks
+    for (uint64_t i = 0; i < 50000; i++) {
+        uint64_t t = 10000 + i * 4000;
+        add(t, EDGE_SIGNAL_TXD, false);
+        add(t + 100 + i % 7, EDGE_SIGNAL_RXD, false);
+        add(t + 2000, EDGE_SIGNAL_TXD, true);
+        add(t + 2130 + i % 5, EDGE_SIGNAL_RXD, true);
+    }
+
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(fwrite(records.data(), sizeof(EdgeRecord), records.size(), file), records.size());
+    rewind(file);
+
+    EXPECT_EQ(tcan1463q1_timing_analyzer_process_file(analyzer, file), (int64_t)records.size());
+
+    TimingAnalyzer* live = tcan1463q1_timing_analyzer_create(NULL);
+    tcan1463q1_timing_analyzer_feed(live, records.data(), records.size());
+    for (int m = 0; m < TIMING_METRIC_COUNT; m++) {
+        const TimingHistogram* a = histogram((TimingMetric)m);
+        const TimingHistogram* b = tcan1463q1_timing_analyzer_get_histogram(live, (TimingMetric)m);
+        EXPECT_EQ(memcmp(a, b, sizeof(TimingHistogram)), 0) << tcan1463q1_timing_metric_name((TimingMetric)m);
+    }
+    EXPECT_EQ(histogram(TIMING_LOOP_DELAY_DOMINANT)->count, 50000u);
+    EXPECT_EQ(histogram(TIMING_LOOP_DELAY_DOMINANT)->max_ns, 106);
+    tcan1463q1_timing_analyzer_destroy(live);
+
+    // A truncated trailing record is reported
+    fseek(file, 0, SEEK_END);
+    fputc(0, file);
+    rewind(file);
+    tcan1463q1_timing_analyzer_reset(analyzer);
+    EXPECT_EQ(tcan1463q1_timing_analyzer_process_file(analyzer, file), -1);
+    fclose(file);
+}
+
+TEST_F(TimingAnalyzerTest, ObservesSimulatorLoopDelay) {
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_step(sim, 1000000);
+    ASSERT_EQ(tcan1463q1_simulator_get_mode(sim), MODE_NORMAL);
+
+    EdgeProbe probe;
+    memset(&probe, 0, sizeof(probe));
+    tcan1463q1_timing_analyzer_observe(analyzer, &probe, sim);
+
+    // 1-bit dominant, 1-bit recessive at 500 kbit/s, 10 ns steps
+    for (int bit = 0; bit < 20; bit++) {
+        bool recessive = (bit % 2) == 1;
+        tcan1463q1_simulator_set_pin(sim, PIN_TXD, recessive ? PIN_STATE_HIGH : PIN_STATE_LOW,
+                                     recessive ? 3.3 : 0.0);
+        for (int step = 0; step < 200; step++) {
+            tcan1463q1_simulator_step(sim, 10);
+            tcan1463q1_timing_analyzer_observe(analyzer, &probe, sim);
+        }
+    }
+
+    // TXD edges are observed after the step that applies them, so delays
+    // are relative to that sample
+    const TimingHistogram* dominant = histogram(TIMING_LOOP_DELAY_DOMINANT);
+    const TimingHistogram* recessive = histogram(TIMING_LOOP_DELAY_RECESSIVE);
+    EXPECT_EQ(dominant->count, 10u);
+    EXPECT_EQ(recessive->count, 10u);
+    EXPECT_GT(dominant->max_ns, 0);
+    EXPECT_LT(dominant->max_ns, 2000);
+    EXPECT_EQ(histogram(TIMING_BUS_DELAY_DOMINANT)->count, 10u);
+    EXPECT_EQ(tcan1463q1_timing_analyzer_unmatched(analyzer, EDGE_SIGNAL_RXD), 0u);
+
+    // RXD pulses track the 2 us bit time
+    const TimingHistogram* symmetry = histogram(TIMING_RXD_SYMMETRY_DOMINANT);
+    EXPECT_EQ(symmetry->count, 10u);
+    EXPECT_LE(llabs(symmetry->worst_ns), 200);
+
+    tcan1463q1_simulator_destroy(sim);
+}
+
+// Property-Based Tests
+
+TEST(TimingAnalyzerPropertyTest, HistogramAccountsForEveryMatchedEdge) {
+    rc::check("every matched edge lands in exactly one bin and asymmetry equals delay difference", []() {
+        auto pulses = *rc::gen::inRange(1, 200);
+        auto base_fall = *rc::gen::inRange(0, 400);
+        auto base_rise = *rc::gen::inRange(0, 400);
+
+        TimingAnalyzer* analyzer = tcan1463q1_timing_analyzer_create(NULL);
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_TXD, true, 0);
+        tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_RXD, true, 0);
+
+        int64_t expected_asymmetry_sum = 0;
+        for (int i = 0; i < pulses; i++) {
+            uint64_t t = 10000 + (uint64_t)i * 10000;
+            int64_t fall = base_fall + (i * 37) % 50;
+            int64_t rise = base_rise + (i * 11) % 30;
+            tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_TXD, false, t);
+            tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_RXD, false, t + fall);
+            tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_TXD, true, t + 4000);
+            tcan1463q1_timing_analyzer_feed_edge(analyzer, EDGE_SIGNAL_RXD, true, t + 4000 + rise);
+            expected_asymmetry_sum += rise - fall;
+        }
+
+        const TimingMetric metrics[] = {TIMING_LOOP_DELAY_DOMINANT, TIMING_LOOP_DELAY_RECESSIVE};
+        for (TimingMetric metric : metrics) {
+            const TimingHistogram* h = tcan1463q1_timing_analyzer_get_histogram(analyzer, metric);
+            uint64_t total = h->underflow + h->overflow;
+            for (int b = 0; b < TIMING_HISTOGRAM_BINS; b++) total += h->bins[b];
+            RC_ASSERT(h->count == (uint64_t)pulses);
+            RC_ASSERT(total == h->count);
+            RC_ASSERT(h->min_ns <= h->max_ns);
+        }
+
+        const TimingHistogram* asym =
+            tcan1463q1_timing_analyzer_get_histogram(analyzer, TIMING_RXD_ASYMMETRY_DOMINANT);
+        RC_ASSERT(asym->count == (uint64_t)pulses);
+        RC_ASSERT((int64_t)asym->sum_ns == expected_asymmetry_sum);
+
+        tcan1463q1_timing_analyzer_destroy(analyzer);
+    });
+}
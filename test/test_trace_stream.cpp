@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+#include "tcan1463q1_trace_stream.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <vector>
+
+// Unit tests for live trace streaming
+
+static std::vector<EdgeRecord> read_records(int fd) {
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[8192];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    std::vector<EdgeRecord> records(bytes.size() / sizeof(EdgeRecord));
+    if (!records.empty()) memcpy(records.data(), bytes.data(), records.size() * sizeof(EdgeRecord));
+    return records;
+}
+
+static EdgeRecord make_record(uint64_t i) {
+    EdgeRecord record;
+    memset(&record, 0, sizeof(record));
+    record.time_ns = i * 10;
+    record.signal = (uint8_t)(i % EDGE_SIGNAL_COUNT);
+    record.level = (uint8_t)(i & 1);
+    return record;
+}
+
+static void power_up(TCAN1463Q1Simulator* sim) {
+    tcan1463q1_simulator_set_pin(sim, PIN_VSUP, PIN_STATE_ANALOG, 12.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VCC, PIN_STATE_ANALOG, 5.0);
+    tcan1463q1_simulator_set_pin(sim, PIN_VIO, PIN_STATE_ANALOG, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_EN, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_NSTB, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_HIGH, 3.3);
+    tcan1463q1_simulator_step(sim, 1000000);
+}
+
+static size_t count_signal(const std::vector<EdgeRecord>& records, int signal) {
+    size_t count = 0;
+    for (const EdgeRecord& record : records) {
+        if (record.signal == signal) count++;
+    }
+    return count;
+}
+
+TEST(TraceStreamTest, PipeDeliversRecordsInOrder) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    TraceStreamConfig config;
+    tcan1463q1_trace_stream_config_init(&config);
+    config.chunk_bytes = 4096;
+    TraceStream* stream = tcan1463q1_trace_stream_open_fd(fds[1], &config);
+    ASSERT_NE(stream, nullptr);
+
+    std::vector<EdgeRecord> received;
+    std::thread reader([&]() { received = read_records(fds[0]); });
+
+    // Many chunks in odd-sized pieces, so chunk reuse races with the reader
+    const uint64_t total = 50000;
+    uint64_t next = 0;
+    while (next < total) {
+        EdgeRecord batch[37];
+        size_t count = 0;
+        while (count < 37 && next < total) batch[count++] = make_record(next++);
+        ASSERT_TRUE(tcan1463q1_trace_stream_write(stream, batch, count));
+        if (next % 1000 < 37) {
+            ASSERT_TRUE(tcan1463q1_trace_stream_flush(stream));
+        }
+    }
+
+    TraceStreamStats stats;
+    tcan1463q1_trace_stream_get_stats(stream, &stats);
+    EXPECT_TRUE(tcan1463q1_trace_stream_close(stream));
+    close(fds[1]);
+    reader.join();
+    close(fds[0]);
+
+    ASSERT_EQ(received.size(), total);
+    for (uint64_t i = 0; i < total; i++) {
+        EdgeRecord expected = make_record(i);
+        ASSERT_EQ(memcmp(&received[i], &expected, sizeof(EdgeRecord)), 0) << "record " << i;
+    }
+    EXPECT_EQ(stats.records, total);
+    EXPECT_LT(stats.writes, total * sizeof(EdgeRecord) / 4096 + 100);
+#ifdef __linux__
+    EXPECT_GT(stats.spliced_bytes, 0u);
+#endif
+}
+
+TEST(TraceStreamTest, ObserveRecordsInitialLevelsAndChanges) {
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    TraceStream* stream = tcan1463q1_trace_stream_open_fd(fileno(file), NULL);
+    ASSERT_NE(stream, nullptr);
+
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    power_up(sim);
+    EdgeProbe probe;
+    memset(&probe, 0, sizeof(probe));
+    ASSERT_TRUE(tcan1463q1_trace_stream_observe(stream, &probe, sim));
+    // Nothing changed
+    tcan1463q1_simulator_step(sim, 10);
+    ASSERT_TRUE(tcan1463q1_trace_stream_observe(stream, &probe, sim));
+
+    tcan1463q1_simulator_set_pin(sim, PIN_TXD, PIN_STATE_LOW, 0.0);
+    for (int step = 0; step < 100; step++) {
+        tcan1463q1_simulator_step(sim, 10);
+        ASSERT_TRUE(tcan1463q1_trace_stream_observe(stream, &probe, sim));
+    }
+    ASSERT_TRUE(tcan1463q1_trace_stream_close(stream));
+
+    rewind(file);
+    std::vector<EdgeRecord> records = read_records(fileno(file));
+    fclose(file);
+    tcan1463q1_simulator_destroy(sim);
+
+    // Initial levels: 3 edge signals, 8 pins, 12 flags, the mode
+    ASSERT_GE(records.size(), 24u);
+    EXPECT_EQ(records[0].signal, EDGE_SIGNAL_TXD);
+    EXPECT_EQ(records[0].level, 1);
+    EXPECT_EQ(records[3].signal, TRACE_SIGNAL_PIN_BASE + PIN_TXD);
+    EXPECT_EQ(records[3].level, PIN_STATE_HIGH);
+    EXPECT_EQ(records[23].signal, TRACE_SIGNAL_MODE);
+    EXPECT_EQ(records[23].level, MODE_NORMAL);
+
+    // TXD falling, the loop back on RXD and the dominant bus
+    EXPECT_EQ(count_signal(records, EDGE_SIGNAL_TXD), 2u);
+    EXPECT_EQ(count_signal(records, EDGE_SIGNAL_RXD), 2u);
+    EXPECT_EQ(count_signal(records, EDGE_SIGNAL_BUS), 2u);
+    EXPECT_EQ(count_signal(records, TRACE_SIGNAL_PIN_BASE + PIN_TXD), 2u);
+    EXPECT_EQ(count_signal(records, TRACE_SIGNAL_MODE), 1u);
+    for (size_t i = 1; i < records.size(); i++) {
+        EXPECT_GE(records[i].time_ns, records[i - 1].time_ns);
+    }
+}
+
+TEST(TraceStreamTest, ClassMaskSelectsRecords) {
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    TraceStreamConfig config;
+    tcan1463q1_trace_stream_config_init(&config);
+    config.classes = TRACE_MODE;
+    TraceStream* stream = tcan1463q1_trace_stream_open_fd(fileno(file), &config);
+    ASSERT_NE(stream, nullptr);
+
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    EdgeProbe probe;
+    memset(&probe, 0, sizeof(probe));
+    ASSERT_TRUE(tcan1463q1_trace_stream_observe(stream, &probe, sim));
+    power_up(sim);
+    ASSERT_TRUE(tcan1463q1_trace_stream_observe(stream, &probe, sim));
+    ASSERT_TRUE(tcan1463q1_trace_stream_close(stream));
+
+    rewind(file);
+    std::vector<EdgeRecord> records = read_records(fileno(file));
+    fclose(file);
+    tcan1463q1_simulator_destroy(sim);
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].signal, TRACE_SIGNAL_MODE);
+    EXPECT_EQ(records[1].level, MODE_NORMAL);
+    EXPECT_FALSE(probe.valid);
+}
+
+TEST(TraceStreamTest, TimingAnalyzerConsumesLivePipe) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    TraceStream* stream = tcan1463q1_trace_stream_open_fd(fds[1], NULL);
+    ASSERT_NE(stream, nullptr);
+
+    TimingAnalyzerConfig config;
+    tcan1463q1_timing_analyzer_config_init(&config);
+    TimingAnalyzer* analyzer = tcan1463q1_timing_analyzer_create(&config);
+    int64_t processed = 0;
+    std::thread reader([&]() {
+        FILE* file = fdopen(fds[0], "rb");
+        processed = tcan1463q1_timing_analyzer_process_file(analyzer, file);
+        fclose(file);
+    });
+
+    TCAN1463Q1Simulator* sim = tcan1463q1_simulator_create();
+    power_up(sim);
+    EdgeProbe probe;
+    memset(&probe, 0, sizeof(probe));
+    ASSERT_TRUE(tcan1463q1_trace_stream_observe(stream, &probe, sim));
+    for (int bit = 0; bit < 20; bit++) {
+        bool recessive = (bit % 2) == 1;
+        tcan1463q1_simulator_set_pin(sim, PIN_TXD, recessive ? PIN_STATE_HIGH : PIN_STATE_LOW,
+                                     recessive ? 3.3 : 0.0);
+        for (int step = 0; step < 200; step++) {
+            tcan1463q1_simulator_step(sim, 10);
+            ASSERT_TRUE(tcan1463q1_trace_stream_observe(stream, &probe, sim));
+        }
+    }
+    TraceStreamStats stats;
+    tcan1463q1_trace_stream_get_stats(stream, &stats);
+    ASSERT_TRUE(tcan1463q1_trace_stream_close(stream));
+    close(fds[1]);
+    reader.join();
+
+    // Pin, flag and mode records are skipped by the analyzer
+    EXPECT_EQ((uint64_t)processed, stats.records);
+    EXPECT_EQ(tcan1463q1_timing_analyzer_get_histogram(analyzer, TIMING_LOOP_DELAY_DOMINANT)->count,
+              10u);
+    tcan1463q1_timing_analyzer_destroy(analyzer);
+    tcan1463q1_simulator_destroy(sim);
+}
+
+TEST(TraceStreamTest, UnixSocketAndClosedPeer) {
+    char path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+    snprintf(path, sizeof(path), "/tmp/tcan_trace_%d.sock", (int)getpid());
+    unlink(path);
+    EXPECT_EQ(tcan1463q1_trace_stream_connect(path, NULL), nullptr);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    ASSERT_EQ(bind(listener, (struct sockaddr*)&address, sizeof(address)), 0);
+    ASSERT_EQ(listen(listener, 1), 0);
+
+    TraceStream* stream = tcan1463q1_trace_stream_connect(path, NULL);
+    ASSERT_NE(stream, nullptr);
+    int client = accept(listener, NULL, NULL);
+    ASSERT_GE(client, 0);
+
+    EdgeRecord records[100];
+    for (int i = 0; i < 100; i++) records[i] = make_record(i);
+    ASSERT_TRUE(tcan1463q1_trace_stream_write(stream, records, 100));
+    ASSERT_TRUE(tcan1463q1_trace_stream_flush(stream));
+    uint8_t buffer[sizeof(records)];
+    size_t received = 0;
+    while (received < sizeof(buffer)) {
+        ssize_t n = read(client, buffer + received, sizeof(buffer) - received);
+        ASSERT_GT(n, 0);
+        received += (size_t)n;
+    }
+    EXPECT_EQ(memcmp(buffer, records, sizeof(records)), 0);
+
+    // Consumer gone: the stream fails instead of raising SIGPIPE
+    close(client);
+    bool ok = true;
+    for (int i = 0; i < 100 && ok; i++) {
+        ok = tcan1463q1_trace_stream_write(stream, records, 100) &&
+             tcan1463q1_trace_stream_flush(stream);
+    }
+    EXPECT_FALSE(ok);
+    EXPECT_FALSE(tcan1463q1_trace_stream_write(stream, records, 1));
+    EXPECT_FALSE(tcan1463q1_trace_stream_close(stream));
+
+    close(listener);
+    unlink(path);
+}
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include <rapidcheck.h>
+#include "tcan1463q1_wup_scanner.h"
+#include "wake_handler.h"
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Reference: wake_handler_process_wup at every sample, re-arming once the
+// bus is sampled recessive after a detection
+static std::vector<WUPMatch> reference_scan(const std::vector<uint8_t>& samples,
+                                            uint64_t start_ns, uint64_t period_ns) {
+    std::vector<WUPMatch> matches;
+    WakeState state;
+    wake_handler_init(&state);
+    bool rearm_wait = false;
+
+    for (size_t i = 0; i < samples.size(); i++) {
+        uint64_t t = start_ns + i * period_ns;
+        bool recessive = samples[i] != 0;
+        if (rearm_wait) {
+            if (!recessive) continue;
+            rearm_wait = false;
+        }
+        uint64_t pattern_start = state.wup_timeout_start;
+        wake_handler_process_wup(&state, recessive ? BUS_STATE_RECESSIVE : BUS_STATE_DOMINANT, t);
+        if (state.wup_state == WUP_STATE_COMPLETE) {
+            matches.push_back({pattern_start, t});
+            wake_handler_init(&state);
+            rearm_wait = true;
+        }
+    }
+    return matches;
+}
+
+// Bus activity: bursts of short pulses separated by idle gaps
+static std::vector<uint8_t> random_bus(size_t count, uint32_t seed) {
+    std::vector<uint8_t> samples(count, 1);
+    uint32_t x = seed * 2654435761u + 1;
+    auto next = [&x]() { x ^= x << 13; x ^= x >> 17; x ^= x << 5; return x; };
+
+    size_t i = 0;
+    bool level = true;
+    while (i < count) {
+        size_t run = level ? 1 + next() % 40 : 1 + next() % 8;
+        if (next() % 16 == 0) run += 200;
+        for (size_t j = 0; j < run && i < count; j++) samples[i++] = level ? 1 : 0;
+        level = !level;
+    }
+    return samples;
+}
+
+static bool same_matches(const WUPScanResult& result, const std::vector<WUPMatch>& expected) {
+    if (result.count != expected.size()) return false;
+    for (size_t i = 0; i < result.count; i++) {
+        if (result.matches[i].start_ns != expected[i].start_ns ||
+            result.matches[i].complete_ns != expected[i].complete_ns) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static EdgeRecord bus_edge(uint64_t t, bool recessive) {
+    EdgeRecord record;
+    memset(&record, 0, sizeof(record));
+    record.time_ns = t;
+    record.signal = EDGE_SIGNAL_BUS;
+    record.level = recessive ? 1 : 0;
+    return record;
+}
+
+// Unit Tests
+
+TEST(WUPScannerTest, ConfigDefaultsMatchWakeHandler) {
+    WUPScanConfig config;
+    tcan1463q1_wup_scan_config_init(&config, NULL);
+    EXPECT_EQ(config.filter_ns, 500u);
+    EXPECT_EQ(config.timeout_ns, 2000000u);
+}
+
+TEST(WUPScannerTest, DetectsPatternOnStepGrid) {
+    // 1 us steps: dominant 2 us, recessive 1 us, dominant 1 us
+    std::vector<EdgeRecord> edges = {
+        bus_edge(0, true),
+        bus_edge(10000, false),
+        bus_edge(12000, true),
+        bus_edge(13000, false),
+        bus_edge(14000, true),
+        // Glitches shorter than the step are never sampled
+        bus_edge(50100, false),
+        bus_edge(50400, true),
+    };
+
+    WUPScanConfig config;
+    tcan1463q1_wup_scan_config_init(&config, NULL);
+    WUPScanResult result;
+    ASSERT_TRUE(tcan1463q1_wup_scan_edges(edges.data(), edges.size(), 100000, 1000,
+                                          &config, 1, 1, &result));
+    ASSERT_EQ(result.count, 1u);
+    EXPECT_EQ(result.matches[0].start_ns, 10000u);
+    EXPECT_EQ(result.matches[0].complete_ns, 13000u);
+    tcan1463q1_wup_scan_result_free(&result);
+}
+
+TEST(WUPScannerTest, IgnoresOtherSignals) {
+    std::vector<EdgeRecord> edges;
+    for (uint64_t t = 0; t < 100000; t += 700) {
+        EdgeRecord txd = bus_edge(t, (t / 700) % 2 == 0);
+        txd.signal = EDGE_SIGNAL_TXD;
+        edges.push_back(txd);
+    }
+
+    WUPScanConfig config;
+    tcan1463q1_wup_scan_config_init(&config, NULL);
+    WUPScanResult result;
+    ASSERT_TRUE(tcan1463q1_wup_scan_edges(edges.data(), edges.size(), 100000, 100,
+                                          &config, 1, 1, &result));
+    EXPECT_EQ(result.count, 0u);
+}
+
+TEST(WUPScannerTest, RejectsInvalidArguments) {
+    EdgeRecord edge = bus_edge(0, true);
+    WUPScanConfig config = {500, 2000000};
+    WUPScanResult result;
+
+    EXPECT_FALSE(tcan1463q1_wup_scan_edges(&edge, 1, 0, 0, &config, 1, 1, &result));
+    config.filter_ns = 0;
+    EXPECT_FALSE(tcan1463q1_wup_scan_edges(&edge, 1, 0, 1000, &config, 1, 1, &result));
+    EXPECT_EQ(result.matches, nullptr);
+    EXPECT_FALSE(tcan1463q1_wup_scan_samples(NULL, 0, 0, 0, &config, 1, 1, &result));
+}
+
+TEST(WUPScannerTest, MatchesPerSampleWakeHandler) {
+    std::vector<uint8_t> samples = random_bus(200000, 7);
+    std::vector<WUPMatch> expected = reference_scan(samples, 5000, 250);
+    ASSERT_GT(expected.size(), 10u);
+
+    WUPScanConfig config;
+    tcan1463q1_wup_scan_config_init(&config, NULL);
+    WUPScanResult result;
+    ASSERT_TRUE(tcan1463q1_wup_scan_samples(samples.data(), samples.size(), 5000, 250,
+                                            &config, 1, 1, &result));
+    EXPECT_TRUE(same_matches(result, expected));
+    tcan1463q1_wup_scan_result_free(&result);
+}
+
+TEST(WUPScannerTest, ParallelChunksMatchSequentialScan) {
+    std::vector<uint8_t> samples = random_bus(2000000, 11);
+
+    // Two corners in one pass
+    WUPScanConfig configs[2] = {{500, 800000}, {1800, 2000000}};
+    WUPScanResult sequential[2];
+    WUPScanResult parallel[2];
+    ASSERT_TRUE(tcan1463q1_wup_scan_samples(samples.data(), samples.size(), 0, 300,
+                                            configs, 2, 1, sequential));
+    ASSERT_TRUE(tcan1463q1_wup_scan_samples(samples.data(), samples.size(), 0, 300,
+                                            configs, 2, 8, parallel));
+
+    for (int c = 0; c < 2; c++) {
+        ASSERT_GT(sequential[c].count, 0u);
+        std::vector<WUPMatch> expected(sequential[c].matches,
+                                       sequential[c].matches + sequential[c].count);
+        EXPECT_TRUE(same_matches(parallel[c], expected)) << "corner " << c;
+        tcan1463q1_wup_scan_result_free(&sequential[c]);
+        tcan1463q1_wup_scan_result_free(&parallel[c]);
+    }
+}
+
+TEST(WUPScannerTest, ScansEdgeTraceFile) {
+    // Convert a sampled bus into bus edges (plus TXD noise) and write a trace
+    std::vector<uint8_t> samples = random_bus(400000, 3);
+    std::vector<EdgeRecord> edges;
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (i == 0 || samples[i] != samples[i - 1]) {
+            edges.push_back(bus_edge(i * 400, samples[i] != 0));
+            EdgeRecord txd = edges.back();
+            txd.signal = EDGE_SIGNAL_TXD;
+            edges.push_back(txd);
+        }
+    }
+
+    std::string path = testing::TempDir() + "wup_scan_trace.edges";
+    FILE* file = fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite(edges.data(), sizeof(EdgeRecord), edges.size(), file);
+    fclose(file);
+
+    WUPScanConfig config;
+    tcan1463q1_wup_scan_config_init(&config, NULL);
+    WUPScanResult from_file;
+    WUPScanResult from_samples;
+    ASSERT_TRUE(tcan1463q1_wup_scan_file(path.c_str(), 400, &config, 1, 4, &from_file));
+    ASSERT_TRUE(tcan1463q1_wup_scan_samples(samples.data(), samples.size(), 0, 400,
+                                            &config, 1, 1, &from_samples));
+
+    // The file ends at its last edge; compare the common span
+    ASSERT_GT(from_samples.count, 0u);
+    uint64_t end = edges.back().time_ns;
+    std::vector<WUPMatch> expected;
+    for (size_t i = 0; i < from_samples.count; i++) {
+        if (from_samples.matches[i].complete_ns < end) expected.push_back(from_samples.matches[i]);
+    }
+    EXPECT_TRUE(same_matches(from_file, expected));
+
+    tcan1463q1_wup_scan_result_free(&from_file);
+    tcan1463q1_wup_scan_result_free(&from_samples);
+    remove(path.c_str());
+}
+
+// Property-Based Tests
+
+TEST(WUPScannerPropertyTest, EventSkippingMatchesEverySampleEvaluation) {
+    rc::check("scan equals evaluating wake_handler_process_wup at every sample", []() {
+        auto seed = *rc::gen::inRange(1, 100000);
+        auto period = *rc::gen::inRange(50, 1200);
+        auto threads = *rc::gen::inRange(1, 5);
+
+        std::vector<uint8_t> samples = random_bus(150000, (uint32_t)seed);
+        std::vector<WUPMatch> expected = reference_scan(samples, 0, (uint64_t)period);
+
+        WUPScanConfig config;
+        tcan1463q1_wup_scan_config_init(&config, NULL);
+        WUPScanResult result;
+        RC_ASSERT(tcan1463q1_wup_scan_samples(samples.data(), samples.size(), 0,
+                                              (uint64_t)period, &config, 1,
+                                              (unsigned)threads, &result));
+        RC_ASSERT(same_matches(result, expected));
+        tcan1463q1_wup_scan_result_free(&result);
+    });
+}
@@ -0,0 +1,747 @@
+/**
+ * tcan1463q1_run - Command-line scenario runner
+ *
+ * Loads scenario files (or directories of *.scn files), executes them on a
+ * pool of worker threads and writes a summary plus optional JSON results.
+ * Each worker owns one simulator which is reset between scenarios.
+ *
+ * With --lockstep every scenario runs alongside a reference simulator
+ * advancing in fine steps (see tcan1463q1_lockstep.h); the first state
+ * divergence fails the scenario.
+ *
+ * SIGINT/SIGTERM cancel the run (tcan1463q1_run_control.h): running
+ * scenarios stop at their next check, the rest are not started, and the
+ * summary and results are still written.
+ */
+
+#include "tcan1463q1_simulator.h"
+#include "tcan1463q1_scenario.h"
+#include "tcan1463q1_lockstep.h"
+#include "tcan1463q1_run_control.h"
+#include "tcan1463q1_profile.h"
+#include "tcan1463q1_noise.h"
+#include <errno.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+// Exit codes
+#define EXIT_ALL_PASSED 0
+#define EXIT_FAILURES 1
+#define EXIT_USAGE 2
+
+// Upper bound for -j; larger counts are typos, not machines
+#define MAX_JOBS 1024u
+
+/**
+ * Runner options
+ */
+struct RunnerOptions {
+    unsigned jobs;
+    DeviceProfile* profile;
+    const char* results_path;
+    const char* trace_dir;
+    uint64_t seed;
+    bool shuffle;
+    bool quiet;
+    bool progress;
+    bool lockstep;
+    LockstepConfig lockstep_config;
+    bool noise;
+    NoiseConfig noise_config;  // Seeded per run
+    RunControl* control;
+};
+
+/**
+ * A -t override: a device profile timing key and its value
+ */
+struct TimingOverride {
+    const char* key;
+    double value_ns;
+};
+
+/**
+ * One scenario file and its outcome
+ */
+struct RunJob {
+    std::string path;
+    Scenario* scenario;
+    std::string load_error;
+    uint64_t seed;
+    bool started;
+
+    ScenarioResult result;
+    uint64_t sim_time_ns;
+    double wall_time_us;
+    SupplyEnergy energy;
+    std::string trace_path;
+    std::string divergence;  // Lockstep divergence report
+};
+
+static void print_usage(const char* argv0) {
+    printf("Usage: %s [options] <scenario file|directory>...\n", argv0);
+    printf("\n");
+    printf("Options:\n");
+    printf("  -j, --jobs N              Worker threads (default: number of CPUs)\n");
+    printf("  -t, --timing NAME=VALUE   Set a device timing for every run (applied to the\n");
+    printf("                            profile; tuv_ms, ttxddto_ms, tbusdom_ms,\n");
+    printf("                            twk_filter_us, twk_timeout_ms, tsilence_s)\n");
+    printf("  -p, --profile FILE        Run every scenario with a device profile file\n");
+    printf("  -o, --results FILE        Write machine-readable results (JSON)\n");
+    printf("      --trace-failures DIR  Re-run failing scenarios with an action trace in DIR\n");
+    printf("      --seed N              Base seed for run ordering and noise (default 1)\n");
+    printf("      --shuffle             Execute scenarios in seeded random order\n");
+    printf("      --noise-rms V         Differential EMC noise on CANH/CANL, seeded per run\n");
+    printf("      --noise-cm-rms V      Common-mode EMC noise, seeded per run\n");
+    printf("      --lockstep            Validate against a fine-step reference simulator\n");
+    printf("      --fast-step NS        Lockstep: fast simulator step (default: whole WAITs)\n");
+    printf("      --reference-step NS   Lockstep: reference simulator step (default 1)\n");
+    printf("      --progress            Print progress to stderr every second\n");
+    printf("  -q, --quiet               Only print failures and the summary\n");
+    printf("  -h, --help                Show this help\n");
+}
+
+// -t names and the profile timing they set
+static const struct {
+    const char* name;
+    const char* key;
+    double scale_ns;
+} timing_names[] = {
+    {"tuv_ms", "tuv", 1e6},
+    {"ttxddto_ms", "ttxddto", 1e6},
+    {"tbusdom_ms", "tbusdom", 1e6},
+    {"twk_filter_us", "twk_filter", 1e3},
+    {"twk_timeout_ms", "twk_timeout", 1e6},
+    {"tsilence_s", "tsilence", 1e9},
+};
+
+static bool parse_timing_override(const char* assignment, TimingOverride* entry) {
+    const char* eq = strchr(assignment, '=');
+    if (!eq) return false;
+
+    std::string name(assignment, eq - assignment);
+    char* end = NULL;
+    double value = strtod(eq + 1, &end);
+    if (end == eq + 1 || *end != '\0' || !(value > 0.0)) return false;
+
+    for (const auto& timing : timing_names) {
+        if (name == timing.name) {
+            entry->key = timing.key;
+            entry->value_ns = value * timing.scale_ns;
+            return entry->value_ns < 1e18;
+        }
+    }
+    return false;
+}
+
+// Whole-argument unsigned integer in [min, max]; strtoull alone takes "-3" and "abc"
+static bool parse_unsigned(const char* text, uint64_t min, uint64_t max, uint64_t* value) {
+    if (text[0] < '0' || text[0] > '9') return false;
+
+    char* end = NULL;
+    errno = 0;
+    unsigned long long parsed = strtoull(text, &end, 0);
+    if (errno != 0 || *end != '\0' || parsed < min || parsed > max) return false;
+    *value = parsed;
+    return true;
+}
+
+// Whole-argument finite, non-negative voltage
+static bool parse_volts(const char* text, double* value) {
+    char* end = NULL;
+    double parsed = strtod(text, &end);
+    if (end == text || *end != '\0' || !isfinite(parsed) || parsed < 0.0) return false;
+    *value = parsed;
+    return true;
+}
+
+/**
+ * Derive the profile every run uses from the -p profile (or the default
+ * variant) with the -t timings applied; the kernels read timings from it
+ */
+static DeviceProfile* apply_timing_overrides(DeviceProfile* base,
+                                             const std::vector<TimingOverride>& overrides,
+                                             char* error, size_t error_size) {
+    DeviceVariant variant = base ? tcan1463q1_profile_get_variant(base)
+                                 : DEVICE_VARIANT_TCAN1463Q1;
+    DeviceParams params = base ? *tcan1463q1_profile_get_params(base)
+                               : *tcan1463q1_device_get_params(variant);
+    for (const TimingOverride& entry : overrides) {
+        if (!tcan1463q1_profile_set_param(&params, entry.key, entry.value_ns)) {
+            snprintf(error, error_size, "cannot set %s", entry.key);
+            return NULL;
+        }
+    }
+
+    std::string name = base ? tcan1463q1_profile_get_name(base) : "default";
+    name += " + timing overrides";
+    return tcan1463q1_profile_create(name.c_str(), variant, &params, error, error_size);
+}
+
+static bool collect_scenario_files(const char* arg, std::vector<std::string>* paths) {
+    std::error_code ec;
+    fs::path root(arg);
+
+    if (fs::is_directory(root, ec)) {
+        std::vector<std::string> found;
+        for (const auto& entry : fs::recursive_directory_iterator(root, ec)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".scn") {
+                found.push_back(entry.path().string());
+            }
+        }
+        std::sort(found.begin(), found.end());
+        paths->insert(paths->end(), found.begin(), found.end());
+        return !ec;
+    }
+
+    if (fs::is_regular_file(root, ec)) {
+        paths->push_back(root.string());
+        return true;
+    }
+
+    return false;
+}
+
+// SplitMix64 step, used to derive independent per-run seeds
+static uint64_t mix_seed(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static void prepare_simulator(TCAN1463Q1Simulator* sim, const RunnerOptions* options,
+                              uint64_t seed) {
+    tcan1463q1_simulator_reset(sim);
+    if (options->noise) {
+        NoiseConfig noise = options->noise_config;
+        noise.seed = seed;
+        tcan1463q1_noise_attach(sim, &noise);
+    }
+}
+
+static void write_trace_state(FILE* out, TCAN1463Q1Simulator* sim) {
+    static const PinType traced_pins[] = {
+        PIN_TXD, PIN_RXD, PIN_EN, PIN_NSTB, PIN_NFAULT, PIN_INH, PIN_CANH, PIN_CANL
+    };
+
+    fprintf(out, "    mode=%s",
+            tcan1463q1_scenario_mode_name(tcan1463q1_simulator_get_mode(sim)));
+
+    bool flags[12];
+    tcan1463q1_simulator_get_flags(sim, &flags[0], &flags[1], &flags[2], &flags[3],
+                                   &flags[4], &flags[5], &flags[6], &flags[7],
+                                   &flags[8], &flags[9], &flags[10], &flags[11]);
+    fprintf(out, " flags=");
+    bool any = false;
+    for (int i = 0; i < 12; i++) {
+        if (flags[i]) {
+            fprintf(out, "%s%s", any ? "," : "", tcan1463q1_scenario_flag_name((FlagType)i));
+            any = true;
+        }
+    }
+    if (!any) fprintf(out, "-");
+    fprintf(out, "\n   ");
+
+    for (PinType pin : traced_pins) {
+        PinState state;
+        double voltage;
+        tcan1463q1_simulator_get_pin(sim, pin, &state, &voltage);
+        fprintf(out, " %s=%s/%.3fV", tcan1463q1_scenario_pin_name(pin),
+                tcan1463q1_scenario_pin_state_name(state), voltage);
+    }
+    fprintf(out, "\n");
+}
+
+/**
+ * Re-run a failed scenario action by action and record the simulator
+ * state after every action
+ */
+static void trace_failed_run(RunJob* job, TCAN1463Q1Simulator* sim,
+                             const RunnerOptions* options, size_t job_index) {
+    std::string base = fs::path(job->path).stem().string();
+    char name[512];
+    snprintf(name, sizeof(name), "%s/%04zu_%s.trace", options->trace_dir, job_index, base.c_str());
+
+    FILE* out = fopen(name, "w");
+    if (!out) return;
+
+    prepare_simulator(sim, options, job->seed);
+    Scenario* scenario = job->scenario;
+    tcan1463q1_scenario_reset(scenario);
+
+    fprintf(out, "# scenario: %s\n", scenario->name ? scenario->name : "(unnamed)");
+    fprintf(out, "# file: %s\n", job->path.c_str());
+    fprintf(out, "# seed: %llu\n", (unsigned long long)job->seed);
+    if (options->profile) {
+        fprintf(out, "# profile: %s\n", tcan1463q1_profile_get_name(options->profile));
+    }
+
+    for (size_t i = 0; i < scenario->action_count; i++) {
+        const ScenarioAction* action = &scenario->actions[i];
+        ScenarioResult step = tcan1463q1_scenario_execute_step(scenario, sim);
+
+        fprintf(out, "[%zu] t=%lluns %s%s%s\n", i + 1,
+                (unsigned long long)sim->timing.current_time_ns,
+                step.success ? "ok" : "FAIL",
+                action->description ? " " : "",
+                action->description ? action->description : "");
+        if (!step.success && step.error_message) {
+            fprintf(out, "    error: %s\n", step.error_message);
+        }
+        write_trace_state(out, sim);
+
+        if (!step.success && scenario->stop_on_error) {
+            break;
+        }
+    }
+
+    fclose(out);
+    job->trace_path = name;
+}
+
+static void json_string(FILE* out, const char* text) {
+    fputc('"', out);
+    for (const char* p = text ? text : ""; *p; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\') {
+            fprintf(out, "\\%c", c);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void write_energy(FILE* out, const SupplyEnergy* energy) {
+    fprintf(out, "{\"vsup\": %.6e, \"vcc\": %.6e, \"vio\": %.6e}",
+            tcan1463q1_supply_energy_total(energy, SUPPLY_VSUP),
+            tcan1463q1_supply_energy_total(energy, SUPPLY_VCC),
+            tcan1463q1_supply_energy_total(energy, SUPPLY_VIO));
+}
+
+static bool write_results(const char* path, const std::vector<RunJob>& jobs,
+                          const RunnerOptions* options, double wall_time_s) {
+    FILE* out = fopen(path, "w");
+    if (!out) return false;
+
+    size_t passed = 0;
+    SupplyEnergy fleet;
+    memset(&fleet, 0, sizeof(fleet));
+    for (const RunJob& job : jobs) {
+        if (job.load_error.empty() && job.result.success) passed++;
+        if (job.load_error.empty()) tcan1463q1_supply_energy_merge(&fleet, &job.energy);
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"seed\": %llu,\n", (unsigned long long)options->seed);
+    fprintf(out, "  \"jobs\": %u,\n", options->jobs);
+    if (options->profile) {
+        fprintf(out, "  \"profile\": ");
+        json_string(out, tcan1463q1_profile_get_name(options->profile));
+        fprintf(out, ",\n");
+    }
+    fprintf(out, "  \"total\": %zu,\n", jobs.size());
+    fprintf(out, "  \"passed\": %zu,\n", passed);
+    fprintf(out, "  \"failed\": %zu,\n", jobs.size() - passed);
+    fprintf(out, "  \"wall_time_s\": %.6f,\n", wall_time_s);
+    fprintf(out, "  \"energy_j\": ");
+    write_energy(out, &fleet);
+    fprintf(out, ",\n");
+    fprintf(out, "  \"results\": [\n");
+
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const RunJob& job = jobs[i];
+        bool loaded = job.load_error.empty();
+        bool success = loaded && job.result.success;
+
+        fprintf(out, "    {\"file\": ");
+        json_string(out, job.path.c_str());
+        fprintf(out, ", \"name\": ");
+        json_string(out, loaded && job.scenario->name ? job.scenario->name : "");
+        fprintf(out, ", \"success\": %s", success ? "true" : "false");
+        fprintf(out, ", \"seed\": %llu", (unsigned long long)job.seed);
+
+        if (loaded) {
+            fprintf(out, ", \"actions_executed\": %zu, \"actions_passed\": %zu, \"actions_failed\": %zu",
+                    job.result.actions_executed, job.result.actions_passed,
+                    job.result.actions_failed);
+            fprintf(out, ", \"sim_time_ns\": %llu, \"wall_time_us\": %.1f",
+                    (unsigned long long)job.sim_time_ns, job.wall_time_us);
+            fprintf(out, ", \"energy_j\": ");
+            write_energy(out, &job.energy);
+        }
+        if (!success) {
+            fprintf(out, ", \"error\": ");
+            json_string(out, loaded ? job.result.error_message : job.load_error.c_str());
+            if (loaded && job.result.cancelled) {
+                fprintf(out, ", \"cancelled\": true");
+            } else if (loaded) {
+                fprintf(out, ", \"failed_action\": %zu", job.result.failed_action_index + 1);
+            }
+        }
+        if (!job.trace_path.empty()) {
+            fprintf(out, ", \"trace\": ");
+            json_string(out, job.trace_path.c_str());
+        }
+        fprintf(out, "}%s\n", i + 1 < jobs.size() ? "," : "");
+    }
+
+    fprintf(out, "  ]\n}\n");
+    return fclose(out) == 0;
+}
+
+static void report_job(const RunJob& job, const RunnerOptions* options, std::mutex* lock) {
+    bool success = job.load_error.empty() && job.result.success;
+    if (success && options->quiet) return;
+
+    std::lock_guard<std::mutex> guard(*lock);
+    if (!job.load_error.empty()) {
+        printf("ERROR %s: %s\n", job.path.c_str(), job.load_error.c_str());
+        return;
+    }
+
+    const char* name = job.scenario->name ? job.scenario->name : job.path.c_str();
+    if (success) {
+        printf("PASS  %s (%.1f us)\n", name, job.wall_time_us);
+        return;
+    }
+
+    size_t index = job.result.failed_action_index;
+    const char* description = index < job.scenario->action_count
+        ? job.scenario->actions[index].description : NULL;
+    printf("FAIL  %s: %s at action %zu%s%s%s\n", name,
+           job.result.error_message ? job.result.error_message : "failed",
+           index + 1,
+           description ? " (" : "", description ? description : "", description ? ")" : "");
+    if (!job.trace_path.empty()) {
+        printf("      trace: %s\n", job.trace_path.c_str());
+    }
+    if (!job.divergence.empty()) {
+        fputs(job.divergence.c_str(), stdout);
+    }
+}
+
+/**
+ * Run a scenario with the reference simulator in lockstep and turn a
+ * divergence into a failure
+ */
+static void lockstep_run(RunJob* job, TCAN1463Q1Simulator* sim,
+                         TCAN1463Q1Simulator* reference, const RunnerOptions* options) {
+    prepare_simulator(reference, options, job->seed);
+
+    LockstepResult lockstep;
+    if (tcan1463q1_lockstep_execute_scenario(job->scenario, sim, reference,
+                                             &options->lockstep_config, &job->result,
+                                             &lockstep) || !lockstep.diverged) {
+        return;
+    }
+
+    char report[2048];
+    tcan1463q1_lockstep_format(&lockstep, report, sizeof(report));
+    job->divergence = report;
+    job->result.error_message = "lockstep divergence";
+}
+
+static void worker_main(std::vector<RunJob>* jobs, const std::vector<size_t>* order,
+                        std::atomic<size_t>* next, const RunnerOptions* options,
+                        std::mutex* print_lock) {
+    // Pooled simulator, reused for every scenario this worker picks up
+    TCAN1463Q1Simulator* sim = options->profile
+        ? tcan1463q1_simulator_create_with_profile(options->profile)
+        : tcan1463q1_simulator_create();
+    if (!sim) return;
+
+    TCAN1463Q1Simulator* reference = NULL;
+    if (options->lockstep) {
+        reference = options->profile
+            ? tcan1463q1_simulator_create_with_profile(options->profile)
+            : tcan1463q1_simulator_create();
+        if (!reference) {
+            tcan1463q1_simulator_destroy(sim);
+            return;
+        }
+    }
+    tcan1463q1_simulator_set_run_control(sim, options->control);
+    tcan1463q1_simulator_set_run_control(reference, options->control);
+
+    for (;;) {
+        if (tcan1463q1_run_control_is_cancelled(options->control)) break;
+        size_t slot = next->fetch_add(1);
+        if (slot >= order->size()) break;
+
+        size_t index = (*order)[slot];
+        RunJob* job = &(*jobs)[index];
+        job->started = true;
+
+        if (job->load_error.empty()) {
+            prepare_simulator(sim, options, job->seed);
+
+            auto start = std::chrono::steady_clock::now();
+            if (reference) {
+                lockstep_run(job, sim, reference, options);
+            } else {
+                job->result = tcan1463q1_scenario_execute(job->scenario, sim);
+            }
+            auto stop = std::chrono::steady_clock::now();
+
+            job->sim_time_ns = sim->timing.current_time_ns;
+            tcan1463q1_simulator_get_supply_energy(sim, &job->energy);
+            job->wall_time_us = std::chrono::duration<double, std::micro>(stop - start).count();
+
+            if (!job->result.success && !job->result.cancelled && options->trace_dir) {
+                trace_failed_run(job, sim, options, index);
+            }
+        }
+
+        report_job(*job, options, print_lock);
+    }
+
+    tcan1463q1_simulator_destroy(reference);
+    tcan1463q1_simulator_destroy(sim);
+}
+
+// Cancelled by SIGINT/SIGTERM
+static RunControl* signal_control = NULL;
+
+static void handle_signal(int) {
+    tcan1463q1_run_control_cancel(signal_control);
+}
+
+int main(int argc, char** argv) {
+    RunnerOptions options;
+    memset(&options, 0, sizeof(options));
+    options.jobs = std::thread::hardware_concurrency();
+    options.seed = 1;
+    tcan1463q1_lockstep_config_init(&options.lockstep_config);
+    tcan1463q1_noise_config_init(&options.noise_config);
+
+    std::vector<std::string> paths;
+    std::vector<TimingOverride> timing_overrides;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            print_usage(argv[0]);
+            return EXIT_ALL_PASSED;
+        } else if ((strcmp(arg, "-j") == 0 || strcmp(arg, "--jobs") == 0) && has_value) {
+            uint64_t jobs = 0;
+            if (!parse_unsigned(argv[++i], 1, MAX_JOBS, &jobs)) {
+                fprintf(stderr, "error: invalid job count '%s' (1..%u)\n", argv[i], MAX_JOBS);
+                print_usage(argv[0]);
+                return EXIT_USAGE;
+            }
+            options.jobs = (unsigned)jobs;
+        } else if ((strcmp(arg, "-t") == 0 || strcmp(arg, "--timing") == 0) && has_value) {
+            TimingOverride entry;
+            if (!parse_timing_override(argv[++i], &entry)) {
+                fprintf(stderr, "error: invalid timing override '%s'\n", argv[i]);
+                return EXIT_USAGE;
+            }
+            timing_overrides.push_back(entry);
+        } else if ((strcmp(arg, "-p") == 0 || strcmp(arg, "--profile") == 0) && has_value) {
+            char error[256] = {0};
+            tcan1463q1_profile_release(options.profile);
+            options.profile = tcan1463q1_profile_load(argv[++i], error, sizeof(error));
+            if (!options.profile) {
+                fprintf(stderr, "error: %s: %s\n", argv[i], error);
+                return EXIT_USAGE;
+            }
+        } else if ((strcmp(arg, "-o") == 0 || strcmp(arg, "--results") == 0) && has_value) {
+            options.results_path = argv[++i];
+        } else if (strcmp(arg, "--trace-failures") == 0 && has_value) {
+            options.trace_dir = argv[++i];
+        } else if (strcmp(arg, "--seed") == 0 && has_value) {
+            if (!parse_unsigned(argv[++i], 0, UINT64_MAX, &options.seed)) {
+                fprintf(stderr, "error: invalid seed '%s'\n", argv[i]);
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--shuffle") == 0) {
+            options.shuffle = true;
+        } else if (strcmp(arg, "--noise-rms") == 0 && has_value) {
+            if (!parse_volts(argv[++i], &options.noise_config.differential_rms_v)) {
+                fprintf(stderr, "error: invalid noise RMS '%s'\n", argv[i]);
+                return EXIT_USAGE;
+            }
+            options.noise = true;
+        } else if (strcmp(arg, "--noise-cm-rms") == 0 && has_value) {
+            if (!parse_volts(argv[++i], &options.noise_config.common_mode_rms_v)) {
+                fprintf(stderr, "error: invalid noise RMS '%s'\n", argv[i]);
+                return EXIT_USAGE;
+            }
+            options.noise = true;
+        } else if (strcmp(arg, "--lockstep") == 0) {
+            options.lockstep = true;
+        } else if (strcmp(arg, "--fast-step") == 0 && has_value) {
+            if (!parse_unsigned(argv[++i], 0, UINT64_MAX, &options.lockstep_config.fast_step_ns)) {
+                fprintf(stderr, "error: invalid fast step '%s'\n", argv[i]);
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--reference-step") == 0 && has_value) {
+            if (!parse_unsigned(argv[++i], 1, UINT64_MAX,
+                                &options.lockstep_config.reference_step_ns)) {
+                fprintf(stderr, "error: invalid reference step '%s'\n", argv[i]);
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--progress") == 0) {
+            options.progress = true;
+        } else if (strcmp(arg, "-q") == 0 || strcmp(arg, "--quiet") == 0) {
+            options.quiet = true;
+        } else if (arg[0] == '-') {
+            fprintf(stderr, "error: unknown or incomplete option '%s'\n", arg);
+            print_usage(argv[0]);
+            return EXIT_USAGE;
+        } else if (!collect_scenario_files(arg, &paths)) {
+            fprintf(stderr, "error: cannot read '%s'\n", arg);
+            return EXIT_USAGE;
+        }
+    }
+
+    if (paths.empty()) {
+        print_usage(argv[0]);
+        return EXIT_USAGE;
+    }
+    if (options.jobs == 0) {
+        options.jobs = 1;
+    }
+    if (!timing_overrides.empty()) {
+        char error[256] = {0};
+        DeviceProfile* profile = apply_timing_overrides(options.profile, timing_overrides,
+                                                        error, sizeof(error));
+        if (!profile) {
+            fprintf(stderr, "error: timing overrides: %s\n", error);
+            return EXIT_USAGE;
+        }
+        tcan1463q1_profile_release(options.profile);
+        options.profile = profile;
+    }
+    if (options.trace_dir) {
+        std::error_code ec;
+        fs::create_directories(options.trace_dir, ec);
+        if (ec) {
+            fprintf(stderr, "error: cannot create trace directory '%s'\n", options.trace_dir);
+            return EXIT_USAGE;
+        }
+    }
+
+    // Load all scenarios up front so parse errors are reported once
+    std::vector<RunJob> jobs(paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        char error[256] = {0};
+        jobs[i].path = paths[i];
+        jobs[i].scenario = tcan1463q1_scenario_load_file(paths[i].c_str(), error, sizeof(error));
+        jobs[i].seed = mix_seed(options.seed ^ (uint64_t)i);
+        jobs[i].started = false;
+        memset(&jobs[i].result, 0, sizeof(jobs[i].result));
+        jobs[i].sim_time_ns = 0;
+        jobs[i].wall_time_us = 0.0;
+        memset(&jobs[i].energy, 0, sizeof(jobs[i].energy));
+        if (!jobs[i].scenario) {
+            jobs[i].load_error = error[0] ? error : "failed to load";
+        }
+    }
+
+    std::vector<size_t> order(jobs.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    if (options.shuffle) {
+        std::mt19937_64 rng(options.seed);
+        std::shuffle(order.begin(), order.end(), rng);
+    }
+
+    options.control = tcan1463q1_run_control_create();
+    if (!options.control) {
+        fprintf(stderr, "error: out of memory\n");
+        return EXIT_USAGE;
+    }
+    signal_control = options.control;
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+
+    unsigned workers = std::min<size_t>(options.jobs, jobs.size());
+    std::atomic<size_t> next(0);
+    std::atomic<unsigned> running(workers);
+    std::mutex print_lock;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < workers; i++) {
+        threads.emplace_back([&]() {
+            worker_main(&jobs, &order, &next, &options, &print_lock);
+            running--;
+        });
+    }
+    if (options.progress) {
+        auto last = start;
+        while (running > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            auto now = std::chrono::steady_clock::now();
+            if (now - last < std::chrono::seconds(1)) continue;
+            last = now;
+            RunProgress progress;
+            tcan1463q1_run_control_get_progress(options.control, &progress);
+            fprintf(stderr, "progress: %llu/%zu runs, %llu actions, %.3f s simulated\n",
+                    (unsigned long long)progress.runs_finished, jobs.size(),
+                    (unsigned long long)progress.actions_completed, progress.sim_time_ns / 1e9);
+        }
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double wall_time_s = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+
+    // Scenarios never started because of cancellation
+    for (RunJob& job : jobs) {
+        if (job.load_error.empty() && !job.started) {
+            job.result.cancelled = true;
+            job.result.error_message = "Cancelled";
+        }
+    }
+
+    // Summary
+    size_t passed = 0;
+    size_t cancelled = 0;
+    uint64_t sim_time_ns = 0;
+    for (const RunJob& job : jobs) {
+        if (job.load_error.empty() && job.result.success) passed++;
+        if (job.load_error.empty() && job.result.cancelled) cancelled++;
+        sim_time_ns += job.sim_time_ns;
+    }
+
+    printf("\n%zu scenarios, %zu passed, %zu failed (%u workers, %.3f s wall, %.3f s simulated)\n",
+           jobs.size(), passed, jobs.size() - passed, workers, wall_time_s, sim_time_ns / 1e9);
+    if (cancelled) {
+        printf("cancelled: %zu scenarios stopped or not started\n", cancelled);
+    }
+
+    if (options.results_path && !write_results(options.results_path, jobs, &options, wall_time_s)) {
+        fprintf(stderr, "error: cannot write results to '%s'\n", options.results_path);
+    }
+
+    for (RunJob& job : jobs) {
+        tcan1463q1_scenario_destroy(job.scenario);
+    }
+    tcan1463q1_profile_release(options.profile);
+    tcan1463q1_run_control_destroy(options.control);
+
+    return passed == jobs.size() ? EXIT_ALL_PASSED : EXIT_FAILURES;
+}
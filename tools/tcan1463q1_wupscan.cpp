@@ -0,0 +1,120 @@
+/**
+ * tcan1463q1_wupscan - Find wake-up patterns in recorded bus traces
+ *
+ * Scans edge trace files (EdgeRecord arrays, see
+ * tcan1463q1_timing_analyzer.h) with the wake handler's WUP detection at
+ * the four tWK_FILTER/tWK_TIMEOUT datasheet corners, or at one explicit
+ * corner, in a single pass per file spread over worker threads.
+ */
+
+#include "tcan1463q1_wup_scanner.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+// Exit codes
+#define EXIT_NONE_FOUND 0
+#define EXIT_FOUND 1
+#define EXIT_USAGE 2
+
+static void print_usage(const char* argv0) {
+    printf("Usage: %s [options] <edge trace>...\n", argv0);
+    printf("\n");
+    printf("Options:\n");
+    printf("  -s, --step NS         Evaluation step, as the simulator step (default 1000)\n");
+    printf("  -f, --filter NS       Scan one corner with this tWK_FILTER\n");
+    printf("  -t, --timeout NS      tWK_TIMEOUT for --filter (default: datasheet maximum)\n");
+    printf("  -j, --jobs N          Worker threads (default: number of CPUs)\n");
+    printf("  -c, --count           Only print the number of patterns per corner\n");
+    printf("  -h, --help            Show this help\n");
+    printf("\n");
+    printf("Exit status is 1 if any pattern was found.\n");
+}
+
+int main(int argc, char** argv) {
+    uint64_t step_ns = 1000;
+    uint64_t filter_ns = 0;
+    uint64_t timeout_ns = 0;
+    unsigned jobs = std::thread::hardware_concurrency();
+    bool count_only = false;
+
+    int first_path = argc;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            print_usage(argv[0]);
+            return EXIT_NONE_FOUND;
+        } else if ((strcmp(arg, "-s") == 0 || strcmp(arg, "--step") == 0) && has_value) {
+            step_ns = strtoull(argv[++i], NULL, 0);
+        } else if ((strcmp(arg, "-f") == 0 || strcmp(arg, "--filter") == 0) && has_value) {
+            filter_ns = strtoull(argv[++i], NULL, 0);
+        } else if ((strcmp(arg, "-t") == 0 || strcmp(arg, "--timeout") == 0) && has_value) {
+            timeout_ns = strtoull(argv[++i], NULL, 0);
+        } else if ((strcmp(arg, "-j") == 0 || strcmp(arg, "--jobs") == 0) && has_value) {
+            jobs = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(arg, "-c") == 0 || strcmp(arg, "--count") == 0) {
+            count_only = true;
+        } else if (arg[0] == '-') {
+            fprintf(stderr, "error: unknown or incomplete option '%s'\n", arg);
+            print_usage(argv[0]);
+            return EXIT_USAGE;
+        } else {
+            first_path = i;
+            break;
+        }
+    }
+
+    if (first_path >= argc || step_ns == 0) {
+        print_usage(argv[0]);
+        return EXIT_USAGE;
+    }
+
+    // Datasheet corners, or the single corner given on the command line
+    const DeviceParams* params = tcan1463q1_device_get_params(DEVICE_VARIANT_TCAN1463Q1);
+    WUPScanConfig corners[4];
+    size_t corner_count = 0;
+    if (filter_ns) {
+        corners[0].filter_ns = filter_ns;
+        corners[0].timeout_ns = timeout_ns ? timeout_ns : params->twk_timeout.max_ns;
+        corner_count = 1;
+    } else {
+        uint64_t filters[2] = {params->twk_filter.min_ns, params->twk_filter.max_ns};
+        uint64_t timeouts[2] = {params->twk_timeout.min_ns, params->twk_timeout.max_ns};
+        for (int f = 0; f < 2; f++) {
+            for (int t = 0; t < 2; t++) {
+                corners[corner_count].filter_ns = filters[f];
+                corners[corner_count].timeout_ns = timeouts[t];
+                corner_count++;
+            }
+        }
+    }
+
+    int status = EXIT_NONE_FOUND;
+    for (int i = first_path; i < argc; i++) {
+        WUPScanResult results[4];
+        if (!tcan1463q1_wup_scan_file(argv[i], step_ns, corners, corner_count, jobs, results)) {
+            fprintf(stderr, "error: %s: cannot scan (unreadable or truncated trace)\n", argv[i]);
+            return EXIT_USAGE;
+        }
+
+        for (size_t c = 0; c < corner_count; c++) {
+            printf("%s: filter=%llu ns timeout=%llu ns: %zu pattern(s)\n", argv[i],
+                   (unsigned long long)corners[c].filter_ns,
+                   (unsigned long long)corners[c].timeout_ns, results[c].count);
+            if (!count_only) {
+                for (size_t m = 0; m < results[c].count; m++) {
+                    printf("  start=%llu ns wake=%llu ns\n",
+                           (unsigned long long)results[c].matches[m].start_ns,
+                           (unsigned long long)results[c].matches[m].complete_ns);
+                }
+            }
+            if (results[c].count > 0) status = EXIT_FOUND;
+            tcan1463q1_wup_scan_result_free(&results[c]);
+        }
+    }
+
+    return status;
+}